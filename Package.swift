@@ -38,6 +38,24 @@ let package = Package(
             ]
         ),
 
+        // Performance benchmarks (JSON results for tracking regressions across releases)
+        .executableTarget(
+            name: "ArcaBench",
+            dependencies: [
+                .product(name: "ArgumentParser", package: "swift-argument-parser"),
+                .product(name: "Logging", package: "swift-log"),
+                .product(name: "NIOCore", package: "swift-nio"),
+                .product(name: "NIOPosix", package: "swift-nio"),
+                "ArcaTestSupport",
+                "ContainerBridge",
+            ]
+        ),
+
+        // Shell/daemon helpers shared by the integration tests and ArcaBench
+        .target(
+            name: "ArcaTestSupport"
+        ),
+
         // Daemon server (HTTP/Unix socket server)
         .target(
             name: "ArcaDaemon",
@@ -80,6 +98,7 @@ let package = Package(
             name: "ArcaTests",
             dependencies: [
                 "Arca",
+                "ArcaTestSupport",
                 "ArcaDaemon",
                 "DockerAPI",
                 "ContainerBridge",
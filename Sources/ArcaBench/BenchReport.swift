@@ -0,0 +1,88 @@
+import Foundation
+import ContainerBridge
+
+/// One measured quantity, summarised over its samples
+struct BenchResult: Codable, Sendable {
+    let suite: String
+    let name: String
+    let unit: String
+    let samples: Int
+    let p50: Double
+    let p90: Double
+    let p99: Double
+    let mean: Double
+    let min: Double
+    let max: Double
+
+    init(suite: String, name: String, unit: String, samples values: [Double]) {
+        let sorted = values.sorted()
+        self.suite = suite
+        self.name = name
+        self.unit = unit
+        self.samples = sorted.count
+        self.p50 = Self.percentile(sorted, 0.50)
+        self.p90 = Self.percentile(sorted, 0.90)
+        self.p99 = Self.percentile(sorted, 0.99)
+        self.mean = sorted.isEmpty ? 0 : sorted.reduce(0, +) / Double(sorted.count)
+        self.min = sorted.first ?? 0
+        self.max = sorted.last ?? 0
+    }
+
+    /// Nearest-rank percentile of already sorted values
+    static func percentile(_ sorted: [Double], _ fraction: Double) -> Double {
+        guard !sorted.isEmpty else { return 0 }
+        let rank = Int((fraction * Double(sorted.count)).rounded(.up))
+        return sorted[Swift.min(Swift.max(rank, 1), sorted.count) - 1]
+    }
+}
+
+/// A full benchmark run, written as JSON so results can be compared across releases
+struct BenchReport: Codable, Sendable {
+    struct Host: Codable, Sendable {
+        let model: String
+        let cpuCount: Int
+        let memoryBytes: UInt64
+        let osVersion: String
+
+        static var current: Host {
+            var size = 0
+            sysctlbyname("hw.model", nil, &size, nil, 0)
+            var model = [CChar](repeating: 0, count: Swift.max(size, 1))
+            sysctlbyname("hw.model", &model, &size, nil, 0)
+
+            return Host(
+                model: String(cString: model),
+                cpuCount: ProcessInfo.processInfo.activeProcessorCount,
+                memoryBytes: ProcessInfo.processInfo.physicalMemory,
+                osVersion: ProcessInfo.processInfo.operatingSystemVersionString
+            )
+        }
+    }
+
+    /// Bumped when fields change meaning, so trackers don't compare unlike results
+    var schemaVersion = 1
+    let arcaVersion: String
+    let gitCommit: String
+    let label: String?
+    let host: Host
+    let startedAt: Date
+    var durationSeconds: Double = 0
+    var results: [BenchResult] = []
+    /// Suite name -> why it failed; the other suites still report
+    var failures: [String: String] = [:]
+
+    init(label: String?) {
+        self.arcaVersion = ArcaVersion.version
+        self.gitCommit = ArcaVersion.gitCommit
+        self.label = label
+        self.host = .current
+        self.startedAt = Date()
+    }
+
+    func encoded() throws -> Data {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        encoder.dateEncodingStrategy = .iso8601
+        return try encoder.encode(self)
+    }
+}
@@ -0,0 +1,75 @@
+import Foundation
+import Logging
+import ArcaTestSupport
+
+/// Settings shared by every suite in a run
+struct BenchContext: Sendable {
+    /// Daemon socket the Docker CLI and API client talk to
+    let socketPath: String
+    /// Samples per latency measurement
+    let iterations: Int
+    /// Repetitions of each throughput measurement
+    let rounds: Int
+    /// Containers present while API latency is measured
+    let containerCount: Int
+    /// Small image used for runs and API load (must provide `true` and `ping`)
+    let image: String
+    /// Image providing iperf3 for container-to-container bandwidth
+    let iperfImage: String
+    let logger: Logger
+
+    @discardableResult
+    func docker(_ args: String) throws -> String {
+        try ArcaTestSupport.docker(args, socketPath: socketPath)
+    }
+}
+
+/// A group of related measurements
+protocol BenchSuite: Sendable {
+    /// Name used on the command line and in results
+    static var name: String { get }
+
+    init()
+
+    func run(context: BenchContext) async throws -> [BenchResult]
+}
+
+/// Seconds elapsed while running `body`
+func measure(_ body: () throws -> Void) rethrows -> Double {
+    let start = ContinuousClock.now
+    try body()
+    return seconds(since: start)
+}
+
+/// Seconds elapsed while running `body`
+func measure(_ body: () async throws -> Void) async rethrows -> Double {
+    let start = ContinuousClock.now
+    try await body()
+    return seconds(since: start)
+}
+
+func seconds(since start: ContinuousClock.Instant) -> Double {
+    let elapsed = ContinuousClock.now - start
+    return Double(elapsed.components.seconds) + Double(elapsed.components.attoseconds) / 1e18
+}
+
+/// Errors raised by benchmark suites
+enum BenchError: Error, CustomStringConvertible {
+    case unexpectedOutput(command: String, output: String)
+    case httpStatus(path: String, status: Int)
+    case socket(operation: String, errno: Int32)
+    case timeout(String)
+
+    var description: String {
+        switch self {
+        case .unexpectedOutput(let command, let output):
+            return "Unexpected output from '\(command)': \(output.prefix(200))"
+        case .httpStatus(let path, let status):
+            return "GET \(path) returned HTTP \(status)"
+        case .socket(let operation, let errno):
+            return "Socket \(operation) failed: \(String(cString: strerror(errno)))"
+        case .timeout(let what):
+            return "Timed out waiting for \(what)"
+        }
+    }
+}
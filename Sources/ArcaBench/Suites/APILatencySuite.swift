@@ -0,0 +1,59 @@
+import Foundation
+
+/// API latency for container list and inspect with `containerCount` containers present
+///
+/// The containers are created but not started: list and inspect cost depends on how many
+/// containers the daemon tracks, not on whether their VMs are running.
+struct APILatencySuite: BenchSuite {
+    static let name = "api"
+
+    private static let warmupRequests = 10
+
+    func run(context: BenchContext) async throws -> [BenchResult] {
+        try context.docker("pull \(context.image)")
+
+        let names = (0..<context.containerCount).map { "arca-bench-api-\($0)" }
+        for name in names {
+            try? context.docker("rm -f \(name)")
+            try context.docker("create --name \(name) \(context.image) true")
+        }
+        defer {
+            for name in names {
+                try? context.docker("rm -f \(name)")
+            }
+        }
+
+        let list = try latencies(path: "/containers/json?all=1", context: context)
+        var inspect: [Double] = []
+        for iteration in 0..<context.iterations {
+            let name = names[iteration % names.count]
+            inspect += try latencies(path: "/containers/\(name)/json", context: context, count: 1, warmup: iteration == 0)
+        }
+
+        let suffix = "n\(context.containerCount)"
+        return [
+            BenchResult(suite: Self.name, name: "containers_list_\(suffix)", unit: "milliseconds", samples: list),
+            BenchResult(suite: Self.name, name: "containers_inspect_\(suffix)", unit: "milliseconds", samples: inspect)
+        ]
+    }
+
+    /// Request `path` repeatedly, returning each request's latency in milliseconds
+    private func latencies(path: String, context: BenchContext, count: Int? = nil, warmup: Bool = true) throws -> [Double] {
+        if warmup {
+            for _ in 0..<Self.warmupRequests {
+                _ = try UnixHTTPClient.get(path, socketPath: context.socketPath)
+            }
+        }
+
+        var samples: [Double] = []
+        for _ in 0..<(count ?? context.iterations) {
+            var status = 0
+            let elapsed = try measure {
+                status = try UnixHTTPClient.get(path, socketPath: context.socketPath).status
+            }
+            guard status == 200 else { throw BenchError.httpStatus(path: path, status: status) }
+            samples.append(elapsed * 1000)
+        }
+        return samples
+    }
+}
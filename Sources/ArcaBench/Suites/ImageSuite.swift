@@ -0,0 +1,37 @@
+import Foundation
+
+/// Image pull and load time
+///
+/// Every sample starts with the image removed, so pulls download and unpack in full.
+/// Loads replay an archive saved from the pulled image.
+struct ImageSuite: BenchSuite {
+    static let name = "images"
+
+    func run(context: BenchContext) async throws -> [BenchResult] {
+        var pull: [Double] = []
+        for _ in 0..<context.rounds {
+            try? context.docker("rmi -f \(context.image)")
+            pull.append(try measure {
+                try context.docker("pull \(context.image)")
+            })
+        }
+
+        let archive = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-bench-image-\(UUID().uuidString).tar")
+        defer { try? FileManager.default.removeItem(at: archive) }
+        try context.docker("save -o \(archive.path) \(context.image)")
+
+        var load: [Double] = []
+        for _ in 0..<context.rounds {
+            try? context.docker("rmi -f \(context.image)")
+            load.append(try measure {
+                try context.docker("load -i \(archive.path)")
+            })
+        }
+
+        return [
+            BenchResult(suite: Self.name, name: "pull", unit: "seconds", samples: pull),
+            BenchResult(suite: Self.name, name: "load", unit: "seconds", samples: load)
+        ]
+    }
+}
@@ -0,0 +1,52 @@
+import Foundation
+import ContainerBridge
+
+/// Log ingest rate through FileLogWriter
+///
+/// Feeds typical container output (80-column lines in 4 KB writes) into a json-file log,
+/// the path every line a container prints takes on the way to `docker logs`.
+struct LogIngestSuite: BenchSuite {
+    static let name = "logs"
+
+    /// Output bytes written per round
+    private static let bytesPerRound = 64 << 20
+    private static let writeSize = 4096
+    private static let lineLength = 80
+
+    func run(context: BenchContext) async throws -> [BenchResult] {
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-bench-logs-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: directory) }
+
+        let chunk = Self.outputChunk()
+        let linesPerChunk = Self.writeSize / Self.lineLength
+        let writes = Self.bytesPerRound / chunk.count
+
+        var throughput: [Double] = []
+        var lineRate: [Double] = []
+        for round in 0..<context.rounds {
+            let writer = try FileLogWriter(path: directory.appendingPathComponent("\(round)-json.log"), stream: "stdout")
+            let elapsed = try measure {
+                for _ in 0..<writes {
+                    try writer.write(chunk)
+                }
+                try writer.close()
+            }
+            throughput.append(Double(writes * chunk.count) / elapsed / 1_000_000)
+            lineRate.append(Double(writes * linesPerChunk) / elapsed)
+        }
+
+        return [
+            BenchResult(suite: Self.name, name: "json_file_throughput", unit: "MB/s", samples: throughput),
+            BenchResult(suite: Self.name, name: "json_file_line_rate", unit: "lines/s", samples: lineRate)
+        ]
+    }
+
+    /// One write's worth of newline-terminated printable lines
+    private static func outputChunk() -> Data {
+        let line = String(repeating: "arca bench log line ", count: lineLength / 20 + 1)
+            .prefix(lineLength - 1) + "\n"
+        return Data(String(repeating: String(line), count: writeSize / lineLength).utf8)
+    }
+}
@@ -0,0 +1,234 @@
+import Foundation
+import Logging
+import NIOCore
+import NIOPosix
+import ContainerBridge
+
+/// TCPProxy and UDPProxy throughput on loopback
+///
+/// Runs in-process against a local sink, so it measures the proxies themselves rather than
+/// the container network behind them. A direct (unproxied) TCP transfer is reported
+/// alongside as the ceiling.
+struct ProxySuite: BenchSuite {
+    static let name = "proxy"
+
+    /// Bytes sent per TCP round
+    private static let tcpBytes = 1 << 30
+    private static let tcpChunk = 64 * 1024
+    /// Datagrams sent per UDP round
+    private static let udpDatagrams = 200_000
+    private static let udpPayload = 1200
+
+    func run(context: BenchContext) async throws -> [BenchResult] {
+        let group = MultiThreadedEventLoopGroup(numberOfThreads: System.coreCount)
+        defer { try? group.syncShutdownGracefully() }
+
+        var direct: [Double] = []
+        var proxied: [Double] = []
+        var udpRate: [Double] = []
+        var udpThroughput: [Double] = []
+        var udpLoss: [Double] = []
+
+        for _ in 0..<context.rounds {
+            direct.append(try await tcpThroughput(group: group, logger: context.logger, proxied: false))
+            proxied.append(try await tcpThroughput(group: group, logger: context.logger, proxied: true))
+
+            let udp = try await udpRound(group: group, logger: context.logger)
+            udpRate.append(udp.packetsPerSecond)
+            udpThroughput.append(udp.packetsPerSecond * Double(Self.udpPayload) / 1_000_000)
+            udpLoss.append(udp.lossPercent)
+        }
+
+        return [
+            BenchResult(suite: Self.name, name: "tcp_direct_throughput", unit: "MB/s", samples: direct),
+            BenchResult(suite: Self.name, name: "tcp_proxy_throughput", unit: "MB/s", samples: proxied),
+            BenchResult(suite: Self.name, name: "udp_proxy_packet_rate", unit: "packets/s", samples: udpRate),
+            BenchResult(suite: Self.name, name: "udp_proxy_throughput", unit: "MB/s", samples: udpThroughput),
+            BenchResult(suite: Self.name, name: "udp_proxy_loss", unit: "percent", samples: udpLoss)
+        ]
+    }
+
+    // MARK: - TCP
+
+    private func tcpThroughput(group: EventLoopGroup, logger: Logger, proxied: Bool) async throws -> Double {
+        let counter = ByteCounter()
+        let sink = try await ServerBootstrap(group: group)
+            .childChannelInitializer { $0.pipeline.addHandler(CountingHandler(counter: counter)) }
+            .bind(host: "127.0.0.1", port: 0).get()
+        defer { sink.close(promise: nil) }
+        let sinkPort = sink.localAddress?.port ?? 0
+
+        var targetPort = sinkPort
+        var proxy: TCPProxy?
+        if proxied {
+            let port = try await freePort(group: group)
+            let tcpProxy = TCPProxy(
+                listenAddress: "127.0.0.1",
+                listenPort: port,
+                targetAddress: "127.0.0.1",
+                targetPort: sinkPort,
+                group: group,
+                logger: logger
+            )
+            try await tcpProxy.start()
+            proxy = tcpProxy
+            targetPort = port
+        }
+
+        let client = try await ClientBootstrap(group: group)
+            .channelOption(ChannelOptions.socketOption(.tcp_nodelay), value: 1)
+            .connect(host: "127.0.0.1", port: targetPort).get()
+
+        var chunk = client.allocator.buffer(capacity: Self.tcpChunk)
+        chunk.writeRepeatingByte(0x61, count: Self.tcpChunk)
+
+        let elapsed = try await measure {
+            // Write in 1 MB batches, waiting for each batch, so the client never queues more
+            var sent = 0
+            while sent < Self.tcpBytes {
+                for _ in 0..<15 {
+                    client.write(chunk, promise: nil)
+                }
+                try await client.writeAndFlush(chunk).get()
+                sent += 16 * Self.tcpChunk
+            }
+            try await counter.wait(for: sent)
+        }
+
+        try? await client.close()
+        try? await proxy?.stop()
+        return Double(Self.tcpBytes) / elapsed / 1_000_000
+    }
+
+    // MARK: - UDP
+
+    private func udpRound(group: EventLoopGroup, logger: Logger) async throws -> (packetsPerSecond: Double, lossPercent: Double) {
+        let counter = ByteCounter()
+        let sink = try await DatagramBootstrap(group: group)
+            .channelOption(ChannelOptions.socketOption(.so_rcvbuf), value: 8 << 20)
+            .channelInitializer { $0.pipeline.addHandler(CountingDatagramHandler(counter: counter)) }
+            .bind(host: "127.0.0.1", port: 0).get()
+        defer { sink.close(promise: nil) }
+
+        let port = try await freePort(group: group)
+        let proxy = UDPProxy(
+            listenAddress: "127.0.0.1",
+            listenPort: port,
+            targetAddress: "127.0.0.1",
+            targetPort: sink.localAddress?.port ?? 0,
+            group: group,
+            logger: logger
+        )
+        try await proxy.start()
+
+        let client = try await DatagramBootstrap(group: group)
+            .channelOption(ChannelOptions.socketOption(.so_sndbuf), value: 8 << 20)
+            .bind(host: "127.0.0.1", port: 0).get()
+        defer { client.close(promise: nil) }
+        let target = try SocketAddress(ipAddress: "127.0.0.1", port: port)
+
+        var payload = client.allocator.buffer(capacity: Self.udpPayload)
+        payload.writeRepeatingByte(0x62, count: Self.udpPayload)
+        let envelope = AddressedEnvelope(remoteAddress: target, data: payload)
+
+        let start = ContinuousClock.now
+        var sent = 0
+        while sent < Self.udpDatagrams {
+            for _ in 0..<63 {
+                client.write(envelope, promise: nil)
+            }
+            try await client.writeAndFlush(envelope).get()
+            sent += 64
+        }
+
+        // Datagrams can be dropped; stop once nothing has arrived for a while
+        var last = counter.messages
+        while true {
+            try await Task.sleep(for: .milliseconds(200))
+            let now = counter.messages
+            if now == last || now >= sent { break }
+            last = now
+        }
+        let received = counter.messages
+        let elapsed = seconds(since: start)
+        try? await proxy.stop()
+
+        return (Double(received) / elapsed, 100 * Double(sent - min(received, sent)) / Double(sent))
+    }
+
+    // MARK: - Helpers
+
+    private func freePort(group: EventLoopGroup) async throws -> Int {
+        let probe = try await ServerBootstrap(group: group).bind(host: "127.0.0.1", port: 0).get()
+        let port = probe.localAddress?.port ?? 0
+        try await probe.close()
+        return port
+    }
+}
+
+/// Bytes and messages received by a sink, with a way to wait for a total
+/// @unchecked Sendable: Safe because all state is protected by NSLock
+private final class ByteCounter: @unchecked Sendable {
+    private let lock = NSLock()
+    private var bytes = 0
+    private var count = 0
+    private var waiter: (target: Int, continuation: CheckedContinuation<Void, Error>)?
+
+    var messages: Int {
+        lock.withLock { count }
+    }
+
+    func add(_ received: Int) {
+        lock.lock()
+        bytes += received
+        count += 1
+        var ready: CheckedContinuation<Void, Error>?
+        if let waiter = waiter, bytes >= waiter.target {
+            ready = waiter.continuation
+            self.waiter = nil
+        }
+        lock.unlock()
+        ready?.resume()
+    }
+
+    func wait(for target: Int) async throws {
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+            lock.lock()
+            if bytes >= target {
+                lock.unlock()
+                continuation.resume()
+                return
+            }
+            waiter = (target, continuation)
+            lock.unlock()
+        }
+    }
+}
+
+private final class CountingHandler: ChannelInboundHandler {
+    typealias InboundIn = ByteBuffer
+
+    private let counter: ByteCounter
+
+    init(counter: ByteCounter) {
+        self.counter = counter
+    }
+
+    func channelRead(context: ChannelHandlerContext, data: NIOAny) {
+        counter.add(unwrapInboundIn(data).readableBytes)
+    }
+}
+
+private final class CountingDatagramHandler: ChannelInboundHandler {
+    typealias InboundIn = AddressedEnvelope<ByteBuffer>
+
+    private let counter: ByteCounter
+
+    init(counter: ByteCounter) {
+        self.counter = counter
+    }
+
+    func channelRead(context: ChannelHandlerContext, data: NIOAny) {
+        counter.add(unwrapInboundIn(data).data.readableBytes)
+    }
+}
@@ -0,0 +1,83 @@
+import Foundation
+
+/// `docker run` latency, cold (image not present) and warm, broken down by phase
+///
+/// Phase boundaries come from the daemon's own container events, so each run is split into:
+/// - `pull_and_create`: CLI start until the create event (includes the pull when cold)
+/// - `start`: create event until the start event (VM boot and process launch)
+/// - `run`: start event until the die event (the command itself is `true`)
+/// - `exit`: die event until the CLI returns
+struct RunLatencySuite: BenchSuite {
+    static let name = "run"
+
+    private static let phases = ["pull_and_create", "start", "run", "exit", "total"]
+
+    func run(context: BenchContext) async throws -> [BenchResult] {
+        var cold: [String: [Double]] = [:]
+        var warm: [String: [Double]] = [:]
+
+        for round in 0..<context.rounds {
+            try? context.docker("rmi -f \(context.image)")
+            let phases = try timedRun(context: context, name: "arca-bench-run-cold-\(round)")
+            for (phase, value) in phases { cold[phase, default: []].append(value) }
+        }
+
+        try context.docker("pull \(context.image)")
+        for iteration in 0..<context.iterations {
+            let phases = try timedRun(context: context, name: "arca-bench-run-warm-\(iteration)")
+            for (phase, value) in phases { warm[phase, default: []].append(value) }
+        }
+
+        var results: [BenchResult] = []
+        for phase in Self.phases {
+            results.append(BenchResult(suite: Self.name, name: "cold_\(phase)", unit: "seconds", samples: cold[phase] ?? []))
+        }
+        for phase in Self.phases {
+            results.append(BenchResult(suite: Self.name, name: "warm_\(phase)", unit: "seconds", samples: warm[phase] ?? []))
+        }
+        return results
+    }
+
+    /// Run one container to completion and split its latency by phase
+    private func timedRun(context: BenchContext, name: String) throws -> [String: Double] {
+        try? context.docker("rm -f \(name)")
+
+        let started = Date()
+        try context.docker("run --name \(name) \(context.image) true")
+        let finished = Date()
+        defer { try? context.docker("rm -f \(name)") }
+
+        // --until is exclusive at second granularity
+        let since = Int(started.timeIntervalSince1970)
+        let until = Int(finished.timeIntervalSince1970) + 1
+        let output = try context.docker(
+            "events --since \(since) --until \(until) --filter container=\(name) --format '{{json .}}'"
+        )
+
+        var eventTimes: [String: Double] = [:]
+        for line in output.split(separator: "\n") {
+            guard let data = line.data(using: .utf8),
+                  let event = try? JSONSerialization.jsonObject(with: data) as? [String: Any],
+                  let action = event["Action"] as? String ?? event["status"] as? String,
+                  let timeNano = (event["timeNano"] as? NSNumber)?.doubleValue else {
+                continue
+            }
+            // Keep the first occurrence of each action
+            if eventTimes[action] == nil {
+                eventTimes[action] = timeNano / 1e9
+            }
+        }
+
+        guard let create = eventTimes["create"], let start = eventTimes["start"], let die = eventTimes["die"] else {
+            throw BenchError.unexpectedOutput(command: "docker events for \(name)", output: output)
+        }
+
+        return [
+            "pull_and_create": create - started.timeIntervalSince1970,
+            "start": start - create,
+            "run": die - start,
+            "exit": finished.timeIntervalSince1970 - die,
+            "total": finished.timeIntervalSince(started)
+        ]
+    }
+}
@@ -0,0 +1,73 @@
+import Foundation
+
+/// Container-to-container RTT and bandwidth over a WireGuard bridge network
+///
+/// Bridge networks use the WireGuard backend by default. RTT is measured with `ping` from
+/// `image`, bandwidth with iperf3 from `iperfImage`, both against an iperf3 server container
+/// on the same network.
+struct WireGuardSuite: BenchSuite {
+    static let name = "wireguard"
+
+    private static let network = "arca-bench-wg"
+    private static let server = "arca-bench-wg-server"
+    private static let iperfSeconds = 10
+
+    func run(context: BenchContext) async throws -> [BenchResult] {
+        try context.docker("pull \(context.image)")
+        try context.docker("pull \(context.iperfImage)")
+
+        cleanup(context: context)
+        try context.docker("network create \(Self.network)")
+        defer { cleanup(context: context) }
+        try context.docker("run -d --name \(Self.server) --network \(Self.network) \(context.iperfImage) -s")
+
+        let ping = try context.docker(
+            "run --rm --network \(Self.network) \(context.image) ping -c \(context.iterations) -i 0.2 \(Self.server)"
+        )
+        let rtt = Self.pingTimes(ping)
+        guard !rtt.isEmpty else {
+            throw BenchError.unexpectedOutput(command: "ping \(Self.server)", output: ping)
+        }
+
+        var bandwidth: [Double] = []
+        for _ in 0..<context.rounds {
+            let output = try context.docker(
+                "run --rm --network \(Self.network) \(context.iperfImage) -c \(Self.server) -t \(Self.iperfSeconds) -J"
+            )
+            guard let bitsPerSecond = Self.iperfReceivedBitsPerSecond(output) else {
+                throw BenchError.unexpectedOutput(command: "iperf3 -c \(Self.server)", output: output)
+            }
+            bandwidth.append(bitsPerSecond / 1_000_000)
+        }
+
+        return [
+            BenchResult(suite: Self.name, name: "container_rtt", unit: "milliseconds", samples: rtt),
+            BenchResult(suite: Self.name, name: "container_bandwidth", unit: "Mbit/s", samples: bandwidth)
+        ]
+    }
+
+    private func cleanup(context: BenchContext) {
+        try? context.docker("rm -f \(Self.server)")
+        try? context.docker("network rm \(Self.network)")
+    }
+
+    /// Per-reply times from ping output ("... time=0.512 ms")
+    static func pingTimes(_ output: String) -> [Double] {
+        output.split(separator: "\n").compactMap { line in
+            guard let range = line.range(of: "time=") else { return nil }
+            let value = line[range.upperBound...].prefix { $0.isNumber || $0 == "." }
+            return Double(value)
+        }
+    }
+
+    /// Receiver-side bandwidth from iperf3 JSON output
+    static func iperfReceivedBitsPerSecond(_ output: String) -> Double? {
+        guard let data = output.data(using: .utf8),
+              let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any],
+              let end = json["end"] as? [String: Any],
+              let received = end["sum_received"] as? [String: Any] else {
+            return nil
+        }
+        return (received["bits_per_second"] as? NSNumber)?.doubleValue
+    }
+}
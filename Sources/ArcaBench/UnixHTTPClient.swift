@@ -0,0 +1,115 @@
+import Foundation
+import Darwin
+
+/// Minimal HTTP/1.1 client over the daemon's Unix socket
+///
+/// API latency is measured with direct requests rather than the Docker CLI, whose process
+/// startup would dominate a sub-millisecond endpoint. Each request opens its own connection,
+/// the way the CLI does.
+enum UnixHTTPClient {
+    /// GET `path`, returning the status code and the size of the body read
+    static func get(_ path: String, socketPath: String) throws -> (status: Int, bodyBytes: Int) {
+        let fd = socket(AF_UNIX, SOCK_STREAM, 0)
+        guard fd >= 0 else { throw BenchError.socket(operation: "socket", errno: errno) }
+        defer { close(fd) }
+
+        var address = sockaddr_un()
+        address.sun_family = sa_family_t(AF_UNIX)
+        let pathBytes = Array(socketPath.utf8)
+        guard pathBytes.count < MemoryLayout.size(ofValue: address.sun_path) else {
+            throw BenchError.socket(operation: "connect", errno: ENAMETOOLONG)
+        }
+        withUnsafeMutableBytes(of: &address.sun_path) { buffer in
+            buffer.copyBytes(from: pathBytes)
+        }
+        let connected = withUnsafePointer(to: &address) { pointer in
+            pointer.withMemoryRebound(to: sockaddr.self, capacity: 1) {
+                connect(fd, $0, socklen_t(MemoryLayout<sockaddr_un>.size))
+            }
+        }
+        guard connected == 0 else { throw BenchError.socket(operation: "connect", errno: errno) }
+
+        let request = Array("GET \(path) HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n".utf8)
+        var sent = 0
+        while sent < request.count {
+            let n = request[sent...].withUnsafeBytes { Darwin.write(fd, $0.baseAddress, $0.count) }
+            guard n > 0 else { throw BenchError.socket(operation: "write", errno: errno) }
+            sent += n
+        }
+
+        return try readResponse(fd: fd, path: path)
+    }
+
+    /// Read one response, using Content-Length or chunked framing to find its end
+    private static func readResponse(fd: Int32, path: String) throws -> (status: Int, bodyBytes: Int) {
+        var received: [UInt8] = []
+        var chunk = [UInt8](repeating: 0, count: 64 * 1024)
+        let terminator: [UInt8] = Array("\r\n\r\n".utf8)
+
+        func readMore() throws -> Bool {
+            let n = chunk.withUnsafeMutableBytes { Darwin.read(fd, $0.baseAddress, $0.count) }
+            if n < 0 { throw BenchError.socket(operation: "read", errno: errno) }
+            received.append(contentsOf: chunk[0..<n])
+            return n > 0
+        }
+
+        var headerEnd: Int?
+        while headerEnd == nil {
+            guard try readMore() else { throw BenchError.socket(operation: "read", errno: ECONNRESET) }
+            headerEnd = firstRange(of: terminator, in: received)
+        }
+
+        let head = String(decoding: received[0..<headerEnd!], as: UTF8.self)
+        let lines = head.components(separatedBy: "\r\n")
+        let statusParts = lines.first?.split(separator: " ") ?? []
+        guard statusParts.count >= 2, let status = Int(statusParts[1]) else {
+            throw BenchError.unexpectedOutput(command: "GET \(path)", output: head)
+        }
+
+        var contentLength: Int?
+        var chunked = false
+        for line in lines.dropFirst() {
+            let lower = line.lowercased()
+            if lower.hasPrefix("content-length:") {
+                contentLength = Int(lower.dropFirst("content-length:".count).trimmingCharacters(in: .whitespaces))
+            } else if lower.hasPrefix("transfer-encoding:") && lower.contains("chunked") {
+                chunked = true
+            }
+        }
+
+        let bodyStart = headerEnd! + terminator.count
+        if let length = contentLength {
+            while received.count - bodyStart < length {
+                guard try readMore() else { break }
+            }
+        } else if chunked {
+            let lastChunk: [UInt8] = Array("0\r\n\r\n".utf8)
+            var searchFrom = bodyStart
+            while firstRange(of: lastChunk, in: received[searchFrom...]) == nil {
+                // Only the tail can complete the terminator after the next read
+                searchFrom = Swift.max(bodyStart, received.count - lastChunk.count)
+                guard try readMore() else { break }
+            }
+        } else {
+            while try readMore() {}
+        }
+
+        return (status, received.count - bodyStart)
+    }
+
+    private static func firstRange(of needle: [UInt8], in haystack: ArraySlice<UInt8>) -> Int? {
+        guard haystack.count >= needle.count else { return nil }
+        var index = haystack.startIndex
+        while index <= haystack.endIndex - needle.count {
+            if haystack[index..<(index + needle.count)].elementsEqual(needle) {
+                return index
+            }
+            index += 1
+        }
+        return nil
+    }
+
+    private static func firstRange(of needle: [UInt8], in haystack: [UInt8]) -> Int? {
+        firstRange(of: needle, in: haystack[...])
+    }
+}
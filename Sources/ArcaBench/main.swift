@@ -0,0 +1,156 @@
+import ArgumentParser
+import ArcaTestSupport
+import ContainerBridge
+import Foundation
+import Logging
+
+/// ArcaBench - Reproducible performance benchmarks for Arca
+///
+/// Runs against a daemon (an existing one, or one it starts) and writes a JSON report so
+/// results can be tracked across releases. Suites that fail are recorded in the report and
+/// the remaining suites still run.
+@main
+struct ArcaBench: AsyncParsableCommand {
+    static let configuration = CommandConfiguration(
+        commandName: "arca-bench",
+        abstract: "Arca performance benchmarks",
+        discussion: """
+            Suites:
+              run        docker run latency, cold and warm, by phase
+              api        /containers/json and inspect p50/p99 with N containers
+              proxy      TCPProxy/UDPProxy throughput on loopback (no daemon needed)
+              wireguard  container-to-container RTT and bandwidth
+              logs       FileLogWriter ingest rate (no daemon needed)
+              images     image pull and load time
+            """,
+        version: ArcaVersion.fullVersion
+    )
+
+    static let allSuites: [any BenchSuite.Type] = [
+        RunLatencySuite.self,
+        APILatencySuite.self,
+        ProxySuite.self,
+        WireGuardSuite.self,
+        LogIngestSuite.self,
+        ImageSuite.self
+    ]
+
+    @Option(name: .long, help: "Comma-separated suites to run (default: all)")
+    var suites: String?
+
+    @Option(
+        name: .long,
+        help: "Unix socket path for the daemon (default: ~/.arca/arca.sock)"
+    )
+    var socketPath: String = {
+        let homeDir = FileManager.default.homeDirectoryForCurrentUser.path
+        return "\(homeDir)/.arca/arca.sock"
+    }()
+
+    @Flag(name: .long, help: "Start a fresh daemon on --socket-path (clears ~/.arca/state.db) instead of using a running one")
+    var startDaemon: Bool = false
+
+    @Option(name: .long, help: "Arca binary used with --start-daemon")
+    var arcaBinary: String = ".build/release/Arca"
+
+    @Option(name: .long, help: "Samples per latency measurement")
+    var iterations: Int = 50
+
+    @Option(name: .long, help: "Repetitions of each throughput and cold-start measurement")
+    var rounds: Int = 3
+
+    @Option(name: .long, help: "Containers present while API latency is measured")
+    var containers: Int = 50
+
+    @Option(name: .long, help: "Image for run, API and image suites")
+    var image: String = "alpine:latest"
+
+    @Option(name: .long, help: "Image providing iperf3 for the wireguard suite")
+    var iperfImage: String = "networkstatic/iperf3:latest"
+
+    @Option(name: .long, help: "Label stored in the report (e.g. a release or branch name)")
+    var label: String?
+
+    @Option(name: .shortAndLong, help: "Write the JSON report here instead of stdout")
+    var output: String?
+
+    @Option(name: .long, help: "Log level (trace, debug, info, warning, error, critical)")
+    var logLevel: String = "warning"
+
+    func validate() throws {
+        guard iterations > 0, rounds > 0, containers > 0 else {
+            throw ValidationError("--iterations, --rounds and --containers must be positive")
+        }
+        let known = Set(Self.allSuites.map { $0.name })
+        for name in requestedSuiteNames where !known.contains(name) {
+            throw ValidationError("Unknown suite '\(name)' (known: \(Self.allSuites.map { $0.name }.joined(separator: ", ")))")
+        }
+    }
+
+    func run() async throws {
+        var logger = Logger(label: "com.vassolutus.arca.bench")
+        logger.logLevel = Logger.Level(rawValue: logLevel) ?? .warning
+
+        var daemonPID: Int32?
+        if startDaemon {
+            let logFile = FileManager.default.temporaryDirectory.appendingPathComponent("arca-bench-daemon.log").path
+            daemonPID = try ArcaTestSupport.startDaemon(socketPath: socketPath, arcaBinary: arcaBinary, logFile: logFile)
+            log("Started daemon (pid \(daemonPID!), log \(logFile))")
+        }
+        defer {
+            if let pid = daemonPID {
+                try? stopDaemon(pid: pid)
+            }
+        }
+
+        let context = BenchContext(
+            socketPath: socketPath,
+            iterations: iterations,
+            rounds: rounds,
+            containerCount: containers,
+            image: image,
+            iperfImage: iperfImage,
+            logger: logger
+        )
+
+        let selected = requestedSuiteNames
+        var report = BenchReport(label: label)
+        let start = ContinuousClock.now
+
+        for suite in Self.allSuites where selected.isEmpty || selected.contains(suite.name) {
+            log("Running \(suite.name)...")
+            let suiteStart = ContinuousClock.now
+            do {
+                let results = try await suite.init().run(context: context)
+                report.results += results
+                log("  \(suite.name): \(results.count) results in \(String(format: "%.1f", seconds(since: suiteStart)))s")
+            } catch {
+                report.failures[suite.name] = "\(error)"
+                log("  \(suite.name) failed: \(error)")
+            }
+        }
+        report.durationSeconds = seconds(since: start)
+
+        let data = try report.encoded()
+        if let output = output {
+            try data.write(to: URL(fileURLWithPath: output))
+            log("Wrote \(output)")
+        } else {
+            FileHandle.standardOutput.write(data)
+            FileHandle.standardOutput.write(Data("\n".utf8))
+        }
+
+        if !report.failures.isEmpty {
+            throw ExitCode(1)
+        }
+    }
+
+    private var requestedSuiteNames: [String] {
+        suites?.split(separator: ",").map { $0.trimmingCharacters(in: .whitespaces) } ?? []
+    }
+
+    /// Progress goes to stderr so stdout stays valid JSON
+    private func log(_ message: String) {
+        FileHandle.standardError.write(Data("\(message)\n".utf8))
+    }
+}
@@ -5,13 +5,16 @@ import DockerAPI
 /// Middleware that normalizes Docker API version prefixes
 /// Transforms paths like /v1.51/containers/json to /containers/json
 /// This allows route handlers to be registered without version prefixes
+///
+/// Router skips the prefix itself while walking its route trie, so the daemon no longer
+/// installs this middleware; it remains for middleware that wants the normalized URI.
 public struct APIVersionNormalizer: Middleware {
 
     public init() {}
 
     public func handle(_ request: HTTPRequest, next: @Sendable @escaping (HTTPRequest) async -> HTTPResponseType) async -> HTTPResponseType {
         // Normalize the path by removing API version prefix
-        let normalizedPath = normalizePath(request.path)
+        let normalizedPath = Self.normalizePath(request.path)
 
         // If path was normalized, create new request with normalized path
         if normalizedPath != request.path {
@@ -30,6 +33,7 @@ public struct APIVersionNormalizer: Middleware {
                 uri: newURI,
                 headers: request.headers,
                 body: request.body,
+                bodyStream: request.bodyStream,
                 pathParameters: request.pathParameters
             )
 
@@ -45,21 +49,39 @@ public struct APIVersionNormalizer: Middleware {
     ///   /v1.51/containers/json -> /containers/json
     ///   /v1.24/version -> /version
     ///   /version -> /version (unchanged)
-    private func normalizePath(_ path: String) -> String {
-        // Match /vX.Y/ prefix (e.g., /v1.51/, /v1.24/)
-        let versionPattern = #"^/v\d+\.\d+(/.*)?$"#
-        guard let regex = try? NSRegularExpression(pattern: versionPattern),
-              let match = regex.firstMatch(in: path, range: NSRange(path.startIndex..., in: path)) else {
-            return path
-        }
+    static func normalizePath(_ path: String) -> String {
+        let stripped = strippingVersionPrefix(path[...])
+        return stripped.startIndex == path.startIndex ? path : String(stripped)
+    }
+
+    /// Drop a leading /vX.Y segment, keeping the "/" that starts the rest of the path
+    /// Scans the bytes directly; Router calls this on every request
+    static func strippingVersionPrefix(_ path: Substring) -> Substring {
+        let utf8 = path.utf8
+        var index = utf8.startIndex
+        guard index != utf8.endIndex, utf8[index] == UInt8(ascii: "/") else { return path }
+        let slash = index
+        index = utf8.index(after: index)
+        guard index != utf8.endIndex, utf8[index] == UInt8(ascii: "v") else { return path }
+        index = utf8.index(after: index)
 
-        // If there's a capture group (the part after version), return it
-        if match.numberOfRanges > 1,
-           let captureRange = Range(match.range(at: 1), in: path) {
-            let captured = String(path[captureRange])
-            return captured.isEmpty ? "/" : captured
+        // Major version digits, ".", minor version digits
+        func skipDigits() -> Bool {
+            let start = index
+            while index != utf8.endIndex, (UInt8(ascii: "0")...UInt8(ascii: "9")).contains(utf8[index]) {
+                index = utf8.index(after: index)
+            }
+            return index != start
         }
+        guard skipDigits(), index != utf8.endIndex, utf8[index] == UInt8(ascii: ".") else { return path }
+        index = utf8.index(after: index)
+        guard skipDigits() else { return path }
 
-        return path
+        if index == utf8.endIndex {
+            // "/v1.51" alone is the root
+            return path[slash...slash]
+        }
+        guard utf8[index] == UInt8(ascii: "/") else { return path }
+        return path[index...]
     }
 }
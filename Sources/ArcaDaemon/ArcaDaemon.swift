@@ -39,7 +39,13 @@ public final class ArcaDaemon: @unchecked Sendable {
             config = ArcaConfig(
                 kernelPath: kernelPath,
                 socketPath: config.socketPath,
-                logLevel: config.logLevel
+                logLevel: config.logLevel,
+                logDriver: config.logDriver,
+                healthChecks: config.healthChecks,
+                layerCache: config.layerCache,
+                pulls: config.pulls,
+                outputBuffer: config.outputBuffer,
+                tracing: config.tracing
             )
         }
 
@@ -52,6 +58,8 @@ public final class ArcaDaemon: @unchecked Sendable {
         // Validate that kernel exists
         try configManager.validateConfig(config)
 
+        Tracing.configure(config.tracing, logger: logger)
+
         // Check if socket already exists (daemon might be running)
         if ArcaServer.socketExists(at: socketPath) {
             logger.warning("Socket file already exists", metadata: [
@@ -66,7 +74,7 @@ public final class ArcaDaemon: @unchecked Sendable {
         }
 
         // Initialize ImageManager
-        let imageManager = try ImageManager(logger: logger, imageStorePath: nil)
+        let imageManager = try ImageManager(logger: logger, imageStorePath: nil, pullConfig: config.pulls)
         self.imageManager = imageManager
 
         do {
@@ -164,6 +172,9 @@ public final class ArcaDaemon: @unchecked Sendable {
             imageManager: imageManager,
             kernelPath: config.kernelPath,
             stateStore: stateStore,
+            logDriver: config.logDriver ?? .jsonFile,
+            layerCache: config.layerCache,
+            outputBuffer: config.outputBuffer,
             logger: logger
         )
         self.containerManager = containerManager
@@ -175,7 +186,15 @@ public final class ArcaDaemon: @unchecked Sendable {
         // Initialize HealthChecker BEFORE containerManager.initialize()
         // This ensures health checks are available when containers are auto-restarted via restart policies
         logger.info("Initializing health checker...")
-        let healthChecker = HealthChecker(logger: logger, execManager: execManager)
+        // Checks run over each container's persistent control channels when it has them
+        let healthChecker = HealthChecker(
+            logger: logger,
+            execManager: execManager,
+            config: config.healthChecks,
+            controlChannels: { [weak containerManager] id in
+                await containerManager?.getControlChannels(id: id)
+            }
+        )
         await containerManager.setHealthChecker(healthChecker)
         logger.debug("ContainerManager configured with HealthChecker")
 
@@ -262,6 +281,13 @@ public final class ArcaDaemon: @unchecked Sendable {
         await containerManager.setPortMapManager(portMapManager)
         logger.debug("ContainerManager configured with PortMapManager")
 
+        registerMetricCollectors(
+            containerManager: containerManager,
+            imageManager: imageManager,
+            eventManager: eventManager,
+            portMapManager: portMapManager
+        )
+
         // Apply restart policies in background - don't block daemon startup!
         // All managers are wired up, so containers can restart now
         Task { [containerManager, logger] in
@@ -277,9 +303,16 @@ public final class ArcaDaemon: @unchecked Sendable {
         }
 
         // Create router builder, register middlewares and routes
+        // API version prefixes (/v1.51/...) are skipped by the router's trie walk
         let builder = Router.builder(logger: logger)
             .use(RequestLogger(logger: logger))
-            .use(APIVersionNormalizer())
+
+        // Stats sampling ends whichever path removes a container
+        let statsSampler = StatsSampler(containerManager: containerManager, logger: logger)
+        await containerManager.setRemovalObserver { [statsSampler] dockerID in
+            await statsSampler.stop(dockerID: dockerID)
+        }
+
         registerRoutes(
             builder: builder,
             containerManager: containerManager,
@@ -287,7 +320,8 @@ public final class ArcaDaemon: @unchecked Sendable {
             execManager: execManager,
             networkManager: networkManager,
             volumeManager: volumeManager,
-            eventManager: eventManager
+            eventManager: eventManager,
+            statsSampler: statsSampler
         )
         let router = builder.build()
 
@@ -331,12 +365,13 @@ public final class ArcaDaemon: @unchecked Sendable {
         execManager: ExecManager,
         networkManager: NetworkManager?,
         volumeManager: VolumeManager?,
-        eventManager: EventManager
+        eventManager: EventManager,
+        statsSampler: StatsSampler
     ) {
         logger.info("Registering API routes")
 
         // Create handlers
-        let containerHandlers = ContainerHandlers(containerManager: containerManager, imageManager: imageManager, execManager: execManager, logger: logger)
+        let containerHandlers = ContainerHandlers(containerManager: containerManager, imageManager: imageManager, execManager: execManager, statsSampler: statsSampler, logger: logger)
         let imageHandlers = ImageHandlers(imageManager: imageManager, logger: logger)
         let execHandlers = ExecHandlers(execManager: execManager, logger: logger)
         let networkHandlers = networkManager.map { NetworkHandlers(networkManager: $0, containerManager: containerManager, logger: logger) }
@@ -375,6 +410,23 @@ public final class ArcaDaemon: @unchecked Sendable {
             return .standard(HTTPResponse.json(response))
         }
 
+        // Prometheus metrics (not part of the Docker API)
+        Metrics.shared.register { [statsSampler] in
+            let activity = await statsSampler.activity()
+            return [
+                .gauge("arca_stats_streams", help: "Containers with an active stats sampling loop", value: Double(activity.containers)),
+                .gauge("arca_stats_subscribers", help: "Stats stream clients", value: Double(activity.subscribers))
+            ]
+        }
+
+        _ = builder.get("/metrics") { _ in
+            let body = Data(await Metrics.shared.render().utf8)
+            var headers = HTTPHeaders()
+            headers.add(name: "Content-Type", value: "text/plain; version=0.0.4; charset=utf-8")
+            headers.add(name: "Content-Length", value: "\(body.count)")
+            return .standard(HTTPResponse(status: .ok, headers: headers, body: body))
+        }
+
         // Events endpoint - Stream real-time events
         _ = builder.get("/events") { request in
             let since = request.queryString("since")
@@ -419,20 +471,21 @@ public final class ArcaDaemon: @unchecked Sendable {
                 let filters = try QueryParameterValidator.parseDockerFiltersToArray(request.queryParameters["filters"])
 
                 // Call handler asynchronously
-                let listResponse = await containerHandlers.handleListContainers(
+                let result = await containerHandlers.handleListContainersEncoded(
                     all: all,
                     limit: limit,
                     size: size,
                     filters: filters
                 )
 
-                if let error = listResponse.error {
+                switch result {
+                case .success(let body):
+                    return .standard(HTTPResponse.json(encoded: body))
+                case .failure(let error):
                     return .standard(HTTPResponse.internalServerError(
                         "Failed to list containers: \(error.localizedDescription)"
                     ))
                 }
-
-                return .standard(HTTPResponse.ok(listResponse.containers))
             } catch let error as ValidationError {
                 return .standard(error.toHTTPResponse())
             } catch {
@@ -689,6 +742,17 @@ public final class ArcaDaemon: @unchecked Sendable {
             }
         }
 
+        // Container endpoints - Stats for all running containers (Arca extension)
+        _ = builder.get("/containers/stats") { _ in
+            let result = await containerHandlers.handleGetAllContainerStats()
+            switch result {
+            case .success(let stats):
+                return .standard(HTTPResponse.ok(stats))
+            case .failure(let error):
+                return .standard(HTTPResponse.internalServerError(error.description))
+            }
+        }
+
         // Container endpoints - Stats
         _ = builder.get("/containers/{id}/stats") { request in
             guard let id = request.pathParam("id") else {
@@ -748,11 +812,11 @@ public final class ArcaDaemon: @unchecked Sendable {
                 return .standard(HTTPResponse.badRequest("Missing container ID"))
             }
 
-            let result = await containerHandlers.handleInspectContainer(id: id)
+            let result = await containerHandlers.handleInspectContainerEncoded(id: id)
 
             switch result {
-            case .success(let inspect):
-                return .standard(HTTPResponse.json(inspect))
+            case .success(let body):
+                return .standard(HTTPResponse.json(encoded: body))
             case .failure(let error):
                 // Return 404 for .notFound errors, 500 for everything else
                 let status: HTTPResponseStatus
@@ -969,7 +1033,7 @@ public final class ArcaDaemon: @unchecked Sendable {
 
             let result = await containerHandlers.handleGetArchive(id: id, path: path)
             switch result {
-            case .success(let (tarData, stat)):
+            case .success(let (reader, stat)):
                 // Create JSON for X-Docker-Container-Path-Stat header
                 let statJSON: [String: Any] = [
                     "name": stat.name,
@@ -981,17 +1045,26 @@ public final class ArcaDaemon: @unchecked Sendable {
 
                 guard let jsonData = try? JSONSerialization.data(withJSONObject: statJSON),
                       let base64Stat = String(data: jsonData.base64EncodedData(), encoding: .utf8) else {
+                    await reader.close()
                     return .standard(HTTPResponse.internalServerError("Failed to encode path stat"))
                 }
 
                 var headers = HTTPHeaders()
                 headers.add(name: "Content-Type", value: "application/x-tar")
                 headers.add(name: "X-Docker-Container-Path-Stat", value: base64Stat)
-                return .standard(HTTPResponse(
-                    status: .ok,
-                    headers: headers,
-                    body: tarData
-                ))
+
+                // Relay chunks as the guest produces them instead of buffering the whole tar
+                return .streaming(status: .ok, headers: headers) { writer in
+                    do {
+                        while let chunk = try await reader.next() {
+                            try await writer.write(chunk)
+                        }
+                    } catch {
+                        await reader.close()
+                        throw error
+                    }
+                    await reader.close()
+                }
             case .failure(let error):
                 let status: HTTPResponseStatus
                 if case .notFound = error {
@@ -1013,9 +1086,12 @@ public final class ArcaDaemon: @unchecked Sendable {
             }
 
             // HEAD endpoint returns same stat header as GET but without body
+            // The stat arrives with the first chunk, so the rest of the archive is never transferred
             let result = await containerHandlers.handleGetArchive(id: id, path: path)
             switch result {
-            case .success(let (_, stat)):
+            case .success(let (reader, stat)):
+                await reader.close()
+
                 // Create JSON for X-Docker-Container-Path-Stat header
                 let statJSON: [String: Any] = [
                     "name": stat.name,
@@ -1048,7 +1124,7 @@ public final class ArcaDaemon: @unchecked Sendable {
             }
         }
 
-        _ = builder.put("/containers/{id}/archive") { request in
+        _ = builder.put("/containers/{id}/archive", streamingBody: true) { request in
             guard let id = request.pathParam("id") else {
                 return .standard(HTTPResponse.badRequest("Missing container ID"))
             }
@@ -1057,11 +1133,11 @@ public final class ArcaDaemon: @unchecked Sendable {
                 return .standard(HTTPResponse.badRequest("Missing path parameter"))
             }
 
-            guard let tarData = request.body else {
+            guard let body = request.bodyStream else {
                 return .standard(HTTPResponse.badRequest("Missing request body (tar archive)"))
             }
 
-            let result = await containerHandlers.handlePutArchive(id: id, path: path, tarData: tarData)
+            let result = await containerHandlers.handlePutArchive(id: id, path: path, body: body)
             switch result {
             case .success:
                 return .standard(HTTPResponse(status: .ok, headers: HTTPHeaders(), body: nil))
@@ -1082,10 +1158,49 @@ public final class ArcaDaemon: @unchecked Sendable {
                 return .standard(HTTPResponse.badRequest("Missing container ID"))
             }
 
-            let result = await containerHandlers.handleContainerChanges(id: id)
+            // Arca extension: `path` and `depth` limit the diff to a subtree
+            let query: UpperdirQuery
+            do {
+                let depth = try QueryParameterValidator.parsePositiveInt(request.queryParameters["depth"], paramName: "depth")
+                query = UpperdirQuery(pathPrefix: request.queryParameters["path"] ?? "/", maxDepth: depth)
+            } catch let error as ValidationError {
+                return .standard(error.toHTTPResponse())
+            } catch {
+                return .standard(HTTPResponse.badRequest("Invalid query parameters: \(error.localizedDescription)"))
+            }
+
+            let result = await containerHandlers.handleContainerChanges(id: id, query: query)
             switch result {
-            case .success(let changes):
-                return .standard(HTTPResponse.ok(changes))
+            case .success(let reader):
+                var headers = HTTPHeaders()
+                headers.add(name: "Content-Type", value: "application/json")
+
+                // Write the JSON array a page at a time as the guest walks upperdir
+                return .streaming(status: .ok, headers: headers) { writer in
+                    let encoder = JSONEncoder()
+                    var first = true
+                    do {
+                        try await writer.write(Data("[".utf8))
+                        while let page = try await reader.next() {
+                            var chunk = Data()
+                            for change in page.compactMap(FilesystemChange.init(upperdirEntry:)) {
+                                if !first {
+                                    chunk.append(UInt8(ascii: ","))
+                                }
+                                chunk.append(try encoder.encode(change))
+                                first = false
+                            }
+                            if !chunk.isEmpty {
+                                try await writer.write(chunk)
+                            }
+                        }
+                        try await writer.write(Data("]".utf8))
+                    } catch {
+                        await reader.close()
+                        throw error
+                    }
+                    await reader.close()
+                }
             case .failure(let error):
                 let status: HTTPResponseStatus
                 switch error {
@@ -1233,13 +1348,13 @@ public final class ArcaDaemon: @unchecked Sendable {
         }
 
         // Image load endpoint - Load images from tar archive
-        _ = builder.post("/images/load") { request in
-            // Read tar data from request body
-            guard let tarData = request.body else {
+        _ = builder.post("/images/load", streamingBody: true) { request in
+            // Tar data is streamed from the request body, never buffered whole
+            guard let body = request.bodyStream else {
                 return .standard(HTTPResponse.badRequest("Missing request body (tar archive required)"))
             }
 
-            let result = await imageHandlers.handleLoadImage(tarData: tarData)
+            let result = await imageHandlers.handleLoadImage(body: body)
 
             switch result {
             case .success(let response):
@@ -1262,6 +1377,7 @@ public final class ArcaDaemon: @unchecked Sendable {
         }
 
         // Network endpoints
+        let coreRouteCount = builder.routeCount
         if let networkHandlers = networkHandlers {
             _ = builder.get("/networks") { request in
                 do {
@@ -1442,6 +1558,7 @@ public final class ArcaDaemon: @unchecked Sendable {
         }
 
         // Volume routes (if VolumeManager is available)
+        let networkRouteCount = builder.routeCount - coreRouteCount
         if let volumeHandlers = volumeHandlers {
             // POST /volumes/create - Create volume
             _ = builder.post("/volumes/create") { request in
@@ -1526,12 +1643,91 @@ public final class ArcaDaemon: @unchecked Sendable {
                     return .standard(HTTPResponse.badRequest("Invalid filters parameter"))
                 }
             }
+        }
 
-            logger.info("Registered 28 routes (including 6 network routes, 5 volume routes)")
-        } else if networkHandlers != nil {
-            logger.info("Registered 23 routes (including 6 network routes, volume routes skipped)")
-        } else {
-            logger.info("Registered 17 routes (network and volume routes skipped)")
+        logger.info("Registered API routes", metadata: [
+            "routes": "\(builder.routeCount)",
+            "network_routes": networkHandlers != nil ? "\(networkRouteCount)" : "skipped",
+            "volume_routes": volumeHandlers != nil ? "\(builder.routeCount - coreRouteCount - networkRouteCount)" : "skipped"
+        ])
+    }
+
+    /// Expose counters held by the managers on the metrics endpoint
+    /// Each collector reads its manager's state when /metrics is scraped.
+    private func registerMetricCollectors(
+        containerManager: ContainerBridge.ContainerManager,
+        imageManager: ImageManager,
+        eventManager: EventManager,
+        portMapManager: PortMapManager
+    ) {
+        let metrics = Metrics.shared
+
+        metrics.register { [weak containerManager] in
+            guard let containerManager = containerManager else { return [] }
+            var families: [MetricFamily] = [
+                .gauge("arca_live_vms", help: "Containers with a booted VM", value: Double(await containerManager.liveVMCount))
+            ]
+            let recovery = containerManager.recoveryProgress
+            families += [
+                MetricFamily(name: "arca_recovery_containers", help: "Startup restarts by outcome", kind: .gauge, samples: [
+                    MetricFamily.Sample(labels: [(name: "state", value: "started")], value: Double(recovery.started)),
+                    MetricFamily.Sample(labels: [(name: "state", value: "failed")], value: Double(recovery.failed)),
+                    MetricFamily.Sample(labels: [(name: "state", value: "pending")], value: Double(recovery.pending))
+                ]),
+                .gauge("arca_recovery_complete", help: "1 once every startup restart has been attempted", value: recovery.complete ? 1 : 0)
+            ]
+            return families
+        }
+
+        metrics.register { [weak eventManager] in
+            guard let stats = await eventManager?.stats() else { return [] }
+            return [
+                .gauge("arca_event_subscribers", help: "Connected /events clients", value: Double(stats.subscribers)),
+                .gauge("arca_event_queue_depth", help: "Events queued for the furthest-behind /events client", value: Double(stats.queueDepth)),
+                .gauge("arca_event_history", help: "Events retained for since replays", value: Double(stats.history)),
+                MetricFamily(name: "arca_events_emitted_total", help: "Events emitted", kind: .counter, samples: [
+                    MetricFamily.Sample(value: Double(stats.emitted))
+                ]),
+                MetricFamily(name: "arca_event_subscribers_disconnected_total", help: "/events clients disconnected for falling behind", kind: .counter, samples: [
+                    MetricFamily.Sample(value: Double(stats.disconnectedSubscribers))
+                ])
+            ]
+        }
+
+        metrics.register { [weak imageManager] in
+            guard let activity = await imageManager?.pullActivity() else { return [] }
+            return [
+                .gauge("arca_image_pull_transfers", help: "Registry pulls in flight", value: Double(activity.transfers)),
+                .gauge("arca_image_pull_watchers", help: "Pull requests sharing an in-flight transfer", value: Double(activity.watchers))
+            ]
+        }
+
+        metrics.register { [weak portMapManager] in
+            guard let mappings = await portMapManager?.mappingStats() else { return [] }
+            var bytes: [MetricFamily.Sample] = []
+            var opened: [MetricFamily.Sample] = []
+            var active: [MetricFamily.Sample] = []
+            var failed: [MetricFamily.Sample] = []
+            for mapping in mappings {
+                let labels: [(name: String, value: String)] = [
+                    (name: "container", value: String(mapping.containerID.prefix(12))),
+                    (name: "proto", value: mapping.proto),
+                    (name: "host_ip", value: mapping.hostIP),
+                    (name: "host_port", value: "\(mapping.hostPort)"),
+                    (name: "container_port", value: "\(mapping.containerPort)")
+                ]
+                bytes.append(MetricFamily.Sample(labels: labels + [(name: "direction", value: "to_container")], value: Double(mapping.bytesToContainer)))
+                bytes.append(MetricFamily.Sample(labels: labels + [(name: "direction", value: "from_container")], value: Double(mapping.bytesFromContainer)))
+                opened.append(MetricFamily.Sample(labels: labels, value: Double(mapping.connectionsTotal)))
+                active.append(MetricFamily.Sample(labels: labels, value: Double(mapping.connectionsActive)))
+                failed.append(MetricFamily.Sample(labels: labels, value: Double(mapping.connectionsFailed)))
+            }
+            return [
+                MetricFamily(name: "arca_port_proxy_bytes_total", help: "Bytes relayed by published-port proxies", kind: .counter, samples: bytes),
+                MetricFamily(name: "arca_port_proxy_connections_total", help: "Connections (TCP) or flows (UDP) accepted by published-port proxies", kind: .counter, samples: opened),
+                MetricFamily(name: "arca_port_proxy_connections_active", help: "Open published-port proxy connections", kind: .gauge, samples: active),
+                MetricFamily(name: "arca_port_proxy_connections_failed_total", help: "Published-port connections that could not reach the container", kind: .counter, samples: failed)
+            ]
         }
     }
 
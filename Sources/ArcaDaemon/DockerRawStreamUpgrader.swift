@@ -159,7 +159,7 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
             // Add our raw stream handler with stdin support AT THE FRONT of the pipeline
             // CRITICAL: Must use .first position to ensure our handler receives data before
             // any remaining HTTP decoder/encoder handlers that may still be in the pipeline
-            let rawHandler = DockerRawStreamHandler(logger: self.logger, stdinContinuation: stdinReader.continuation)
+            let rawHandler = DockerRawStreamHandler(logger: self.logger, stdinReader: stdinReader)
             return pipeline.addHandler(rawHandler, position: .first).flatMap { _ in
                 // Fire channelActive manually since adding handler to active channel
                 // doesn't automatically trigger channelActive callback
@@ -235,7 +235,7 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
             let stdinReader = ChannelReader()
 
             // Add our raw stream handler with stdin support AT THE FRONT of the pipeline
-            let rawHandler = DockerRawStreamHandler(logger: self.logger, stdinContinuation: stdinReader.continuation)
+            let rawHandler = DockerRawStreamHandler(logger: self.logger, stdinReader: stdinReader)
             return pipeline.addHandler(rawHandler, position: .first).flatMap { _ in
                 // Fire channelActive manually since adding handler to active channel
                 if channel.isActive {
@@ -307,26 +307,13 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
 
         logger.debug("Container TTY mode", metadata: ["container_id": "\(containerID)", "tty": "\(isTTY)"])
 
-        // Create AsyncStreams for stdout/stderr from the container process
+        // Create writers that frame output straight onto the channel
         // CRITICAL: Do this FIRST to avoid race condition with container start
-        let (stdoutStream, stdoutContinuation) = AsyncStream<Data>.makeStream()
-        let (stderrStream, stderrContinuation) = AsyncStream<Data>.makeStream()
-
-        // Create writers that feed the AsyncStreams
-        // TTY mode: Use RawWriter (no multiplexing headers)
-        // Non-TTY mode: Use StreamingWriter (with multiplexing headers)
-        let stdoutWriter: Writer
-        let stderrWriter: Writer
-
-        if isTTY {
-            // TTY mode: Output is raw, no stream type headers
-            stdoutWriter = RawWriter(continuation: stdoutContinuation)
-            stderrWriter = RawWriter(continuation: stderrContinuation)
-        } else {
-            // Non-TTY mode: Output is multiplexed with stream type headers
-            stdoutWriter = StreamingWriter(continuation: stdoutContinuation, streamType: 1)
-            stderrWriter = StreamingWriter(continuation: stderrContinuation, streamType: 2)
-        }
+        // TTY mode: raw output (no multiplexing headers)
+        // Non-TTY mode: multiplexed with stream type headers
+        let output = RawStreamOutput(channel: channel)
+        let stdoutWriter = output.writer(streamType: isTTY ? nil : 1)
+        let stderrWriter = output.writer(streamType: isTTY ? nil : 2)
 
         // Create a continuation to signal when the container exits
         let exitContinuation = AsyncStream<Void>.makeStream()
@@ -348,70 +335,9 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
         // CRITICAL: Do this before reading historical logs to avoid race with container start
         await containerManager.registerAttach(containerID: containerID, handles: handles, exitSignal: exitContinuation.continuation)
 
-        logger.debug("Attach handles registered, starting forward task", metadata: ["container_id": "\(containerID)"])
-
-        // Start task to forward stream data to the raw TCP channel
-        let forwardTask = Task {
-            await withTaskGroup(of: Void.self) { group in
-                // Forward stdout
-                group.addTask {
-                    var count = 0
-                    for await data in stdoutStream {
-                        count += 1
-                        do {
-                            try await self.writeToChannel(channel: channel, data: data)
-                            self.logger.debug("Wrote stdout chunk", metadata: [
-                                "container_id": "\(containerID)",
-                                "bytes": "\(data.count)",
-                                "chunk": "\(count)"
-                            ])
-                        } catch {
-                            // Client disconnected - stop forwarding to avoid log spam
-                            self.logger.info("Client disconnected, stopping stdout forwarding", metadata: [
-                                "container_id": "\(containerID)",
-                                "chunks_sent": "\(count)"
-                            ])
-                            break
-                        }
-                    }
-                    self.logger.debug("Stdout forwarding finished", metadata: [
-                        "container_id": "\(containerID)",
-                        "chunks": "\(count)"
-                    ])
-                }
+        logger.debug("Attach handles registered", metadata: ["container_id": "\(containerID)"])
 
-                // Forward stderr
-                group.addTask {
-                    var count = 0
-                    for await data in stderrStream {
-                        count += 1
-                        do {
-                            try await self.writeToChannel(channel: channel, data: data)
-                            self.logger.debug("Wrote stderr chunk", metadata: [
-                                "container_id": "\(containerID)",
-                                "bytes": "\(data.count)",
-                                "chunk": "\(count)"
-                            ])
-                        } catch {
-                            // Client disconnected - stop forwarding
-                            self.logger.info("Client disconnected, stopping stderr forwarding", metadata: [
-                                "container_id": "\(containerID)",
-                                "chunks_sent": "\(count)"
-                            ])
-                            break
-                        }
-                    }
-                    self.logger.debug("Stderr forwarding finished", metadata: [
-                        "container_id": "\(containerID)",
-                        "chunks": "\(count)"
-                    ])
-                }
-
-                await group.waitForAll()
-            }
-        }
-
-        // Now that attach handles are registered and forward task is running,
+        // Now that attach handles are registered,
         // send historical logs if requested (this can be slow, but won't block container start)
         if logs {
             logger.debug("Reading historical logs for attach", metadata: ["container_id": "\(containerID)"])
@@ -419,19 +345,18 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
             // Get log paths for this container
             if let logPaths = logManager.getLogPaths(dockerID: containerID) {
                 do {
-                    // Read and format historical logs
-                    let historicalLogs = try retrieveHistoricalLogs(
+                    // Replay historical logs onto the channel in bounded batches
+                    let bytes = try await sendHistoricalLogs(
+                        output: output,
                         logPaths: logPaths,
                         stdout: stdout,
                         stderr: stderr
                     )
 
-                    // Send historical logs to channel
-                    if !historicalLogs.isEmpty {
-                        try await writeToChannel(channel: channel, data: historicalLogs)
+                    if bytes > 0 {
                         logger.debug("Sent historical logs", metadata: [
                             "container_id": "\(containerID)",
-                            "bytes": "\(historicalLogs.count)"
+                            "bytes": "\(bytes)"
                         ])
                     } else {
                         logger.debug("No historical logs to send", metadata: ["container_id": "\(containerID)"])
@@ -451,12 +376,13 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
         // Wait for container to exit (the start logic will call the waitForExit closure)
         try await handles.waitForExit()
 
-        logger.debug("Container exited, waiting for forward task", metadata: ["container_id": "\(containerID)"])
+        logger.debug("Container exited, waiting for output", metadata: ["container_id": "\(containerID)"])
 
-        // Wait for all data to be forwarded
-        await forwardTask.value
+        // Wait for the writers to be closed, then for their output to reach the client
+        await output.waitForWriters()
+        await output.drain()
 
-        logger.debug("Forward task completed", metadata: ["container_id": "\(containerID)"])
+        logger.debug("Output delivered", metadata: ["container_id": "\(containerID)"])
 
         // Close the channel (non-fatal if already closed)
         do {
@@ -515,91 +441,12 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
 
         let isTTY = execInfo.config.tty
 
-        // Create AsyncStreams for stdout/stderr from the exec process
-        let (stdoutStream, stdoutContinuation) = AsyncStream<Data>.makeStream()
-        let (stderrStream, stderrContinuation) = AsyncStream<Data>.makeStream()
-
-        // Create writers that feed the AsyncStreams
-        // TTY mode: Use RawWriter (no multiplexing headers)
-        // Non-TTY mode: Use StreamingWriter (with multiplexing headers)
-        let stdoutWriter: Writer
-        let stderrWriter: Writer
-
-        if isTTY {
-            // TTY mode: Output is raw, no stream type headers
-            stdoutWriter = RawWriter(continuation: stdoutContinuation)
-            stderrWriter = RawWriter(continuation: stderrContinuation)
-            logger.debug("Using raw writers for TTY mode", metadata: ["exec_id": "\(execID)"])
-        } else {
-            // Non-TTY mode: Output is multiplexed with stream type headers
-            stdoutWriter = StreamingWriter(continuation: stdoutContinuation, streamType: 1)
-            stderrWriter = StreamingWriter(continuation: stderrContinuation, streamType: 2)
-            logger.debug("Using streaming writers for non-TTY mode", metadata: ["exec_id": "\(execID)"])
-        }
-
-        // Start task to forward stream data to the raw TCP channel
-        let forwardTask = Task {
-            await withTaskGroup(of: Void.self) { group in
-                // Forward stdout
-                group.addTask {
-                    var count = 0
-                    for await data in stdoutStream {
-                        count += 1
-                        do {
-                            try await self.writeToChannel(channel: channel, data: data)
-                            self.logger.debug("Wrote stdout chunk", metadata: [
-                                "exec_id": "\(execID)",
-                                "bytes": "\(data.count)",
-                                "chunk": "\(count)"
-                            ])
-                        } catch {
-                            // Client disconnected (Ctrl+C, connection loss, etc.)
-                            // Stop forwarding output to avoid log spam
-                            // Note: The exec process continues running (Docker behavior)
-                            // For non-TTY exec, Ctrl+C just closes the client, doesn't signal the process
-                            self.logger.info("Client disconnected, stopping stdout forwarding", metadata: [
-                                "exec_id": "\(execID)",
-                                "chunks_sent": "\(count)"
-                            ])
-                            break
-                        }
-                    }
-                    self.logger.debug("Stdout forwarding finished", metadata: [
-                        "exec_id": "\(execID)",
-                        "chunks": "\(count)"
-                    ])
-                }
-
-                // Forward stderr
-                group.addTask {
-                    var count = 0
-                    for await data in stderrStream {
-                        count += 1
-                        do {
-                            try await self.writeToChannel(channel: channel, data: data)
-                            self.logger.debug("Wrote stderr chunk", metadata: [
-                                "exec_id": "\(execID)",
-                                "bytes": "\(data.count)",
-                                "chunk": "\(count)"
-                            ])
-                        } catch {
-                            // Client disconnected - stop forwarding
-                            self.logger.info("Client disconnected, stopping stderr forwarding", metadata: [
-                                "exec_id": "\(execID)",
-                                "chunks_sent": "\(count)"
-                            ])
-                            break
-                        }
-                    }
-                    self.logger.debug("Stderr forwarding finished", metadata: [
-                        "exec_id": "\(execID)",
-                        "chunks": "\(count)"
-                    ])
-                }
-
-                await group.waitForAll()
-            }
-        }
+        // Create writers that frame output straight onto the channel
+        // TTY mode: raw output (no multiplexing headers)
+        // Non-TTY mode: multiplexed with stream type headers
+        let output = RawStreamOutput(channel: channel)
+        let stdoutWriter = output.writer(streamType: isTTY ? nil : 1)
+        let stderrWriter = output.writer(streamType: isTTY ? nil : 2)
 
         do {
             // Start the exec process with stdin support
@@ -615,10 +462,12 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
 
             logger.info("Exec process completed", metadata: ["exec_id": "\(execID)"])
 
-            // Wait for all data to be forwarded
-            await forwardTask.value
+            // ExecManager closes the writers once the process exits; wait for the
+            // output queued before that to reach the client
+            await output.waitForWriters()
+            await output.drain()
 
-            logger.debug("Forward task completed", metadata: ["exec_id": "\(execID)"])
+            logger.debug("Output delivered", metadata: ["exec_id": "\(execID)"])
 
             // Close the channel (non-fatal if already closed)
             do {
@@ -637,7 +486,6 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
                 "error": "\(error)"
             ])
 
-            forwardTask.cancel()
             try? await closeChannel(channel)
 
             // Re-throw the error - it will be caught by the upgrade task
@@ -645,25 +493,6 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
         }
     }
 
-    /// Write data to raw TCP channel
-    private func writeToChannel(channel: Channel, data: Data) async throws {
-        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
-            channel.eventLoop.execute {
-                var buffer = channel.allocator.buffer(capacity: data.count)
-                buffer.writeBytes(data)
-
-                channel.writeAndFlush(buffer).whenComplete { result in
-                    switch result {
-                    case .success:
-                        continuation.resume()
-                    case .failure(let error):
-                        continuation.resume(throwing: error)
-                    }
-                }
-            }
-        }
-    }
-
     /// Close the channel
     private func closeChannel(_ channel: Channel) async throws {
         try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
@@ -705,107 +534,31 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
         return params
     }
 
-    /// Retrieve and format historical logs from log files
-    /// Returns Docker multiplexed stream format data
-    private func retrieveHistoricalLogs(
+    /// Replay historical logs from the log files as Docker multiplexed frames
+    /// Frames are queued a batch at a time, waiting for the client whenever the channel
+    /// is backed up, so a large log streams at the client's pace instead of being built
+    /// in memory first
+    /// - Returns: Number of bytes written
+    private func sendHistoricalLogs(
+        output: RawStreamOutput,
         logPaths: ContainerBridge.ContainerLogManager.LogPaths,
         stdout: Bool,
         stderr: Bool
-    ) throws -> Data {
-        var allLogs: [LogEntry] = []
-
-        // Helper to parse log files
-        func parseLogs(from path: URL, forStream stream: String) throws {
-            guard FileManager.default.fileExists(atPath: path.path) else {
-                return
+    ) async throws -> Int {
+        var streams = Set<LogStream>()
+        if stdout { streams.insert(.stdout) }
+        if stderr { streams.insert(.stderr) }
+
+        let replay = try LogReplay(logPaths: logPaths, streams: streams)
+        var bytes = 0
+        while let frames = try replay.nextFrames(timestamps: false) {
+            if output.backlog > RawStreamOutput.lowWaterMark {
+                await output.drain()
             }
-
-            let content = try String(contentsOf: path, encoding: .utf8)
-            let lines = content.components(separatedBy: .newlines)
-
-            for line in lines {
-                guard !line.isEmpty else { continue }
-
-                // Parse JSON log entry
-                guard let data = line.data(using: .utf8),
-                      let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any],
-                      let logStream = json["stream"] as? String,
-                      let logMessage = json["log"] as? String,
-                      let timeString = json["time"] as? String else {
-                    continue
-                }
-
-                // Parse timestamp
-                let formatter = ISO8601DateFormatter()
-                guard let timestamp = formatter.date(from: timeString) else {
-                    continue
-                }
-
-                allLogs.append(LogEntry(
-                    stream: logStream,
-                    message: logMessage,
-                    timestamp: timestamp
-                ))
-            }
-        }
-
-        // Read from stdout log file if requested
-        if stdout {
-            try parseLogs(from: logPaths.stdoutPath, forStream: "stdout")
-        }
-
-        // Read from stderr log file if requested
-        if stderr {
-            try parseLogs(from: logPaths.stderrPath, forStream: "stderr")
+            output.send(frames)
+            bytes += frames.count
         }
-
-        // Sort by timestamp (logs from different streams need to be interleaved chronologically)
-        allLogs.sort { $0.timestamp < $1.timestamp }
-
-        // Format as Docker multiplexed stream
-        return formatMultiplexedStream(logs: allLogs)
-    }
-
-    /// Format log entries as Docker multiplexed stream
-    /// Docker format: [stream_type (1 byte)][padding (3 bytes)][size (4 bytes big-endian)][payload]
-    /// Stream types: 0=stdin, 1=stdout, 2=stderr
-    private func formatMultiplexedStream(logs: [LogEntry]) -> Data {
-        var result = Data()
-
-        for entry in logs {
-            // Determine stream type
-            let streamType: UInt8 = entry.stream == "stdout" ? 1 : 2
-
-            // Convert message to data
-            guard let messageData = entry.message.data(using: .utf8) else {
-                continue
-            }
-
-            // Build frame header: [stream_type][padding][size]
-            var header = Data()
-            header.append(streamType)                    // 1 byte: stream type
-            header.append(contentsOf: [0, 0, 0])        // 3 bytes: padding
-
-            // 4 bytes: size (big-endian UInt32)
-            let size = UInt32(messageData.count)
-            header.append(UInt8((size >> 24) & 0xFF))
-            header.append(UInt8((size >> 16) & 0xFF))
-            header.append(UInt8((size >> 8) & 0xFF))
-            header.append(UInt8(size & 0xFF))
-
-            // Append header + payload
-            result.append(header)
-            result.append(messageData)
-        }
-
-        return result
-    }
-
-    /// Log entry structure
-    private struct LogEntry {
-        let stream: String
-        let message: String
-        let timestamp: Date
+        return bytes
     }
 
     enum UpgradeError: Error {
@@ -814,18 +567,30 @@ final class DockerRawStreamUpgrader: HTTPServerProtocolUpgrader, Sendable {
 }
 
 /// Handler for Docker raw stream protocol (after HTTP upgrade)
-/// Keeps the channel pipeline alive after HTTP upgrade
-/// All I/O is handled directly via channel.writeAndFlush in the upgrader
+/// Keeps the channel pipeline alive after HTTP upgrade and feeds client input to stdin
+/// Whole reads are handed to the stdin reader; when the process falls behind, reading
+/// stops until it catches up, so the client's TCP window pushes back on the sender
+/// Output is handled by RawStreamOutput in the upgrader
 final class DockerRawStreamHandler: ChannelInboundHandler, RemovableChannelHandler, Sendable {
     typealias InboundIn = ByteBuffer
     typealias OutboundOut = ByteBuffer
 
     private let logger: Logger
-    private let stdinContinuation: AsyncStream<UInt8>.Continuation?
+    private let stdinReader: ChannelReader?
 
-    init(logger: Logger, stdinContinuation: AsyncStream<UInt8>.Continuation? = nil) {
+    init(logger: Logger, stdinReader: ChannelReader? = nil) {
         self.logger = logger
-        self.stdinContinuation = stdinContinuation
+        self.stdinReader = stdinReader
+    }
+
+    func handlerAdded(context: ChannelHandlerContext) {
+        let channel = context.channel
+        let logger = self.logger
+        stdinReader?.setResumeHandler {
+            channel.setOption(ChannelOptions.autoRead, value: true).whenFailure { error in
+                logger.debug("Failed to resume reading stdin", metadata: ["error": "\(error)"])
+            }
+        }
     }
 
     func channelActive(context: ChannelHandlerContext) {
@@ -839,14 +604,12 @@ final class DockerRawStreamHandler: ChannelInboundHandler, RemovableChannelHandl
     }
 
     func channelRead(context: ChannelHandlerContext, data: NIOAny) {
-        var buffer = unwrapInboundIn(data)
-        logger.debug("Received raw stream data", metadata: ["bytes": "\(buffer.readableBytes)"])
-
-        // Forward stdin data to the exec process
-        if let stdinCont = stdinContinuation {
-            let bytes = buffer.readBytes(length: buffer.readableBytes) ?? []
-            for byte in bytes {
-                stdinCont.yield(byte)
+        let buffer = unwrapInboundIn(data)
+
+        // Forward stdin data to the process, pausing reads while its buffer is full
+        if let stdinReader = stdinReader, !stdinReader.push(buffer.readableBytesView) {
+            context.channel.setOption(ChannelOptions.autoRead, value: false).whenFailure { error in
+                self.logger.debug("Failed to pause reading stdin", metadata: ["error": "\(error)"])
             }
         }
     }
@@ -859,7 +622,7 @@ final class DockerRawStreamHandler: ChannelInboundHandler, RemovableChannelHandl
     func userInboundEventTriggered(context: ChannelHandlerContext, event: Any) {
         // Handle half-closure: client closed write side (sent EOF on stdin) but keeps read side open
         if event is ChannelEvent, (event as! ChannelEvent) == ChannelEvent.inputClosed {
-            stdinContinuation?.finish()
+            stdinReader?.finish()
         }
         context.fireUserInboundEventTriggered(event)
     }
@@ -867,7 +630,7 @@ final class DockerRawStreamHandler: ChannelInboundHandler, RemovableChannelHandl
     func errorCaught(context: ChannelHandlerContext, error: Error) {
         logger.error("Error in Docker raw stream handler", metadata: ["error": "\(error)"])
         // Close stdin stream if active
-        stdinContinuation?.finish()
+        stdinReader?.finish()
 
         // Only close if channel is still active to avoid "Bad file descriptor" errors
         // when the channel is already closing/closed
@@ -878,7 +641,7 @@ final class DockerRawStreamHandler: ChannelInboundHandler, RemovableChannelHandl
 
     func channelInactive(context: ChannelHandlerContext) {
         // Close stdin stream when channel closes
-        stdinContinuation?.finish()
+        stdinReader?.finish()
     }
 }
 
@@ -82,6 +82,8 @@ final class HTTPHandler: ChannelInboundHandler, RemovableChannelHandler, @unchec
     private var requestURI: String?
     private var requestHeaders: HTTPHeaders?
     private var bodyBuffer: ByteBuffer?
+    /// Feeds the body of a streaming-body route; non-nil from head until end of request
+    private var bodySource: HTTPRequestBody.Source?
     private var channelActive: Bool = true
 
     init(router: Router, logger: Logger) {
@@ -91,6 +93,13 @@ final class HTTPHandler: ChannelInboundHandler, RemovableChannelHandler, @unchec
 
     func channelInactive(context: ChannelHandlerContext) {
         channelActive = false
+
+        // Fail any in-flight streaming body so the handler doesn't treat a truncated upload as complete
+        if let source = bodySource {
+            source.finish(HTTPRequestBodyError.connectionClosed)
+            bodySource = nil
+        }
+
         context.fireChannelInactive()
     }
 
@@ -105,17 +114,36 @@ final class HTTPHandler: ChannelInboundHandler, RemovableChannelHandler, @unchec
             requestHeaders = head.headers
             bodyBuffer = nil
 
+            // Streaming-body routes are dispatched as soon as the head arrives
+            if router.expectsStreamingBody(method: head.method, uri: head.uri) {
+                handleStreamingRequest(context: context, head: head)
+            }
+
         case .body(var buffer):
-            // Accumulate request body
-            if bodyBuffer == nil {
+            if let source = bodySource {
+                // Hand the chunk to the handler; pause socket reads if it falls behind
+                switch source.yield(buffer) {
+                case .stopProducing:
+                    _ = context.channel.setOption(ChannelOptions.autoRead, value: false)
+                case .produceMore, .dropped:
+                    break
+                }
+            } else if bodyBuffer == nil {
+                // Accumulate request body
                 bodyBuffer = buffer
             } else {
                 bodyBuffer?.writeBuffer(&buffer)
             }
 
         case .end:
-            // Request complete, process it
-            handleRequest(context: context)
+            if let source = bodySource {
+                // Streaming request already dispatched - just complete its body
+                source.finish()
+                bodySource = nil
+            } else {
+                // Request complete, process it
+                handleRequest(context: context)
+            }
         }
     }
 
@@ -135,6 +163,36 @@ final class HTTPHandler: ChannelInboundHandler, RemovableChannelHandler, @unchec
 
         // Create request object
         let request = HTTPRequest(method: method, uri: uri, headers: headers, body: bodyData)
+        dispatch(context: context, request: request)
+    }
+
+    /// Dispatch a request whose route consumes the body incrementally
+    /// Body chunks are yielded into `bodySource` as they arrive; the channel's autoRead
+    /// is toggled from the sequence's backpressure callbacks so the socket is only read
+    /// as fast as the handler consumes.
+    private func handleStreamingRequest(context: ChannelHandlerContext, head: HTTPRequestHead) {
+        let channel = context.channel
+        let expectedLength = head.headers.first(name: "Content-Length").flatMap { Int($0) }
+
+        let (body, source) = HTTPRequestBody.makeStream(
+            expectedLength: expectedLength,
+            onProduceMore: {
+                _ = channel.setOption(ChannelOptions.autoRead, value: true)
+            },
+            onTerminate: {
+                // Consumer finished or abandoned the body - keep draining the connection
+                _ = channel.setOption(ChannelOptions.autoRead, value: true)
+            }
+        )
+        bodySource = source
+
+        let request = HTTPRequest(method: head.method, uri: head.uri, headers: head.headers, body: nil, bodyStream: body)
+        dispatch(context: context, request: request)
+    }
+
+    private func dispatch(context: ChannelHandlerContext, request: HTTPRequest) {
+        let method = request.method
+        let uri = request.uri
 
         // Log the request
         logger.info("Incoming request", metadata: [
@@ -9,6 +9,8 @@ public struct HTTPRequest: Sendable {
     public let uri: String
     public let headers: HTTPHeaders
     public let body: Data?
+    /// Streaming body for routes registered with `streamingBody: true` (`body` is nil for those)
+    public let bodyStream: HTTPRequestBody?
     public var pathParameters: [String: String]
 
     /// Extract the path without query parameters
@@ -31,11 +33,12 @@ public struct HTTPRequest: Sendable {
         return params
     }
 
-    public init(method: HTTPMethod, uri: String, headers: HTTPHeaders, body: Data?, pathParameters: [String: String] = [:]) {
+    public init(method: HTTPMethod, uri: String, headers: HTTPHeaders, body: Data?, bodyStream: HTTPRequestBody? = nil, pathParameters: [String: String] = [:]) {
         self.method = method
         self.uri = uri
         self.headers = headers
         self.body = body
+        self.bodyStream = bodyStream
         self.pathParameters = pathParameters
     }
 }
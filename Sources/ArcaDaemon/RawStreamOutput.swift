@@ -0,0 +1,185 @@
+import Foundation
+import NIO
+import Containerization  // For Writer protocol
+
+/// Output side of an upgraded exec/attach connection
+///
+/// Each chunk of container output is copied once, straight into a ByteBuffer with its 8-byte
+/// multiplex header written in place ahead of the payload. Buffers are queued on the channel
+/// without flushing and flushed once per event-loop tick, so a burst of small chunks leaves
+/// in a few large socket writes instead of one syscall and one await each.
+///
+/// Writers block while more than `highWaterMark` bytes are queued on the channel. That
+/// pushes back through the process's output pipe (or the attach subscriber's buffer) rather
+/// than holding a slow client's backlog in the daemon.
+/// @unchecked Sendable: Safe because the byte accounting is protected by the NSCondition and
+/// `flushScheduled` is only touched on the channel's event loop
+final class RawStreamOutput: @unchecked Sendable {
+    /// Queued bytes above which writers wait for the client
+    static let highWaterMark = 4 << 20
+    /// Queued bytes below which waiting writers continue
+    static let lowWaterMark = 1 << 20
+
+    private let channel: Channel
+    private let condition = NSCondition()
+    private var queuedBytes = 0
+    private var failed = false  // Client went away; further output is discarded
+    private var openWriters = 0
+    private var closeWaiters: [CheckedContinuation<Void, Never>] = []
+    private var flushScheduled = false
+
+    init(channel: Channel) {
+        self.channel = channel
+        channel.closeFuture.whenComplete { [weak self] _ in
+            self?.markFailed()
+        }
+    }
+
+    /// A Writer for one output stream
+    /// - Parameter streamType: Multiplex stream type (1=stdout, 2=stderr), or nil for raw TTY output
+    func writer(streamType: UInt8?) -> Writer {
+        condition.lock()
+        openWriters += 1
+        condition.unlock()
+        return StreamWriter(output: self, streamType: streamType)
+    }
+
+    /// Bytes queued on the channel and not yet written to the socket
+    var backlog: Int {
+        condition.lock()
+        defer { condition.unlock() }
+        return queuedBytes
+    }
+
+    /// Queue output for the client, framed with a multiplex header when `streamType` is set
+    /// Blocks while the channel is backed up; output after the client disconnects is dropped
+    func send(_ data: Data, streamType: UInt8? = nil) {
+        guard !data.isEmpty else { return }
+        let size = data.count + (streamType == nil ? 0 : 8)
+        guard reserve(size) else { return }
+
+        var buffer = channel.allocator.buffer(capacity: size)
+        if let streamType = streamType {
+            // Byte 0: stream type, bytes 1-3: padding, bytes 4-7: payload size (big-endian)
+            buffer.writeInteger(streamType)
+            buffer.writeRepeatingByte(0, count: 3)
+            buffer.writeInteger(UInt32(data.count))
+        }
+        buffer.writeBytes(data)
+
+        let channel = self.channel
+        channel.eventLoop.execute {
+            channel.write(buffer).whenComplete { result in
+                if case .failure = result {
+                    self.markFailed()
+                }
+                self.release(size)
+            }
+            if !self.flushScheduled {
+                self.flushScheduled = true
+                channel.eventLoop.execute {
+                    self.flushScheduled = false
+                    channel.flush()
+                }
+            }
+        }
+    }
+
+    /// Wait until every writer handed out has been closed
+    func waitForWriters() async {
+        await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+            condition.lock()
+            if openWriters == 0 {
+                condition.unlock()
+                continuation.resume()
+                return
+            }
+            closeWaiters.append(continuation)
+            condition.unlock()
+        }
+    }
+
+    /// Wait until everything queued so far has been written to the socket
+    func drain() async {
+        let channel = self.channel
+        let empty = channel.allocator.buffer(capacity: 0)
+        try? await channel.eventLoop.flatSubmit {
+            channel.writeAndFlush(empty)
+        }.get()
+    }
+
+    // MARK: - Private
+
+    private func reserve(_ bytes: Int) -> Bool {
+        condition.lock()
+        defer { condition.unlock() }
+        while queuedBytes > Self.highWaterMark && !failed {
+            condition.wait()
+        }
+        if failed {
+            return false
+        }
+        queuedBytes += bytes
+        return true
+    }
+
+    private func release(_ bytes: Int) {
+        condition.lock()
+        queuedBytes -= bytes
+        if queuedBytes <= Self.lowWaterMark {
+            condition.broadcast()
+        }
+        condition.unlock()
+    }
+
+    private func markFailed() {
+        condition.lock()
+        failed = true
+        condition.broadcast()
+        condition.unlock()
+    }
+
+    fileprivate func writerClosed() {
+        condition.lock()
+        openWriters -= 1
+        var waiters: [CheckedContinuation<Void, Never>] = []
+        if openWriters == 0 {
+            waiters = closeWaiters
+            closeWaiters.removeAll()
+        }
+        condition.unlock()
+
+        for waiter in waiters {
+            waiter.resume()
+        }
+    }
+}
+
+/// One output stream of a RawStreamOutput
+/// @unchecked Sendable: Safe because the closed flag is protected by NSLock
+private final class StreamWriter: Writer, @unchecked Sendable {
+    private let output: RawStreamOutput
+    private let streamType: UInt8?
+    private let lock = NSLock()
+    private var closed = false
+
+    init(output: RawStreamOutput, streamType: UInt8?) {
+        self.output = output
+        self.streamType = streamType
+    }
+
+    func write(_ data: Data) throws {
+        output.send(data, streamType: streamType)
+    }
+
+    func close() throws {
+        lock.lock()
+        let wasClosed = closed
+        closed = true
+        lock.unlock()
+
+        if !wasClosed {
+            output.writerClosed()
+        }
+    }
+}
@@ -2,22 +2,56 @@ import Foundation
 import Logging
 import NIOHTTP1
 import DockerAPI
+import ContainerBridge
 
 /// Type alias for route handler functions
 public typealias RouteHandler = @Sendable (HTTPRequest) async -> HTTPResponseType
 
 /// A route pattern matcher and request dispatcher
 /// Routes are registered during initialization and become immutable after setup
+///
+/// `RouterBuilder.build()` compiles the patterns into one segment trie per method, so a
+/// request is matched, its parameters extracted and its API version prefix skipped in a
+/// single walk over the path instead of a scan of every registered pattern.
+///
+/// Each request runs in a tracing span and its latency is recorded per route pattern (not
+/// per path, so IDs in the path don't multiply the series).
 public final class Router: Sendable {
     private let logger: Logger
-    private let routes: [(method: HTTPMethod, pattern: RoutePattern, handler: RouteHandler)]
+    private let tries: [String: RouteNode]  // HTTP method -> compiled routes
     private let middlewares: [Middleware]
 
+    /// A registered route
+    struct Route: Sendable {
+        let method: HTTPMethod
+        let pattern: RoutePattern
+        let streamingBody: Bool
+        let handler: RouteHandler
+    }
+
+    /// A route matched against a request path
+    struct Match {
+        let route: Route
+        let parameters: [String: String]
+    }
+
     /// Initialize router with routes and middlewares registered via builder
-    fileprivate init(logger: Logger, routes: [(method: HTTPMethod, pattern: RoutePattern, handler: RouteHandler)], middlewares: [Middleware]) {
+    fileprivate init(logger: Logger, routes: [Route], middlewares: [Middleware]) {
         self.logger = logger
-        self.routes = routes
         self.middlewares = middlewares
+
+        var tries: [String: RouteNode] = [:]
+        for route in routes {
+            let root = tries[route.method.rawValue] ?? RouteNode()
+            if !root.insert(route, segments: route.pattern.segments[...]) {
+                logger.warning("Duplicate route ignored", metadata: [
+                    "method": "\(route.method.rawValue)",
+                    "pattern": "\(route.pattern.pattern)"
+                ])
+            }
+            tries[route.method.rawValue] = root
+        }
+        self.tries = tries
     }
 
     /// Create a router builder for registering routes
@@ -25,10 +59,22 @@ public final class Router: Sendable {
         return RouterBuilder(logger: logger)
     }
 
+    /// Check whether the route for a request consumes its body as a stream
+    /// Called by the HTTP handler when the request head arrives, before any body is read,
+    /// so streaming routes can be dispatched immediately instead of after buffering
+    public func expectsStreamingBody(method: HTTPMethod, uri: String) -> Bool {
+        return match(method: method, path: Self.path(of: uri))?.route.streamingBody ?? false
+    }
+
     /// Route an incoming request to the appropriate handler
     public func route(request: HTTPRequest) async -> HTTPResponseType {
         // Execute middleware chain before routing
-        return await executeMiddlewareChain(request: request, middlewareIndex: 0)
+        return await Tracing.withSpan(
+            "\(request.method.rawValue) \(Self.path(of: request.uri))",
+            traceparent: request.headers.first(name: "traceparent")
+        ) {
+            await executeMiddlewareChain(request: request, middlewareIndex: 0)
+        }
     }
 
     /// Execute middleware chain recursively
@@ -48,67 +94,219 @@ public final class Router: Sendable {
 
     /// Handle route matching and dispatch to handler
     private func handleRoute(request: HTTPRequest) async -> HTTPResponseType {
-        let path = request.path
+        let start = ContinuousClock.now
+        let path = Self.path(of: request.uri)
 
         logger.debug("Routing request", metadata: [
             "method": "\(request.method.rawValue)",
             "path": "\(path)"
         ])
 
-        // Find matching route
-        for route in routes {
-            if route.method == request.method && route.pattern.matches(path) {
-                logger.debug("Route matched", metadata: [
-                    "pattern": "\(route.pattern.pattern)"
-                ])
-
-                // Extract path parameters and add to request
-                let pathParams = route.pattern.extractParameters(from: path)
-                var requestWithParams = request
-                requestWithParams.pathParameters = pathParams
+        if let match = match(method: request.method, path: path) {
+            logger.debug("Route matched", metadata: [
+                "pattern": "\(match.route.pattern.pattern)"
+            ])
 
-                if !pathParams.isEmpty {
-                    logger.debug("Extracted path parameters", metadata: [
-                        "parameters": "\(pathParams)"
-                    ])
-                }
+            var requestWithParams = request
+            requestWithParams.pathParameters = match.parameters
 
-                return await route.handler(requestWithParams)
+            if !match.parameters.isEmpty {
+                logger.debug("Extracted path parameters", metadata: [
+                    "parameters": "\(match.parameters)"
+                ])
             }
+
+            let response = await match.route.handler(requestWithParams)
+            record(response, method: request.method, route: match.route.pattern.pattern, since: start)
+            return response
         }
 
         // Check if path matches any pattern but with wrong method
-        for route in routes {
-            if route.pattern.matches(path) {
+        for (method, root) in tries where method != request.method.rawValue {
+            if let match = Self.walk(root, path: path) {
                 logger.warning("Path matched but wrong method", metadata: [
-                    "expected": "\(route.method.rawValue)",
+                    "expected": "\(match.route.method.rawValue)",
                     "received": "\(request.method.rawValue)"
                 ])
-                return .standard(HTTPResponse.error(
-                    "Method \(request.method.rawValue) not allowed for \(request.path)",
+                let response = HTTPResponseType.standard(HTTPResponse.error(
+                    "Method \(request.method.rawValue) not allowed for \(path)",
                     status: .methodNotAllowed
                 ))
+                record(response, method: request.method, route: Self.unmatchedRoute, since: start)
+                return response
             }
         }
 
         // No matching route found
         logger.warning("No route found", metadata: [
-            "path": "\(request.path)"
+            "path": "\(path)"
         ])
-        return .standard(HTTPResponse.error("Not found: \(request.path)", status: .notFound))
+        let response = HTTPResponseType.standard(HTTPResponse.error("Not found: \(path)", status: .notFound))
+        record(response, method: request.method, route: Self.unmatchedRoute, since: start)
+        return response
+    }
+
+    /// Route label for requests that matched no pattern
+    private static let unmatchedRoute = "unmatched"
+
+    private func record(_ response: HTTPResponseType, method: HTTPMethod, route: String, since start: ContinuousClock.Instant) {
+        let status: UInt
+        switch response {
+        case .standard(let standard):
+            status = standard.status.code
+        case .streaming(let head, _, _):
+            status = head.code
+        }
+        Metrics.shared.httpRequestDuration.observe(since: start, labels: [method.rawValue, route, "\(status)"])
+    }
+
+    /// Find the route for a request path (with or without an API version prefix)
+    func match(method: HTTPMethod, path: String) -> Match? {
+        guard let root = tries[method.rawValue] else { return nil }
+        return Self.walk(root, path: path)
+    }
+
+    private static func walk(_ root: RouteNode, path: String) -> Match? {
+        let routed = APIVersionNormalizer.strippingVersionPrefix(path[...])
+        guard routed.first == "/" else { return nil }
+
+        var captures: [Substring] = []
+        guard let route = root.match(routed.dropFirst(), captures: &captures) else {
+            return nil
+        }
+
+        // Parameter values are only copied out of the path once the walk has succeeded
+        var parameters: [String: String] = [:]
+        if !captures.isEmpty {
+            parameters.reserveCapacity(captures.count)
+            for (name, value) in zip(route.pattern.parameterNames, captures) {
+                parameters[name] = String(value)
+            }
+        }
+        return Match(route: route, parameters: parameters)
+    }
+
+    /// Request path without the query string
+    /// Percent-encoded paths are decoded the way `HTTPRequest.path` does; plain paths are
+    /// sliced directly to avoid a URLComponents parse on every request
+    static func path(of uri: String) -> String {
+        let utf8 = uri.utf8
+        let end = utf8.firstIndex(where: { $0 == UInt8(ascii: "?") || $0 == UInt8(ascii: "#") }) ?? utf8.endIndex
+        let raw = uri[..<end]
+        if raw.utf8.contains(UInt8(ascii: "%")) {
+            return URLComponents(string: uri)?.path ?? uri
+        }
+        return String(raw)
+    }
+}
+
+/// One node of a method's route trie
+///
+/// Children are tried most specific first: literal segments, then a `{param}` segment, then
+/// a greedy `{param:.*}` that may span several segments. A failed branch backtracks, so a
+/// path matches whenever some registered pattern accepts it, as with the old regex scan.
+///
+/// @unchecked Sendable: Safe because nodes are only mutated by Router.init while the trie is
+/// being compiled and are read-only once the Router is published.
+final class RouteNode: @unchecked Sendable {
+    // A handful of literals per node, so a linear scan beats hashing a Substring
+    private var literals: [(segment: String, node: RouteNode)] = []
+    private var parameter: RouteNode?
+    private var greedy: RouteNode?
+    private var route: Router.Route?
+
+    /// Add a route below this node
+    /// - Returns: false if a route with the same shape was already registered (first one wins)
+    func insert(_ route: Router.Route, segments: ArraySlice<RoutePattern.Segment>) -> Bool {
+        guard let segment = segments.first else {
+            guard self.route == nil else { return false }
+            self.route = route
+            return true
+        }
+
+        let child: RouteNode
+        switch segment {
+        case .literal(let text):
+            if let existing = literals.first(where: { $0.segment == text })?.node {
+                child = existing
+            } else {
+                child = RouteNode()
+                literals.append((segment: text, node: child))
+            }
+        case .parameter:
+            child = parameter ?? RouteNode()
+            parameter = child
+        case .greedy:
+            child = greedy ?? RouteNode()
+            greedy = child
+        }
+        return child.insert(route, segments: segments.dropFirst())
+    }
+
+    /// Match the remainder of a path (after the "/" that led to this node)
+    /// - Parameter captures: Parameter values in pattern order; restored on backtrack
+    func match(_ path: Substring, captures: inout [Substring]) -> Router.Route? {
+        let slash = path.firstIndex(of: "/")
+        let segment = path[..<(slash ?? path.endIndex)]
+        let rest = slash.map { path[path.index(after: $0)...] }
+
+        if let literal = literals.first(where: { $0.segment.utf8.elementsEqual(segment.utf8) }),
+           let route = literal.node.descend(rest, captures: &captures) {
+            return route
+        }
+
+        if let parameter = parameter, !segment.isEmpty {
+            captures.append(segment)
+            if let route = parameter.descend(rest, captures: &captures) {
+                return route
+            }
+            captures.removeLast()
+        }
+
+        if let greedy = greedy, !path.isEmpty {
+            // Longest capture first, like the regex `(.+)` it replaces
+            if let route = greedy.route {
+                captures.append(path)
+                return route
+            }
+            var end = path.endIndex
+            while let split = path[..<end].lastIndex(of: "/") {
+                let capture = path[..<split]
+                if !capture.isEmpty {
+                    captures.append(capture)
+                    if let route = greedy.match(path[path.index(after: split)...], captures: &captures) {
+                        return route
+                    }
+                    captures.removeLast()
+                }
+                end = split
+            }
+        }
+
+        return nil
+    }
+
+    private func descend(_ rest: Substring?, captures: inout [Substring]) -> Router.Route? {
+        guard let rest = rest else { return route }
+        return match(rest, captures: &captures)
     }
 }
 
 /// Builder for constructing a Router with routes and middlewares
 public final class RouterBuilder {
     private let logger: Logger
-    private var routes: [(method: HTTPMethod, pattern: RoutePattern, handler: RouteHandler)] = []
+    private var routes: [Router.Route] = []
     private var middlewares: [Middleware] = []
 
     fileprivate init(logger: Logger) {
         self.logger = logger
     }
 
+    /// Number of routes registered so far
+    public var routeCount: Int {
+        routes.count
+    }
+
     /// Register a middleware to be executed before route handlers
     public func use(_ middleware: Middleware) -> RouterBuilder {
         middlewares.append(middleware)
@@ -119,12 +317,15 @@ public final class RouterBuilder {
     }
 
     /// Register a route handler
-    public func register(method: HTTPMethod, pattern: String, handler: @escaping RouteHandler) -> RouterBuilder {
+    /// - Parameter streamingBody: Deliver the body incrementally via `HTTPRequest.bodyStream`
+    ///   instead of buffering it into `HTTPRequest.body` (for large uploads)
+    public func register(method: HTTPMethod, pattern: String, streamingBody: Bool = false, handler: @escaping RouteHandler) -> RouterBuilder {
         let routePattern = RoutePattern(pattern: pattern)
-        routes.append((method: method, pattern: routePattern, handler: handler))
+        routes.append(Router.Route(method: method, pattern: routePattern, streamingBody: streamingBody, handler: handler))
         logger.debug("Registered route", metadata: [
             "method": "\(method.rawValue)",
-            "pattern": "\(pattern)"
+            "pattern": "\(pattern)",
+            "streaming_body": "\(streamingBody)"
         ])
         return self
     }
@@ -137,13 +338,13 @@ public final class RouterBuilder {
     }
 
     /// Register a POST route
-    public func post(_ pattern: String, handler: @escaping RouteHandler) -> RouterBuilder {
-        return register(method: .POST, pattern: pattern, handler: handler)
+    public func post(_ pattern: String, streamingBody: Bool = false, handler: @escaping RouteHandler) -> RouterBuilder {
+        return register(method: .POST, pattern: pattern, streamingBody: streamingBody, handler: handler)
     }
 
     /// Register a PUT route
-    public func put(_ pattern: String, handler: @escaping RouteHandler) -> RouterBuilder {
-        return register(method: .PUT, pattern: pattern, handler: handler)
+    public func put(_ pattern: String, streamingBody: Bool = false, handler: @escaping RouteHandler) -> RouterBuilder {
+        return register(method: .PUT, pattern: pattern, streamingBody: streamingBody, handler: handler)
     }
 
     /// Register a DELETE route
@@ -156,86 +357,55 @@ public final class RouterBuilder {
         return register(method: .HEAD, pattern: pattern, handler: handler)
     }
 
-    /// Build the immutable router
+    /// Build the immutable router, compiling the registered patterns into route tries
     public func build() -> Router {
         return Router(logger: logger, routes: routes, middlewares: middlewares)
     }
 }
 
-/// Pattern matcher for routes
+/// Parsed route pattern
 /// Supports path parameters using {paramName} syntax
 /// Example: /containers/{id}/start matches /containers/abc123/start
 /// Supports greedy parameters using {paramName:.*} syntax for matching paths with slashes
 /// Example: /images/{name:.*}/json matches /images/foo/bar:latest/json
-struct RoutePattern {
+struct RoutePattern: Sendable {
+    enum Segment: Sendable {
+        case literal(String)
+        case parameter(String)
+        case greedy(String)  // Captures one or more segments, including slashes
+    }
+
     let pattern: String
-    private let regex: NSRegularExpression?
-    private let parameterNames: [String]
+    let segments: [Segment]
+    let parameterNames: [String]
 
     init(pattern: String) {
         self.pattern = pattern
 
-        // Extract parameter names from pattern (e.g., {id} -> "id", {name:.*} -> "name")
+        var segments: [Segment] = []
         var names: [String] = []
-        var regexPattern = "^"
-
-        // Split pattern into components and process each
-        let components = pattern.split(separator: "/", omittingEmptySubsequences: false)
-        for (index, component) in components.enumerated() {
-            if index > 0 {
-                regexPattern += "/"
-            }
 
+        // Split pattern into components after the leading "/"
+        let components = pattern.split(separator: "/", omittingEmptySubsequences: false).dropFirst()
+        for component in components {
             let componentStr = String(component)
             if componentStr.hasPrefix("{") && componentStr.hasSuffix("}") {
-                // Extract parameter name and check for greedy syntax
+                // Extract parameter name and check for greedy syntax (e.g., "name:.*")
                 let paramContent = String(componentStr.dropFirst().dropLast())
-
-                // Check if this is a greedy parameter (e.g., "name:.*")
-                let isGreedy = paramContent.hasSuffix(":.*")
-                let paramName = isGreedy ? String(paramContent.dropLast(3)) : paramContent
-
-                names.append(paramName)
-
-                if isGreedy {
-                    // Greedy match - captures everything including slashes
-                    regexPattern += "(.+)"
+                if paramContent.hasSuffix(":.*") {
+                    let paramName = String(paramContent.dropLast(3))
+                    names.append(paramName)
+                    segments.append(.greedy(paramName))
                 } else {
-                    // Regular match - excludes slashes
-                    regexPattern += "([^/]+)"
+                    names.append(paramContent)
+                    segments.append(.parameter(paramContent))
                 }
-            } else if !componentStr.isEmpty {
-                // Regular path component - escape it
-                regexPattern += NSRegularExpression.escapedPattern(for: componentStr)
+            } else {
+                segments.append(.literal(componentStr))
             }
         }
-        regexPattern += "$"
 
+        self.segments = segments
         self.parameterNames = names
-        self.regex = try? NSRegularExpression(pattern: regexPattern)
-    }
-
-    func matches(_ path: String) -> Bool {
-        guard let regex = regex else { return false }
-        let range = NSRange(path.startIndex..., in: path)
-        return regex.firstMatch(in: path, range: range) != nil
-    }
-
-    /// Extract path parameters from a matching path
-    func extractParameters(from path: String) -> [String: String] {
-        guard let regex = regex else { return [:] }
-        let range = NSRange(path.startIndex..., in: path)
-        guard let match = regex.firstMatch(in: path, range: range) else { return [:] }
-
-        var parameters: [String: String] = [:]
-        for (index, paramName) in parameterNames.enumerated() {
-            let captureIndex = index + 1  // Capture groups start at 1
-            if captureIndex < match.numberOfRanges,
-               let captureRange = Range(match.range(at: captureIndex), in: path) {
-                parameters[paramName] = String(path[captureRange])
-            }
-        }
-
-        return parameters
     }
 }
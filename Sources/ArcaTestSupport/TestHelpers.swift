@@ -1,10 +1,11 @@
 import Foundation
 
 // MARK: - Shared Test Helpers
+// Used by the integration tests and by ArcaBench
 
 /// Execute a shell command and return output
 @discardableResult
-func shell(_ command: String, environment: [String: String]? = nil) throws -> String {
+public func shell(_ command: String, environment: [String: String]? = nil) throws -> String {
     let task = Process()
     task.executableURL = URL(fileURLWithPath: "/bin/bash")
     task.arguments = ["-c", command]
@@ -36,13 +37,13 @@ func shell(_ command: String, environment: [String: String]? = nil) throws -> St
 
 /// Execute a docker command with DOCKER_HOST set
 @discardableResult
-func docker(_ args: String, socketPath: String) throws -> String {
+public func docker(_ args: String, socketPath: String) throws -> String {
     let env = ["DOCKER_HOST": "unix://\(socketPath)"]
     return try shell("docker \(args)", environment: env)
 }
 
 /// Execute a docker command with DOCKER_HOST set, returning success/failure without throwing
-func dockerExpectFailure(_ args: String, socketPath: String) -> Bool {
+public func dockerExpectFailure(_ args: String, socketPath: String) -> Bool {
     let task = Process()
     task.executableURL = URL(fileURLWithPath: "/bin/bash")
     task.arguments = ["-c", "docker \(args)"]
@@ -65,7 +66,7 @@ func dockerExpectFailure(_ args: String, socketPath: String) -> Bool {
 }
 
 /// Start Arca daemon and return process ID
-func startDaemon(socketPath: String, arcaBinary: String = ".build/debug/Arca", logFile: String, cleanDatabase: Bool = true) throws -> Int32 {
+public func startDaemon(socketPath: String, arcaBinary: String = ".build/debug/Arca", logFile: String, cleanDatabase: Bool = true) throws -> Int32 {
     // Kill any existing Arca processes first
     _ = try? shell("pkill -9 Arca")
     Thread.sleep(forTimeInterval: 1.0)
@@ -114,7 +115,7 @@ func startDaemon(socketPath: String, arcaBinary: String = ".build/debug/Arca", l
 }
 
 /// Stop Arca daemon gracefully
-func stopDaemon(pid: Int32) throws {
+public func stopDaemon(pid: Int32) throws {
     kill(pid, SIGTERM)
 
     // Wait for process to exit
@@ -136,11 +137,11 @@ func stopDaemon(pid: Int32) throws {
 
 // MARK: - Error Types
 
-enum ArcaTestError: Error, CustomStringConvertible {
+public enum ArcaTestError: Error, CustomStringConvertible {
     case commandFailed(command: String, output: String, exitCode: Int32)
     case daemonStartFailed
 
-    var description: String {
+    public var description: String {
         switch self {
         case .commandFailed(let command, let output, let exitCode):
             return "Command failed: \(command)\nExit code: \(exitCode)\nOutput:\n\(output)"
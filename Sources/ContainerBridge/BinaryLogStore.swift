@@ -0,0 +1,631 @@
+import Foundation
+import Containerization
+
+/// Output stream a log record belongs to
+/// Raw values match the stream type byte of the Docker multiplexed stream format
+public enum LogStream: UInt8, Sendable {
+    case stdout = 1
+    case stderr = 2
+
+    public init?(name: String) {
+        switch name {
+        case "stdout": self = .stdout
+        case "stderr": self = .stderr
+        default: return nil
+        }
+    }
+
+    public var name: String {
+        switch self {
+        case .stdout: return "stdout"
+        case .stderr: return "stderr"
+        }
+    }
+}
+
+/// On-disk layout of the binary ("local" driver) container log
+///
+/// container.log holds framed records appended in write order, both streams interleaved:
+///   [magic u8][stream u8][reserved u16][payload length u32][timestamp i64][payload][record length u32]
+/// All integers are little-endian. The timestamp is wall-clock nanoseconds since the epoch,
+/// clamped so it never decreases within a file. The trailing record length allows walking
+/// the file backwards for `--tail`.
+///
+/// container.idx is a sparse time index of (timestamp i64, offset u64) pairs, one for the
+/// first record and then one every `indexInterval` bytes of log data, so `--since` can
+/// binary-search to a nearby offset instead of scanning from the start.
+enum BinaryLogFormat {
+    static let magic: UInt8 = 0xA7
+    static let headerSize = 16
+    static let trailerSize = 4
+    static let indexEntrySize = 16
+
+    /// Bytes of log data between sparse index entries
+    static let indexInterval: UInt64 = 64 * 1024
+
+    /// Largest payload stored in one record; bigger writes are split across records
+    static let maxPayload = 1 << 20
+
+    /// Read window used when scanning records
+    static let readChunkSize = 256 * 1024
+
+    static let logFileName = "container.log"
+    static let indexFileName = "container.idx"
+
+    static func putUInt16(_ value: UInt16, into data: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+    }
+
+    static func putUInt32(_ value: UInt32, into data: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+    }
+
+    static func putInt64(_ value: Int64, into data: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+    }
+
+    static func putUInt64(_ value: UInt64, into data: inout Data) {
+        withUnsafeBytes(of: value.littleEndian) { data.append(contentsOf: $0) }
+    }
+
+    static func uint32(_ bytes: [UInt8], at offset: Int) -> UInt32 {
+        var value: UInt32 = 0
+        for i in 0..<4 {
+            value |= UInt32(bytes[offset + i]) << (8 * i)
+        }
+        return value
+    }
+
+    static func uint64(_ bytes: [UInt8], at offset: Int) -> UInt64 {
+        var value: UInt64 = 0
+        for i in 0..<8 {
+            value |= UInt64(bytes[offset + i]) << (8 * i)
+        }
+        return value
+    }
+
+    /// Current wall-clock time in nanoseconds since the epoch
+    static func now() -> Int64 {
+        var ts = timespec()
+        clock_gettime(CLOCK_REALTIME, &ts)
+        return Int64(ts.tv_sec) * 1_000_000_000 + Int64(ts.tv_nsec)
+    }
+
+    /// Split output into lines, each keeping its trailing newline; a final unterminated
+    /// fragment is its own line (matches FileLogWriter's per-chunk entries)
+    static func splitLines(_ data: Data) -> [Data] {
+        var result: [Data] = []
+        var lineStart = data.startIndex
+        for index in data.indices where data[index] == UInt8(ascii: "\n") {
+            result.append(data[lineStart...index])
+            lineStart = data.index(after: index)
+        }
+        if lineStart < data.endIndex {
+            result.append(data[lineStart..<data.endIndex])
+        }
+        return result
+    }
+
+    static func nanoseconds(_ date: Date) -> Int64 {
+        return Int64((date.timeIntervalSince1970 * 1_000_000_000).rounded(.down))
+    }
+
+    static func date(_ nanoseconds: Int64) -> Date {
+        return Date(timeIntervalSince1970: TimeInterval(nanoseconds) / 1_000_000_000)
+    }
+}
+
+/// Append-only binary log for one container, shared by its stdout and stderr writers
+/// @unchecked Sendable: Safe because all mutable state is protected by NSLock
+public final class BinaryLogStore: @unchecked Sendable {
+    public let logPath: URL
+    public let indexPath: URL
+
+    private let logHandle: FileHandle
+    private let indexHandle: FileHandle
+    private let lock = NSLock()
+    private var endOffset: UInt64
+    private var lastIndexedOffset: UInt64?
+    private var lastTimestamp: Int64
+    private var openWriters = 0
+
+    /// Open (or create) the binary log in a container log directory
+    /// An incomplete record left by a crash mid-write is truncated away.
+    public init(directory: URL) throws {
+        let logPath = directory.appendingPathComponent(BinaryLogFormat.logFileName)
+        let indexPath = directory.appendingPathComponent(BinaryLogFormat.indexFileName)
+        self.logPath = logPath
+        self.indexPath = indexPath
+
+        try FileManager.default.createDirectory(
+            at: directory,
+            withIntermediateDirectories: true,
+            attributes: nil
+        )
+        for path in [logPath, indexPath] where !FileManager.default.fileExists(atPath: path.path) {
+            FileManager.default.createFile(atPath: path.path, contents: nil, attributes: nil)
+        }
+
+        guard let logHandle = try? FileHandle(forUpdating: logPath) else {
+            throw LogWriterError.cannotOpenFile(logPath.path)
+        }
+        guard let indexHandle = try? FileHandle(forUpdating: indexPath) else {
+            try? logHandle.close()
+            throw LogWriterError.cannotOpenFile(indexPath.path)
+        }
+        self.logHandle = logHandle
+        self.indexHandle = indexHandle
+
+        // Recover the append position: scan forward from the last index entry to the end
+        // of the last complete record, and drop anything after it
+        let reader = try BinaryLogReader(logPath: logPath, indexPath: indexPath)
+        var index = reader.index
+        var lastTimestamp = index.last?.timestamp ?? 0
+        let validEnd = try reader.forEachRecord(from: index.last?.offset ?? 0) { record in
+            lastTimestamp = record.timestamp
+            return true
+        }
+
+        if try logHandle.seekToEnd() > validEnd {
+            try logHandle.truncate(atOffset: validEnd)
+        }
+        while let last = index.last, last.offset >= validEnd {
+            index.removeLast()
+        }
+        try indexHandle.truncate(atOffset: UInt64(index.count * BinaryLogFormat.indexEntrySize))
+        try indexHandle.seekToEnd()
+
+        self.endOffset = validEnd
+        self.lastIndexedOffset = index.last?.offset
+        self.lastTimestamp = lastTimestamp
+    }
+
+    /// Create a writer for one stream; the files are closed when every writer is closed
+    public func makeWriter(stream: LogStream) -> BinaryLogWriter {
+        lock.lock()
+        openWriters += 1
+        lock.unlock()
+        return BinaryLogWriter(store: self, stream: stream)
+    }
+
+    /// Append one chunk of container output
+    /// The chunk is framed and written with a single write, no per-line processing
+    /// - Returns: The log's end offset just after the chunk
+    @discardableResult
+    public func append(_ data: Data, stream: LogStream) throws -> UInt64 {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !data.isEmpty else { return endOffset }
+
+        let timestamp = max(BinaryLogFormat.now(), lastTimestamp)
+        let recordOffset = endOffset
+
+        var frame = Data()
+        let pieces = (data.count + BinaryLogFormat.maxPayload - 1) / BinaryLogFormat.maxPayload
+        frame.reserveCapacity(data.count + pieces * (BinaryLogFormat.headerSize + BinaryLogFormat.trailerSize))
+
+        var start = data.startIndex
+        while start < data.endIndex {
+            let end = data.index(start, offsetBy: BinaryLogFormat.maxPayload, limitedBy: data.endIndex) ?? data.endIndex
+            let length = end - start
+            frame.append(BinaryLogFormat.magic)
+            frame.append(stream.rawValue)
+            BinaryLogFormat.putUInt16(0, into: &frame)
+            BinaryLogFormat.putUInt32(UInt32(length), into: &frame)
+            BinaryLogFormat.putInt64(timestamp, into: &frame)
+            frame.append(data[start..<end])
+            BinaryLogFormat.putUInt32(
+                UInt32(BinaryLogFormat.headerSize + length + BinaryLogFormat.trailerSize),
+                into: &frame
+            )
+            start = end
+        }
+
+        try logHandle.write(contentsOf: frame)
+        endOffset += UInt64(frame.count)
+        lastTimestamp = timestamp
+
+        // Index after the record is on disk so an entry never points past the end of the log
+        if lastIndexedOffset.map({ recordOffset - $0 >= BinaryLogFormat.indexInterval }) ?? true {
+            var entry = Data(capacity: BinaryLogFormat.indexEntrySize)
+            BinaryLogFormat.putInt64(timestamp, into: &entry)
+            BinaryLogFormat.putUInt64(recordOffset, into: &entry)
+            try indexHandle.write(contentsOf: entry)
+            lastIndexedOffset = recordOffset
+        }
+        return endOffset
+    }
+
+    /// End offset of the last complete record written
+    public func committedEnd() -> UInt64 {
+        lock.lock()
+        defer { lock.unlock() }
+        return endOffset
+    }
+
+    /// Release one writer's reference, closing the files after the last one
+    fileprivate func release() throws {
+        lock.lock()
+        defer { lock.unlock() }
+
+        guard openWriters > 0 else { return }
+        openWriters -= 1
+        if openWriters == 0 {
+            try logHandle.close()
+            try indexHandle.close()
+        }
+    }
+
+    deinit {
+        try? logHandle.close()
+        try? indexHandle.close()
+    }
+}
+
+/// Writer for one stream of a container's binary log
+public final class BinaryLogWriter: LogPositionWriter, @unchecked Sendable {
+    private let store: BinaryLogStore
+    private let stream: LogStream
+    private let lock = NSLock()
+    private var closed = false
+
+    fileprivate init(store: BinaryLogStore, stream: LogStream) {
+        self.store = store
+        self.stream = stream
+    }
+
+    public func write(_ data: Data) throws {
+        try store.append(data, stream: stream)
+    }
+
+    public func writeReturningEnd(_ data: Data) throws -> UInt64 {
+        try store.append(data, stream: stream)
+    }
+
+    public func committedEnd() -> UInt64 {
+        store.committedEnd()
+    }
+
+    func lines(after: UInt64, through: UInt64) throws -> LogLineCursor {
+        let records = try BinaryLogRecordCursor(logPath: store.logPath, offset: after, limit: through)
+        return BinaryLogLineCursor(records: records, streams: [stream])
+    }
+
+    public func close() throws {
+        lock.lock()
+        let wasClosed = closed
+        closed = true
+        lock.unlock()
+
+        if !wasClosed {
+            try store.release()
+        }
+    }
+}
+
+/// One record read back from a binary log
+public struct BinaryLogRecord: Sendable {
+    public let stream: LogStream
+    /// Nanoseconds since the epoch
+    public let timestamp: Int64
+    public let payload: Data
+    /// File offset of the record
+    public let offset: UInt64
+
+    /// File offset just past the record
+    public var end: UInt64 {
+        offset + UInt64(BinaryLogFormat.headerSize + payload.count + BinaryLogFormat.trailerSize)
+    }
+
+    public var date: Date {
+        BinaryLogFormat.date(timestamp)
+    }
+
+    /// Split the payload into lines the way FileLogWriter splits a chunk into JSON entries
+    public func lines() -> [Data] {
+        BinaryLogFormat.splitLines(payload)
+    }
+
+    /// Number of lines `lines()` would return
+    public var lineCount: Int {
+        guard let last = payload.last else { return 0 }
+        let newlines = payload.reduce(0) { $1 == UInt8(ascii: "\n") ? $0 + 1 : $0 }
+        return last == UInt8(ascii: "\n") ? newlines : newlines + 1
+    }
+}
+
+/// Reader for a container's binary log
+/// Safe to use while the container is writing: a trailing partial record is treated as end of log.
+public final class BinaryLogReader {
+    public struct IndexEntry: Sendable {
+        public let timestamp: Int64
+        public let offset: UInt64
+    }
+
+    public let logPath: URL
+    public let indexPath: URL
+
+    /// Sparse time index, ascending by offset and timestamp
+    public let index: [IndexEntry]
+
+    public init(logPath: URL, indexPath: URL) throws {
+        self.logPath = logPath
+        self.indexPath = indexPath
+
+        var entries: [IndexEntry] = []
+        if let data = FileManager.default.contents(atPath: indexPath.path) {
+            let bytes = [UInt8](data)
+            let count = bytes.count / BinaryLogFormat.indexEntrySize
+            entries.reserveCapacity(count)
+            for i in 0..<count {
+                let base = i * BinaryLogFormat.indexEntrySize
+                entries.append(IndexEntry(
+                    timestamp: Int64(bitPattern: BinaryLogFormat.uint64(bytes, at: base)),
+                    offset: BinaryLogFormat.uint64(bytes, at: base + 8)
+                ))
+            }
+        }
+        self.index = entries
+    }
+
+    /// Convenience initializer for a container log directory
+    public convenience init(directory: URL) throws {
+        try self.init(
+            logPath: directory.appendingPathComponent(BinaryLogFormat.logFileName),
+            indexPath: directory.appendingPathComponent(BinaryLogFormat.indexFileName)
+        )
+    }
+
+    /// Offset to start scanning from to see every record at or after `timestamp`
+    /// Binary search for the last index entry strictly older than `timestamp`; every
+    /// record before that entry is at least as old, so it can be skipped.
+    public func offset(since timestamp: Int64) -> UInt64 {
+        var low = 0
+        var high = index.count
+        while low < high {
+            let mid = (low + high) / 2
+            if index[mid].timestamp < timestamp {
+                low = mid + 1
+            } else {
+                high = mid
+            }
+        }
+        return low == 0 ? 0 : index[low - 1].offset
+    }
+
+    /// Offset of a record from which at least `lines` lines of the given streams follow
+    /// Walks the file backwards using record trailers; returns 0 if the log is shorter.
+    public func tailOffset(lines: Int, streams: Set<LogStream>) throws -> UInt64 {
+        guard lines > 0 else {
+            return try fileSize()
+        }
+
+        let handle = try FileHandle(forReadingFrom: logPath)
+        defer { try? handle.close() }
+
+        var position = try handle.seekToEnd()
+        var remaining = lines
+
+        while position > 0 && remaining > 0 {
+            guard position >= UInt64(BinaryLogFormat.headerSize + BinaryLogFormat.trailerSize) else {
+                return 0
+            }
+
+            try handle.seek(toOffset: position - UInt64(BinaryLogFormat.trailerSize))
+            guard let trailer = try handle.read(upToCount: BinaryLogFormat.trailerSize),
+                  trailer.count == BinaryLogFormat.trailerSize else {
+                return 0
+            }
+            let recordLength = UInt64(BinaryLogFormat.uint32([UInt8](trailer), at: 0))
+            guard recordLength >= UInt64(BinaryLogFormat.headerSize + BinaryLogFormat.trailerSize),
+                  recordLength <= position else {
+                // Torn tail (writer mid-append) or corruption - fall back to a forward scan
+                return 0
+            }
+
+            let recordOffset = position - recordLength
+            try handle.seek(toOffset: recordOffset)
+            guard let data = try handle.read(upToCount: Int(recordLength)),
+                  let record = Self.parseRecord([UInt8](data), at: 0, offset: recordOffset) else {
+                return 0
+            }
+
+            if streams.contains(record.stream) {
+                remaining -= record.lineCount
+            }
+            position = recordOffset
+        }
+
+        return position
+    }
+
+    /// Cursor over complete records starting at `offset`
+    /// - Parameter limit: Stop at this file offset (e.g. the size at a snapshot), nil for end of file
+    public func records(from offset: UInt64, limit: UInt64? = nil) throws -> BinaryLogRecordCursor {
+        return try BinaryLogRecordCursor(logPath: logPath, offset: offset, limit: limit)
+    }
+
+    /// Visit complete records in order starting at `offset`
+    /// - Parameter body: Return false to stop after the current record
+    /// - Returns: Offset just past the last record visited (the resume point for a follower)
+    @discardableResult
+    public func forEachRecord(from offset: UInt64, _ body: (BinaryLogRecord) throws -> Bool) throws -> UInt64 {
+        let cursor = try records(from: offset)
+        while let record = try cursor.next() {
+            if try !body(record) {
+                break
+            }
+        }
+        return cursor.offset
+    }
+
+    /// Offset to start reading from for the given `docker logs` filters
+    /// `since` seeks through the index and `tail` walks back from the end, so neither
+    /// scans the whole file; records before `since` may still follow and must be filtered.
+    public func startOffset(
+        streams: Set<LogStream>,
+        since: Date? = nil,
+        until: Date? = nil,
+        tail: Int? = nil
+    ) throws -> UInt64 {
+        var start: UInt64 = 0
+        if let since = since {
+            start = offset(since: BinaryLogFormat.nanoseconds(since))
+        }
+        // Tail counts back from the end of the log, which is only the right window without `until`
+        if let tail = tail, until == nil {
+            start = max(start, try tailOffset(lines: tail, streams: streams))
+        }
+        return start
+    }
+
+    /// Read log lines for `docker logs`, both streams in write order
+    public func readLines(
+        streams: Set<LogStream>,
+        since: Date? = nil,
+        until: Date? = nil,
+        tail: Int? = nil
+    ) throws -> [LogLine] {
+        let sinceNanoseconds = since.map(BinaryLogFormat.nanoseconds)
+        let untilNanoseconds = until.map(BinaryLogFormat.nanoseconds)
+        let start = try startOffset(streams: streams, since: since, until: until, tail: tail)
+
+        var lines: [LogLine] = []
+        try forEachRecord(from: start) { record in
+            if let untilNanoseconds = untilNanoseconds, record.timestamp > untilNanoseconds {
+                return false
+            }
+            guard streams.contains(record.stream) else { return true }
+            if let sinceNanoseconds = sinceNanoseconds, record.timestamp < sinceNanoseconds {
+                return true
+            }
+
+            let date = record.date
+            for line in record.lines() {
+                lines.append(LogLine(stream: record.stream, timestamp: date, message: line))
+            }
+            // Keep memory bounded by the tail window when scanning a long range
+            if let tail = tail, lines.count > tail * 2 + 1024 {
+                lines.removeFirst(lines.count - tail)
+            }
+            return true
+        }
+
+        if let tail = tail {
+            return Array(lines.suffix(tail))
+        }
+        return lines
+    }
+
+    /// Current size of the log file
+    public func fileSize() throws -> UInt64 {
+        let attributes = try FileManager.default.attributesOfItem(atPath: logPath.path)
+        return attributes[.size] as? UInt64 ?? 0
+    }
+
+    /// Parse and validate one record at `start` in `bytes`
+    fileprivate static func parseRecord(_ bytes: [UInt8], at start: Int, offset: UInt64) -> BinaryLogRecord? {
+        guard bytes.count - start >= BinaryLogFormat.headerSize + BinaryLogFormat.trailerSize,
+              bytes[start] == BinaryLogFormat.magic,
+              let stream = LogStream(rawValue: bytes[start + 1]) else {
+            return nil
+        }
+
+        let payloadLength = Int(BinaryLogFormat.uint32(bytes, at: start + 4))
+        let recordLength = BinaryLogFormat.headerSize + payloadLength + BinaryLogFormat.trailerSize
+        guard payloadLength <= BinaryLogFormat.maxPayload,
+              bytes.count - start >= recordLength,
+              Int(BinaryLogFormat.uint32(bytes, at: start + recordLength - BinaryLogFormat.trailerSize)) == recordLength else {
+            return nil
+        }
+
+        let payloadStart = start + BinaryLogFormat.headerSize
+        return BinaryLogRecord(
+            stream: stream,
+            timestamp: Int64(bitPattern: BinaryLogFormat.uint64(bytes, at: start + 8)),
+            payload: Data(bytes[payloadStart..<(payloadStart + payloadLength)]),
+            offset: offset
+        )
+    }
+}
+
+/// Forward cursor over the complete records of a binary log
+/// Reads in large windows; stops at end of file or at a partial/corrupt record.
+public final class BinaryLogRecordCursor {
+    private let handle: FileHandle?
+    private let limit: UInt64?
+    private var buffer: [UInt8] = []
+    private var cursor = 0
+    private var bufferOffset: UInt64  // File offset of buffer[0]
+    private var done = false
+
+    /// Offset just past the last record returned (the resume point for a follower)
+    public var offset: UInt64 {
+        bufferOffset + UInt64(cursor)
+    }
+
+    init(logPath: URL, offset: UInt64, limit: UInt64? = nil) throws {
+        self.bufferOffset = offset
+        self.limit = limit
+        if FileManager.default.fileExists(atPath: logPath.path) {
+            let handle = try FileHandle(forReadingFrom: logPath)
+            try handle.seek(toOffset: offset)
+            self.handle = handle
+        } else {
+            self.handle = nil
+            self.done = true
+        }
+    }
+
+    deinit {
+        try? handle?.close()
+    }
+
+    /// Next complete record, or nil at the end of the readable log
+    public func next() throws -> BinaryLogRecord? {
+        guard !done, try fill(BinaryLogFormat.headerSize) else {
+            done = true
+            return nil
+        }
+
+        let payloadLength = Int(BinaryLogFormat.uint32(buffer, at: cursor + 4))
+        guard buffer[cursor] == BinaryLogFormat.magic,
+              payloadLength <= BinaryLogFormat.maxPayload else {
+            done = true
+            return nil
+        }
+
+        let recordLength = BinaryLogFormat.headerSize + payloadLength + BinaryLogFormat.trailerSize
+        guard try fill(recordLength),
+              let record = BinaryLogReader.parseRecord(buffer, at: cursor, offset: offset) else {
+            done = true
+            return nil
+        }
+
+        cursor += recordLength
+        return record
+    }
+
+    /// Ensure at least `count` unread bytes are buffered; false at end of file
+    private func fill(_ count: Int) throws -> Bool {
+        guard let handle = handle else { return false }
+        while buffer.count - cursor < count {
+            if cursor > 0 {
+                buffer.removeFirst(cursor)
+                bufferOffset += UInt64(cursor)
+                cursor = 0
+            }
+            var length = max(BinaryLogFormat.readChunkSize, count)
+            if let limit = limit {
+                let readPosition = bufferOffset + UInt64(buffer.count)
+                guard readPosition < limit else { return false }
+                length = Int(min(UInt64(length), limit - readPosition))
+            }
+            guard let chunk = try handle.read(upToCount: length), !chunk.isEmpty else {
+                return false
+            }
+            buffer.append(contentsOf: chunk)
+        }
+        return true
+    }
+}
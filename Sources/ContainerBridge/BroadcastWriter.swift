@@ -1,29 +1,85 @@
 import Foundation
 import Containerization
 
+/// What a BroadcastWriter does when a subscriber's buffer is full
+public enum SlowSubscriberPolicy: String, Codable, Sendable {
+    /// Discard the oldest buffered output and tell the subscriber how much was lost
+    case dropOldest = "drop-oldest"
+    /// Lose nothing: output that overflows the buffer is re-read from the container's log
+    /// once the subscriber catches up. The container is never held up; without a log this
+    /// falls back to drop-oldest.
+    case replayFromLog = "replay-from-log"
+}
+
+/// Buffering for output subscribers (attach clients, log followers)
+public struct OutputBufferConfig: Codable, Sendable {
+    /// Slow subscriber handling; drop-oldest when unset
+    public let slowSubscribers: SlowSubscriberPolicy?
+    /// Output buffered per subscriber before the policy applies; 4096 KB when unset
+    public let bufferSizeKB: Int?
+
+    public init(slowSubscribers: SlowSubscriberPolicy? = nil, bufferSizeKB: Int? = nil) {
+        self.slowSubscribers = slowSubscribers
+        self.bufferSizeKB = bufferSizeKB
+    }
+}
+
 /// A Writer that broadcasts to multiple destinations and supports dynamic subscription
 /// Used for container stdout/stderr to support both persistent logging and dynamic attach
-/// @unchecked Sendable: Safe because subscribers array is protected by NSLock
+///
+/// The initial subscribers (the container's log writers) are written inline, so the log file
+/// always sees output first and in order. Subscribers added later each get a bounded buffer
+/// drained on their own queue; a slow or stuck attach client only ever affects itself, as
+/// set by the slow-subscriber policy. Log followers buffer for themselves and are handed
+/// each chunk with the log offsets it spans.
+/// @unchecked Sendable: Safe because the subscriber lists are protected by NSLock
 public final class BroadcastWriter: Writer, @unchecked Sendable {
-    private var subscribers: [Writer]
+    private var primaries: [Writer]
+    private var subscribers: [BufferedSubscriber] = []
+    private var followers: [LogFollower] = []
     private let lock = NSLock()
+    private let stream: LogStream
+    /// Slow-subscriber policy for attach clients and log followers
+    let policy: SlowSubscriberPolicy
+    /// Output buffered per subscriber or follower before the policy applies
+    let bufferBytes: Int
+
+    public init(initialSubscribers: [Writer] = [], stream: LogStream, config: OutputBufferConfig? = nil) {
+        self.primaries = initialSubscribers
+        self.stream = stream
+        self.policy = config?.slowSubscribers ?? .dropOldest
+        self.bufferBytes = max(config?.bufferSizeKB ?? 4096, 64) * 1024
+    }
 
-    public init(initialSubscribers: [Writer] = []) {
-        self.subscribers = initialSubscribers
+    /// The container's log writer for this stream, if it can report offsets
+    var logWriter: LogPositionWriter? {
+        lock.lock()
+        defer { lock.unlock() }
+        return primaries.lazy.compactMap { $0 as? LogPositionWriter }.first
     }
 
     /// Write data to all subscribed writers
     /// Continues even if one writer fails, to ensure other destinations still receive data
     public func write(_ data: Data) throws {
         lock.lock()
-        let currentSubscribers = subscribers
+        let currentPrimaries = primaries
         lock.unlock()
 
         var lastError: Error?
+        var delivered = false
+        var start: UInt64?
+        var end: UInt64?
 
-        for writer in currentSubscribers {
+        for writer in currentPrimaries {
             do {
-                try writer.write(data)
+                if let logWriter = writer as? LogPositionWriter {
+                    // Writes to one stream are serial, so nothing of this stream lands between
+                    start = logWriter.committedEnd()
+                    end = try logWriter.writeReturningEnd(data)
+                } else {
+                    try writer.write(data)
+                }
+                delivered = true
             } catch {
                 // Store error but continue writing to other writers
                 // This ensures one failing destination doesn't break others
@@ -31,51 +87,99 @@ public final class BroadcastWriter: Writer, @unchecked Sendable {
             }
         }
 
-        // If all writers failed, throw the last error
-        if let error = lastError {
-            var allFailed = true
-            for writer in currentSubscribers {
-                do {
-                    try writer.write(Data())  // Test with empty data
-                    allFailed = false
-                    break
-                } catch {
-                    // Writer still failed
+        // Taken after logging: a follower that subscribes in between finds this chunk in its
+        // replay instead, so every chunk reaches it one way or the other
+        lock.lock()
+        let currentSubscribers = subscribers
+        let currentFollowers = followers
+        lock.unlock()
+
+        var failed: [BufferedSubscriber] = []
+        if !data.isEmpty && (!currentSubscribers.isEmpty || !currentFollowers.isEmpty) {
+            let chunk = LogChunk(stream: stream, data: data, timestamp: Date(), start: start, end: end)
+            for follower in currentFollowers {
+                follower.receive(chunk)
+                delivered = true
+            }
+            for subscriber in currentSubscribers {
+                if subscriber.enqueue(chunk) {
+                    delivered = true
+                } else {
+                    failed.append(subscriber)
                 }
             }
+        }
 
-            if allFailed {
-                throw error
-            }
+        // Writers that failed (e.g. a disconnected attach client) stop receiving output
+        if !failed.isEmpty {
+            lock.lock()
+            subscribers.removeAll { subscriber in failed.contains { $0 === subscriber } }
+            lock.unlock()
+        }
+
+        // If all writers failed, throw the last error
+        if let error = lastError, !delivered {
+            throw error
         }
     }
 
     /// Add a new subscriber to receive future writes
     /// Thread-safe and can be called while container is running
     public func addSubscriber(_ writer: Writer) {
+        let subscriber = BufferedSubscriber(writer: writer, policy: policy, maxBytes: bufferBytes, log: logWriter)
+        lock.lock()
+        defer { lock.unlock() }
+        subscribers.append(subscriber)
+    }
+
+    /// Add a log follower to receive future chunks
+    func addFollower(_ follower: LogFollower) {
         lock.lock()
         defer { lock.unlock() }
-        subscribers.append(writer)
+        followers.append(follower)
+    }
+
+    /// Remove a log follower when it ends
+    func removeFollower(_ follower: LogFollower) {
+        lock.lock()
+        defer { lock.unlock() }
+        followers.removeAll { $0 === follower }
+    }
+
+    /// End offset of the last chunk the log writer committed, nil without a log writer
+    func committedEnd() -> UInt64? {
+        logWriter?.committedEnd()
     }
 
-    /// Remove a subscriber (not needed - failed writes are handled automatically)
-    /// When a client disconnects, writes to their Writer fail and are silently ignored
-    /// while other subscribers (like log files) continue receiving data
+    /// Remove a subscriber so it stops receiving writes
+    /// Attach clients don't need this (writes to a disconnected client fail and are ignored),
+    /// but long-lived subscribers must unsubscribe when they end
     public func removeSubscriber(_ writer: Writer) {
-        // No-op: We don't need explicit removal because:
-        // 1. Write errors to disconnected clients are caught and ignored (line 25-28)
-        // 2. Log files and other subscribers continue working
-        // 3. Failed Writers are cleaned up when container exits
+        lock.lock()
+        primaries.removeAll { ($0 as AnyObject) === (writer as AnyObject) }
+        let removed = subscribers.filter { ($0.writer as AnyObject) === (writer as AnyObject) }
+        subscribers.removeAll { ($0.writer as AnyObject) === (writer as AnyObject) }
+        lock.unlock()
+
+        for subscriber in removed {
+            subscriber.stop()
+        }
     }
 
     /// Close all subscribed writers
+    /// Buffered subscribers are closed once they have drained what they already hold
     public func close() throws {
         lock.lock()
+        let currentPrimaries = primaries
         let currentSubscribers = subscribers
         lock.unlock()
 
+        for subscriber in currentSubscribers {
+            subscriber.close()
+        }
+
         var lastError: Error?
-        for writer in currentSubscribers {
+        for writer in currentPrimaries {
             do {
                 try writer.close()
             } catch {
@@ -88,3 +192,215 @@ public final class BroadcastWriter: Writer, @unchecked Sendable {
         }
     }
 }
+
+/// Bounded queue of output waiting for one slow subscriber or follower
+///
+/// Overflow discards the oldest chunks. Under `.replayFromLog` a discarded chunk that was logged
+/// becomes a gap - the log range it spans, merged with the gap before it - for the consumer
+/// to re-read once it gets there; everything else is counted and reported as dropped.
+/// Not thread-safe; owners guard it with their own lock.
+struct OutputQueue {
+    enum Item {
+        case chunk(LogChunk)
+        case dropped(LogStream, bytes: Int)
+        /// Output to re-read from the stream's log: records ending in (after, through]
+        case gap(LogStream, after: UInt64, through: UInt64, bytes: Int)
+    }
+
+    private struct Gap {
+        let after: UInt64
+        var through: UInt64
+        var bytes: Int
+    }
+
+    private let policy: SlowSubscriberPolicy
+    private let maxBytes: Int
+    private var pending = RingBuffer<LogChunk>(capacity: 1024)
+    private var pendingBytes = 0
+    private var droppedBytes: [LogStream: Int] = [:]  // Discarded since the last delivered chunk
+    private var gaps: [LogStream: Gap] = [:]
+
+    init(policy: SlowSubscriberPolicy, maxBytes: Int) {
+        self.policy = policy
+        self.maxBytes = maxBytes
+    }
+
+    var isEmpty: Bool {
+        pending.isEmpty && droppedBytes.isEmpty && gaps.isEmpty
+    }
+
+    mutating func append(_ chunk: LogChunk) {
+        while !pending.isEmpty && (pending.isFull || pendingBytes + chunk.data.count > maxBytes) {
+            if let oldest = pending.popFirst() {
+                pendingBytes -= oldest.data.count
+                discard(oldest)
+            }
+        }
+        pending.append(chunk)
+        pendingBytes += chunk.data.count
+    }
+
+    /// Gaps and drop counts come before the chunks queued after them
+    mutating func next() -> Item? {
+        if let dropped = droppedBytes.first {
+            droppedBytes.removeValue(forKey: dropped.key)
+            return .dropped(dropped.key, bytes: dropped.value)
+        }
+        if let gap = gaps.first {
+            gaps.removeValue(forKey: gap.key)
+            return .gap(gap.key, after: gap.value.after, through: gap.value.through, bytes: gap.value.bytes)
+        }
+        guard let chunk = pending.popFirst() else { return nil }
+        pendingBytes -= chunk.data.count
+        return .chunk(chunk)
+    }
+
+    /// Drop queued chunks that match, e.g. ones a replay already covers
+    mutating func removeAll(where shouldRemove: (LogChunk) -> Bool) {
+        var kept = RingBuffer<LogChunk>(capacity: pending.capacity)
+        while let chunk = pending.popFirst() {
+            if shouldRemove(chunk) {
+                pendingBytes -= chunk.data.count
+            } else {
+                kept.append(chunk)
+            }
+        }
+        pending = kept
+    }
+
+    mutating func removeAll() {
+        pending.removeAll()
+        pendingBytes = 0
+        droppedBytes.removeAll()
+        gaps.removeAll()
+    }
+
+    private mutating func discard(_ chunk: LogChunk) {
+        if policy == .replayFromLog, let start = chunk.start, let end = chunk.end {
+            if var gap = gaps[chunk.stream] {
+                gap.through = end
+                gap.bytes += chunk.data.count
+                gaps[chunk.stream] = gap
+            } else {
+                gaps[chunk.stream] = Gap(after: start, through: end, bytes: chunk.data.count)
+            }
+        } else {
+            droppedBytes[chunk.stream, default: 0] += chunk.data.count
+        }
+    }
+}
+
+/// A broadcast subscriber behind a bounded buffer with its own drain queue
+/// Enqueueing never waits: under `.replayFromLog` the drain queue re-reads overflow from the log.
+/// @unchecked Sendable: Safe because all mutable state is protected by NSLock
+private final class BufferedSubscriber: @unchecked Sendable {
+    let writer: Writer
+
+    private let log: LogPositionWriter?
+    private let lock = NSLock()
+    private let queue = DispatchQueue(label: "com.arca.broadcast.subscriber", qos: .utility)
+
+    private var pending: OutputQueue
+    private var draining = false
+    private var closeRequested = false
+    private var stopped = false  // Removed, or its writer failed
+
+    init(writer: Writer, policy: SlowSubscriberPolicy, maxBytes: Int, log: LogPositionWriter?) {
+        self.writer = writer
+        self.log = log
+        self.pending = OutputQueue(policy: policy, maxBytes: maxBytes)
+    }
+
+    /// Queue output for the subscriber; false once it is stopped
+    func enqueue(_ chunk: LogChunk) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        if stopped { return false }
+        if closeRequested { return true }  // Output after close is ignored
+
+        pending.append(chunk)
+        startDrainIfNeeded()
+        return true
+    }
+
+    /// Deliver what is buffered, then close the writer
+    func close() {
+        lock.lock()
+        defer { lock.unlock() }
+        guard !stopped && !closeRequested else { return }
+        closeRequested = true
+        startDrainIfNeeded()
+    }
+
+    /// Discard buffered output and stop delivering
+    func stop() {
+        lock.lock()
+        stopped = true
+        pending.removeAll()
+        lock.unlock()
+    }
+
+    /// Caller holds the lock
+    private func startDrainIfNeeded() {
+        guard !draining else { return }
+        draining = true
+        queue.async { [self] in
+            drain()
+        }
+    }
+
+    private func drain() {
+        while true {
+            lock.lock()
+            guard !stopped, let item = pending.next() else {
+                draining = false
+                let shouldClose = closeRequested && !stopped
+                if shouldClose { stopped = true }
+                lock.unlock()
+                if shouldClose {
+                    try? writer.close()
+                }
+                return
+            }
+            lock.unlock()
+
+            do {
+                switch item {
+                case .chunk(let chunk):
+                    try writer.write(chunk.data)
+                case .dropped(_, let bytes):
+                    try writeDropNotice(bytes)
+                case .gap(let stream, let after, let through, let bytes):
+                    try catchUp(stream: stream, after: after, through: through, bytes: bytes)
+                }
+            } catch {
+                stop()
+                return
+            }
+        }
+    }
+
+    /// Re-send overflowed output from the log, a read window at a time
+    private func catchUp(stream: LogStream, after: UInt64, through: UInt64, bytes: Int) throws {
+        guard let log = log, let lines = try? log.lines(after: after, through: through) else {
+            try writeDropNotice(bytes)
+            return
+        }
+
+        var batch = Data()
+        while let line = try? lines.next() {
+            batch.append(line.message)
+            if batch.count >= 64 * 1024 {
+                try writer.write(batch)
+                batch.removeAll(keepingCapacity: true)
+            }
+        }
+        if !batch.isEmpty {
+            try writer.write(batch)
+        }
+    }
+
+    private func writeDropNotice(_ bytes: Int) throws {
+        try writer.write(Data("\n[arca: \(bytes) bytes of output dropped, client too slow]\n".utf8))
+    }
+}
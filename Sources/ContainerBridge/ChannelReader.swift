@@ -1,36 +1,103 @@
 import Foundation
 import Containerization
 
-/// A ReaderStream implementation that provides container stdin from an AsyncStream
-/// Used for reading stdin from Docker CLI during interactive exec sessions
+/// A ReaderStream implementation that provides container stdin from a client connection
+/// Used for reading stdin from Docker CLI during interactive exec and attach sessions
+///
+/// Input arrives in whatever chunks the connection reads and is handed to the process as
+/// soon as it asks for more, so keystrokes go straight through while bulk input (`docker
+/// exec -i ... < dump.sql`) is passed on in large coalesced chunks. The buffer is bounded:
+/// `push(_:)` reports when the producer should stop reading, and the resume handler runs
+/// once the process has caught up.
+/// @unchecked Sendable: Safe because all mutable state is protected by NSLock
 public final class ChannelReader: ReaderStream, @unchecked Sendable {
-    private let byteStream: AsyncStream<UInt8>
-    public let continuation: AsyncStream<UInt8>.Continuation
+    /// Buffered input above which the producer should pause
+    public static let highWaterMark = 1 << 20
 
-    public init() {
-        var cont: AsyncStream<UInt8>.Continuation!
-        self.byteStream = AsyncStream<UInt8> { continuation in
-            cont = continuation
+    private let lock = NSLock()
+    private var pending = Data()
+    private var finished = false
+    private var paused = false
+    private var waiter: CheckedContinuation<Data?, Never>?
+    private var onResume: (@Sendable () -> Void)?
+
+    public init() {}
+
+    /// Set the handler that restarts a paused producer
+    public func setResumeHandler(_ handler: @escaping @Sendable () -> Void) {
+        lock.lock()
+        defer { lock.unlock() }
+        onResume = handler
+    }
+
+    /// Append input for the process
+    /// - Returns: False when the buffer is full and the producer should pause until resumed
+    @discardableResult
+    public func push<Bytes: Sequence>(_ bytes: Bytes) -> Bool where Bytes.Element == UInt8 {
+        lock.lock()
+        if finished {
+            lock.unlock()
+            return true
+        }
+        pending.append(contentsOf: bytes)
+
+        // A process already waiting for input takes it directly
+        if let waiter = waiter, !pending.isEmpty {
+            self.waiter = nil
+            let chunk = pending
+            pending = Data()
+            lock.unlock()
+            waiter.resume(returning: chunk)
+            return true
+        }
+
+        if pending.count >= Self.highWaterMark {
+            paused = true
         }
-        self.continuation = cont
+        let accepting = !paused
+        lock.unlock()
+        return accepting
+    }
+
+    /// Signal end of input (client half-closed or disconnected)
+    public func finish() {
+        lock.lock()
+        finished = true
+        let waiter = self.waiter
+        self.waiter = nil
+        lock.unlock()
+        waiter?.resume(returning: nil)
     }
 
     /// ReaderStream conformance - returns stream of Data chunks
-    /// For interactive TTY, yields each byte immediately for real-time response
+    /// Each element is everything buffered since the process last read
     public func stream() -> AsyncStream<Data> {
-        return AsyncStream<Data> { continuation in
-            Task {
-                for await byte in self.byteStream {
-                    // Yield each byte immediately for interactive TTY response
-                    continuation.yield(Data([byte]))
-                }
-                continuation.finish()
-            }
-        }
+        return AsyncStream(unfolding: { await self.next() })
     }
 
     /// Close the reader
     public func close() {
-        continuation.finish()
+        finish()
+    }
+
+    private func next() async -> Data? {
+        lock.lock()
+        if !pending.isEmpty {
+            let chunk = pending
+            pending = Data()
+            let resume = paused ? onResume : nil
+            paused = false
+            lock.unlock()
+            resume?()
+            return chunk
+        }
+        if finished {
+            lock.unlock()
+            return nil
+        }
+        return await withCheckedContinuation { continuation in
+            waiter = continuation
+            lock.unlock()
+        }
     }
 }
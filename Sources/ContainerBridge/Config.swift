@@ -6,17 +6,51 @@ public struct ArcaConfig: Codable, Sendable {
     public let kernelPath: String
     public let socketPath: String
     public let logLevel: String
+    /// Default container log driver ("json-file" or "local"); json-file when unset
+    public let logDriver: LogDriver?
+    /// Health check scheduling and native probes; defaults when unset
+    public let healthChecks: HealthCheckerConfig?
+    /// Layer cache size bound and pull-time prefetch; defaults when unset
+    public let layerCache: LayerCacheConfig?
+    /// Image pull concurrency; defaults when unset
+    public let pulls: PullConfig?
+    /// Buffering of container output to attach clients and log followers; defaults when unset
+    public let outputBuffer: OutputBufferConfig?
+    /// Span logging for API requests, lifecycle phases and guest RPCs; disabled when unset
+    public let tracing: TracingConfig?
 
     enum CodingKeys: String, CodingKey {
         case kernelPath
         case socketPath
         case logLevel
+        case logDriver
+        case healthChecks
+        case layerCache
+        case pulls
+        case outputBuffer
+        case tracing
     }
 
-    public init(kernelPath: String, socketPath: String, logLevel: String) {
+    public init(
+        kernelPath: String,
+        socketPath: String,
+        logLevel: String,
+        logDriver: LogDriver? = nil,
+        healthChecks: HealthCheckerConfig? = nil,
+        layerCache: LayerCacheConfig? = nil,
+        pulls: PullConfig? = nil,
+        outputBuffer: OutputBufferConfig? = nil,
+        tracing: TracingConfig? = nil
+    ) {
         self.kernelPath = kernelPath
         self.socketPath = socketPath
         self.logLevel = logLevel
+        self.logDriver = logDriver
+        self.healthChecks = healthChecks
+        self.layerCache = layerCache
+        self.pulls = pulls
+        self.outputBuffer = outputBuffer
+        self.tracing = tracing
     }
 }
 
@@ -63,7 +97,8 @@ public final class ConfigManager {
             logger.info("Configuration loaded successfully", metadata: [
                 "kernel_path": "\(config.kernelPath)",
                 "socket_path": "\(config.socketPath)",
-                "log_level": "\(config.logLevel)"
+                "log_level": "\(config.logLevel)",
+                "log_driver": "\(config.logDriver?.rawValue ?? LogDriver.jsonFile.rawValue)"
             ])
 
             // Expand ~ in all paths
@@ -113,7 +148,13 @@ public final class ConfigManager {
         return ArcaConfig(
             kernelPath: expandTilde(config.kernelPath),
             socketPath: expandTilde(config.socketPath),
-            logLevel: config.logLevel
+            logLevel: config.logLevel,
+            logDriver: config.logDriver,
+            healthChecks: config.healthChecks,
+            layerCache: config.layerCache,
+            pulls: config.pulls,
+            outputBuffer: config.outputBuffer,
+            tracing: config.tracing
         )
     }
 }
@@ -16,8 +16,12 @@ public actor ContainerManager {
     private let kernelPath: String
 
     // Container state tracking
-    // Actor isolation ensures thread-safe access to all mutable state
-    private var containers: [String: ContainerInfo] = [:]  // Docker ID -> Info
+    // The actor is the only writer; each write publishes a copy-on-write snapshot to the
+    // registry, which list/inspect/resolve read without hopping onto the actor
+    private let registry = ContainerRegistry<ContainerInfo>()
+    private var containers: [String: ContainerInfo] {  // Docker ID -> Info
+        registry.entries
+    }
     private var nativeContainers: [String: Containerization.LinuxContainer] = [:]  // Docker ID -> Native LinuxContainer
     private var idMapping: [String: String] = [:]  // Docker ID -> Native ID
     private var reverseMapping: [String: String] = [:]  // Native ID -> Docker ID
@@ -25,12 +29,16 @@ public actor ContainerManager {
     // Log management
     // logManager is immutable and thread-safe, so it can be accessed from nonisolated contexts
     nonisolated public let logManager: ContainerLogManager
-    private var logWriters: [String: (FileLogWriter, FileLogWriter)] = [:]  // Docker ID -> (stdout, stderr)
+    private var logWriters: [String: (Writer, Writer)] = [:]  // Docker ID -> (stdout, stderr)
     private var broadcastWriters: [String: (BroadcastWriter, BroadcastWriter)] = [:]  // Docker ID -> (stdout, stderr) broadcast writers for dynamic attach
+    private var logFollowers: [String: [UUID: LogFollower]] = [:]  // Docker ID -> live `docker logs -f` subscriptions
 
     // Filesystem clients for container filesystem operations (docker diff, archive ops)
     private var filesystemClients: [String: FilesystemClient] = [:]  // Docker ID -> FilesystemClient
 
+    // Persistent vsock gRPC channels to each running container's control services
+    private var controlChannelPools: [String: ControlChannelPool] = [:]  // Docker ID -> pool
+
     // Background monitoring tasks
     private var monitoringTasks: [String: Task<Void, Never>] = [:]  // Docker ID -> Monitoring Task
 
@@ -42,11 +50,14 @@ public actor ContainerManager {
 
     private var nativeManager: Containerization.ContainerManager?
 
-    // Optional NetworkManager reference for auto-attachment to networks
-    private var networkManager: NetworkManager?
+    // NetworkManager (auto-attachment to networks) and HealthChecker (Phase 6 - Task 6.2)
+    // references, readable from the nonisolated inspect/list paths
+    private let services = ServiceReferences()
+    private nonisolated var networkManager: NetworkManager? { services.networkManager }
+    private nonisolated var healthChecker: HealthChecker? { services.healthChecker }
 
-    // Optional HealthChecker reference for health check management (Phase 6 - Task 6.2)
-    private var healthChecker: HealthChecker?
+    // Restart-policy recovery progress, readable while applyRestartPolicies() runs
+    private let recovery = RecoveryTracker()
 
     // Optional VolumeManager reference for named volume resolution
     private var volumeManager: VolumeManager?
@@ -57,6 +68,9 @@ public actor ContainerManager {
     // Optional EventManager reference for emitting Docker events
     private var eventEmitter: EventEmitter?
 
+    // Told the Docker ID of each removed container (e.g. to end its stats sampling)
+    private var removalObserver: (@Sendable (String) async -> Void)?
+
     // Shared vmnet network for NAT networking with internet access
     private var sharedNetwork: SharedVmnetNetwork?
 
@@ -65,6 +79,21 @@ public actor ContainerManager {
 
     // Layer unpacker for OverlayFS
     private var overlayUnpacker: OverlayFSUnpacker?
+    private let layerCacheConfig: LayerCacheConfig?
+    /// Image reference -> creates in progress that aren't in the registry yet
+    /// Their layers count as in use, so eviction can't remove them before registration.
+    private var imagesBeingCreated: [String: Int] = [:]
+
+    // Per-subscriber buffering for attach clients and log followers
+    private let outputBufferConfig: OutputBufferConfig?
+
+    /// Size of each container's thin-provisioned writable.ext4
+    /// 64 GB provides sufficient space for build caches and large workloads
+    private static let writableFilesystemSizeMB = 65536
+
+    // Empty writable.ext4 template, cloned for each container; next to the container
+    // directories because clonefile can't cross volumes
+    private let writableTemplates: EXT4TemplateStore
 
     /// Configuration for a container whose .create() was deferred
     private struct DeferredContainerConfig {
@@ -170,23 +199,37 @@ public actor ContainerManager {
         imageManager: ImageManager,
         kernelPath: String,
         stateStore: StateStore,
+        logDriver: LogDriver = .jsonFile,
+        layerCache: LayerCacheConfig? = nil,
+        outputBuffer: OutputBufferConfig? = nil,
         logger: Logger
     ) {
         self.imageManager = imageManager
         self.kernelPath = kernelPath
         self.stateStore = stateStore
         self.logger = logger
-        self.logManager = ContainerLogManager(logger: logger)
+        self.logManager = ContainerLogManager(logger: logger, defaultDriver: logDriver)
+        self.layerCacheConfig = layerCache
+        self.outputBufferConfig = outputBuffer
+        let appleStorePath = NSString(string: "~/Library/Application Support/com.apple.containerization").expandingTildeInPath
+        self.writableTemplates = EXT4TemplateStore(
+            directory: URL(fileURLWithPath: appleStorePath).appendingPathComponent("arca-templates"),
+            logger: logger
+        )
     }
 
     /// Set the NetworkManager (called after NetworkManager is initialized)
     public func setNetworkManager(_ manager: NetworkManager) {
-        self.networkManager = manager
+        services.networkManager = manager
     }
 
     /// Set the HealthChecker (called after HealthChecker is initialized) - Phase 6, Task 6.2
-    public func setHealthChecker(_ checker: HealthChecker) {
-        self.healthChecker = checker
+    /// Status changes are pushed into the registry, where list and inspect read them
+    public func setHealthChecker(_ checker: HealthChecker) async {
+        services.healthChecker = checker
+        await checker.setStatusObserver { [registry] dockerID, health in
+            registry.updateHealth(health, for: dockerID)
+        }
     }
 
     /// Set the VolumeManager (called after VolumeManager is initialized)
@@ -203,6 +246,11 @@ public actor ContainerManager {
         self.eventEmitter = emitter
     }
 
+    /// Set the observer called once a container is removed, whichever path removed it
+    public func setRemovalObserver(_ observer: @escaping @Sendable (String) async -> Void) {
+        self.removalObserver = observer
+    }
+
     /// Set the SharedVmnetNetwork (called after network is initialized)
     public func setSharedVmnetNetwork(_ network: SharedVmnetNetwork) {
         self.sharedNetwork = network
@@ -244,11 +292,20 @@ public actor ContainerManager {
 
         // Initialize OverlayFS unpacker for parallel layer caching
         let layerCachePath = NSString(string: "~/.arca/layers").expandingTildeInPath
-        overlayUnpacker = OverlayFSUnpacker(
+        let unpacker = OverlayFSUnpacker(
             layerCachePath: URL(fileURLWithPath: layerCachePath),
             stateStore: stateStore,
+            config: layerCacheConfig,
+            layersInUse: { [weak self] in
+                await self?.layerDigestsInUse() ?? []
+            },
             logger: logger
         )
+        overlayUnpacker = unpacker
+        if layerCacheConfig?.prefetchOnPull ?? true {
+            await imageManager.setLayerPrefetcher(unpacker)
+        }
+        await unpacker.scheduleCollection()
 
         logger.info("ContainerManager initialized successfully")
 
@@ -260,13 +317,17 @@ public actor ContainerManager {
     private func loadPersistedState() async throws {
         logger.info("Loading persisted container state...")
 
-        // Load all containers from database
-        let persistedContainers = try await stateStore.loadAllContainers()
+        // Load all containers and their attachments from one database snapshot
+        let snapshot = try await stateStore.loadContainerSnapshot()
+        let persistedContainers = snapshot.containers
 
         logger.info("Found persisted containers", metadata: [
             "count": "\(persistedContainers.count)"
         ])
 
+        // Containers found "running" in the database, marked exited (137) once all are restored
+        var crashed: [String] = []
+
         // Reconstruct in-memory state for each container
         for containerData in persistedContainers {
             // Parse config and hostConfig JSON
@@ -295,7 +356,7 @@ public actor ContainerManager {
             }
 
             // Load network attachments
-            let attachments = try await stateStore.loadNetworkAttachments(containerID: containerData.id)
+            let attachments = snapshot.attachments[containerData.id] ?? []
             var networkAttachments: [String: NetworkAttachment] = [:]
             for attachment in attachments {
                 networkAttachments[attachment.networkID] = NetworkAttachment(
@@ -328,13 +389,8 @@ public actor ContainerManager {
                     "exitCode": "137"
                 ])
 
-                // Update database: mark as exited with exit code 137
-                try await stateStore.updateContainerStatus(
-                    id: containerData.id,
-                    status: "exited",
-                    exitCode: 137,
-                    finishedAt: Date()
-                )
+                // Database is updated below, together with the other crashed containers
+                crashed.append(containerData.id)
             } else {
                 // Preserve other states (created, exited, etc.)
                 actualState = containerData.status
@@ -378,7 +434,7 @@ public actor ContainerManager {
             )
 
             // Store in containers map
-            containers[containerData.id] = containerInfo
+            registry.update(containerData.id, with: containerInfo)
 
             // Create ID mappings (dockerID -> nativeID, nativeID -> dockerID)
             idMapping[containerData.id] = nativeID
@@ -392,8 +448,8 @@ public actor ContainerManager {
             let combinedPath = logDir.appendingPathComponent("combined.log")
 
             // Only register if log files exist
-            if FileManager.default.fileExists(atPath: stdoutPath.path) &&
-               FileManager.default.fileExists(atPath: stderrPath.path) {
+            if let driver = logManager.existingDriver(logDir: logDir),
+               driver == .local || FileManager.default.fileExists(atPath: stderrPath.path) {
                 // Register log paths in logManager (internal method call needed)
                 // We can't use createLogWriters() because it would truncate existing logs
                 // Instead, we directly register the paths using the LogPaths struct
@@ -403,7 +459,8 @@ public actor ContainerManager {
                     dockerID: containerData.id,
                     stdoutPath: stdoutPath,
                     stderrPath: stderrPath,
-                    combinedPath: combinedPath
+                    combinedPath: combinedPath,
+                    driver: driver
                 )
 
                 logger.debug("Registered existing log paths", metadata: [
@@ -425,8 +482,20 @@ public actor ContainerManager {
             ])
         }
 
+        // Issued concurrently so the updates share group commits instead of one fsync each
+        let finishedAt = Date()
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for id in crashed {
+                group.addTask { [stateStore] in
+                    try await stateStore.updateContainerStatus(id: id, status: "exited", exitCode: 137, finishedAt: finishedAt)
+                }
+            }
+            try await group.waitForAll()
+        }
+
         logger.info("Container state recovery complete", metadata: [
-            "restored": "\(containers.count)"
+            "restored": "\(containers.count)",
+            "crash_recovered": "\(crashed.count)"
         ])
 
         // NOTE: Restart policies are NOT applied here
@@ -437,6 +506,14 @@ public actor ContainerManager {
     /// Apply restart policies to containers on startup
     /// IMPORTANT: Must be called AFTER NetworkManager and VolumeManager are wired up!
     public func applyRestartPolicies() async throws {
+        try await applyRestartPolicies(maxConcurrent: RecoveryPlan.defaultConcurrency())
+    }
+
+    /// Restart containers in dependency waves, up to `maxConcurrent` at a time
+    /// Each wave starts once the previous one has finished, successfully or not. WireGuard
+    /// mesh links between containers of the same wave are configured in one batch after the
+    /// wave; links to containers from earlier waves are configured as each one starts.
+    func applyRestartPolicies(maxConcurrent: Int) async throws {
         logger.info("Applying restart policies...")
 
         let containersToRestart = try await stateStore.getContainersToRestart()
@@ -445,32 +522,98 @@ public actor ContainerManager {
             "count": "\(containersToRestart.count)"
         ])
 
-        for container in containersToRestart {
-            logger.info("Auto-restarting container", metadata: [
-                "id": "\(container.id)",
-                "name": "\(container.name)",
-                "policy": "\(container.policy)",
-                "exitCode": "\(container.exitCode)"
+        let current = containers
+        let plan = RecoveryPlan(containersToRestart.map { container in
+            RecoveryPlan.Member(
+                id: container.id,
+                labels: current[container.id]?.labels ?? [:],
+                networkIDs: current[container.id]?.networkIDs ?? []
+            )
+        })
+        if !plan.cyclic.isEmpty {
+            logger.warning("Container dependencies form a cycle; restarting those containers last", metadata: [
+                "containers": "\(plan.cyclic.map { String($0.prefix(12)) })"
             ])
+        }
 
-            do {
-                try await startContainer(id: container.id)
-                logger.info("Container auto-restarted successfully", metadata: [
-                    "id": "\(container.id)"
-                ])
-            } catch {
-                logger.error("Failed to auto-restart container", metadata: [
-                    "id": "\(container.id)",
-                    "error": "\(error)"
-                ])
+        let limit = max(maxConcurrent, 1)
+        recovery.begin(total: containersToRestart.count)
+        logger.info("Restart plan", metadata: [
+            "containers": "\(containersToRestart.count)",
+            "waves": "\(plan.waves.count)",
+            "concurrency": "\(limit)"
+        ])
+
+        let byID = Dictionary(containersToRestart.map { ($0.id, $0) }, uniquingKeysWith: { first, _ in first })
+        for (index, wave) in plan.waves.enumerated() {
+            await networkManager?.beginMeshBatch(containerIDs: Set(wave))
+
+            await withTaskGroup(of: Void.self) { group in
+                var next = 0
+                func addNext() {
+                    guard next < wave.count, let container = byID[wave[next]] else { return }
+                    next += 1
+                    group.addTask { await self.autoRestart(container) }
+                }
+
+                for _ in 0..<min(limit, wave.count) {
+                    addNext()
+                }
+                while await group.next() != nil {
+                    addNext()
+                }
             }
+
+            await networkManager?.finishMeshBatch()
+
+            let progress = recovery.progress
+            logger.info("Restart wave complete", metadata: [
+                "wave": "\(index + 1)/\(plan.waves.count)",
+                "started": "\(progress.started)",
+                "failed": "\(progress.failed)",
+                "pending": "\(progress.pending)"
+            ])
         }
 
+        recovery.finish()
+        let progress = recovery.progress
         logger.info("Restart policy application complete", metadata: [
-            "restarted": "\(containersToRestart.count)"
+            "restarted": "\(progress.started)",
+            "failed": "\(progress.failed)"
         ])
     }
 
+    /// Start one container for its restart policy and record the outcome
+    private func autoRestart(_ container: (id: String, name: String, policy: String, exitCode: Int)) async {
+        logger.info("Auto-restarting container", metadata: [
+            "id": "\(container.id)",
+            "name": "\(container.name)",
+            "policy": "\(container.policy)",
+            "exitCode": "\(container.exitCode)"
+        ])
+
+        do {
+            try await startContainer(id: container.id)
+            recovery.record(success: true)
+            let progress = recovery.progress
+            logger.info("Container auto-restarted successfully", metadata: [
+                "id": "\(container.id)",
+                "progress": "\(progress.total - progress.pending)/\(progress.total)"
+            ])
+        } catch {
+            recovery.record(success: false)
+            logger.error("Failed to auto-restart container", metadata: [
+                "id": "\(container.id)",
+                "error": "\(error)"
+            ])
+        }
+    }
+
+    /// Progress of the startup restarts, for readiness reporting
+    nonisolated public var recoveryProgress: RecoveryProgress {
+        recovery.progress
+    }
+
     // MARK: - Graceful Shutdown
 
     /// Gracefully shutdown ContainerManager
@@ -500,11 +643,20 @@ public actor ContainerManager {
         logger.debug("Waiting for cleanup operations to complete...")
         try? await Task.sleep(nanoseconds: 200_000_000)  // 200ms
 
+        await portMapManager?.shutdown()
+
         logger.info("ContainerManager graceful shutdown complete", metadata: [
             "tasks_cancelled": "\(taskCount)"
         ])
     }
 
+    /// Containers whose VM is booted (created or running, not yet exited)
+    public var liveVMCount: Int {
+        nativeContainers.keys.reduce(0) { count, dockerID in
+            containers[dockerID]?.state == "exited" ? count : count + 1
+        }
+    }
+
     // MARK: - Platform Detection
 
     /// Detect the current system platform
@@ -516,10 +668,32 @@ public actor ContainerManager {
         #endif
     }
 
+    // MARK: - Layer Cache
+
+    /// Layer digests of the images used by existing containers or creates in progress
+    /// (protected from cache eviction)
+    private func layerDigestsInUse() async -> Set<String> {
+        let platform = detectSystemPlatform().ociPlatform()
+        var digests: Set<String> = []
+        let images = Set(registry.entries.values.map { $0.image }).union(imagesBeingCreated.keys)
+        for imageRef in images {
+            guard let image = try? await imageManager.getImage(nameOrId: imageRef),
+                  let manifest = try? await image.manifest(for: platform) else {
+                continue
+            }
+            digests.formUnion(manifest.layers.map { $0.digest })
+        }
+        return digests
+    }
+
     // MARK: - Container Lifecycle
 
     /// List all containers
-    public func listContainers(all: Bool = false, filters: [String: [String]] = [:]) async throws -> [ContainerSummary] {
+    /// Served from the registry snapshot, so it never waits on lifecycle work in the actor
+    ///
+    /// Filters backed by a registry index (state, status, label, network, ancestor, health)
+    /// narrow the candidate set first; the rest are then checked on the survivors only.
+    nonisolated public func listContainers(all: Bool = false, filters: [String: [String]] = [:]) async throws -> [ContainerSummary] {
         logger.debug("Listing containers", metadata: [
             "all": "\(all)",
             "filters": "\(filters)"
@@ -529,111 +703,111 @@ public actor ContainerManager {
         // By default, internal containers (com.arca.internal=true) are hidden
         let showInternal = filters["label"]?.contains(where: { $0.contains("com.arca.internal") }) ?? false
 
-        // Extract label filters for matching
-        let labelFilters = filters["label"] ?? []
+        let snapshot = registry.snapshot
+        let containers = snapshot.entries
 
-        // Pre-fetch health statuses if health filter is present
-        var healthStatuses: [String: String] = [:]
-        if let healthFilters = filters["health"], !healthFilters.isEmpty, let healthChecker = healthChecker {
-            // Fetch health status for all containers
-            for (dockerID, _) in containers {
-                if let health = await healthChecker.getStatus(containerID: dockerID) {
-                    healthStatuses[dockerID] = health.status
-                }
+        // Intersect the index lookups; nil means no indexed filter applied yet
+        var candidates: Set<String>?
+        func narrow(_ ids: Set<String>) {
+            candidates = candidates.map { $0.intersection(ids) } ?? ids
+        }
+
+        if !all {
+            narrow(snapshot.byState["running"] ?? [])
+        }
+
+        // Status filter (match container state)
+        if let statusFilters = filters["status"], !statusFilters.isEmpty {
+            narrow(statusFilters.reduce(into: Set<String>()) { ids, status in
+                ids.formUnion(snapshot.byState[status.lowercased()] ?? [])
+            })
+        }
+
+        // Label filters: each is "key" (label exists) or "key=value" (exact match), all must hold
+        for labelFilter in filters["label"] ?? [] {
+            if labelFilter.contains("=") {
+                let parts = labelFilter.split(separator: "=", maxSplits: 1)
+                let value = parts.count > 1 ? String(parts[1]) : ""
+                narrow(snapshot.labelled(String(parts[0]), value: value))
+            } else {
+                narrow(snapshot.labelled(labelFilter))
             }
         }
 
-        // List containers from our internal state tracking
-        // Background monitoring tasks automatically update state when containers exit
-        return containers.values.compactMap { info -> ContainerSummary? in
-            // Filter by state if not showing all
-            if !all && info.state != "running" {
-                return nil
+        // Network filter (attached network ID, exact or prefix)
+        if let networkFilters = filters["network"], !networkFilters.isEmpty {
+            var ids = Set<String>()
+            for (networkID, members) in snapshot.byNetwork
+            where networkFilters.contains(where: { networkID == $0 || networkID.hasPrefix($0) }) {
+                ids.formUnion(members)
             }
+            narrow(ids)
+        }
 
-            // Filter out internal containers unless explicitly requested
-            if !showInternal && info.labels["com.arca.internal"] == "true" {
-                return nil
+        // Ancestor filter (image reference, or image ID exact or prefix)
+        if let ancestorFilters = filters["ancestor"], !ancestorFilters.isEmpty {
+            var ids = Set<String>()
+            for filterAncestor in ancestorFilters {
+                ids.formUnion(snapshot.byImage[filterAncestor] ?? [])
             }
+            for (imageID, members) in snapshot.byImageID
+            where ancestorFilters.contains(where: { imageID.hasPrefix($0) }) {
+                ids.formUnion(members)
+            }
+            narrow(ids)
+        }
 
-            // Apply label filters
-            // Each filter can be "key" (label exists) or "key=value" (exact match)
-            if !labelFilters.isEmpty {
-                let matchesAllLabels = labelFilters.allSatisfy { labelFilter in
-                    if labelFilter.contains("=") {
-                        // Exact match: "key=value"
-                        let parts = labelFilter.split(separator: "=", maxSplits: 1)
-                        let key = String(parts[0])
-                        let value = parts.count > 1 ? String(parts[1]) : ""
-                        return info.labels[key] == value
-                    } else {
-                        // Existence check: "key"
-                        return info.labels[labelFilter] != nil
-                    }
-                }
+        // Health filter, from the status HealthChecker last pushed ("none" when never checked)
+        if let healthFilters = filters["health"], !healthFilters.isEmpty {
+            let wanted = Set(healthFilters.map { $0.lowercased() })
+            var ids = Set<String>()
+            for status in wanted {
+                ids.formUnion(snapshot.byHealth[status] ?? [])
+            }
+            if wanted.contains("none") {
+                ids.formUnion(containers.keys.lazy.filter { snapshot.health[$0] == nil })
+            }
+            narrow(ids)
+        }
 
-                if !matchesAllLabels {
-                    return nil
-                }
+        // Remaining filters are checked per candidate
+        let nameFilters = filters["name"] ?? []
+        let idFilters = filters["id"] ?? []
+        let volumeFilters = filters["volume"] ?? []
+        let exitedFilters = filters["exited"] ?? []
+        let before = filters["before"]?.first.flatMap { containers[$0] }
+        let since = filters["since"]?.first.flatMap { containers[$0] }
+
+        let selected: [(key: String, value: ContainerInfo)]
+        if let candidates = candidates {
+            selected = candidates.compactMap { dockerID in
+                containers[dockerID].map { (key: dockerID, value: $0) }
             }
+        } else {
+            selected = Array(containers)
+        }
 
-            // Get the docker ID for this container (needed for some filters below)
-            guard let dockerID = reverseMapping[info.nativeID] else {
-                logger.error("BUG: Container has invalid nativeID mapping", metadata: [
-                    "native_id": "\(info.nativeID)",
-                    "name": "\(info.name ?? "unknown")",
-                    "state": "\(info.state)",
-                    "reverse_mapping_keys": "\(reverseMapping.keys.sorted())"
-                ])
+        return selected.compactMap { dockerID, info -> ContainerSummary? in
+            // Filter out internal containers unless explicitly requested
+            if !showInternal && info.labels["com.arca.internal"] == "true" {
                 return nil
             }
 
             // Apply name filter (partial match on container name)
-            if let nameFilters = filters["name"], !nameFilters.isEmpty {
+            if !nameFilters.isEmpty {
                 let containerName = info.name ?? ""
-                let matchesName = nameFilters.contains { filterName in
-                    containerName.contains(filterName)
-                }
-                if !matchesName {
+                if !nameFilters.contains(where: { containerName.contains($0) }) {
                     return nil
                 }
             }
 
             // Apply id filter (exact or prefix match on container ID)
-            if let idFilters = filters["id"], !idFilters.isEmpty {
-                let matchesID = idFilters.contains { filterId in
-                    dockerID.hasPrefix(filterId) || dockerID == filterId
-                }
-                if !matchesID {
-                    return nil
-                }
-            }
-
-            // Apply status filter (match container state)
-            if let statusFilters = filters["status"], !statusFilters.isEmpty {
-                let matchesStatus = statusFilters.contains { filterStatus in
-                    info.state.lowercased() == filterStatus.lowercased()
-                }
-                if !matchesStatus {
-                    return nil
-                }
-            }
-
-            // Apply network filter (check if container is on specific network)
-            if let networkFilters = filters["network"], !networkFilters.isEmpty {
-                let matchesNetwork = networkFilters.contains { filterNetwork in
-                    // Check if container is attached to this network (by ID or name)
-                    info.networkAttachments.contains { networkID, _ in
-                        networkID == filterNetwork || networkID.hasPrefix(filterNetwork)
-                    }
-                }
-                if !matchesNetwork {
-                    return nil
-                }
+            if !idFilters.isEmpty, !idFilters.contains(where: { dockerID.hasPrefix($0) }) {
+                return nil
             }
 
             // Apply volume filter (check if container has specific volume/mount)
-            if let volumeFilters = filters["volume"], !volumeFilters.isEmpty {
+            if !volumeFilters.isEmpty {
                 let matchesVolume = volumeFilters.contains { filterVolume in
                     // Check if any bind matches the volume name or mount point
                     info.hostConfig.binds.contains { bind in
@@ -652,70 +826,22 @@ public actor ContainerManager {
                 }
             }
 
-            // Apply ancestor filter (match imageID)
-            if let ancestorFilters = filters["ancestor"], !ancestorFilters.isEmpty {
-                let matchesAncestor = ancestorFilters.contains { filterAncestor in
-                    // Match against image name or imageID
-                    info.image == filterAncestor ||
-                    info.imageID == filterAncestor ||
-                    info.imageID.hasPrefix(filterAncestor)
-                }
-                if !matchesAncestor {
-                    return nil
-                }
-            }
-
             // Apply exited filter (match exit code for exited containers)
-            if let exitedFilters = filters["exited"], !exitedFilters.isEmpty {
-                if info.state == "exited" {
-                    let matchesExitCode = exitedFilters.contains { filterExitCode in
-                        if let exitCodeInt = Int(filterExitCode) {
-                            return info.exitCode == exitCodeInt
-                        }
-                        return false
-                    }
-                    if !matchesExitCode {
-                        return nil
-                    }
-                } else {
-                    // Container is not exited, so it doesn't match the exited filter
-                    return nil
-                }
-            }
-
-            // Apply health filter (match health status)
-            if let healthFilters = filters["health"], !healthFilters.isEmpty {
-                // Get current health status (pre-fetched or default to "none")
-                let currentHealth = healthStatuses[dockerID] ?? "none"
-
-                // Match against filter values (case-insensitive)
-                let matches = healthFilters.contains { filter in
-                    filter.lowercased() == currentHealth.lowercased()
-                }
-
-                if !matches {
+            if !exitedFilters.isEmpty {
+                guard info.state == "exited",
+                      exitedFilters.contains(where: { Int($0) == info.exitCode }) else {
                     return nil
                 }
             }
 
             // Apply before filter (created before specified container)
-            if let beforeFilters = filters["before"], !beforeFilters.isEmpty {
-                if let beforeContainerID = beforeFilters.first,
-                   let beforeContainer = containers.values.first(where: { reverseMapping[$0.nativeID] == beforeContainerID }) {
-                    if info.created >= beforeContainer.created {
-                        return nil
-                    }
-                }
+            if let before = before, info.created >= before.created {
+                return nil
             }
 
             // Apply since filter (created after specified container)
-            if let sinceFilters = filters["since"], !sinceFilters.isEmpty {
-                if let sinceContainerID = sinceFilters.first,
-                   let sinceContainer = containers.values.first(where: { reverseMapping[$0.nativeID] == sinceContainerID }) {
-                    if info.created <= sinceContainer.created {
-                        return nil
-                    }
-                }
+            if let since = since, info.created <= since.created {
+                return nil
             }
 
             return ContainerSummary(
@@ -729,30 +855,51 @@ public actor ContainerManager {
                 state: info.state,
                 status: formatStatusFromState(info),
                 ports: info.ports,
-                labels: info.labels
+                labels: info.labels,
+                generation: snapshot.generations[dockerID] ?? 0
             )
         }
     }
 
+    /// Generation of a container's last change (state, config or health)
+    /// Anything derived from the container, such as its encoded inspect response, stays valid
+    /// while this is unchanged.
+    /// - Returns: The resolved Docker ID and its generation, nil if no such container
+    nonisolated public func containerGeneration(id: String) -> (dockerID: String, generation: UInt64)? {
+        let snapshot = registry.snapshot
+        guard let dockerID = resolve(id, in: snapshot), let generation = snapshot.generations[dockerID] else {
+            return nil
+        }
+        return (dockerID, generation)
+    }
+
+    /// Docker IDs of all known containers, including internal ones
+    nonisolated public var containerIDs: Set<String> {
+        Set(registry.snapshot.entries.keys)
+    }
+
     /// Resolve container ID or name to Docker ID
     /// Handles full IDs, short IDs (min 4 chars), and container names
-    public func resolveContainer(idOrName: String) -> String? {
+    nonisolated public func resolveContainer(idOrName: String) -> String? {
         return resolveContainerID(idOrName)
     }
 
     /// Get a specific container by ID (for inspect)
-    public func getContainer(id: String) async throws -> Container? {
+    /// Reads the registry snapshot; only host-network containers hop onto the actor for their interfaces
+    nonisolated public func getContainer(id: String) async throws -> Container? {
         logger.debug("Getting container", metadata: ["id": "\(id)"])
 
+        let snapshot = registry.snapshot
+
         // Resolve name or ID to Docker ID
-        guard let dockerID = resolveContainer(idOrName: id) else {
+        guard let dockerID = resolve(id, in: snapshot) else {
             logger.warning("Container not found in state", metadata: ["id": "\(id)"])
             return nil
         }
 
         // Look up in our state
         // Background monitoring tasks automatically update state when containers exit
-        guard let info = containers[dockerID] else {
+        guard let info = snapshot.entries[dockerID] else {
             logger.warning("Container not found in state", metadata: ["docker_id": "\(dockerID)"])
             return nil
         }
@@ -789,7 +936,7 @@ public actor ContainerManager {
 
         // For host network (vmnet driver) containers, add network information
         // host network containers use Apple's vmnet framework and don't have networkAttachments
-        if info.hostConfig.networkMode == "host", let nativeContainer = nativeContainers[dockerID] {
+        if info.hostConfig.networkMode == "host", let nativeContainer = await getNativeContainer(id: dockerID) {
             // Get all vmnet interfaces from native container
             // Try to cast each interface to ContainerManager.VmnetNetwork.Interface
             var vmnetIndex = 0
@@ -836,13 +983,8 @@ public actor ContainerManager {
             networks: networks
         )
 
-        // Get health status if health checker is available (Phase 6 - Task 6.2)
-        let health: Health?
-        if let healthChecker = healthChecker {
-            health = await healthChecker.getStatus(containerID: dockerID)
-        } else {
-            health = nil
-        }
+        // Health status as last pushed by HealthChecker (Phase 6 - Task 6.2)
+        let health = snapshot.health[dockerID]
 
         return Container(
             id: dockerID,
@@ -1056,7 +1198,9 @@ public actor ContainerManager {
 
         logger.debug("⏱️ Fetching image config", metadata: ["docker_id": "\(dockerID)"])
         let imageConfigStart = Date()
+        let imageConfigPhase = ContainerPhase.begin("image_config", containerID: dockerID)
         let imageConfig = try await config.image.config(for: imagePlatform)
+        imageConfigPhase.end()
         let imageConfigDuration = Date().timeIntervalSince(imageConfigStart)
         logger.debug("⏱️ Image config fetched", metadata: [
             "docker_id": "\(dockerID)",
@@ -1096,6 +1240,7 @@ public actor ContainerManager {
             // Unpack image using OverlayFS layer cache
             logger.debug("⏱️ Unpacking image with OverlayFS", metadata: ["docker_id": "\(dockerID)"])
             let unpackStart = Date()
+            let unpackPhase = ContainerPhase.begin("layer_unpack", containerID: dockerID)
 
             guard let unpacker = overlayUnpacker else {
                 throw ContainerManagerError.notInitialized
@@ -1107,6 +1252,7 @@ public actor ContainerManager {
                 at: containerPath
             )
 
+            unpackPhase.end()
             let unpackDuration = Date().timeIntervalSince(unpackStart)
             logger.info("⏱️ Image unpacked with OverlayFS", metadata: [
                 "docker_id": "\(dockerID)",
@@ -1121,13 +1267,22 @@ public actor ContainerManager {
         let mounter = OverlayFSMounter(logger: logger)
 
         if !FileManager.default.fileExists(atPath: writablePath.path) {
-            // 64 GB provides sufficient space for build caches and large workloads
+            let writablePhase = ContainerPhase.begin("writable_fs", containerID: dockerID)
             // Thin-provisioned (sparse file) so only actual data consumes disk space
-            try mounter.createWritableFilesystem(at: writablePath.path, sizeMB: 65536)
+            // Cloned from the template; runs off the actor so the first use, which formats
+            // the template, doesn't stall other containers' operations
+            try await Task.detached { [logger, writableTemplates] in
+                try OverlayFSMounter(logger: logger).createWritableFilesystem(
+                    at: writablePath.path,
+                    sizeMB: Self.writableFilesystemSizeMB,
+                    templates: writableTemplates
+                )
+            }.value
             logger.info("Created writable filesystem", metadata: [
                 "docker_id": "\(dockerID)",
                 "path": "\(writablePath.path)"
             ])
+            writablePhase.end()
         } else {
             logger.debug("Writable filesystem already exists", metadata: [
                 "docker_id": "\(dockerID)",
@@ -1186,6 +1341,7 @@ public actor ContainerManager {
             "additional_mounts": "\(additionalMounts.count)"
         ])
         let managerCreateStart = Date()
+        let configurePhase = ContainerPhase.begin("vm_configure", containerID: dockerID)
         let container = try await manager.create(
             dockerID,
             image: config.image,
@@ -1354,12 +1510,11 @@ public actor ContainerManager {
             // The framework uses cgroup v2 for enforcement via Cgroup2Manager
             // Apple requires minimum 512MB, use 4GB default if not specified
             // Memory ballooning means the VM only consumes physical memory as needed up to this limit
-            let defaultMemory: Int64 = 4 * 1024 * 1024 * 1024  // 4GB
             let effectiveMemory: Int64
             if let memory = config.memory, memory > 0 {
                 effectiveMemory = memory
             } else {
-                effectiveMemory = defaultMemory
+                effectiveMemory = VMResources.defaultMemory
             }
             containerConfig.memoryInBytes = UInt64(effectiveMemory)
 
@@ -1372,11 +1527,11 @@ public actor ContainerManager {
             } else {
                 configLogger.debug("Using default memory limit", metadata: [
                     "docker_id": "\(dockerID)",
-                    "memory_mb": "4096"
+                    "memory_mb": "\(VMResources.defaultMemory / 1024 / 1024)"
                 ])
             }
 
-            // Configure memory reservation (soft limit) via OCI LinuxMemory
+            // Memory reservation (soft limit) has no VM-level equivalent; it is recorded only
             if let reservation = config.memoryReservation {
                 configLogger.info("Configured memory reservation", metadata: [
                     "docker_id": "\(dockerID)",
@@ -1402,48 +1557,30 @@ public actor ContainerManager {
             }
 
             // Configure CPU limits (Phase 5 - Task 5.2)
-            // Wire Docker API CPU parameters to Apple's Containerization framework
-            if let nanoCpus = config.nanoCpus {
-                // Convert nanocpus to number of CPUs
-                // nanoCpus is in units of 1e-9 CPUs, so 1 CPU = 1_000_000_000 nanocpus
-                let cpus = Int(nanoCpus / 1_000_000_000)
-                if cpus > 0 {
-                    containerConfig.cpus = cpus
-                    configLogger.info("Configured CPU limit", metadata: [
-                        "docker_id": "\(dockerID)",
-                        "nano_cpus": "\(nanoCpus)",
-                        "cpus": "\(cpus)"
-                    ])
-                }
-            }
-
-            // Log other CPU parameters (not directly supported by containerConfig.cpus)
-            // These would require cgroup configuration via OCI runtime spec
-            if let cpuShares = config.cpuShares {
-                configLogger.info("CPU shares specified (requires cgroup support)", metadata: [
-                    "docker_id": "\(dockerID)",
-                    "cpu_shares": "\(cpuShares)"
-                ])
-            }
-
-            if let cpuPeriod = config.cpuPeriod {
-                configLogger.info("CPU period specified (requires cgroup support)", metadata: [
+            // Each container has its own VM, so --cpus, --cpu-quota/--cpu-period and
+            // --cpuset-cpus all become the VM's vCPU count (the smallest of them)
+            if let cpus = VMResources.vcpuCount(
+                nanoCpus: config.nanoCpus,
+                cpuQuota: config.cpuQuota,
+                cpuPeriod: config.cpuPeriod,
+                cpusetCpus: config.cpusetCpus
+            ) {
+                containerConfig.cpus = cpus
+                configLogger.info("Configured CPU limit", metadata: [
                     "docker_id": "\(dockerID)",
-                    "cpu_period": "\(cpuPeriod)"
+                    "nano_cpus": "\(config.nanoCpus ?? 0)",
+                    "cpu_quota": "\(config.cpuQuota ?? 0)",
+                    "cpu_period": "\(config.cpuPeriod ?? 0)",
+                    "cpuset_cpus": "\(config.cpusetCpus ?? "")",
+                    "cpus": "\(cpus)"
                 ])
             }
 
-            if let cpuQuota = config.cpuQuota {
-                configLogger.info("CPU quota specified (requires cgroup support)", metadata: [
-                    "docker_id": "\(dockerID)",
-                    "cpu_quota": "\(cpuQuota)"
-                ])
-            }
-
-            if let cpusetCpus = config.cpusetCpus {
-                configLogger.info("CPUset CPUs specified (requires cgroup support)", metadata: [
+            // CPU shares are relative weights inside a shared cgroup tree; each VM has its own
+            if let cpuShares = config.cpuShares {
+                configLogger.info("CPU shares specified (not applied, no shared cgroup between VMs)", metadata: [
                     "docker_id": "\(dockerID)",
-                    "cpuset_cpus": "\(cpusetCpus)"
+                    "cpu_shares": "\(cpuShares)"
                 ])
             }
 
@@ -1496,6 +1633,7 @@ public actor ContainerManager {
             ])
         }
 
+        configurePhase.end()
         let managerCreateDuration = Date().timeIntervalSince(managerCreateStart)
         logger.debug("⏱️ manager.create() completed", metadata: [
             "docker_id": "\(dockerID)",
@@ -1507,7 +1645,9 @@ public actor ContainerManager {
             "docker_id": "\(dockerID)"
         ])
         let containerCreateStart = Date()
+        let createPhase = ContainerPhase.begin("vm_create", containerID: dockerID)
         try await container.create()
+        createPhase.end()
         let containerCreateDuration = Date().timeIntervalSince(containerCreateStart)
         logger.info("Container VM created successfully", metadata: [
             "docker_id": "\(dockerID)",
@@ -1631,6 +1771,11 @@ public actor ContainerManager {
         // Get the image from ImageStore (no auto-pull - let Docker CLI handle it)
         logger.debug("Retrieving image", metadata: ["image": "\(image)"])
         let containerImage = try await imageManager.getImage(nameOrId: image)
+        imagesBeingCreated[image, default: 0] += 1
+        defer {
+            let count = imagesBeingCreated[image] ?? 1
+            imagesBeingCreated[image] = count > 1 ? count - 1 : nil
+        }
 
         // Get image details for metadata and default command
         let imageDetails = try await imageManager.inspectImage(nameOrId: image)
@@ -1657,15 +1802,15 @@ public actor ContainerManager {
 
         // Create log writers for capturing stdout/stderr
         logger.debug("Creating log writers", metadata: ["docker_id": "\(dockerID)"])
-        let (stdoutLogWriter, stderrLogWriter): (FileLogWriter, FileLogWriter)
+        let (stdoutLogWriter, stderrLogWriter): (Writer, Writer)
         let (stdoutBroadcast, stderrBroadcast): (BroadcastWriter, BroadcastWriter)
         do {
             (stdoutLogWriter, stderrLogWriter) = try logManager.createLogWriters(dockerID: dockerID)
             logWriters[dockerID] = (stdoutLogWriter, stderrLogWriter)
 
             // Wrap log writers in broadcast writers to support dynamic attach
-            stdoutBroadcast = BroadcastWriter(initialSubscribers: [stdoutLogWriter])
-            stderrBroadcast = BroadcastWriter(initialSubscribers: [stderrLogWriter])
+            stdoutBroadcast = BroadcastWriter(initialSubscribers: [stdoutLogWriter], stream: .stdout, config: outputBufferConfig)
+            stderrBroadcast = BroadcastWriter(initialSubscribers: [stderrLogWriter], stream: .stderr, config: outputBufferConfig)
             broadcastWriters[dockerID] = (stdoutBroadcast, stderrBroadcast)
         } catch {
             logger.error("Failed to create log writers", metadata: [
@@ -1890,7 +2035,7 @@ public actor ContainerManager {
             initialNetworkAliases: initialNetworkAliases  // Aliases for initial network (from Docker Compose)
         )
 
-        containers[dockerID] = containerInfo
+        registry.update(dockerID, with: containerInfo)
 
         // Persist container state
         try await persistContainerState(dockerID: dockerID, info: containerInfo)
@@ -1931,41 +2076,18 @@ public actor ContainerManager {
     /// - Full 64-char Docker IDs
     /// - Short IDs (minimum 4 chars, prefix matching)
     /// - Container names (with or without "/" prefix)
-    public func resolveContainerID(_ nameOrID: String) -> String? {
-        // First try direct ID lookup (full 64-char ID)
-        if containers[nameOrID] != nil {
-            return nameOrID
-        }
-
-        // Try short ID prefix matching (4-64 chars)
-        if nameOrID.count >= 4 && nameOrID.count < 64 {
-            // Check if it's a valid hex string
-            let hexCharset = CharacterSet(charactersIn: "0123456789abcdefABCDEF")
-            if nameOrID.unicodeScalars.allSatisfy({ hexCharset.contains($0) }) {
-                // Find containers with IDs that start with this prefix
-                let matches = containers.keys.filter { $0.hasPrefix(nameOrID.lowercased()) }
-
-                if matches.count == 1 {
-                    return matches.first
-                } else if matches.count > 1 {
-                    // Multiple matches - return first (Docker behavior)
-                    logger.warning("Multiple containers match short ID", metadata: [
-                        "short_id": "\(nameOrID)",
-                        "matches": "\(matches.count)"
-                    ])
-                    return matches.sorted().first
-                }
-            }
-        }
+    nonisolated public func resolveContainerID(_ nameOrID: String) -> String? {
+        resolve(nameOrID, in: registry.snapshot)
+    }
 
-        // Then try name lookup
-        for (id, info) in containers {
-            if info.name == nameOrID || info.name == "/\(nameOrID)" {
-                return id
-            }
+    /// Resolve against one snapshot so a caller's lookup and subsequent reads agree
+    private nonisolated func resolve(_ nameOrID: String, in snapshot: ContainerRegistry<ContainerInfo>.Snapshot) -> String? {
+        snapshot.resolve(nameOrID) { matches in
+            logger.warning("Multiple containers match short ID", metadata: [
+                "short_id": "\(nameOrID)",
+                "matches": "\(matches)"
+            ])
         }
-
-        return nil
     }
 
     // MARK: - Container Attach Support
@@ -1983,6 +2105,30 @@ public actor ContainerManager {
         return pendingAttaches.removeValue(forKey: containerID)
     }
 
+    /// Get or create the log writers and broadcast writers for a container
+    /// Containers restored after a daemon restart have neither until they are started or followed
+    private func ensureBroadcastWriters(dockerID: String) throws -> (BroadcastWriter, BroadcastWriter) {
+        if let existing = broadcastWriters[dockerID] {
+            return existing
+        }
+
+        let (stdoutLogWriter, stderrLogWriter): (Writer, Writer)
+        if let existing = logWriters[dockerID] {
+            (stdoutLogWriter, stderrLogWriter) = existing
+        } else {
+            let writers = try logManager.createLogWriters(dockerID: dockerID)
+            logWriters[dockerID] = writers
+            (stdoutLogWriter, stderrLogWriter) = writers
+        }
+
+        let broadcasts = (
+            BroadcastWriter(initialSubscribers: [stdoutLogWriter], stream: .stdout, config: outputBufferConfig),
+            BroadcastWriter(initialSubscribers: [stderrLogWriter], stream: .stderr, config: outputBufferConfig)
+        )
+        broadcastWriters[dockerID] = broadcasts
+        return broadcasts
+    }
+
     /// Subscribe attach handles to broadcast writers for a running/created container
     /// This allows dynamic attachment without recreating the container
     private func subscribeAttachToBroadcast(containerID: String, handles: AttachHandles) throws {
@@ -2152,26 +2298,8 @@ public actor ContainerManager {
                 ])
                 let containerImage = try await imageManager.getImage(nameOrId: info.image)
 
-                // Get log writers (create if they don't exist yet)
-                let (stdoutLogWriter, stderrLogWriter): (FileLogWriter, FileLogWriter)
-                let (stdoutBroadcast, stderrBroadcast): (BroadcastWriter, BroadcastWriter)
-
-                if let existing = logWriters[dockerID] {
-                    (stdoutLogWriter, stderrLogWriter) = existing
-                } else {
-                    let writers = try logManager.createLogWriters(dockerID: dockerID)
-                    logWriters[dockerID] = writers
-                    (stdoutLogWriter, stderrLogWriter) = writers
-                }
-
-                // Get or create broadcast writers
-                if let existing = broadcastWriters[dockerID] {
-                    (stdoutBroadcast, stderrBroadcast) = existing
-                } else {
-                    stdoutBroadcast = BroadcastWriter(initialSubscribers: [stdoutLogWriter])
-                    stderrBroadcast = BroadcastWriter(initialSubscribers: [stderrLogWriter])
-                    broadcastWriters[dockerID] = (stdoutBroadcast, stderrBroadcast)
-                }
+                // Get log writers and broadcast writers (create if they don't exist yet)
+                let (stdoutBroadcast, stderrBroadcast) = try ensureBroadcastWriters(dockerID: dockerID)
 
                 // Parse volume mounts from persisted binds (includes both bind mounts and named volumes)
                 let recreatedMounts = try await parseVolumeMounts(info.hostConfig.binds, dockerID: dockerID)
@@ -2251,12 +2379,15 @@ public actor ContainerManager {
 
         // Wait for arca-services to signal all services are ready (port 51819)
         // dialVsock works in .created state, so we can do this before start()
+        let servicesPhase = ContainerPhase.begin("services_ready", containerID: dockerID)
         try await waitForServicesReady(container: nativeContainer, dockerID: dockerID)
+        servicesPhase.end()
 
         // Create FilesystemClient for container filesystem operations (diff, archive)
         let filesystemClient = FilesystemClient(
             containerID: dockerID,
             container: nativeContainer,
+            channelPool: controlChannels(dockerID: dockerID, container: nativeContainer),
             logger: logger
         )
         filesystemClients[dockerID] = filesystemClient
@@ -2280,6 +2411,8 @@ public actor ContainerManager {
             "networkMode": "\(info.hostConfig.networkMode)"
         ])
 
+        let networkPhase = ContainerPhase.begin("network_attach", containerID: dockerID)
+
         // Auto-attach to network based on networkMode if no networks are attached
         // Docker CLI sets networkMode in HostConfig and expects the daemon to handle attachment
         if let networkManager = networkManager,
@@ -2424,6 +2557,7 @@ public actor ContainerManager {
         for networkID in info.networkAttachments.keys {
             await pushDNSTopologyToNetwork(networkID: networkID)
         }
+        networkPhase.end()
 
         // Publish ports if configured (Phase 4.1)
         if let portMapManager = portMapManager,
@@ -2453,6 +2587,7 @@ public actor ContainerManager {
                     let overlayIP = updatedInfo.networkAttachments.values.first?.ip ?? ""
 
                     // Publish all port mappings
+                    let publishPhase = ContainerPhase.begin("port_publish", containerID: dockerID)
                     try await portMapManager.publishPorts(
                         containerID: dockerID,
                         vmnetIP: vmnetIP,
@@ -2460,6 +2595,7 @@ public actor ContainerManager {
                         portBindings: info.hostConfig.portBindings,
                         wireguardClient: wireguardClient
                     )
+                    publishPhase.end()
 
                     logger.info("Published port mappings for container", metadata: [
                         "container": "\(dockerID)",
@@ -2479,7 +2615,9 @@ public actor ContainerManager {
         // START CONTAINER - Network namespace already exists from AddNetwork above
         // vmexec will join the pre-existing namespace immediately, no waiting needed
         // ===================================================================================
+        let startPhase = ContainerPhase.begin("vm_start", containerID: dockerID)
         try await nativeContainer.start()
+        startPhase.end()
 
         // ===================================================================================
         // ALL SETUP COMPLETE - Now safe to mark container as "running"
@@ -2488,7 +2626,7 @@ public actor ContainerManager {
         info.state = "running"
         info.startedAt = Date()
         info.pid = 1  // Containers run as PID 1 in their VM
-        containers[dockerID] = info
+        registry.update(dockerID, with: info)
 
         // Persist state change
         try await persistContainerState(dockerID: dockerID, info: info)
@@ -2701,7 +2839,9 @@ public actor ContainerManager {
         info.finishedAt = Date()
         info.exitCode = 0
         info.pid = 0
-        containers[dockerID] = info
+        registry.update(dockerID, with: info)
+        finishLogFollowers(dockerID: dockerID)
+        await closeControlChannels(dockerID: dockerID)
 
         // Persist state change (mark as stopped by user)
         try await persistContainerState(dockerID: dockerID, info: info, stoppedByUser: true)
@@ -2853,7 +2993,7 @@ public actor ContainerManager {
 
     /// Get container statistics
     public func getContainerStats(id: String) async throws -> Containerization.ContainerStatistics {
-        logger.info("Getting container statistics", metadata: ["id": "\(id)"])
+        logger.debug("Getting container statistics", metadata: ["id": "\(id)"])
 
         // Resolve name or ID to Docker ID
         guard let dockerID = resolveContainerID(id) else {
@@ -2905,14 +3045,14 @@ public actor ContainerManager {
         // Update in-memory state
         var updatedInfo = info
         updatedInfo.name = newName
-        containers[dockerID] = updatedInfo
+        registry.update(dockerID, with: updatedInfo)
 
         // Update database (will throw if name already exists due to UNIQUE constraint)
         do {
             try await stateStore.updateContainerName(id: dockerID, newName: newName)
         } catch {
             // Rollback in-memory change
-            containers[dockerID] = info
+            registry.update(dockerID, with: info)
             throw ContainerManagerError.invalidConfiguration("Name '\(newName)' is already in use")
         }
 
@@ -3096,7 +3236,10 @@ public actor ContainerManager {
             reverseMapping.removeValue(forKey: nativeID)
         }
         idMapping.removeValue(forKey: dockerID)
-        containers.removeValue(forKey: dockerID)
+        registry.remove(dockerID)
+        finishLogFollowers(dockerID: dockerID)
+        await closeControlChannels(dockerID: dockerID)
+        await removalObserver?(dockerID)
 
         // Clean up volumes before deleting container
         await cleanupVolumesForContainer(dockerID: dockerID)
@@ -3177,7 +3320,9 @@ public actor ContainerManager {
         info.exitCode = Int(exitStatus.exitCode)
         info.finishedAt = Date()
         info.pid = 0
-        containers[dockerID] = info
+        registry.update(dockerID, with: info)
+        finishLogFollowers(dockerID: dockerID)
+        await closeControlChannels(dockerID: dockerID)
 
         // Persist container state (not stopped by user - this was a natural exit from wait)
         try await persistContainerState(dockerID: dockerID, info: info, stoppedByUser: false)
@@ -3307,7 +3452,7 @@ public actor ContainerManager {
 
         // Update container info with new HostConfig
         info.hostConfig = updatedHostConfig
-        containers[dockerID] = info
+        registry.update(dockerID, with: info)
 
         // Persist the updated configuration to database
         try await persistContainerState(dockerID: dockerID, info: info, stoppedByUser: false)
@@ -3343,7 +3488,9 @@ public actor ContainerManager {
         containerInfo.exitCode = exitCode
         containerInfo.finishedAt = Date()
         containerInfo.pid = 0
-        containers[dockerID] = containerInfo
+        registry.update(dockerID, with: containerInfo)
+        finishLogFollowers(dockerID: dockerID)
+        await closeControlChannels(dockerID: dockerID)
 
         // Clean up in-memory network state (TAP devices are auto-cleaned by VM shutdown)
         if let networkManager = networkManager {
@@ -3493,7 +3640,7 @@ public actor ContainerManager {
             aliases: aliases
         )
         containerInfo.networkAttachments[networkID] = attachment
-        containers[dockerID] = containerInfo
+        registry.update(dockerID, with: containerInfo)
 
         // Persist network attachment
         try await stateStore.saveNetworkAttachment(
@@ -3536,7 +3683,7 @@ public actor ContainerManager {
 
         // Remove network attachment
         containerInfo.networkAttachments.removeValue(forKey: networkID)
-        containers[dockerID] = containerInfo
+        registry.update(dockerID, with: containerInfo)
 
         // Persist network detachment
         try await stateStore.deleteNetworkAttachment(
@@ -3561,48 +3708,50 @@ public actor ContainerManager {
     }
 
     /// Get network attachments for a container
-    public func getNetworkAttachments(dockerID: String) async -> [String: NetworkAttachment] {
-        return containers[dockerID]?.networkAttachments ?? [:]
+    nonisolated public func getNetworkAttachments(dockerID: String) async -> [String: NetworkAttachment] {
+        return registry.entries[dockerID]?.networkAttachments ?? [:]
     }
 
     /// Get container name by Docker ID
-    public func getContainerName(dockerID: String) async -> String? {
-        return containers[dockerID]?.name
+    nonisolated public func getContainerName(dockerID: String) async -> String? {
+        return registry.entries[dockerID]?.name
     }
 
     /// Get container network mode by Docker ID
-    public func getContainerNetworkMode(dockerID: String) async -> String? {
-        return containers[dockerID]?.hostConfig.networkMode
+    nonisolated public func getContainerNetworkMode(dockerID: String) async -> String? {
+        return registry.entries[dockerID]?.hostConfig.networkMode
     }
 
     // MARK: - Helpers for ExecManager
 
     /// Get container state by ID (for checking if container is running)
-    public func getContainerState(id: String) async -> String? {
-        guard let dockerID = resolveContainerID(id) else {
+    nonisolated public func getContainerState(id: String) async -> String? {
+        let snapshot = registry.snapshot
+        guard let dockerID = resolve(id, in: snapshot) else {
             return nil
         }
-        return containers[dockerID]?.state
+        return snapshot.entries[dockerID]?.state
     }
 
     /// Get container TTY flag by ID (for attach/exec stream multiplexing)
-    public func getContainerTTY(id: String) async -> Bool? {
-        guard let dockerID = resolveContainerID(id) else {
+    nonisolated public func getContainerTTY(id: String) async -> Bool? {
+        let snapshot = registry.snapshot
+        guard let dockerID = resolve(id, in: snapshot) else {
             return nil
         }
-        return containers[dockerID]?.tty
+        return snapshot.entries[dockerID]?.tty
     }
 
     /// Check if container is running (for log streaming)
-    public func isContainerRunning(dockerID: String) async -> Bool {
-        return containers[dockerID]?.state == "running"
+    nonisolated public func isContainerRunning(dockerID: String) async -> Bool {
+        return registry.entries[dockerID]?.state == "running"
     }
 
     /// Check if container should continue streaming logs
     /// Returns true for non-terminal states (created, running, restarting, paused)
     /// Returns false for terminal states (exited, dead, removing) or if container doesn't exist
-    public func shouldStreamLogs(dockerID: String) async -> Bool {
-        guard let state = containers[dockerID]?.state else {
+    nonisolated public func shouldStreamLogs(dockerID: String) async -> Bool {
+        guard let state = registry.entries[dockerID]?.state else {
             return false  // Container doesn't exist
         }
 
@@ -3618,6 +3767,64 @@ public actor ContainerManager {
         }
     }
 
+    /// Subscribe to a container's live stdout/stderr for `docker logs -f`
+    /// Returns nil when there is nothing to follow (container gone or already stopped).
+    /// The follower's stream ends when the container stops or is removed; callers that stop
+    /// early must call `stopFollowingLogs` to unsubscribe. Replay history only up to the
+    /// follower's `replayEnds`, which are taken after subscribing so no output falls between.
+    public func followLogs(dockerID: String) async -> LogFollower? {
+        guard await shouldStreamLogs(dockerID: dockerID),
+              let (stdoutBroadcast, stderrBroadcast) = try? ensureBroadcastWriters(dockerID: dockerID) else {
+            return nil
+        }
+
+        let follower = LogFollower(policy: stdoutBroadcast.policy, maxBytes: stdoutBroadcast.bufferBytes)
+        stdoutBroadcast.addFollower(follower)
+        stderrBroadcast.addFollower(follower)
+
+        var logs: [LogStream: LogPositionWriter] = [:]
+        logs[.stdout] = stdoutBroadcast.logWriter
+        logs[.stderr] = stderrBroadcast.logWriter
+        follower.start(replayEnds: logs.mapValues { $0.committedEnd() }, logs: logs)
+        logFollowers[dockerID, default: [:]][follower.id] = follower
+
+        logger.debug("Log follower subscribed", metadata: [
+            "docker_id": "\(dockerID)",
+            "followers": "\(logFollowers[dockerID]?.count ?? 0)"
+        ])
+        return follower
+    }
+
+    /// Unsubscribe a log follower (client disconnected or stopped reading)
+    public func stopFollowingLogs(dockerID: String, follower: LogFollower) {
+        if let (stdoutBroadcast, stderrBroadcast) = broadcastWriters[dockerID] {
+            stdoutBroadcast.removeFollower(follower)
+            stderrBroadcast.removeFollower(follower)
+        }
+        logFollowers[dockerID]?.removeValue(forKey: follower.id)
+        if logFollowers[dockerID]?.isEmpty == true {
+            logFollowers.removeValue(forKey: dockerID)
+        }
+        follower.finish()
+    }
+
+    /// End every live log follower of a container (it stopped or was removed)
+    private func finishLogFollowers(dockerID: String) {
+        guard let followers = logFollowers.removeValue(forKey: dockerID) else { return }
+
+        let broadcasts = broadcastWriters[dockerID]
+        for follower in followers.values {
+            broadcasts?.0.removeFollower(follower)
+            broadcasts?.1.removeFollower(follower)
+            follower.finish()
+        }
+
+        logger.debug("Finished log followers", metadata: [
+            "docker_id": "\(dockerID)",
+            "followers": "\(followers.count)"
+        ])
+    }
+
     /// Get native container instance by ID (for exec operations)
     public func getNativeContainer(id: String) async -> LinuxContainer? {
         guard let dockerID = resolveContainerID(id) else {
@@ -3626,6 +3833,34 @@ public actor ContainerManager {
         return nativeContainers[dockerID]
     }
 
+    /// Persistent control channels for a running container (WireGuard, filesystem, process services)
+    /// Clients built on the pool share one connection per service instead of dialing per call
+    public func getControlChannels(id: String) -> ControlChannelPool? {
+        guard let dockerID = resolveContainerID(id), let container = nativeContainers[dockerID] else {
+            return nil
+        }
+        return controlChannels(dockerID: dockerID, container: container)
+    }
+
+    /// Pool for the container's current VM; a restarted container gets a fresh pool
+    private func controlChannels(dockerID: String, container: Containerization.LinuxContainer) -> ControlChannelPool {
+        if let pool = controlChannelPools[dockerID], pool.container === container {
+            return pool
+        }
+
+        let pool = ControlChannelPool(containerID: dockerID, container: container, logger: logger)
+        if let stale = controlChannelPools.updateValue(pool, forKey: dockerID) {
+            Task { await stale.close() }
+        }
+        return pool
+    }
+
+    /// Close a container's control channels (the VM has stopped or the container is gone)
+    private func closeControlChannels(dockerID: String) async {
+        guard let pool = controlChannelPools.removeValue(forKey: dockerID) else { return }
+        await pool.close()
+    }
+
     /// Get LinuxContainer instance by Docker ID (for network operations)
     /// This is an alias for getNativeContainer but with a clearer name for networking context
     public func getLinuxContainer(dockerID: String) async throws -> LinuxContainer? {
@@ -4108,13 +4343,46 @@ public actor ContainerManager {
 
     /// Get filesystem changes for a container using OverlayFS upperdir enumeration
     /// Much faster than full filesystem enumeration - only reads upperdir
-    public func getContainerChanges(id: String) async throws -> [FilesystemChange] {
+    public func getContainerChanges(id: String, query: UpperdirQuery = UpperdirQuery()) async throws -> [FilesystemChange] {
+        let reader = try await streamContainerChanges(id: id, query: query)
+
+        var changes: [FilesystemChange] = []
+        while let page = try await reader.next() {
+            for entry in page {
+                if let change = FilesystemChange(upperdirEntry: entry) {
+                    changes.append(change)
+                } else {
+                    // Unknown type - skip
+                    logger.warning("Unknown upperdir entry type", metadata: [
+                        "path": "\(entry.path)",
+                        "type": "\(entry.type)"
+                    ])
+                }
+            }
+        }
+
+        logger.info("Filesystem changes calculated from upperdir", metadata: [
+            "container": "\(id)",
+            "changes": "\(changes.count)",
+            "cached": "\(await reader.cached)"
+        ])
+
+        return changes.sorted { $0.path < $1.path }
+    }
+
+    /// Stream filesystem changes for a container page by page, in the guest's walk order
+    /// Lets `docker diff` start answering before a large upperdir has been walked. The
+    /// reader must be closed; the container's FilesystemClient stays connected.
+    public func streamContainerChanges(id: String, query: UpperdirQuery = UpperdirQuery()) async throws -> UpperdirStreamReader {
         // Resolve name or ID to Docker ID
         guard let dockerID = resolveContainerID(id) else {
             throw ContainerManagerError.containerNotFound(id)
         }
 
-        logger.info("Getting filesystem changes via OverlayFS upperdir", metadata: ["container": "\(dockerID)"])
+        logger.info("Getting filesystem changes via OverlayFS upperdir", metadata: [
+            "container": "\(dockerID)",
+            "path_prefix": "\(query.pathPrefix)"
+        ])
 
         // Check if container is running - get FilesystemClient
         guard let filesystemClient = filesystemClients[dockerID] else {
@@ -4134,48 +4402,7 @@ public actor ContainerManager {
             ])
         }
 
-        // Enumerate upperdir entries
-        let entries = try await filesystemClient.enumerateUpperdir()
-
-        logger.debug("Enumerated upperdir", metadata: [
-            "container": "\(dockerID)",
-            "entries": "\(entries.count)"
-        ])
-
-        // Convert upperdir entries to FilesystemChange
-        var changes: [FilesystemChange] = []
-
-        for entry in entries.sorted(by: { $0.path < $1.path }) {
-            switch entry.type {
-            case "whiteout":
-                // Whiteout = deleted file
-                changes.append(FilesystemChange(
-                    path: entry.path,
-                    kind: .deleted
-                ))
-            case "file", "dir", "symlink":
-                // Present in upperdir = added or modified
-                // We can't distinguish without a baseline, so mark as modified
-                // Docker behavior: upperdir presence = change (could be add or modify)
-                changes.append(FilesystemChange(
-                    path: entry.path,
-                    kind: .modified
-                ))
-            default:
-                // Unknown type - skip
-                logger.warning("Unknown upperdir entry type", metadata: [
-                    "path": "\(entry.path)",
-                    "type": "\(entry.type)"
-                ])
-            }
-        }
-
-        logger.info("Filesystem changes calculated from upperdir", metadata: [
-            "container": "\(dockerID)",
-            "changes": "\(changes.count)"
-        ])
-
-        return changes
+        return try await filesystemClient.enumerateUpperdirStream(query)
     }
 
     // MARK: - ID Mapping
@@ -4262,7 +4489,7 @@ public actor ContainerManager {
     // MARK: - Helper Methods
 
     /// Format status string from container state
-    private func formatStatusFromState(_ info: ContainerInfo) -> String {
+    private nonisolated func formatStatusFromState(_ info: ContainerInfo) -> String {
         switch info.state {
         case "running":
             if let startedAt = info.startedAt {
@@ -4284,7 +4511,7 @@ public actor ContainerManager {
     }
 
     /// Format duration for status string
-    private func formatDuration(_ seconds: TimeInterval) -> String {
+    private nonisolated func formatDuration(_ seconds: TimeInterval) -> String {
         let secs = Int(seconds)
         if secs < 60 {
             return "\(secs) seconds"
@@ -4413,7 +4640,8 @@ public actor ContainerManager {
     // MARK: - Helper Types
 
     /// Internal container tracking info
-    private struct ContainerInfo {
+    /// A value type, so each registry snapshot holds an independent copy per container
+    private struct ContainerInfo: ContainerRegistryEntry {
         let nativeID: String
         var name: String?
         let image: String
@@ -4440,6 +4668,60 @@ public actor ContainerManager {
         var anonymousVolumes: [String]  // Names of anonymous volumes to delete on container removal
         let initialNetworkUserIP: String?  // User-specified IP for initial network (from docker run --ip)
         let initialNetworkAliases: [String]  // Aliases for initial network (from Docker Compose service name)
+
+        var networkIDs: [String] {
+            Array(networkAttachments.keys)
+        }
+    }
+
+    /// Startup restart counts shared with nonisolated readers
+    /// @unchecked Sendable: Safe because the counts are protected by NSLock
+    private final class RecoveryTracker: @unchecked Sendable {
+        private let lock = NSLock()
+        private var current = RecoveryProgress.idle
+
+        var progress: RecoveryProgress {
+            lock.withLock { current }
+        }
+
+        func begin(total: Int) {
+            lock.withLock { current = RecoveryProgress(total: total, started: 0, failed: 0, complete: false) }
+        }
+
+        func record(success: Bool) {
+            lock.withLock {
+                current = RecoveryProgress(
+                    total: current.total,
+                    started: current.started + (success ? 1 : 0),
+                    failed: current.failed + (success ? 0 : 1),
+                    complete: false
+                )
+            }
+        }
+
+        func finish() {
+            lock.withLock {
+                current = RecoveryProgress(total: current.total, started: current.started, failed: current.failed, complete: true)
+            }
+        }
+    }
+
+    /// Late-bound service references shared with nonisolated readers
+    /// @unchecked Sendable: Safe because both references are protected by NSLock
+    private final class ServiceReferences: @unchecked Sendable {
+        private let lock = NSLock()
+        private var _networkManager: NetworkManager?
+        private var _healthChecker: HealthChecker?
+
+        var networkManager: NetworkManager? {
+            get { lock.withLock { _networkManager } }
+            set { lock.withLock { _networkManager = newValue } }
+        }
+
+        var healthChecker: HealthChecker? {
+            get { lock.withLock { _healthChecker } }
+            set { lock.withLock { _healthChecker = newValue } }
+        }
     }
 
     /// Network attachment details for a container
@@ -0,0 +1,240 @@
+import Foundation
+
+/// What the registry needs to know about a container to index it
+protocol ContainerRegistryEntry: Sendable {
+    var nativeID: String { get }
+    var name: String? { get }
+    var state: String { get }
+    var labels: [String: String] { get }
+    /// Image reference the container was created from
+    var image: String { get }
+    var imageID: String { get }
+    /// IDs of the networks the container is attached to
+    var networkIDs: [String] { get }
+}
+
+/// Read-optimized, copy-on-write index of containers for name/ID lookup and listing
+///
+/// ContainerManager is the single writer: every change to its container table publishes a
+/// new immutable Snapshot. Readers (list, inspect, resolve) take the current snapshot under
+/// the lock, which is a reference copy, and then work on it without touching the actor.
+/// A long lifecycle operation on one container therefore never delays lookups of others.
+///
+/// Besides the name and native ID maps, each snapshot carries secondary indexes (state,
+/// label key/value, network, image) that list filters intersect instead of testing every
+/// container, and the health status HealthChecker last pushed for each container. Every
+/// entry is stamped with the generation of its last change (including health changes), so
+/// callers can cache anything derived from an entry and reuse it until the stamp moves.
+///
+/// Writes update only the entry that changed and its index memberships. The previous
+/// snapshot is released before the update, so its storage is mutated in place unless a
+/// reader still holds it, in which case that reader keeps its own copy.
+///
+/// @unchecked Sendable: Safe because the current snapshot and generation counter are
+/// protected by NSLock and snapshots themselves are immutable values.
+final class ContainerRegistry<Entry: ContainerRegistryEntry>: @unchecked Sendable {
+    /// Immutable view of all containers at one point in time
+    struct Snapshot: Sendable {
+        private(set) var entries: [String: Entry] = [:]  // Docker ID -> entry
+        private(set) var dockerIDs: [String: String] = [:]  // Native ID -> Docker ID
+        private(set) var names: [String: String] = [:]  // Name without leading "/" -> Docker ID
+        /// Generation of each entry's last change
+        private(set) var generations: [String: UInt64] = [:]
+
+        // Secondary indexes: value -> Docker IDs
+        private(set) var byState: [String: Set<String>] = [:]  // Lowercased state
+        private(set) var byLabel: [String: [String: Set<String>]] = [:]  // Key -> value -> IDs
+        private(set) var byNetwork: [String: Set<String>] = [:]  // Network ID
+        private(set) var byImage: [String: Set<String>] = [:]  // Image reference
+        private(set) var byImageID: [String: Set<String>] = [:]
+
+        /// Health status per container, as pushed by HealthChecker
+        private(set) var health: [String: Health] = [:]
+        private(set) var byHealth: [String: Set<String>] = [:]  // Lowercased status
+
+        static var empty: Snapshot {
+            Snapshot()
+        }
+
+        /// Resolve a full ID, short ID prefix (4+ hex chars) or name to a Docker ID
+        /// - Parameter ambiguous: Called with the match count when a short ID matches several containers
+        func resolve(_ nameOrID: String, ambiguous: (Int) -> Void = { _ in }) -> String? {
+            // Full 64-char ID
+            if entries[nameOrID] != nil {
+                return nameOrID
+            }
+
+            // Short ID prefix (4-64 chars)
+            if nameOrID.count >= 4 && nameOrID.count < 64,
+               nameOrID.unicodeScalars.allSatisfy({ Self.hexCharset.contains($0) }) {
+                let prefix = nameOrID.lowercased()
+                let matches = entries.keys.filter { $0.hasPrefix(prefix) }
+                if matches.count == 1 {
+                    return matches.first
+                } else if matches.count > 1 {
+                    // Multiple matches - return first (Docker behavior)
+                    ambiguous(matches.count)
+                    return matches.sorted().first
+                }
+            }
+
+            // Name lookup
+            return names[Self.normalize(nameOrID)]
+        }
+
+        /// Containers carrying label `key`, optionally with exactly `value`
+        func labelled(_ key: String, value: String? = nil) -> Set<String> {
+            guard let values = byLabel[key] else { return [] }
+            if let value = value {
+                return values[value] ?? []
+            }
+            return values.values.reduce(into: Set<String>()) { $0.formUnion($1) }
+        }
+
+        // MARK: Maintenance
+
+        fileprivate mutating func insert(_ entry: Entry, for dockerID: String, generation: UInt64) {
+            if let previous = entries[dockerID] {
+                unindex(previous, dockerID: dockerID)
+            }
+            entries[dockerID] = entry
+            generations[dockerID] = generation
+            index(entry, dockerID: dockerID)
+        }
+
+        fileprivate mutating func remove(_ dockerID: String) {
+            guard let previous = entries.removeValue(forKey: dockerID) else { return }
+            unindex(previous, dockerID: dockerID)
+            generations.removeValue(forKey: dockerID)
+            setHealth(nil, for: dockerID)
+        }
+
+        fileprivate mutating func setHealth(_ status: Health?, for dockerID: String) {
+            if let previous = health[dockerID] {
+                Self.remove(dockerID, from: &byHealth, key: previous.status.lowercased())
+            }
+            health[dockerID] = status
+            if let status = status {
+                byHealth[status.status.lowercased(), default: []].insert(dockerID)
+            }
+        }
+
+        fileprivate mutating func stamp(_ dockerID: String, generation: UInt64) {
+            generations[dockerID] = generation
+        }
+
+        private mutating func index(_ entry: Entry, dockerID: String) {
+            dockerIDs[entry.nativeID] = dockerID
+            if let name = entry.name {
+                names[Self.normalize(name)] = dockerID
+            }
+            byState[entry.state.lowercased(), default: []].insert(dockerID)
+            for (key, value) in entry.labels {
+                byLabel[key, default: [:]][value, default: []].insert(dockerID)
+            }
+            for networkID in entry.networkIDs {
+                byNetwork[networkID, default: []].insert(dockerID)
+            }
+            byImage[entry.image, default: []].insert(dockerID)
+            byImageID[entry.imageID, default: []].insert(dockerID)
+        }
+
+        private mutating func unindex(_ entry: Entry, dockerID: String) {
+            if dockerIDs[entry.nativeID] == dockerID {
+                dockerIDs.removeValue(forKey: entry.nativeID)
+            }
+            if let name = entry.name, names[Self.normalize(name)] == dockerID {
+                names.removeValue(forKey: Self.normalize(name))
+            }
+            Self.remove(dockerID, from: &byState, key: entry.state.lowercased())
+            for (key, value) in entry.labels {
+                byLabel[key]?[value]?.remove(dockerID)
+                if byLabel[key]?[value]?.isEmpty == true {
+                    byLabel[key]?.removeValue(forKey: value)
+                }
+                if byLabel[key]?.isEmpty == true {
+                    byLabel.removeValue(forKey: key)
+                }
+            }
+            for networkID in entry.networkIDs {
+                Self.remove(dockerID, from: &byNetwork, key: networkID)
+            }
+            Self.remove(dockerID, from: &byImage, key: entry.image)
+            Self.remove(dockerID, from: &byImageID, key: entry.imageID)
+        }
+
+        private static func remove(_ dockerID: String, from index: inout [String: Set<String>], key: String) {
+            index[key]?.remove(dockerID)
+            if index[key]?.isEmpty == true {
+                index.removeValue(forKey: key)
+            }
+        }
+
+        private static let hexCharset = CharacterSet(charactersIn: "0123456789abcdefABCDEF")
+
+        private static func normalize(_ name: String) -> String {
+            name.hasPrefix("/") ? String(name.dropFirst()) : name
+        }
+    }
+
+    private let lock = NSLock()
+    private var current = Snapshot.empty
+    private var nextGeneration: UInt64 = 1
+
+    /// The latest published state
+    var snapshot: Snapshot {
+        lock.withLock { current }
+    }
+
+    /// The latest published entries (Docker ID -> entry)
+    var entries: [String: Entry] {
+        lock.withLock { current.entries }
+    }
+
+    /// Replace the whole container table (initial load)
+    func publish(_ entries: [String: Entry]) {
+        lock.withLock {
+            var next = Snapshot.empty
+            for (dockerID, entry) in entries {
+                next.insert(entry, for: dockerID, generation: nextGeneration)
+            }
+            nextGeneration += 1
+            current = next
+        }
+    }
+
+    /// Publish a new or changed entry
+    func update(_ dockerID: String, with entry: Entry) {
+        mutate { snapshot, generation in
+            snapshot.insert(entry, for: dockerID, generation: generation)
+        }
+    }
+
+    /// Publish the removal of an entry (and its health status)
+    func remove(_ dockerID: String) {
+        mutate { snapshot, _ in
+            snapshot.remove(dockerID)
+        }
+    }
+
+    /// Record the health status of a known container; ignored once it has been removed
+    func updateHealth(_ status: Health?, for dockerID: String) {
+        mutate { snapshot, generation in
+            guard snapshot.entries[dockerID] != nil else { return }
+            snapshot.setHealth(status, for: dockerID)
+            snapshot.stamp(dockerID, generation: generation)
+        }
+    }
+
+    private func mutate(_ body: (inout Snapshot, UInt64) -> Void) {
+        lock.withLock {
+            // Drop the registry's reference first so the update is in place when no reader
+            // holds the old snapshot
+            var next = current
+            current = .empty
+            body(&next, nextGeneration)
+            nextGeneration += 1
+            current = next
+        }
+    }
+}
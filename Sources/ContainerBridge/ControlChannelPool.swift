@@ -0,0 +1,327 @@
+// ControlChannelPool.swift
+// Persistent gRPC channels to the control services inside a container VM
+//
+// WireGuardClient, FilesystemClient and ProcessControlClient used to dial vsock and do an
+// HTTP/2 handshake for every operation. The pool keeps one connection per in-VM service
+// open for the container's lifetime; clients multiplex their calls over it.
+
+import Foundation
+import GRPC
+import NIO
+import NIOPosix
+import Logging
+import SwiftProtobuf
+import Containerization
+
+/// One container's persistent vsock gRPC channels, keyed by service port
+///
+/// Owned by ContainerManager and closed when the container stops or is removed.
+/// A connected-socket channel cannot redial, so it is only handed out while it is `.ready`,
+/// or `.idle`/`.connecting` with its socket verified open; anything else is replaced by dialing again.
+/// An RPC that fails with UNAVAILABLE drops its channel so the next caller redials too.
+public actor ControlChannelPool {
+    /// vsock ports of the services run by arca-services in the guest
+    public enum Service: UInt32, Sendable, CaseIterable {
+        case wireGuard = 51820
+        case filesystem = 51821
+        case processControl = 51822
+    }
+
+    public enum ControlChannelPoolError: Error, CustomStringConvertible {
+        case closed(String)
+
+        public var description: String {
+            switch self {
+            case .closed(let containerID):
+                return "Control channels for container \(containerID) are closed"
+            }
+        }
+    }
+
+    nonisolated public let containerID: String
+    nonisolated public let container: Containerization.LinuxContainer
+    private let logger: Logger
+
+    /// A dialed channel plus the pool's own descriptor for its socket
+    /// NIO owns (and may close) the descriptor it was given; `socket` is a second one kept
+    /// open until the entry is dropped, so probing it never hits a reused descriptor.
+    private struct Entry: Sendable {
+        let connection: ClientConnection
+        let socket: Int32
+
+        func close() {
+            _ = connection.close()
+            Foundation.close(socket)
+        }
+    }
+
+    // One event loop group serves the channels of every container; a group per pool kept a
+    // thread alive for each running container
+    private static let sharedEventLoopGroup = MultiThreadedEventLoopGroup(numberOfThreads: 2)
+    private let eventLoopGroup: EventLoopGroup = ControlChannelPool.sharedEventLoopGroup
+    private var channels: [UInt32: Entry] = [:]
+    private var dials: [UInt32: Task<Entry, Error>] = [:]  // In-flight dials, shared by concurrent callers
+    private var isClosed = false
+
+    public init(containerID: String, container: Containerization.LinuxContainer, logger: Logger) {
+        self.containerID = containerID
+        self.container = container
+        self.logger = logger
+    }
+
+    /// Channel to the service on `port`, dialing (or re-dialing) if needed
+    public func channel(port: UInt32) async throws -> GRPCChannel {
+        guard !isClosed else {
+            throw ControlChannelPoolError.closed(containerID)
+        }
+
+        if let existing = channels[port] {
+            if Self.isUsable(existing) {
+                return handle(existing, port: port)
+            }
+            logger.debug("Control channel unhealthy, reconnecting", metadata: [
+                "container": "\(containerID)",
+                "vsockPort": "\(port)",
+                "state": "\(existing.connection.connectivity.state)"
+            ])
+            channels.removeValue(forKey: port)
+            existing.close()
+        }
+
+        if let pending = dials[port] {
+            return handle(try await pending.value, port: port)
+        }
+
+        let dial = Task { [containerID, container, eventLoopGroup, logger] in
+            try await Self.dial(
+                containerID: containerID,
+                container: container,
+                port: port,
+                group: eventLoopGroup,
+                logger: logger
+            )
+        }
+        dials[port] = dial
+        defer { dials.removeValue(forKey: port) }
+
+        let entry = try await dial.value
+        guard !isClosed else {
+            entry.close()
+            throw ControlChannelPoolError.closed(containerID)
+        }
+        channels[port] = entry
+        return handle(entry, port: port)
+    }
+
+    /// Channel to one of the well-known services
+    public func channel(for service: Service) async throws -> GRPCChannel {
+        try await channel(port: service.rawValue)
+    }
+
+    /// Drop the channel for `port` so the next caller dials a fresh one
+    /// Called for every RPC on a pooled channel that fails with UNAVAILABLE
+    public func invalidate(port: UInt32) {
+        guard let entry = channels.removeValue(forKey: port) else { return }
+        entry.close()
+    }
+
+    /// Drop the channel for `port` if it is still `connection` (not already redialed)
+    private func invalidate(port: UInt32, connection: ClientConnection) {
+        guard let entry = channels[port], entry.connection === connection else { return }
+        logger.debug("Control channel unavailable, dropping it", metadata: [
+            "container": "\(containerID)",
+            "vsockPort": "\(port)"
+        ])
+        invalidate(port: port)
+    }
+
+    /// The channel callers use: the connection, reporting UNAVAILABLE back to the pool
+    private func handle(_ entry: Entry, port: UInt32) -> GRPCChannel {
+        let connection = entry.connection
+        return PooledChannel(connection: connection) { [weak self] in
+            Task { await self?.invalidate(port: port, connection: connection) }
+        }
+    }
+
+    /// Close every channel; later `channel(port:)` calls fail
+    public func close() async {
+        guard !isClosed else { return }
+        isClosed = true
+
+        for task in dials.values {
+            task.cancel()
+        }
+        let open = Array(channels.values)
+        channels.removeAll()
+
+        for entry in open {
+            try? await entry.connection.close().get()
+            Foundation.close(entry.socket)
+        }
+
+        logger.debug("Closed control channels", metadata: [
+            "container": "\(containerID)",
+            "channels": "\(open.count)"
+        ])
+    }
+
+    /// `.ready`, or `.idle`/`.connecting` with the socket still open
+    /// An idle channel moves to `.connecting` on its first RPC; closing it then would kill
+    /// that RPC, so it counts as usable while its socket is open.
+    private static func isUsable(_ entry: Entry) -> Bool {
+        switch entry.connection.connectivity.state {
+        case .ready:
+            return true
+        case .idle, .connecting:
+            return isOpen(socket: entry.socket)
+        case .transientFailure, .shutdown:
+            return false
+        }
+    }
+
+    /// Whether the peer still has the socket open, without consuming anything
+    private static func isOpen(socket: Int32) -> Bool {
+        var descriptor = pollfd(fd: socket, events: Int16(POLLIN), revents: 0)
+        guard poll(&descriptor, 1, 0) >= 0 else { return false }
+        if descriptor.revents & Int16(POLLHUP | POLLERR | POLLNVAL) != 0 {
+            return false
+        }
+        guard descriptor.revents & Int16(POLLIN) != 0 else { return true }
+
+        // Readable: data waiting, or end of stream
+        var byte: UInt8 = 0
+        let peeked = recv(socket, &byte, 1, MSG_PEEK | MSG_DONTWAIT)
+        return peeked > 0 || (peeked < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    }
+
+    /// Dial the service with the same retry policy the clients used (services may still be starting)
+    private static func dial(
+        containerID: String,
+        container: Containerization.LinuxContainer,
+        port: UInt32,
+        group: EventLoopGroup,
+        logger: Logger
+    ) async throws -> Entry {
+        let maxRetries = 50
+        let retryDelay: Duration = .milliseconds(50)
+        var lastError: Error?
+
+        for attempt in 1...maxRetries {
+            try Task.checkCancellation()
+            do {
+                let fileHandle = try await container.dialVsock(port: port)
+
+                // NIO takes ownership of the descriptor it is given, so hand it a duplicate
+                // and let the FileHandle close the original
+                let fd = dup(fileHandle.fileDescriptor)
+                let probe = dup(fileHandle.fileDescriptor)
+                try? fileHandle.close()
+                guard fd >= 0, probe >= 0 else {
+                    let code = POSIXErrorCode(rawValue: errno) ?? .EBADF
+                    if fd >= 0 { Foundation.close(fd) }
+                    if probe >= 0 { Foundation.close(probe) }
+                    throw POSIXError(code)
+                }
+
+                // The socket can't be re-dialed, so the connection must never idle out (which
+                // closes it) or try to reconnect with backoff
+                var configuration = ClientConnection.Configuration.default(
+                    target: .connectedSocket(NIOBSDSocket.Handle(fd)),
+                    eventLoopGroup: group
+                )
+                configuration.connectionIdleTimeout = .hours(24 * 365)
+                configuration.connectionBackoff = nil
+                let connection = ClientConnection(configuration: configuration)
+
+                logger.debug("Opened control channel", metadata: [
+                    "container": "\(containerID)",
+                    "vsockPort": "\(port)",
+                    "attempts": "\(attempt)"
+                ])
+                return Entry(connection: connection, socket: probe)
+            } catch {
+                lastError = error
+                if attempt < maxRetries {
+                    try await Task.sleep(for: retryDelay)
+                }
+            }
+        }
+
+        logger.error("Failed to open control channel after \(maxRetries) attempts", metadata: [
+            "container": "\(containerID)",
+            "vsockPort": "\(port)",
+            "error": "\(lastError?.localizedDescription ?? "unknown")"
+        ])
+        throw lastError ?? ControlChannelPoolError.closed(containerID)
+    }
+}
+
+/// A pooled connection as handed to clients
+/// Every call carries an interceptor that tells the pool when it ends UNAVAILABLE, so a dead
+/// channel is dropped whichever client or RPC shape (unary, streaming) ran into it.
+private final class PooledChannel: GRPCChannel {
+    private let connection: ClientConnection
+    private let onUnavailable: @Sendable () -> Void
+
+    init(connection: ClientConnection, onUnavailable: @escaping @Sendable () -> Void) {
+        self.connection = connection
+        self.onUnavailable = onUnavailable
+    }
+
+    func makeCall<Request: SwiftProtobuf.Message, Response: SwiftProtobuf.Message>(
+        path: String,
+        type: GRPCCallType,
+        callOptions: CallOptions,
+        interceptors: [ClientInterceptor<Request, Response>]
+    ) -> Call<Request, Response> {
+        connection.makeCall(
+            path: path,
+            type: type,
+            callOptions: callOptions,
+            interceptors: interceptors + [UnavailableInterceptor(onUnavailable)]
+        )
+    }
+
+    func makeCall<Request: GRPCPayload, Response: GRPCPayload>(
+        path: String,
+        type: GRPCCallType,
+        callOptions: CallOptions,
+        interceptors: [ClientInterceptor<Request, Response>]
+    ) -> Call<Request, Response> {
+        connection.makeCall(
+            path: path,
+            type: type,
+            callOptions: callOptions,
+            interceptors: interceptors + [UnavailableInterceptor(onUnavailable)]
+        )
+    }
+
+    /// The pool owns the connection; clients "closing" a pooled channel must not close it
+    func close() -> EventLoopFuture<Void> {
+        connection.eventLoop.makeSucceededVoidFuture()
+    }
+}
+
+/// Reports calls that end with (or fail as) UNAVAILABLE
+private final class UnavailableInterceptor<Request, Response>: ClientInterceptor<Request, Response>, @unchecked Sendable {
+    private let onUnavailable: @Sendable () -> Void
+
+    init(_ onUnavailable: @escaping @Sendable () -> Void) {
+        self.onUnavailable = onUnavailable
+        super.init()
+    }
+
+    override func receive(_ part: GRPCClientResponsePart<Response>, context: ClientInterceptorContext<Request, Response>) {
+        if case .end(let status, _) = part, status.code == .unavailable {
+            onUnavailable()
+        }
+        context.receive(part)
+    }
+
+    override func errorCaught(_ error: Error, context: ClientInterceptorContext<Request, Response>) {
+        if let status = (error as? GRPCStatusTransformable)?.makeGRPCStatus(), status.code == .unavailable {
+            onUnavailable()
+        }
+        context.errorCaught(error)
+    }
+}
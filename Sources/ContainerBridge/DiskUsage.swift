@@ -0,0 +1,158 @@
+import Foundation
+#if canImport(Darwin)
+import Darwin
+#endif
+
+/// Allocated-size measurement for volume storage
+///
+/// Sizes are allocated bytes (`st_blocks`), not apparent sizes: a sparse 512GB block image
+/// that holds 2GB of data reports 2GB, which is what deleting it actually reclaims.
+enum DiskUsage {
+    struct ScanResult: Sendable {
+        let bytes: Int64
+        /// False when the scan hit its deadline; `bytes` is then a lower bound
+        let complete: Bool
+    }
+
+    /// Allocated bytes of a single file without following symlinks
+    static func allocatedSize(ofFile path: String) -> Int64? {
+        var info = stat()
+        guard lstat(path, &info) == 0 else { return nil }
+        return Int64(info.st_blocks) * 512
+    }
+
+    /// Total allocated bytes under `directory`
+    ///
+    /// Directories are shared out to `workers` concurrent walkers through one queue, so a deep
+    /// subtree doesn't serialize the scan. Hard-linked files are counted once. The walk stops at
+    /// `deadline` and reports what it has counted so far as incomplete.
+    static func scan(directory: String, deadline: ContinuousClock.Instant, workers: Int = 4) async -> ScanResult {
+        let state = ScanState(root: directory)
+        await withTaskGroup(of: Void.self) { group in
+            for _ in 0..<max(workers, 1) {
+                group.addTask {
+                    await walk(state: state, deadline: deadline)
+                }
+            }
+        }
+        return state.result
+    }
+
+    private static func walk(state: ScanState, deadline: ContinuousClock.Instant) async {
+        while true {
+            if ContinuousClock.now >= deadline {
+                state.expire()
+                return
+            }
+
+            switch state.next() {
+            case .done:
+                return
+            case .wait:
+                // Another walker is listing a directory that may add more work
+                try? await Task.sleep(for: .milliseconds(1))
+            case .directory(let path):
+                var subdirectories: [String] = []
+                let bytes = list(path, state: state, subdirectories: &subdirectories)
+                state.finish(bytes: bytes, subdirectories: subdirectories)
+            }
+        }
+    }
+
+    /// Sum allocated bytes of the entries in one directory, collecting its subdirectories
+    private static func list(_ path: String, state: ScanState, subdirectories: inout [String]) -> Int64 {
+        guard let dir = opendir(path) else { return 0 }
+        defer { closedir(dir) }
+
+        let fd = dirfd(dir)
+        var bytes: Int64 = 0
+        while let entry = readdir(dir) {
+            var info = stat()
+            let name: String? = withUnsafePointer(to: &entry.pointee.d_name) { pointer in
+                pointer.withMemoryRebound(to: CChar.self, capacity: MemoryLayout.size(ofValue: entry.pointee.d_name)) { cName in
+                    // Skip "." and ".."
+                    if cName[0] == 0x2E && (cName[1] == 0 || (cName[1] == 0x2E && cName[2] == 0)) {
+                        return nil
+                    }
+                    guard fstatat(fd, cName, &info, AT_SYMLINK_NOFOLLOW) == 0 else { return nil }
+                    return String(cString: cName)
+                }
+            }
+            guard let name = name else { continue }
+
+            if (info.st_mode & S_IFMT) == S_IFDIR {
+                subdirectories.append("\(path)/\(name)")
+            } else if info.st_nlink > 1 && !state.claim(device: UInt64(info.st_dev), inode: UInt64(info.st_ino)) {
+                continue
+            }
+            bytes += Int64(info.st_blocks) * 512
+        }
+        return bytes
+    }
+}
+
+/// Work queue and totals shared by the walkers of one scan
+/// @unchecked Sendable: Safe because all mutable state is protected by NSLock
+private final class ScanState: @unchecked Sendable {
+    enum Next {
+        case directory(String)
+        case wait
+        case done
+    }
+
+    private struct Inode: Hashable {
+        let device: UInt64
+        let inode: UInt64
+    }
+
+    private let lock = NSLock()
+    private var pending: [String]
+    private var listing = 0  // Walkers currently listing a directory
+    private var bytes: Int64 = 0
+    private var expired = false
+    private var linkedInodes: Set<Inode> = []
+
+    init(root: String) {
+        self.pending = [root]
+    }
+
+    var result: DiskUsage.ScanResult {
+        lock.lock()
+        defer { lock.unlock() }
+        return DiskUsage.ScanResult(bytes: bytes, complete: !expired)
+    }
+
+    func next() -> Next {
+        lock.lock()
+        defer { lock.unlock() }
+        if expired { return .done }
+        if let path = pending.popLast() {
+            listing += 1
+            return .directory(path)
+        }
+        return listing == 0 ? .done : .wait
+    }
+
+    func finish(bytes: Int64, subdirectories: [String]) {
+        lock.lock()
+        defer { lock.unlock() }
+        self.bytes += bytes
+        pending.append(contentsOf: subdirectories)
+        listing -= 1
+    }
+
+    func expire() {
+        lock.lock()
+        defer { lock.unlock() }
+        if !pending.isEmpty || listing > 0 {
+            expired = true
+        }
+    }
+
+    /// True the first time a hard-linked inode is seen
+    func claim(device: UInt64, inode: UInt64) -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return linkedInodes.insert(Inode(device: device, inode: inode)).inserted
+    }
+}
@@ -206,8 +206,7 @@ public actor ExecManager {
             let exitStatus = try await process.wait()
 
             // Close output streams to signal completion
-            // This finishes the AsyncStream continuations
-            // Works for both RawWriter (TTY mode) and StreamingWriter (non-TTY mode)
+            // The attached client waits for this before its connection is closed
             if let writer = stdout {
                 do {
                     try writer.close()
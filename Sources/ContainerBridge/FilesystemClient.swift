@@ -3,8 +3,8 @@
 //
 // Provides filesystem operations for containers:
 // - Filesystem sync (flush buffers)
-// - OverlayFS upperdir enumeration (for docker diff)
-// - Archive operations (tar creation/extraction for buildx)
+// - OverlayFS upperdir enumeration (for docker diff), unary or paged streaming
+// - Archive operations (tar creation/extraction for buildx), unary or chunked streaming
 
 import Foundation
 import GRPC
@@ -16,6 +16,17 @@ import Containerization
 /// Client for communicating with arca-filesystem-service running in container VM
 /// Connects via vsock port 51821
 public actor FilesystemClient {
+    /// Payload size of each message in the streaming archive RPCs
+    /// Kept well below gRPC's default 4 MiB message limit
+    public static let archiveChunkSize = 1 << 20
+
+    /// Entries per page of a streaming upperdir enumeration
+    public static let upperdirPageSize = 1024
+
+    /// Bytes of an upload kept for replay over unary WriteArchive if the guest predates
+    /// WriteArchiveStream (UNIMPLEMENTED arrives within one round trip, far sooner than this)
+    private static let writeReplayLimit = 16 << 20
+
     private let logger: Logger
     private let containerID: String
     private let container: Containerization.LinuxContainer
@@ -23,10 +34,18 @@ public actor FilesystemClient {
     private var eventLoopGroup: EventLoopGroup?
     private var client: Arca_Filesystem_V1_FilesystemServiceAsyncClient?
     private var vsockFileHandle: FileHandle?  // Keep FileHandle alive for the connection
-
-    public init(containerID: String, container: Containerization.LinuxContainer, logger: Logger) {
+    private let channelPool: ControlChannelPool?
+
+    /// - Parameter channelPool: The container's persistent channels; when nil the client dials its own
+    public init(
+        containerID: String,
+        container: Containerization.LinuxContainer,
+        channelPool: ControlChannelPool? = nil,
+        logger: Logger
+    ) {
         self.containerID = containerID
         self.container = container
+        self.channelPool = channelPool
         self.logger = logger
     }
 
@@ -92,6 +111,11 @@ public actor FilesystemClient {
 
     /// Get or create gRPC client connection
     private func getClient() async throws -> Arca_Filesystem_V1_FilesystemServiceAsyncClient {
+        // Pooled channels are health-checked (and re-dialed) by the pool on every request
+        if let pool = channelPool {
+            return Arca_Filesystem_V1_FilesystemServiceAsyncClient(channel: try await pool.channel(for: .filesystem))
+        }
+
         if let existing = client {
             return existing
         }
@@ -141,7 +165,9 @@ public actor FilesystemClient {
         let client = try await getClient()
         let request = Arca_Filesystem_V1_SyncFilesystemRequest()
 
-        let response = try await client.syncFilesystem(request)
+        let response = try await Tracing.guestCall("filesystem/SyncFilesystem") { options in
+            try await client.syncFilesystem(request, callOptions: options)
+        }
 
         guard response.success else {
             logger.error("Filesystem sync failed", metadata: [
@@ -163,7 +189,9 @@ public actor FilesystemClient {
         let client = try await getClient()
         let request = Arca_Filesystem_V1_EnumerateUpperdirRequest()
 
-        let response = try await client.enumerateUpperdir(request)
+        let response = try await Tracing.guestCall("filesystem/EnumerateUpperdir") { options in
+            try await client.enumerateUpperdir(request, callOptions: options)
+        }
 
         guard response.success else {
             logger.error("Upperdir enumeration failed", metadata: [
@@ -178,15 +206,60 @@ public actor FilesystemClient {
             "entries": "\(response.entries.count)"
         ])
 
-        return response.entries.map { entry in
-            UpperdirEntry(
-                path: entry.path,
-                type: entry.type,
-                size: entry.size,
-                mtime: entry.mtime,
-                mode: entry.mode
-            )
+        return response.entries.map(UpperdirEntry.init)
+    }
+
+    /// Enumerate OverlayFS upperdir as a stream of pages
+    /// Pages arrive in the guest's walk order as it goes, so neither side holds the whole
+    /// listing. The guest may answer from its change journal (when current) instead of walking
+    /// upperdir again. Falls back to unary EnumerateUpperdir, filtered here, when the guest
+    /// predates EnumerateUpperdirStream.
+    public func enumerateUpperdirStream(_ query: UpperdirQuery = UpperdirQuery()) async throws -> UpperdirStreamReader {
+        logger.debug("Enumerating upperdir stream", metadata: [
+            "container": "\(containerID)",
+            "path_prefix": "\(query.pathPrefix)",
+            "max_depth": "\(query.maxDepth.map { "\($0)" } ?? "unlimited")"
+        ])
+
+        var iterator = try await upperdirIterator(query: query, pageToken: "")
+        let first: Arca_Filesystem_V1_EnumerateUpperdirPage?
+        do {
+            first = try await iterator.next()
+        } catch let status as GRPCStatus where status.code == .unimplemented {
+            logger.debug("EnumerateUpperdirStream not supported by guest, using unary EnumerateUpperdir", metadata: [
+                "container": "\(containerID)"
+            ])
+            let entries = try await enumerateUpperdir().filter { query.matches($0.path) }
+            return UpperdirStreamReader(client: self, query: query, iterator: nil, buffered: entries)
+        }
+
+        guard let first = first else {
+            return UpperdirStreamReader(client: self, query: query, iterator: nil, buffered: [])
+        }
+        guard first.error.isEmpty else {
+            logger.error("Upperdir enumeration failed", metadata: [
+                "container": "\(containerID)",
+                "error": "\(first.error)"
+            ])
+            throw FilesystemClientError.enumerationFailed(first.error)
         }
+
+        return UpperdirStreamReader(client: self, query: query, iterator: iterator, first: first)
+    }
+
+    /// Open an EnumerateUpperdirStream call, resuming after `pageToken` if not empty
+    func upperdirIterator(
+        query: UpperdirQuery,
+        pageToken: String
+    ) async throws -> GRPCAsyncResponseStream<Arca_Filesystem_V1_EnumerateUpperdirPage>.AsyncIterator {
+        let client = try await getClient()
+        var request = Arca_Filesystem_V1_EnumerateUpperdirRequest()
+        request.pathPrefix = query.pathPrefix == "/" ? "" : query.pathPrefix
+        request.maxDepth = UInt32(query.maxDepth ?? 0)
+        request.pageSize = UInt32(Self.upperdirPageSize)
+        request.pageToken = pageToken
+        request.allowCached = true
+        return client.enumerateUpperdirStream(request, callOptions: Tracing.callOptions()).makeAsyncIterator()
     }
 
     /// Read archive - create tar archive of filesystem path
@@ -203,7 +276,9 @@ public actor FilesystemClient {
         request.containerID = containerID
         request.path = path
 
-        let response = try await client.readArchive(request)
+        let response = try await Tracing.guestCall("filesystem/ReadArchive") { options in
+            try await client.readArchive(request, callOptions: options)
+        }
 
         guard response.success else {
             logger.error("Read archive failed", metadata: [
@@ -214,13 +289,7 @@ public actor FilesystemClient {
             throw FilesystemClientError.readArchiveFailed(response.error)
         }
 
-        let stat = PathStat(
-            name: response.stat.name,
-            size: response.stat.size,
-            mode: response.stat.mode,
-            mtime: response.stat.mtime,
-            linkTarget: response.stat.linkTarget
-        )
+        let stat = PathStat(response.stat)
 
         logger.debug("Read archive complete", metadata: [
             "container": "\(containerID)",
@@ -247,7 +316,9 @@ public actor FilesystemClient {
         request.path = path
         request.tarData = tarData
 
-        let response = try await client.writeArchive(request)
+        let response = try await Tracing.guestCall("filesystem/WriteArchive") { options in
+            try await client.writeArchive(request, callOptions: options)
+        }
 
         guard response.success else {
             logger.error("Write archive failed", metadata: [
@@ -264,6 +335,159 @@ public actor FilesystemClient {
         ])
     }
 
+    /// Read archive as a stream of chunks
+    /// Pipelines the transfer so the first bytes reach the caller before the whole tar exists,
+    /// and keeps memory constant regardless of archive size. Falls back to unary ReadArchive
+    /// when the guest's filesystem service predates ReadArchiveStream.
+    /// - Returns: A reader yielding tar chunks; it owns this client's connection and
+    ///   disconnects when closed
+    public func readArchiveStream(path: String) async throws -> ArchiveStreamReader {
+        logger.debug("Reading archive stream", metadata: [
+            "container": "\(containerID)",
+            "path": "\(path)"
+        ])
+
+        let client = try await getClient()
+        var request = Arca_Filesystem_V1_ReadArchiveRequest()
+        request.containerID = containerID
+        request.path = path
+
+        var iterator = client.readArchiveStream(request, callOptions: Tracing.callOptions()).makeAsyncIterator()
+        let first: Arca_Filesystem_V1_ArchiveChunk?
+        do {
+            first = try await iterator.next()
+        } catch let status as GRPCStatus where status.code == .unimplemented {
+            logger.debug("ReadArchiveStream not supported by guest, using unary ReadArchive", metadata: [
+                "container": "\(containerID)"
+            ])
+            let (tarData, stat) = try await readArchive(path: path)
+            return ArchiveStreamReader(stat: stat, iterator: nil, buffered: tarData, client: self)
+        }
+
+        guard let first = first else {
+            throw FilesystemClientError.readArchiveFailed("Archive stream ended before path stat was received")
+        }
+        guard first.error.isEmpty else {
+            logger.error("Read archive stream failed", metadata: [
+                "container": "\(containerID)",
+                "path": "\(path)",
+                "error": "\(first.error)"
+            ])
+            throw FilesystemClientError.readArchiveFailed(first.error)
+        }
+
+        return ArchiveStreamReader(stat: PathStat(first.stat), iterator: iterator, buffered: first.data, client: self)
+    }
+
+    /// Write archive from a stream of chunks
+    /// Each incoming buffer is forwarded as one or more `archiveChunkSize` messages, so the
+    /// guest extracts while the upload is still arriving. Falls back to unary WriteArchive
+    /// when the guest's filesystem service predates WriteArchiveStream.
+    public func writeArchive<Chunks: AsyncSequence & Sendable>(
+        path: String,
+        chunks: Chunks
+    ) async throws where Chunks.Element == ByteBuffer {
+        logger.debug("Writing archive stream", metadata: [
+            "container": "\(containerID)",
+            "path": "\(path)"
+        ])
+
+        let client = try await getClient()
+        let call = client.makeWriteArchiveStreamCall(callOptions: Tracing.callOptions())
+
+        var header = Arca_Filesystem_V1_WriteArchiveChunk()
+        header.containerID = containerID
+        header.path = path
+
+        var iterator = chunks.makeAsyncIterator()
+        var replay: Data? = Data()
+        var totalBytes = 0
+        var sendFailed = false
+
+        do {
+            try await call.requestStream.send(header)
+        } catch {
+            sendFailed = true
+        }
+
+        while !sendFailed {
+            let next: ByteBuffer?
+            do {
+                next = try await iterator.next()
+            } catch {
+                // Upload failed - abort the RPC so the guest discards the partial archive
+                call.cancel()
+                throw error
+            }
+            guard var buffer = next else { break }
+
+            totalBytes += buffer.readableBytes
+            if var kept = replay {
+                kept.append(contentsOf: buffer.readableBytesView)
+                replay = kept.count <= Self.writeReplayLimit ? kept : nil
+            }
+
+            do {
+                while buffer.readableBytes > 0 {
+                    let slice = buffer.readSlice(length: min(Self.archiveChunkSize, buffer.readableBytes))!
+                    var message = Arca_Filesystem_V1_WriteArchiveChunk()
+                    message.data = Data(slice.readableBytesView)
+                    try await call.requestStream.send(message)
+                }
+            } catch {
+                sendFailed = true
+            }
+        }
+
+        if sendFailed {
+            let status = await call.status
+            guard status.code == .unimplemented, var tarData = replay else {
+                throw FilesystemClientError.writeArchiveFailed(status.message ?? "\(status.code)")
+            }
+
+            logger.debug("WriteArchiveStream not supported by guest, using unary WriteArchive", metadata: [
+                "container": "\(containerID)"
+            ])
+            while let buffer = try await iterator.next() {
+                tarData.append(contentsOf: buffer.readableBytesView)
+            }
+            try await writeArchive(path: path, tarData: tarData)
+            return
+        }
+
+        call.requestStream.finish()
+        let response: Arca_Filesystem_V1_WriteArchiveResponse
+        do {
+            response = try await call.response
+        } catch let status as GRPCStatus where status.code == .unimplemented {
+            // Every send can succeed before an older guest rejects the call, e.g. for a small
+            // archive; the whole upload is then in `replay`
+            guard let tarData = replay else {
+                throw FilesystemClientError.writeArchiveFailed(status.message ?? "\(status.code)")
+            }
+            logger.debug("WriteArchiveStream not supported by guest, using unary WriteArchive", metadata: [
+                "container": "\(containerID)"
+            ])
+            try await writeArchive(path: path, tarData: tarData)
+            return
+        }
+
+        guard response.success else {
+            logger.error("Write archive stream failed", metadata: [
+                "container": "\(containerID)",
+                "path": "\(path)",
+                "error": "\(response.error)"
+            ])
+            throw FilesystemClientError.writeArchiveFailed(response.error)
+        }
+
+        logger.debug("Write archive stream complete", metadata: [
+            "container": "\(containerID)",
+            "path": "\(path)",
+            "size": "\(totalBytes)"
+        ])
+    }
+
     /// Create bind mount - bind mount a file or directory inside the container
     /// Works like "mount --bind /source /target" inside the container
     /// Used for file bind mounts (VirtioFS only supports directory shares)
@@ -282,7 +506,9 @@ public actor FilesystemClient {
         request.target = target
         request.readOnly = readOnly
 
-        let response = try await client.createBindMount(request)
+        let response = try await Tracing.guestCall("filesystem/CreateBindMount") { options in
+            try await client.createBindMount(request, callOptions: options)
+        }
 
         guard response.success else {
             logger.error("Create bind mount failed", metadata: [
@@ -320,6 +546,151 @@ public struct UpperdirEntry: Sendable {
     }
 }
 
+/// Filter for an upperdir enumeration
+public struct UpperdirQuery: Sendable, Equatable {
+    /// Only entries at or below this path; "/" for the whole upperdir
+    public let pathPrefix: String
+    /// Levels below `pathPrefix` to include (1 = direct children); nil for unlimited
+    public let maxDepth: Int?
+
+    public init(pathPrefix: String = "/", maxDepth: Int? = nil) {
+        let components = pathPrefix.split(separator: "/", omittingEmptySubsequences: true)
+        self.pathPrefix = "/" + components.joined(separator: "/")
+        self.maxDepth = maxDepth.map { max($0, 1) }
+    }
+
+    /// Whether an entry passes the filter (applied here when the guest can't filter)
+    public func matches(_ path: String) -> Bool {
+        let relative: Substring
+        if pathPrefix == "/" {
+            relative = path.drop { $0 == "/" }
+        } else if path == pathPrefix {
+            relative = ""
+        } else if path.hasPrefix(pathPrefix + "/") {
+            relative = path.dropFirst(pathPrefix.count + 1)
+        } else {
+            return false
+        }
+
+        guard let maxDepth = maxDepth else { return true }
+        return relative.split(separator: "/").count <= maxDepth
+    }
+}
+
+/// Reader for an upperdir enumeration streamed from the guest (EnumerateUpperdirStream)
+/// Pages are pulled from the guest as they are read, so a slow consumer holds back the walk
+/// instead of buffering it. A stream dropped by the transport is resumed once from the last
+/// page's token. Does not own the `FilesystemClient`; `close()` only ends the stream.
+public actor UpperdirStreamReader {
+    private let client: FilesystemClient
+    private let query: UpperdirQuery
+    private var iterator: GRPCAsyncResponseStream<Arca_Filesystem_V1_EnumerateUpperdirPage>.AsyncIterator?
+    private var buffered: [UpperdirEntry]
+    private var bufferedOffset = 0
+    private var resumeToken: String?
+    private var resumed = false
+
+    /// Entries returned so far
+    public private(set) var entryCount = 0
+    /// Whether any page came from the guest's change journal
+    public private(set) var cached = false
+
+    init(
+        client: FilesystemClient,
+        query: UpperdirQuery,
+        iterator: GRPCAsyncResponseStream<Arca_Filesystem_V1_EnumerateUpperdirPage>.AsyncIterator?,
+        buffered: [UpperdirEntry]
+    ) {
+        self.client = client
+        self.query = query
+        self.iterator = iterator
+        self.buffered = buffered
+    }
+
+    init(
+        client: FilesystemClient,
+        query: UpperdirQuery,
+        iterator: GRPCAsyncResponseStream<Arca_Filesystem_V1_EnumerateUpperdirPage>.AsyncIterator,
+        first: Arca_Filesystem_V1_EnumerateUpperdirPage
+    ) {
+        self.client = client
+        self.query = query
+        self.iterator = iterator
+        self.buffered = first.entries.map(UpperdirEntry.init)
+        self.resumeToken = first.nextPageToken.isEmpty ? nil : first.nextPageToken
+        self.cached = first.cached
+    }
+
+    /// Next page of entries, or nil when the enumeration is complete
+    public func next() async throws -> [UpperdirEntry]? {
+        if bufferedOffset < buffered.count {
+            let end = min(bufferedOffset + FilesystemClient.upperdirPageSize, buffered.count)
+            let page = Array(buffered[bufferedOffset..<end])
+            bufferedOffset = end
+            if bufferedOffset == buffered.count {
+                buffered = []
+                bufferedOffset = 0
+            }
+            entryCount += page.count
+            return page
+        }
+
+        guard var current = iterator else {
+            return nil
+        }
+
+        while true {
+            let page: Arca_Filesystem_V1_EnumerateUpperdirPage?
+            do {
+                page = try await current.next()
+            } catch let status as GRPCStatus where status.code == .unavailable && !resumed && resumeToken != nil {
+                resumed = true
+                current = try await client.upperdirIterator(query: query, pageToken: resumeToken!)
+                continue
+            } catch {
+                iterator = nil
+                throw error
+            }
+
+            guard let page = page else {
+                iterator = nil
+                return nil
+            }
+            guard page.error.isEmpty else {
+                iterator = nil
+                throw FilesystemClientError.enumerationFailed(page.error)
+            }
+
+            resumeToken = page.nextPageToken.isEmpty ? nil : page.nextPageToken
+            cached = cached || page.cached
+            if !page.entries.isEmpty {
+                iterator = current
+                entryCount += page.entries.count
+                return page.entries.map(UpperdirEntry.init)
+            }
+        }
+    }
+
+    /// Stop reading; the guest's walk is cancelled with the stream
+    public func close() {
+        iterator = nil
+        buffered = []
+        bufferedOffset = 0
+    }
+}
+
+extension UpperdirEntry {
+    init(_ entry: Arca_Filesystem_V1_UpperdirEntry) {
+        self.init(
+            path: entry.path,
+            type: entry.type,
+            size: entry.size,
+            mtime: entry.mtime,
+            mode: entry.mode
+        )
+    }
+}
+
 /// File stat information for archived paths
 public struct PathStat: Sendable {
     public let name: String
@@ -337,6 +708,78 @@ public struct PathStat: Sendable {
     }
 }
 
+/// Reader for a tar archive streamed from the guest (ReadArchiveStream)
+/// Owns the `FilesystemClient` connection it was created from; call `close()` when done,
+/// including on early exit, to release the vsock channel.
+public actor ArchiveStreamReader {
+    /// Stat of the archived path (for X-Docker-Container-Path-Stat)
+    public nonisolated let stat: PathStat
+
+    private var iterator: GRPCAsyncResponseStream<Arca_Filesystem_V1_ArchiveChunk>.AsyncIterator?
+    private var buffered: Data?
+    private var client: FilesystemClient?
+
+    init(
+        stat: PathStat,
+        iterator: GRPCAsyncResponseStream<Arca_Filesystem_V1_ArchiveChunk>.AsyncIterator?,
+        buffered: Data,
+        client: FilesystemClient
+    ) {
+        self.stat = stat
+        self.iterator = iterator
+        self.buffered = buffered.isEmpty ? nil : buffered
+        self.client = client
+    }
+
+    /// Next chunk of tar data, or nil at end of archive
+    public func next() async throws -> Data? {
+        if let data = buffered {
+            buffered = nil
+            return data
+        }
+
+        guard var current = iterator else {
+            return nil
+        }
+
+        while let chunk = try await current.next() {
+            guard chunk.error.isEmpty else {
+                iterator = nil
+                throw FilesystemClientError.readArchiveFailed(chunk.error)
+            }
+            if !chunk.data.isEmpty {
+                iterator = current
+                return chunk.data
+            }
+        }
+
+        iterator = nil
+        return nil
+    }
+
+    /// Stop reading and disconnect from the filesystem service
+    public func close() async {
+        iterator = nil
+        buffered = nil
+        if let client = client {
+            self.client = nil
+            try? await client.disconnect()
+        }
+    }
+}
+
+extension PathStat {
+    init(_ stat: Arca_Filesystem_V1_PathStat) {
+        self.init(
+            name: stat.name,
+            size: stat.size,
+            mode: stat.mode,
+            mtime: stat.mtime,
+            linkTarget: stat.linkTarget
+        )
+    }
+}
+
 /// Errors from FilesystemClient
 public enum FilesystemClientError: Error, CustomStringConvertible {
     case connectionFailed(String)
@@ -48,6 +48,22 @@ public protocol Arca_Filesystem_V1_FilesystemServiceClientProtocol: GRPCClient {
     _ request: Arca_Filesystem_V1_CreateBindMountRequest,
     callOptions: CallOptions?
   ) -> UnaryCall<Arca_Filesystem_V1_CreateBindMountRequest, Arca_Filesystem_V1_CreateBindMountResponse>
+
+  func readArchiveStream(
+    _ request: Arca_Filesystem_V1_ReadArchiveRequest,
+    callOptions: CallOptions?,
+    handler: @escaping (Arca_Filesystem_V1_ArchiveChunk) -> Void
+  ) -> ServerStreamingCall<Arca_Filesystem_V1_ReadArchiveRequest, Arca_Filesystem_V1_ArchiveChunk>
+
+  func writeArchiveStream(
+    callOptions: CallOptions?
+  ) -> ClientStreamingCall<Arca_Filesystem_V1_WriteArchiveChunk, Arca_Filesystem_V1_WriteArchiveResponse>
+
+  func enumerateUpperdirStream(
+    _ request: Arca_Filesystem_V1_EnumerateUpperdirRequest,
+    callOptions: CallOptions?,
+    handler: @escaping (Arca_Filesystem_V1_EnumerateUpperdirPage) -> Void
+  ) -> ServerStreamingCall<Arca_Filesystem_V1_EnumerateUpperdirRequest, Arca_Filesystem_V1_EnumerateUpperdirPage>
 }
 
 extension Arca_Filesystem_V1_FilesystemServiceClientProtocol {
@@ -173,6 +189,69 @@ extension Arca_Filesystem_V1_FilesystemServiceClientProtocol {
       interceptors: self.interceptors?.makeCreateBindMountInterceptors() ?? []
     )
   }
+
+  /// Read archive as a stream of fixed-size chunks
+  /// First chunk carries the path stat; avoids gRPC message size limits for large paths
+  ///
+  /// - Parameters:
+  ///   - request: Request to send to ReadArchiveStream.
+  ///   - callOptions: Call options.
+  ///   - handler: A closure called when each response is received from the server.
+  /// - Returns: A `ServerStreamingCall` with futures for the metadata and status.
+  public func readArchiveStream(
+    _ request: Arca_Filesystem_V1_ReadArchiveRequest,
+    callOptions: CallOptions? = nil,
+    handler: @escaping (Arca_Filesystem_V1_ArchiveChunk) -> Void
+  ) -> ServerStreamingCall<Arca_Filesystem_V1_ReadArchiveRequest, Arca_Filesystem_V1_ArchiveChunk> {
+    return self.makeServerStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.readArchiveStream.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeReadArchiveStreamInterceptors() ?? [],
+      handler: handler
+    )
+  }
+
+  /// Write archive from a stream of chunks
+  /// First chunk carries container_id and path; extraction is pipelined with the transfer
+  ///
+  /// Callers should use the `send` method on the returned object to send messages
+  /// to the server. The caller should send an `.end` after the final message has been sent.
+  ///
+  /// - Parameters:
+  ///   - callOptions: Call options.
+  /// - Returns: A `ClientStreamingCall` with futures for the metadata, status and response.
+  public func writeArchiveStream(
+    callOptions: CallOptions? = nil
+  ) -> ClientStreamingCall<Arca_Filesystem_V1_WriteArchiveChunk, Arca_Filesystem_V1_WriteArchiveResponse> {
+    return self.makeClientStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.writeArchiveStream.path,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeWriteArchiveStreamInterceptors() ?? []
+    )
+  }
+
+  /// Enumerate upperdir as a stream of pages, optionally filtered by path prefix and depth
+  /// Pages are in walk order; each carries a token to resume after it
+  ///
+  /// - Parameters:
+  ///   - request: Request to send to EnumerateUpperdirStream.
+  ///   - callOptions: Call options.
+  ///   - handler: A closure called when each response is received from the server.
+  /// - Returns: A `ServerStreamingCall` with futures for the metadata and status.
+  public func enumerateUpperdirStream(
+    _ request: Arca_Filesystem_V1_EnumerateUpperdirRequest,
+    callOptions: CallOptions? = nil,
+    handler: @escaping (Arca_Filesystem_V1_EnumerateUpperdirPage) -> Void
+  ) -> ServerStreamingCall<Arca_Filesystem_V1_EnumerateUpperdirRequest, Arca_Filesystem_V1_EnumerateUpperdirPage> {
+    return self.makeServerStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.enumerateUpperdirStream.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeEnumerateUpperdirStreamInterceptors() ?? [],
+      handler: handler
+    )
+  }
 }
 
 @available(*, deprecated)
@@ -268,6 +347,20 @@ public protocol Arca_Filesystem_V1_FilesystemServiceAsyncClientProtocol: GRPCCli
     _ request: Arca_Filesystem_V1_CreateBindMountRequest,
     callOptions: CallOptions?
   ) -> GRPCAsyncUnaryCall<Arca_Filesystem_V1_CreateBindMountRequest, Arca_Filesystem_V1_CreateBindMountResponse>
+
+  func makeReadArchiveStreamCall(
+    _ request: Arca_Filesystem_V1_ReadArchiveRequest,
+    callOptions: CallOptions?
+  ) -> GRPCAsyncServerStreamingCall<Arca_Filesystem_V1_ReadArchiveRequest, Arca_Filesystem_V1_ArchiveChunk>
+
+  func makeWriteArchiveStreamCall(
+    callOptions: CallOptions?
+  ) -> GRPCAsyncClientStreamingCall<Arca_Filesystem_V1_WriteArchiveChunk, Arca_Filesystem_V1_WriteArchiveResponse>
+
+  func makeEnumerateUpperdirStreamCall(
+    _ request: Arca_Filesystem_V1_EnumerateUpperdirRequest,
+    callOptions: CallOptions?
+  ) -> GRPCAsyncServerStreamingCall<Arca_Filesystem_V1_EnumerateUpperdirRequest, Arca_Filesystem_V1_EnumerateUpperdirPage>
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -351,6 +444,40 @@ extension Arca_Filesystem_V1_FilesystemServiceAsyncClientProtocol {
       interceptors: self.interceptors?.makeCreateBindMountInterceptors() ?? []
     )
   }
+
+  public func makeReadArchiveStreamCall(
+    _ request: Arca_Filesystem_V1_ReadArchiveRequest,
+    callOptions: CallOptions? = nil
+  ) -> GRPCAsyncServerStreamingCall<Arca_Filesystem_V1_ReadArchiveRequest, Arca_Filesystem_V1_ArchiveChunk> {
+    return self.makeAsyncServerStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.readArchiveStream.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeReadArchiveStreamInterceptors() ?? []
+    )
+  }
+
+  public func makeWriteArchiveStreamCall(
+    callOptions: CallOptions? = nil
+  ) -> GRPCAsyncClientStreamingCall<Arca_Filesystem_V1_WriteArchiveChunk, Arca_Filesystem_V1_WriteArchiveResponse> {
+    return self.makeAsyncClientStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.writeArchiveStream.path,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeWriteArchiveStreamInterceptors() ?? []
+    )
+  }
+
+  public func makeEnumerateUpperdirStreamCall(
+    _ request: Arca_Filesystem_V1_EnumerateUpperdirRequest,
+    callOptions: CallOptions? = nil
+  ) -> GRPCAsyncServerStreamingCall<Arca_Filesystem_V1_EnumerateUpperdirRequest, Arca_Filesystem_V1_EnumerateUpperdirPage> {
+    return self.makeAsyncServerStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.enumerateUpperdirStream.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeEnumerateUpperdirStreamInterceptors() ?? []
+    )
+  }
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -426,6 +553,54 @@ extension Arca_Filesystem_V1_FilesystemServiceAsyncClientProtocol {
       interceptors: self.interceptors?.makeCreateBindMountInterceptors() ?? []
     )
   }
+
+  public func readArchiveStream(
+    _ request: Arca_Filesystem_V1_ReadArchiveRequest,
+    callOptions: CallOptions? = nil
+  ) -> GRPCAsyncResponseStream<Arca_Filesystem_V1_ArchiveChunk> {
+    return self.performAsyncServerStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.readArchiveStream.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeReadArchiveStreamInterceptors() ?? []
+    )
+  }
+
+  public func enumerateUpperdirStream(
+    _ request: Arca_Filesystem_V1_EnumerateUpperdirRequest,
+    callOptions: CallOptions? = nil
+  ) -> GRPCAsyncResponseStream<Arca_Filesystem_V1_EnumerateUpperdirPage> {
+    return self.performAsyncServerStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.enumerateUpperdirStream.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeEnumerateUpperdirStreamInterceptors() ?? []
+    )
+  }
+
+  public func writeArchiveStream<RequestStream>(
+    _ requests: RequestStream,
+    callOptions: CallOptions? = nil
+  ) async throws -> Arca_Filesystem_V1_WriteArchiveResponse where RequestStream: Sequence, RequestStream.Element == Arca_Filesystem_V1_WriteArchiveChunk {
+    return try await self.performAsyncClientStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.writeArchiveStream.path,
+      requests: requests,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeWriteArchiveStreamInterceptors() ?? []
+    )
+  }
+
+  public func writeArchiveStream<RequestStream>(
+    _ requests: RequestStream,
+    callOptions: CallOptions? = nil
+  ) async throws -> Arca_Filesystem_V1_WriteArchiveResponse where RequestStream: AsyncSequence & Sendable, RequestStream.Element == Arca_Filesystem_V1_WriteArchiveChunk {
+    return try await self.performAsyncClientStreamingCall(
+      path: Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.writeArchiveStream.path,
+      requests: requests,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeWriteArchiveStreamInterceptors() ?? []
+    )
+  }
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -464,6 +639,15 @@ public protocol Arca_Filesystem_V1_FilesystemServiceClientInterceptorFactoryProt
 
   /// - Returns: Interceptors to use when invoking 'createBindMount'.
   func makeCreateBindMountInterceptors() -> [ClientInterceptor<Arca_Filesystem_V1_CreateBindMountRequest, Arca_Filesystem_V1_CreateBindMountResponse>]
+
+  /// - Returns: Interceptors to use when invoking 'readArchiveStream'.
+  func makeReadArchiveStreamInterceptors() -> [ClientInterceptor<Arca_Filesystem_V1_ReadArchiveRequest, Arca_Filesystem_V1_ArchiveChunk>]
+
+  /// - Returns: Interceptors to use when invoking 'writeArchiveStream'.
+  func makeWriteArchiveStreamInterceptors() -> [ClientInterceptor<Arca_Filesystem_V1_WriteArchiveChunk, Arca_Filesystem_V1_WriteArchiveResponse>]
+
+  /// - Returns: Interceptors to use when invoking 'enumerateUpperdirStream'.
+  func makeEnumerateUpperdirStreamInterceptors() -> [ClientInterceptor<Arca_Filesystem_V1_EnumerateUpperdirRequest, Arca_Filesystem_V1_EnumerateUpperdirPage>]
 }
 
 public enum Arca_Filesystem_V1_FilesystemServiceClientMetadata {
@@ -477,6 +661,9 @@ public enum Arca_Filesystem_V1_FilesystemServiceClientMetadata {
       Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.readArchive,
       Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.writeArchive,
       Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.createBindMount,
+      Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.readArchiveStream,
+      Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.writeArchiveStream,
+      Arca_Filesystem_V1_FilesystemServiceClientMetadata.Methods.enumerateUpperdirStream,
     ]
   )
 
@@ -516,6 +703,24 @@ public enum Arca_Filesystem_V1_FilesystemServiceClientMetadata {
       path: "/arca.filesystem.v1.FilesystemService/CreateBindMount",
       type: GRPCCallType.unary
     )
+
+    public static let readArchiveStream = GRPCMethodDescriptor(
+      name: "ReadArchiveStream",
+      path: "/arca.filesystem.v1.FilesystemService/ReadArchiveStream",
+      type: GRPCCallType.serverStreaming
+    )
+
+    public static let writeArchiveStream = GRPCMethodDescriptor(
+      name: "WriteArchiveStream",
+      path: "/arca.filesystem.v1.FilesystemService/WriteArchiveStream",
+      type: GRPCCallType.clientStreaming
+    )
+
+    public static let enumerateUpperdirStream = GRPCMethodDescriptor(
+      name: "EnumerateUpperdirStream",
+      path: "/arca.filesystem.v1.FilesystemService/EnumerateUpperdirStream",
+      type: GRPCCallType.serverStreaming
+    )
   }
 }
 
@@ -89,11 +89,27 @@ public struct Arca_Filesystem_V1_SyncFilesystemResponse: Sendable {
 }
 
 /// Request to enumerate OverlayFS upperdir for container diff
+/// The filter and paging fields are honoured by EnumerateUpperdirStream only
 public struct Arca_Filesystem_V1_EnumerateUpperdirRequest: Sendable {
   // SwiftProtobuf.Message conformance is added in an extension below. See the
   // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
   // methods supported on all messages.
 
+  /// Only entries at or below this path (e.g., "/var/cache"); empty for the whole upperdir
+  public var pathPrefix: String = String()
+
+  /// Levels below path_prefix to descend (1 = direct children); 0 for unlimited
+  public var maxDepth: UInt32 = 0
+
+  /// Entries per page; 0 for the service default
+  public var pageSize: UInt32 = 0
+
+  /// Resume after the page that returned this token; empty to start from the beginning
+  public var pageToken: String = String()
+
+  /// Answer from the guest's change journal when it is current, instead of walking upperdir
+  public var allowCached: Bool = false
+
   public var unknownFields = SwiftProtobuf.UnknownStorage()
 
   public init() {}
@@ -118,6 +134,29 @@ public struct Arca_Filesystem_V1_EnumerateUpperdirResponse: Sendable {
   public init() {}
 }
 
+/// One page of an upperdir enumeration (EnumerateUpperdirStream)
+public struct Arca_Filesystem_V1_EnumerateUpperdirPage: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  /// Error message; set on the final message if enumeration failed
+  public var error: String = String()
+
+  /// Entries in this page
+  public var entries: [Arca_Filesystem_V1_UpperdirEntry] = []
+
+  /// Token to resume after this page; empty on the last page
+  public var nextPageToken: String = String()
+
+  /// Page was served from the guest's change journal rather than a walk
+  public var cached: Bool = false
+
+  public var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  public init() {}
+}
+
 /// Represents a file, directory, or whiteout in the OverlayFS upperdir
 public struct Arca_Filesystem_V1_UpperdirEntry: Sendable {
   // SwiftProtobuf.Message conformance is added in an extension below. See the
@@ -296,6 +335,55 @@ public struct Arca_Filesystem_V1_CreateBindMountResponse: Sendable {
   public init() {}
 }
 
+/// Chunk of a streamed tar archive (ReadArchiveStream)
+public struct Arca_Filesystem_V1_ArchiveChunk: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  /// Tar archive bytes (at most 1 MiB per chunk)
+  public var data: Data = Data()
+
+  /// File stat information - set on the first chunk only
+  public var stat: Arca_Filesystem_V1_PathStat {
+    get {return _stat ?? Arca_Filesystem_V1_PathStat()}
+    set {_stat = newValue}
+  }
+  /// Returns true if `stat` has been explicitly set.
+  public var hasStat: Bool {return self._stat != nil}
+  /// Clears the value of `stat`. Subsequent reads from it will return its default value.
+  public mutating func clearStat() {self._stat = nil}
+
+  /// Error message if archive creation failed mid-stream
+  public var error: String = String()
+
+  public var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  public init() {}
+
+  fileprivate var _stat: Arca_Filesystem_V1_PathStat? = nil
+}
+
+/// Chunk of a tar archive to extract (WriteArchiveStream)
+public struct Arca_Filesystem_V1_WriteArchiveChunk: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  /// Container ID - set on the first chunk only
+  public var containerID: String = String()
+
+  /// Destination path where archive should be extracted - set on the first chunk only
+  public var path: String = String()
+
+  /// Tar archive bytes
+  public var data: Data = Data()
+
+  public var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  public init() {}
+}
+
 // MARK: - Code below here is support for the SwiftProtobuf runtime.
 
 fileprivate let _protobuf_package = "arca.filesystem.v1"
@@ -415,18 +503,49 @@ extension Arca_Filesystem_V1_SyncFilesystemResponse: SwiftProtobuf.Message, Swif
 
 extension Arca_Filesystem_V1_EnumerateUpperdirRequest: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
   public static let protoMessageName: String = _protobuf_package + ".EnumerateUpperdirRequest"
-  public static let _protobuf_nameMap = SwiftProtobuf._NameMap()
+  public static let _protobuf_nameMap = SwiftProtobuf._NameMap(bytecode: "\0\u{3}path_prefix\0\u{3}max_depth\0\u{3}page_size\0\u{3}page_token\0\u{3}allow_cached\0")
 
   public mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
-    // Load everything into unknown fields
-    while try decoder.nextFieldNumber() != nil {}
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.pathPrefix) }()
+      case 2: try { try decoder.decodeSingularUInt32Field(value: &self.maxDepth) }()
+      case 3: try { try decoder.decodeSingularUInt32Field(value: &self.pageSize) }()
+      case 4: try { try decoder.decodeSingularStringField(value: &self.pageToken) }()
+      case 5: try { try decoder.decodeSingularBoolField(value: &self.allowCached) }()
+      default: break
+      }
+    }
   }
 
   public func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.pathPrefix.isEmpty {
+      try visitor.visitSingularStringField(value: self.pathPrefix, fieldNumber: 1)
+    }
+    if self.maxDepth != 0 {
+      try visitor.visitSingularUInt32Field(value: self.maxDepth, fieldNumber: 2)
+    }
+    if self.pageSize != 0 {
+      try visitor.visitSingularUInt32Field(value: self.pageSize, fieldNumber: 3)
+    }
+    if !self.pageToken.isEmpty {
+      try visitor.visitSingularStringField(value: self.pageToken, fieldNumber: 4)
+    }
+    if self.allowCached != false {
+      try visitor.visitSingularBoolField(value: self.allowCached, fieldNumber: 5)
+    }
     try unknownFields.traverse(visitor: &visitor)
   }
 
   public static func ==(lhs: Arca_Filesystem_V1_EnumerateUpperdirRequest, rhs: Arca_Filesystem_V1_EnumerateUpperdirRequest) -> Bool {
+    if lhs.pathPrefix != rhs.pathPrefix {return false}
+    if lhs.maxDepth != rhs.maxDepth {return false}
+    if lhs.pageSize != rhs.pageSize {return false}
+    if lhs.pageToken != rhs.pageToken {return false}
+    if lhs.allowCached != rhs.allowCached {return false}
     if lhs.unknownFields != rhs.unknownFields {return false}
     return true
   }
@@ -472,6 +591,51 @@ extension Arca_Filesystem_V1_EnumerateUpperdirResponse: SwiftProtobuf.Message, S
   }
 }
 
+extension Arca_Filesystem_V1_EnumerateUpperdirPage: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  public static let protoMessageName: String = _protobuf_package + ".EnumerateUpperdirPage"
+  public static let _protobuf_nameMap = SwiftProtobuf._NameMap(bytecode: "\0\u{1}error\0\u{1}entries\0\u{3}next_page_token\0\u{1}cached\0")
+
+  public mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.error) }()
+      case 2: try { try decoder.decodeRepeatedMessageField(value: &self.entries) }()
+      case 3: try { try decoder.decodeSingularStringField(value: &self.nextPageToken) }()
+      case 4: try { try decoder.decodeSingularBoolField(value: &self.cached) }()
+      default: break
+      }
+    }
+  }
+
+  public func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.error.isEmpty {
+      try visitor.visitSingularStringField(value: self.error, fieldNumber: 1)
+    }
+    if !self.entries.isEmpty {
+      try visitor.visitRepeatedMessageField(value: self.entries, fieldNumber: 2)
+    }
+    if !self.nextPageToken.isEmpty {
+      try visitor.visitSingularStringField(value: self.nextPageToken, fieldNumber: 3)
+    }
+    if self.cached != false {
+      try visitor.visitSingularBoolField(value: self.cached, fieldNumber: 4)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  public static func ==(lhs: Arca_Filesystem_V1_EnumerateUpperdirPage, rhs: Arca_Filesystem_V1_EnumerateUpperdirPage) -> Bool {
+    if lhs.error != rhs.error {return false}
+    if lhs.entries != rhs.entries {return false}
+    if lhs.nextPageToken != rhs.nextPageToken {return false}
+    if lhs.cached != rhs.cached {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
 extension Arca_Filesystem_V1_UpperdirEntry: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
   public static let protoMessageName: String = _protobuf_package + ".UpperdirEntry"
   public static let _protobuf_nameMap = SwiftProtobuf._NameMap(bytecode: "\0\u{1}path\0\u{1}type\0\u{1}size\0\u{1}mtime\0\u{1}mode\0")
@@ -810,3 +974,87 @@ extension Arca_Filesystem_V1_CreateBindMountResponse: SwiftProtobuf.Message, Swi
     return true
   }
 }
+
+extension Arca_Filesystem_V1_ArchiveChunk: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  public static let protoMessageName: String = _protobuf_package + ".ArchiveChunk"
+  public static let _protobuf_nameMap = SwiftProtobuf._NameMap(bytecode: "\0\u{1}data\0\u{1}stat\0\u{1}error\0")
+
+  public mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularBytesField(value: &self.data) }()
+      case 2: try { try decoder.decodeSingularMessageField(value: &self._stat) }()
+      case 3: try { try decoder.decodeSingularStringField(value: &self.error) }()
+      default: break
+      }
+    }
+  }
+
+  public func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    // The use of inline closures is to circumvent an issue where the compiler
+    // allocates stack space for every if/case branch local when no optimizations
+    // are enabled. https://github.com/apple/swift-protobuf/issues/1034 and
+    // https://github.com/apple/swift-protobuf/issues/1182
+    if !self.data.isEmpty {
+      try visitor.visitSingularBytesField(value: self.data, fieldNumber: 1)
+    }
+    try { if let v = self._stat {
+      try visitor.visitSingularMessageField(value: v, fieldNumber: 2)
+    } }()
+    if !self.error.isEmpty {
+      try visitor.visitSingularStringField(value: self.error, fieldNumber: 3)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  public static func ==(lhs: Arca_Filesystem_V1_ArchiveChunk, rhs: Arca_Filesystem_V1_ArchiveChunk) -> Bool {
+    if lhs.data != rhs.data {return false}
+    if lhs._stat != rhs._stat {return false}
+    if lhs.error != rhs.error {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Arca_Filesystem_V1_WriteArchiveChunk: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  public static let protoMessageName: String = _protobuf_package + ".WriteArchiveChunk"
+  public static let _protobuf_nameMap = SwiftProtobuf._NameMap(bytecode: "\0\u{3}container_id\0\u{1}path\0\u{1}data\0")
+
+  public mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularStringField(value: &self.containerID) }()
+      case 2: try { try decoder.decodeSingularStringField(value: &self.path) }()
+      case 3: try { try decoder.decodeSingularBytesField(value: &self.data) }()
+      default: break
+      }
+    }
+  }
+
+  public func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.containerID.isEmpty {
+      try visitor.visitSingularStringField(value: self.containerID, fieldNumber: 1)
+    }
+    if !self.path.isEmpty {
+      try visitor.visitSingularStringField(value: self.path, fieldNumber: 2)
+    }
+    if !self.data.isEmpty {
+      try visitor.visitSingularBytesField(value: self.data, fieldNumber: 3)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  public static func ==(lhs: Arca_Filesystem_V1_WriteArchiveChunk, rhs: Arca_Filesystem_V1_WriteArchiveChunk) -> Bool {
+    if lhs.containerID != rhs.containerID {return false}
+    if lhs.path != rhs.path {return false}
+    if lhs.data != rhs.data {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
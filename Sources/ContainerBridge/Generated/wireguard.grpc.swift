@@ -68,6 +68,16 @@ public protocol Arca_Wireguard_V1_WireGuardServiceClientProtocol: GRPCClient {
     _ request: Arca_Wireguard_V1_DumpNftablesRequest,
     callOptions: CallOptions?
   ) -> UnaryCall<Arca_Wireguard_V1_DumpNftablesRequest, Arca_Wireguard_V1_DumpNftablesResponse>
+
+  func addPeers(
+    _ request: Arca_Wireguard_V1_AddPeersRequest,
+    callOptions: CallOptions?
+  ) -> UnaryCall<Arca_Wireguard_V1_AddPeersRequest, Arca_Wireguard_V1_AddPeersResponse>
+
+  func applyTopologyDelta(
+    _ request: Arca_Wireguard_V1_ApplyTopologyDeltaRequest,
+    callOptions: CallOptions?
+  ) -> UnaryCall<Arca_Wireguard_V1_ApplyTopologyDeltaRequest, Arca_Wireguard_V1_ApplyTopologyDeltaResponse>
 }
 
 extension Arca_Wireguard_V1_WireGuardServiceClientProtocol {
@@ -256,6 +266,42 @@ extension Arca_Wireguard_V1_WireGuardServiceClientProtocol {
       interceptors: self.interceptors?.makeDumpNftablesInterceptors() ?? []
     )
   }
+
+  /// Add several peers in one call (mesh setup on network attach)
+  ///
+  /// - Parameters:
+  ///   - request: Request to send to AddPeers.
+  ///   - callOptions: Call options.
+  /// - Returns: A `UnaryCall` with futures for the metadata, status and response.
+  public func addPeers(
+    _ request: Arca_Wireguard_V1_AddPeersRequest,
+    callOptions: CallOptions? = nil
+  ) -> UnaryCall<Arca_Wireguard_V1_AddPeersRequest, Arca_Wireguard_V1_AddPeersResponse> {
+    return self.makeUnaryCall(
+      path: Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.addPeers.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeAddPeersInterceptors() ?? []
+    )
+  }
+
+  /// Apply a versioned change to one network's peers and DNS records
+  ///
+  /// - Parameters:
+  ///   - request: Request to send to ApplyTopologyDelta.
+  ///   - callOptions: Call options.
+  /// - Returns: A `UnaryCall` with futures for the metadata, status and response.
+  public func applyTopologyDelta(
+    _ request: Arca_Wireguard_V1_ApplyTopologyDeltaRequest,
+    callOptions: CallOptions? = nil
+  ) -> UnaryCall<Arca_Wireguard_V1_ApplyTopologyDeltaRequest, Arca_Wireguard_V1_ApplyTopologyDeltaResponse> {
+    return self.makeUnaryCall(
+      path: Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.applyTopologyDelta.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeApplyTopologyDeltaInterceptors() ?? []
+    )
+  }
 }
 
 @available(*, deprecated)
@@ -371,6 +417,16 @@ public protocol Arca_Wireguard_V1_WireGuardServiceAsyncClientProtocol: GRPCClien
     _ request: Arca_Wireguard_V1_DumpNftablesRequest,
     callOptions: CallOptions?
   ) -> GRPCAsyncUnaryCall<Arca_Wireguard_V1_DumpNftablesRequest, Arca_Wireguard_V1_DumpNftablesResponse>
+
+  func makeAddPeersCall(
+    _ request: Arca_Wireguard_V1_AddPeersRequest,
+    callOptions: CallOptions?
+  ) -> GRPCAsyncUnaryCall<Arca_Wireguard_V1_AddPeersRequest, Arca_Wireguard_V1_AddPeersResponse>
+
+  func makeApplyTopologyDeltaCall(
+    _ request: Arca_Wireguard_V1_ApplyTopologyDeltaRequest,
+    callOptions: CallOptions?
+  ) -> GRPCAsyncUnaryCall<Arca_Wireguard_V1_ApplyTopologyDeltaRequest, Arca_Wireguard_V1_ApplyTopologyDeltaResponse>
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -502,6 +558,30 @@ extension Arca_Wireguard_V1_WireGuardServiceAsyncClientProtocol {
       interceptors: self.interceptors?.makeDumpNftablesInterceptors() ?? []
     )
   }
+
+  public func makeAddPeersCall(
+    _ request: Arca_Wireguard_V1_AddPeersRequest,
+    callOptions: CallOptions? = nil
+  ) -> GRPCAsyncUnaryCall<Arca_Wireguard_V1_AddPeersRequest, Arca_Wireguard_V1_AddPeersResponse> {
+    return self.makeAsyncUnaryCall(
+      path: Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.addPeers.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeAddPeersInterceptors() ?? []
+    )
+  }
+
+  public func makeApplyTopologyDeltaCall(
+    _ request: Arca_Wireguard_V1_ApplyTopologyDeltaRequest,
+    callOptions: CallOptions? = nil
+  ) -> GRPCAsyncUnaryCall<Arca_Wireguard_V1_ApplyTopologyDeltaRequest, Arca_Wireguard_V1_ApplyTopologyDeltaResponse> {
+    return self.makeAsyncUnaryCall(
+      path: Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.applyTopologyDelta.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeApplyTopologyDeltaInterceptors() ?? []
+    )
+  }
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -625,6 +705,30 @@ extension Arca_Wireguard_V1_WireGuardServiceAsyncClientProtocol {
       interceptors: self.interceptors?.makeDumpNftablesInterceptors() ?? []
     )
   }
+
+  public func addPeers(
+    _ request: Arca_Wireguard_V1_AddPeersRequest,
+    callOptions: CallOptions? = nil
+  ) async throws -> Arca_Wireguard_V1_AddPeersResponse {
+    return try await self.performAsyncUnaryCall(
+      path: Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.addPeers.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeAddPeersInterceptors() ?? []
+    )
+  }
+
+  public func applyTopologyDelta(
+    _ request: Arca_Wireguard_V1_ApplyTopologyDeltaRequest,
+    callOptions: CallOptions? = nil
+  ) async throws -> Arca_Wireguard_V1_ApplyTopologyDeltaResponse {
+    return try await self.performAsyncUnaryCall(
+      path: Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.applyTopologyDelta.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeApplyTopologyDeltaInterceptors() ?? []
+    )
+  }
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -675,6 +779,12 @@ public protocol Arca_Wireguard_V1_WireGuardServiceClientInterceptorFactoryProtoc
 
   /// - Returns: Interceptors to use when invoking 'dumpNftables'.
   func makeDumpNftablesInterceptors() -> [ClientInterceptor<Arca_Wireguard_V1_DumpNftablesRequest, Arca_Wireguard_V1_DumpNftablesResponse>]
+
+  /// - Returns: Interceptors to use when invoking 'addPeers'.
+  func makeAddPeersInterceptors() -> [ClientInterceptor<Arca_Wireguard_V1_AddPeersRequest, Arca_Wireguard_V1_AddPeersResponse>]
+
+  /// - Returns: Interceptors to use when invoking 'applyTopologyDelta'.
+  func makeApplyTopologyDeltaInterceptors() -> [ClientInterceptor<Arca_Wireguard_V1_ApplyTopologyDeltaRequest, Arca_Wireguard_V1_ApplyTopologyDeltaResponse>]
 }
 
 public enum Arca_Wireguard_V1_WireGuardServiceClientMetadata {
@@ -692,6 +802,8 @@ public enum Arca_Wireguard_V1_WireGuardServiceClientMetadata {
       Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.publishPort,
       Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.unpublishPort,
       Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.dumpNftables,
+      Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.addPeers,
+      Arca_Wireguard_V1_WireGuardServiceClientMetadata.Methods.applyTopologyDelta,
     ]
   )
 
@@ -755,6 +867,18 @@ public enum Arca_Wireguard_V1_WireGuardServiceClientMetadata {
       path: "/arca.wireguard.v1.WireGuardService/DumpNftables",
       type: GRPCCallType.unary
     )
+
+    public static let addPeers = GRPCMethodDescriptor(
+      name: "AddPeers",
+      path: "/arca.wireguard.v1.WireGuardService/AddPeers",
+      type: GRPCCallType.unary
+    )
+
+    public static let applyTopologyDelta = GRPCMethodDescriptor(
+      name: "ApplyTopologyDelta",
+      path: "/arca.wireguard.v1.WireGuardService/ApplyTopologyDelta",
+      type: GRPCCallType.unary
+    )
   }
 }
 
@@ -3,18 +3,55 @@ import Logging
 import Containerization
 import ContainerizationExtras
 
+/// Health check scheduling (`healthChecks` in config.json)
+public struct HealthCheckerConfig: Codable, Sendable {
+    /// Checks allowed to run at once across all containers; 16 when unset
+    public let maxConcurrentChecks: Int?
+    /// Run recognised HTTP/TCP checks (`curl -f`, `wget`, `nc -z`) as native probes in the
+    /// guest service instead of spawning the command; off when unset
+    public let nativeProbes: Bool?
+
+    public init(maxConcurrentChecks: Int? = nil, nativeProbes: Bool? = nil) {
+        self.maxConcurrentChecks = maxConcurrentChecks
+        self.nativeProbes = nativeProbes
+    }
+}
+
 /// Health checker actor that manages health check execution for containers
 /// Reference: Docker Engine API v1.51 - Health checks
 /// Phase 6 - Task 6.2
+///
+/// All containers' checks are driven by one timing wheel and one scheduler task instead of a
+/// sleeping task per container. Deadlines are jittered so containers started together don't
+/// check in lockstep, and at most `maxConcurrentChecks` checks run at once; due checks beyond
+/// that wait their turn. Checks go to the guest's process service over the container's
+/// persistent control channel, falling back to a regular exec when the guest lacks Probe.
 public actor HealthChecker {
     private let logger: Logger
     private let execManager: ExecManager
-
-    /// Active health check tasks by container ID
-    private var activeTasks: [String: Task<Void, Never>] = [:]
+    private let controlChannels: (@Sendable (String) async -> ControlChannelPool?)?
+    private let maxConcurrentChecks: Int
+    private let nativeProbes: Bool
 
     /// Health status by container ID
     private var healthStatus: [String: HealthState] = [:]
+    private var nextGeneration: UInt64 = 0
+
+    // Scheduling: one wheel of 100 ms ticks (51 s per revolution; longer intervals re-slot lazily)
+    private static let tickSeconds: TimeInterval = 0.1
+    private var wheel = TimingWheel<String>(slotCount: 512)
+    private let epoch = Date()
+    private var schedulerTask: Task<Void, Never>?
+    private var ready: [String] = []  // Due checks waiting for a concurrency slot, oldest first
+    private var running: Set<String> = []
+
+    /// Containers whose guest service has no Probe RPC; checks use exec
+    private var probeUnsupported: Set<String> = []
+
+    /// Told about every status change, so readers need not call into the actor
+    private var statusObserver: (@Sendable (String, Health?) -> Void)?
+
+    private let timestampFormatter = ISO8601DateFormatter()
 
     /// Internal health state tracking
     private struct HealthState {
@@ -23,6 +60,7 @@ public actor HealthChecker {
         var log: [HealthcheckResult]
         let config: EffectiveHealthConfig
         let containerStartTime: Date
+        let generation: UInt64  // Distinguishes a restarted check from a stale in-flight one
     }
 
     /// Effective health config with defaults applied
@@ -46,11 +84,21 @@ public actor HealthChecker {
         }
     }
 
-    public init(logger: Logger, execManager: ExecManager) {
+    /// - Parameter controlChannels: Looks up a container's persistent control channels; checks
+    ///   exec a new process each time when nil
+    public init(
+        logger: Logger,
+        execManager: ExecManager,
+        config: HealthCheckerConfig? = nil,
+        controlChannels: (@Sendable (String) async -> ControlChannelPool?)? = nil
+    ) {
         var logger = logger
         logger[metadataKey: "component"] = "HealthChecker"
         self.logger = logger
         self.execManager = execManager
+        self.controlChannels = controlChannels
+        self.maxConcurrentChecks = max(config?.maxConcurrentChecks ?? 16, 1)
+        self.nativeProbes = config?.nativeProbes ?? false
     }
 
     /// Start health checks for a container
@@ -67,6 +115,7 @@ public actor HealthChecker {
         stop(containerID: containerID)
 
         let effectiveConfig = EffectiveHealthConfig(from: config)
+        nextGeneration += 1
 
         // Validate config
         guard !effectiveConfig.test.isEmpty else {
@@ -82,35 +131,45 @@ public actor HealthChecker {
                 failingStreak: 0,
                 log: [],
                 config: effectiveConfig,
-                containerStartTime: containerStartTime
+                containerStartTime: containerStartTime,
+                generation: nextGeneration
             )
+            publishStatus(containerID: containerID)
             return
         }
 
         // Initialize health state as "starting"
-        healthStatus[containerID] = HealthState(
+        let state = HealthState(
             status: "starting",
             failingStreak: 0,
             log: [],
             config: effectiveConfig,
-            containerStartTime: containerStartTime
+            containerStartTime: containerStartTime,
+            generation: nextGeneration
         )
+        healthStatus[containerID] = state
+        publishStatus(containerID: containerID)
 
-        // Start health check loop in background task
-        let task = Task {
-            await runHealthCheckLoop(containerID: containerID)
-        }
-
-        activeTasks[containerID] = task
+        // First check after one interval, like Docker
+        scheduleNext(containerID: containerID, state: state)
     }
 
     /// Stop health checks for a container
     public func stop(containerID: String) {
         logger.info("Stopping health checks", metadata: ["container_id": "\(containerID)"])
 
-        activeTasks[containerID]?.cancel()
-        activeTasks.removeValue(forKey: containerID)
-        healthStatus.removeValue(forKey: containerID)
+        // An in-flight check finishes but its result is discarded (generation no longer matches)
+        wheel.remove(containerID)
+        ready.removeAll { $0 == containerID }
+        probeUnsupported.remove(containerID)
+        if healthStatus.removeValue(forKey: containerID) != nil {
+            statusObserver?(containerID, nil)
+        }
+    }
+
+    /// Register the receiver of status changes (ContainerManager's registry)
+    public func setStatusObserver(_ observer: @escaping @Sendable (String, Health?) -> Void) {
+        statusObserver = observer
     }
 
     /// Get current health status for a container
@@ -126,68 +185,224 @@ public actor HealthChecker {
         )
     }
 
-    /// Run the health check loop for a container
-    private func runHealthCheckLoop(containerID: String) async {
-        logger.debug("Health check loop started", metadata: ["container_id": "\(containerID)"])
+    private func publishStatus(containerID: String) {
+        statusObserver?(containerID, getStatus(containerID: containerID))
+    }
+
+    // MARK: - Scheduling
+
+    private func currentTick() -> UInt64 {
+        UInt64(max(Date().timeIntervalSince(epoch), 0) / Self.tickSeconds)
+    }
+
+    /// Put the container's next check on the wheel
+    /// Up to 10% of the interval (capped at 1 s) of jitter spreads containers started together
+    private func scheduleNext(containerID: String, state: HealthState) {
+        let inStartPeriod = Date().timeIntervalSince(state.containerStartTime) < state.config.startPeriod
+        let interval = inStartPeriod ? state.config.startInterval : state.config.interval
+        let jitter = Double.random(in: 0...min(interval * 0.1, 1.0))
+        let ticks = UInt64(max((interval + jitter) / Self.tickSeconds, 1))
+
+        wheel.schedule(containerID, at: currentTick() + ticks)
+        ensureScheduler()
+    }
+
+    private func ensureScheduler() {
+        guard schedulerTask == nil else { return }
+        schedulerTask = Task { [weak self] in
+            await self?.runScheduler()
+        }
+    }
+
+    /// Single loop driving every container's checks; exits when nothing is scheduled
+    private func runScheduler() async {
+        logger.debug("Health check scheduler started")
 
         while !Task.isCancelled {
-            guard let state = healthStatus[containerID] else {
-                logger.warning("Health state not found, stopping loop", metadata: ["container_id": "\(containerID)"])
-                break
+            try? await Task.sleep(for: .milliseconds(Int(Self.tickSeconds * 1000)))
+
+            let tick = currentTick()
+            for containerID in wheel.advance(to: tick) where healthStatus[containerID] != nil {
+                if running.contains(containerID) {
+                    // Previous check still running (timeout longer than interval); retry next tick
+                    wheel.schedule(containerID, at: tick + 1)
+                } else if !ready.contains(containerID) {
+                    ready.append(containerID)
+                }
             }
+            dispatchReady()
 
-            // Determine check interval based on whether we're in start period
-            let timeSinceStart = Date().timeIntervalSince(state.containerStartTime)
-            let inStartPeriod = timeSinceStart < state.config.startPeriod
-            let checkInterval = inStartPeriod ? state.config.startInterval : state.config.interval
-
-            // Wait for next check
-            do {
-                try await Task.sleep(nanoseconds: UInt64(checkInterval * 1_000_000_000))
-            } catch {
-                logger.debug("Health check loop cancelled during sleep", metadata: ["container_id": "\(containerID)"])
+            if wheel.count == 0 && ready.isEmpty && running.isEmpty {
                 break
             }
+        }
 
-            if Task.isCancelled {
-                break
+        schedulerTask = nil
+        logger.debug("Health check scheduler idle")
+    }
+
+    /// Start due checks while the concurrency budget allows
+    private func dispatchReady() {
+        while running.count < maxConcurrentChecks, !ready.isEmpty {
+            let containerID = ready.removeFirst()
+            guard let state = healthStatus[containerID] else { continue }
+
+            running.insert(containerID)
+            let generation = state.generation
+            Task {
+                await self.runCheck(containerID: containerID, generation: generation)
             }
+        }
 
-            // Run health check
-            await performHealthCheck(containerID: containerID, inStartPeriod: inStartPeriod)
+        if !ready.isEmpty {
+            logger.debug("Health checks waiting for a slot", metadata: [
+                "waiting": "\(ready.count)",
+                "running": "\(running.count)"
+            ])
         }
+    }
+
+    private func runCheck(containerID: String, generation: UInt64) async {
+        await performHealthCheck(containerID: containerID, generation: generation)
+        running.remove(containerID)
 
-        logger.debug("Health check loop stopped", metadata: ["container_id": "\(containerID)"])
+        if let state = healthStatus[containerID], state.generation == generation {
+            scheduleNext(containerID: containerID, state: state)
+        }
+        dispatchReady()
     }
 
+    // MARK: - Checks
+
     /// Perform a single health check
-    private func performHealthCheck(containerID: String, inStartPeriod: Bool) async {
-        guard var state = healthStatus[containerID] else {
+    private func performHealthCheck(containerID: String, generation: UInt64) async {
+        guard let initial = healthStatus[containerID], initial.generation == generation else {
             return
         }
 
+        let timeSinceStart = Date().timeIntervalSince(initial.containerStartTime)
+        let inStartPeriod = timeSinceStart < initial.config.startPeriod
         let startTime = Date()
-        let startISO = ISO8601DateFormatter().string(from: startTime)
 
         logger.debug("Running health check", metadata: [
             "container_id": "\(containerID)",
             "in_start_period": "\(inStartPeriod)",
-            "current_status": "\(state.status)",
-            "failing_streak": "\(state.failingStreak)"
+            "current_status": "\(initial.status)",
+            "failing_streak": "\(initial.failingStreak)"
         ])
 
-        // Parse the health check command
-        let (cmd, args) = parseHealthCommand(state.config.test)
+        let (exitCode, output) = await runProbe(containerID: containerID, config: initial.config)
+        let endTime = Date()
+
+        // The container may have been stopped or restarted while the check ran
+        guard var state = healthStatus[containerID], state.generation == generation else {
+            return
+        }
+
+        // Interpret exit code: 0 = healthy, 1 = unhealthy, 2 = reserved (unhealthy), other = error (unhealthy)
+        let isHealthy = (exitCode == 0)
+
+        // Create health check result
+        let result = HealthcheckResult(
+            start: timestampFormatter.string(from: startTime),
+            end: timestampFormatter.string(from: endTime),
+            exitCode: exitCode,
+            output: output
+        )
+
+        // Update health status
+        if isHealthy {
+            // Successful check - transition to healthy immediately (even during start period)
+            // Start period only prevents FAILURES from counting, not successes
+            state.failingStreak = 0
+            if state.status != "healthy" {
+                if inStartPeriod {
+                    logger.info("Container became healthy during start period", metadata: ["container_id": "\(containerID)"])
+                } else {
+                    logger.info("Container is healthy", metadata: ["container_id": "\(containerID)"])
+                }
+            }
+            state.status = "healthy"
+        } else {
+            // Failed check
+            if inStartPeriod {
+                // During start period, failures don't count toward unhealthy
+                logger.debug("Health check failed during start period (not counted)", metadata: [
+                    "container_id": "\(containerID)",
+                    "exit_code": "\(exitCode)"
+                ])
+            } else {
+                // Outside start period, increment failing streak
+                state.failingStreak += 1
+
+                if state.failingStreak >= state.config.retries {
+                    state.status = "unhealthy"
+                    logger.warning("Container is unhealthy", metadata: [
+                        "container_id": "\(containerID)",
+                        "failing_streak": "\(state.failingStreak)",
+                        "exit_code": "\(exitCode)"
+                    ])
+                } else {
+                    logger.debug("Health check failed", metadata: [
+                        "container_id": "\(containerID)",
+                        "failing_streak": "\(state.failingStreak)",
+                        "exit_code": "\(exitCode)"
+                    ])
+                }
+            }
+        }
+
+        // Add result to log (keep last 5)
+        state.log.append(result)
+        if state.log.count > 5 {
+            state.log.removeFirst()
+        }
+
+        // Update state
+        healthStatus[containerID] = state
+        publishStatus(containerID: containerID)
+    }
+
+    /// Run the check's test and return (exit code, output)
+    /// Prefers the guest process service over the persistent control channel, then exec
+    private func runProbe(containerID: String, config: EffectiveHealthConfig) async -> (Int, String) {
+        let (cmd, args) = parseHealthCommand(config.test)
+
+        if !probeUnsupported.contains(containerID), let pool = await controlChannels?(containerID) {
+            let probe = (nativeProbes ? Self.nativeProbe(for: config.test) : nil) ?? .command([cmd] + args)
+            let client = ProcessControlClient(
+                containerID: containerID,
+                container: pool.container,
+                channelPool: pool,
+                logger: logger
+            )
+
+            do {
+                if let result = try await client.probe(probe, timeout: config.timeout) {
+                    if result.timedOut {
+                        return (2, "Health check timed out after \(config.timeout) seconds")
+                    }
+                    return (result.exitCode, result.output.trimmingCharacters(in: .whitespacesAndNewlines))
+                }
+                probeUnsupported.insert(containerID)
+            } catch {
+                logger.debug("Health probe over control channel failed, using exec", metadata: [
+                    "container_id": "\(containerID)",
+                    "error": "\(error)"
+                ])
+            }
+        }
 
-        // Execute health check via exec
-        let exitCode: Int
-        let output: String
+        return await execProbe(containerID: containerID, command: [cmd] + args, timeout: config.timeout)
+    }
 
+    /// Run the check as a regular exec session (guests without the Probe RPC)
+    private func execProbe(containerID: String, command: [String], timeout: TimeInterval) async -> (Int, String) {
         do {
             // Create exec instance for health check
             let execID = try await execManager.createExec(
                 containerID: containerID,
-                cmd: [cmd] + args,
+                cmd: command,
                 env: nil,  // Use container's default environment
                 workingDir: nil,  // Use container's working directory
                 user: nil,  // Run as container's default user
@@ -199,11 +414,7 @@ public actor HealthChecker {
 
             // Buffer to collect output (uses safe owned storage)
             let outputWriter = BufferWriter()
-
-            // Capture timeout value to avoid actor isolation issues
-            // timeout is already in seconds and defaults to 30.0 via EffectiveHealthConfig
-            let timeoutSeconds = state.config.timeout
-            let timeoutNs = UInt64(timeoutSeconds * 1_000_000_000)
+            let timeoutNs = UInt64(timeout * 1_000_000_000)
 
             // Start exec and wait for completion (with timeout)
             // Race the timeout against exec completion
@@ -248,92 +459,149 @@ public actor HealthChecker {
             }
 
             if didTimeout {
-                // Health check timed out
-                exitCode = 2  // Reserved exit code for timeout (treated as unhealthy)
-                output = "Health check timed out after \(state.config.timeout) seconds"
+                // Reserved exit code for timeout (treated as unhealthy)
                 logger.warning("Health check timed out", metadata: ["container_id": "\(containerID)"])
-            } else {
-                // Get exit code from exec info
-                if let execInfo = await execManager.getExecInfo(execID: execID) {
-                    exitCode = execInfo.exitCode ?? 1  // Default to unhealthy if no exit code
-                    output = String(data: outputWriter.data, encoding: .utf8)?.trimmingCharacters(in: .whitespacesAndNewlines) ?? ""
-                } else {
-                    exitCode = 1  // Exec not found, treat as unhealthy
-                    output = "Health check exec instance not found"
-                }
+                return (2, "Health check timed out after \(timeout) seconds")
+            }
+
+            // Get exit code from exec info
+            guard let execInfo = await execManager.getExecInfo(execID: execID) else {
+                return (1, "Health check exec instance not found")  // Treat as unhealthy
             }
+            let output = String(data: outputWriter.data, encoding: .utf8)?.trimmingCharacters(in: .whitespacesAndNewlines) ?? ""
+            return (execInfo.exitCode ?? 1, output)  // Default to unhealthy if no exit code
         } catch {
             // Failed to create/run exec
-            exitCode = 1
-            output = "Failed to execute health check: \(error)"
             logger.error("Failed to execute health check", metadata: [
                 "container_id": "\(containerID)",
                 "error": "\(error)"
             ])
+            return (1, "Failed to execute health check: \(error)")
         }
+    }
 
-        let endTime = Date()
-        let endISO = ISO8601DateFormatter().string(from: endTime)
-
-        // Interpret exit code: 0 = healthy, 1 = unhealthy, 2 = reserved (unhealthy), other = error (unhealthy)
-        let isHealthy = (exitCode == 0)
-
-        // Create health check result
-        let result = HealthcheckResult(
-            start: startISO,
-            end: endISO,
-            exitCode: exitCode,
-            output: output
-        )
-
-        // Update health status
-        if isHealthy {
-            // Successful check - transition to healthy immediately (even during start period)
-            // Start period only prevents FAILURES from counting, not successes
-            state.failingStreak = 0
-            state.status = "healthy"
-            if inStartPeriod {
-                logger.info("Container became healthy during start period", metadata: ["container_id": "\(containerID)"])
-            } else {
-                logger.info("Container is healthy", metadata: ["container_id": "\(containerID)"])
+    // MARK: - Native probes
+
+    /// Recognise HTTP/TCP checks that the guest service can run without spawning a process
+    ///
+    /// Only forms whose pass/fail meaning is unambiguous are matched: `curl` with --fail,
+    /// `wget` (fails on 4xx/5xx), and `nc -z host port`. Anything else runs as a command.
+    static func nativeProbe(for test: [String]) -> HealthProbe? {
+        guard let kind = test.first else { return nil }
+
+        var words: [String]
+        switch kind {
+        case "CMD":
+            words = Array(test.dropFirst())
+        case "CMD-SHELL":
+            var script = test.dropFirst().joined(separator: " ").trimmingCharacters(in: .whitespaces)
+            for suffix in ["|| exit 1", "||exit 1"] where script.hasSuffix(suffix) {
+                script = String(script.dropLast(suffix.count)).trimmingCharacters(in: .whitespaces)
             }
-        } else {
-            // Failed check
-            if inStartPeriod {
-                // During start period, failures don't count toward unhealthy
-                logger.debug("Health check failed during start period (not counted)", metadata: [
-                    "container_id": "\(containerID)",
-                    "exit_code": "\(exitCode)"
-                ])
-            } else {
-                // Outside start period, increment failing streak
-                state.failingStreak += 1
+            // Anything the shell would interpret has to run in a shell
+            guard script.rangeOfCharacter(from: CharacterSet(charactersIn: "|;&$`()<>*?'\"\\\n")) == nil else {
+                return nil
+            }
+            words = script.split(whereSeparator: { $0 == " " || $0 == "\t" }).map(String.init)
+        default:
+            return nil
+        }
 
-                if state.failingStreak >= state.config.retries {
-                    state.status = "unhealthy"
-                    logger.warning("Container is unhealthy", metadata: [
-                        "container_id": "\(containerID)",
-                        "failing_streak": "\(state.failingStreak)",
-                        "exit_code": "\(exitCode)"
-                    ])
+        guard let program = words.first.map({ ($0 as NSString).lastPathComponent }) else { return nil }
+        words.removeFirst()
+
+        switch program {
+        case "curl":
+            return curlProbe(words)
+        case "wget":
+            return wgetProbe(words)
+        case "nc":
+            return netcatProbe(words)
+        default:
+            return nil
+        }
+    }
+
+    private static func curlProbe(_ args: [String]) -> HealthProbe? {
+        var url: String?
+        var fails = false
+        var index = 0
+        while index < args.count {
+            let arg = args[index]
+            switch arg {
+            case "--fail":
+                fails = true
+            case "--silent", "--show-error", "--location":
+                break
+            case "-o", "--output":
+                // Output is discarded either way
+                guard index + 1 < args.count, args[index + 1] == "/dev/null" else { return nil }
+                index += 1
+            default:
+                if arg.hasPrefix("-"), !arg.hasPrefix("--"), arg.count > 1 {
+                    // Bundled short flags, e.g. -fsS
+                    let flags = arg.dropFirst()
+                    guard flags.allSatisfy({ "fsSL".contains($0) }) else { return nil }
+                    fails = fails || flags.contains("f")
+                } else if url == nil, arg.hasPrefix("http://") || arg.hasPrefix("https://") {
+                    url = arg
                 } else {
-                    logger.debug("Health check failed", metadata: [
-                        "container_id": "\(containerID)",
-                        "failing_streak": "\(state.failingStreak)",
-                        "exit_code": "\(exitCode)"
-                    ])
+                    return nil
                 }
             }
+            index += 1
         }
+        // Without --fail curl exits 0 on HTTP errors, which a native probe can't reproduce
+        guard fails, let url = url else { return nil }
+        return .http(url)
+    }
 
-        // Add result to log (keep last 5)
-        state.log.append(result)
-        if state.log.count > 5 {
-            state.log.removeFirst()
+    private static func wgetProbe(_ args: [String]) -> HealthProbe? {
+        var url: String?
+        var index = 0
+        while index < args.count {
+            let arg = args[index]
+            switch arg {
+            case "-q", "--quiet", "--spider", "-nv", "--no-verbose", "-O-", "-qO-":
+                break
+            case "-O", "-qO":
+                guard index + 1 < args.count, ["-", "/dev/null"].contains(args[index + 1]) else { return nil }
+                index += 1
+            default:
+                guard url == nil, arg.hasPrefix("http://") || arg.hasPrefix("https://") else { return nil }
+                url = arg
+            }
+            index += 1
         }
+        return url.map { .http($0) }
+    }
 
-        // Update state
-        healthStatus[containerID] = state
+    private static func netcatProbe(_ args: [String]) -> HealthProbe? {
+        var zeroIO = false
+        var positional: [String] = []
+        var index = 0
+        while index < args.count {
+            let arg = args[index]
+            switch arg {
+            case "-z", "-zv", "-vz":
+                zeroIO = true
+            case "-v":
+                break
+            case "-w":
+                // Timeout is enforced by the probe itself
+                guard index + 1 < args.count, Int(args[index + 1]) != nil else { return nil }
+                index += 1
+            default:
+                guard !arg.hasPrefix("-") else { return nil }
+                positional.append(arg)
+            }
+            index += 1
+        }
+        guard zeroIO, positional.count == 2, let port = Int(positional[1]), (1...65535).contains(port) else {
+            return nil
+        }
+        let host = positional[0].contains(":") ? "[\(positional[0])]" : positional[0]
+        return .tcp("\(host):\(port)")
     }
 
     /// Parse health check command into executable form
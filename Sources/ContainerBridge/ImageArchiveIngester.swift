@@ -0,0 +1,388 @@
+import Foundation
+import Logging
+import NIO
+import CryptoKit
+
+/// Streaming ingester for `docker save` / OCI image archives
+///
+/// Parses tar entries as bytes arrive and writes only what `ImageStore.load(from:)` needs
+/// (`oci-layout`, `index.json` and `blobs/<alg>/<hex>`) into an OCI layout directory.
+/// Legacy docker-archive entries (`manifest.json`, `<id>/layer.tar`, ...) are skipped
+/// without touching disk. Blobs are hashed while they are written and verified against
+/// their path digest; blobs already present in the content store are hard-linked from
+/// there and their bytes are discarded from the stream.
+///
+/// Not thread-safe - owned by a single `ImageManager` call.
+final class ImageArchiveIngester {
+    /// Summary of a completed ingest
+    struct Result {
+        let layoutDirectory: URL
+        let blobsWritten: Int
+        let blobsDeduplicated: Int
+        let bytesWritten: Int64
+        let bytesSkipped: Int64
+    }
+
+    private enum State {
+        case header
+        case body(remaining: Int, padding: Int)
+        case padding(remaining: Int)
+        case finished
+    }
+
+    private enum Sink {
+        case blob(handle: FileHandle, hasher: SHA256, digest: String, url: URL)
+        case metadata(name: String, data: Data)
+        case extendedHeader(data: Data, global: Bool)
+        case longName(data: Data)
+        case discard
+    }
+
+    private static let blockSize = 512
+    private static let maxMetadataSize = 16 * 1024 * 1024
+    private static let layoutFiles: Set<String> = ["index.json", "oci-layout"]
+
+    private let layoutDirectory: URL
+    private let contentBlobsDirectory: URL
+    private let logger: Logger
+
+    private var state: State = .header
+    private var sink: Sink = .discard
+    private var headerBuffer: [UInt8] = []
+    private var zeroBlocks = 0
+    private var pendingPath: String?
+    private var pendingSize: Int?
+
+    private var blobsWritten = 0
+    private var blobsDeduplicated = 0
+    private var bytesWritten: Int64 = 0
+    private var bytesSkipped: Int64 = 0
+
+    /// - Parameters:
+    ///   - layoutDirectory: Empty directory that receives the OCI layout
+    ///   - contentBlobsDirectory: `blobs` directory of the local content store, used for dedupe
+    init(layoutDirectory: URL, contentBlobsDirectory: URL, logger: Logger) {
+        self.layoutDirectory = layoutDirectory
+        self.contentBlobsDirectory = contentBlobsDirectory
+        self.logger = logger
+        headerBuffer.reserveCapacity(Self.blockSize)
+    }
+
+    /// Feed the next chunk of the archive
+    func ingest(_ chunk: ByteBuffer) throws {
+        var chunk = chunk
+
+        while chunk.readableBytes > 0 {
+            switch state {
+            case .header:
+                let needed = Self.blockSize - headerBuffer.count
+                let take = min(needed, chunk.readableBytes)
+                headerBuffer.append(contentsOf: chunk.readBytes(length: take)!)
+
+                if headerBuffer.count == Self.blockSize {
+                    try processHeader(headerBuffer)
+                    headerBuffer.removeAll(keepingCapacity: true)
+                }
+
+            case .body(let remaining, let padding):
+                let take = min(remaining, chunk.readableBytes)
+                let slice = chunk.readSlice(length: take)!
+                try consumeBody(slice)
+
+                if take == remaining {
+                    try finishEntry()
+                    state = padding > 0 ? .padding(remaining: padding) : .header
+                } else {
+                    state = .body(remaining: remaining - take, padding: padding)
+                }
+
+            case .padding(let remaining):
+                let take = min(remaining, chunk.readableBytes)
+                chunk.moveReaderIndex(forwardBy: take)
+                state = take == remaining ? .header : .padding(remaining: remaining - take)
+
+            case .finished:
+                // Trailing zero blocks / record padding after end-of-archive
+                return
+            }
+        }
+    }
+
+    /// Complete the ingest once the stream has ended
+    func finish() throws -> Result {
+        switch state {
+        case .finished:
+            break
+        case .header where headerBuffer.isEmpty:
+            // Some writers omit the end-of-archive blocks
+            break
+        default:
+            cancel()
+            throw ImageManagerError.tarExtractionFailed("Archive is truncated")
+        }
+
+        let indexPath = layoutDirectory.appendingPathComponent("index.json")
+        guard FileManager.default.fileExists(atPath: indexPath.path) else {
+            throw ImageManagerError.tarExtractionFailed(
+                "Archive has no OCI index.json (images saved by Docker 25+ or OCI tools are supported)")
+        }
+
+        return Result(
+            layoutDirectory: layoutDirectory,
+            blobsWritten: blobsWritten,
+            blobsDeduplicated: blobsDeduplicated,
+            bytesWritten: bytesWritten,
+            bytesSkipped: bytesSkipped
+        )
+    }
+
+    /// Abort an in-progress entry (e.g. the upload failed)
+    func cancel() {
+        if case .blob(let handle, _, _, let url) = sink {
+            try? handle.close()
+            try? FileManager.default.removeItem(at: url)
+        }
+        sink = .discard
+    }
+
+    // MARK: - Header Parsing
+
+    private func processHeader(_ block: [UInt8]) throws {
+        if block.allSatisfy({ $0 == 0 }) {
+            zeroBlocks += 1
+            if zeroBlocks == 2 {
+                state = .finished
+            }
+            return
+        }
+        zeroBlocks = 0
+
+        try verifyChecksum(block)
+
+        let typeflag = block[156]
+        guard var size = Self.parseNumeric(block[124..<136]) else {
+            throw ImageManagerError.tarExtractionFailed("Invalid size field in tar header")
+        }
+        if let paxSize = pendingSize, typeflag != UInt8(ascii: "x"), typeflag != UInt8(ascii: "g") {
+            size = paxSize
+        }
+
+        var path = Self.parseString(block[0..<100])
+        if Self.parseString(block[257..<262]) == "ustar" {
+            let prefix = Self.parseString(block[345..<500])
+            if !prefix.isEmpty {
+                path = prefix + "/" + path
+            }
+        }
+
+        switch typeflag {
+        case UInt8(ascii: "x"), UInt8(ascii: "g"):
+            sink = .extendedHeader(data: Data(), global: typeflag == UInt8(ascii: "g"))
+        case UInt8(ascii: "L"):
+            sink = .longName(data: Data())
+        case UInt8(ascii: "0"), 0, UInt8(ascii: "7"):
+            let name = Self.normalize(pendingPath ?? path)
+            pendingPath = nil
+            pendingSize = nil
+            sink = try openSink(for: name, size: size)
+        default:
+            // Directories, links and devices are not part of the OCI layout we load
+            pendingPath = nil
+            pendingSize = nil
+            sink = .discard
+        }
+
+        let padding = (Self.blockSize - size % Self.blockSize) % Self.blockSize
+        if size > 0 {
+            state = .body(remaining: size, padding: padding)
+        } else {
+            try finishEntry()
+            state = .header
+        }
+    }
+
+    private func verifyChecksum(_ block: [UInt8]) throws {
+        guard let expected = Self.parseNumeric(block[148..<156]) else {
+            throw ImageManagerError.tarExtractionFailed("Invalid checksum field in tar header")
+        }
+
+        var sum = 0
+        for (index, byte) in block.enumerated() {
+            sum += (148..<156).contains(index) ? 0x20 : Int(byte)
+        }
+
+        guard sum == expected else {
+            throw ImageManagerError.tarExtractionFailed("Tar header checksum mismatch")
+        }
+    }
+
+    private func openSink(for name: String, size: Int) throws -> Sink {
+        if Self.layoutFiles.contains(name) {
+            guard size <= Self.maxMetadataSize else {
+                throw ImageManagerError.tarExtractionFailed("\(name) exceeds \(Self.maxMetadataSize) bytes")
+            }
+            return .metadata(name: name, data: Data(capacity: size))
+        }
+
+        // blobs/<algorithm>/<hex>
+        let components = name.split(separator: "/")
+        guard components.count == 3, components[0] == "blobs" else {
+            bytesSkipped += Int64(size)
+            return .discard
+        }
+
+        let algorithm = String(components[1])
+        let encoded = String(components[2])
+        guard algorithm == "sha256", encoded.count == 64,
+              encoded.allSatisfy({ $0.isHexDigit && !$0.isUppercase }) else {
+            throw ImageManagerError.tarExtractionFailed("Unsupported blob path in archive: \(name)")
+        }
+
+        let algorithmDir = layoutDirectory.appendingPathComponent("blobs").appendingPathComponent(algorithm)
+        try FileManager.default.createDirectory(at: algorithmDir, withIntermediateDirectories: true)
+        let destination = algorithmDir.appendingPathComponent(encoded)
+
+        // Skip blobs the content store already holds - link them into the layout instead
+        let existing = contentBlobsDirectory.appendingPathComponent(algorithm).appendingPathComponent(encoded)
+        if FileManager.default.fileExists(atPath: existing.path),
+           (try? FileManager.default.linkItem(at: existing, to: destination)) != nil {
+            blobsDeduplicated += 1
+            bytesSkipped += Int64(size)
+            return .discard
+        }
+
+        guard FileManager.default.createFile(atPath: destination.path, contents: nil) else {
+            throw ImageManagerError.tarExtractionFailed("Failed to create blob file: \(destination.path)")
+        }
+        let handle = try FileHandle(forWritingTo: destination)
+        return .blob(handle: handle, hasher: SHA256(), digest: encoded, url: destination)
+    }
+
+    // MARK: - Entry Bodies
+
+    private func consumeBody(_ slice: ByteBuffer) throws {
+        switch sink {
+        case .blob(let handle, var hasher, let digest, let url):
+            try slice.withUnsafeReadableBytes { bytes in
+                hasher.update(bufferPointer: bytes)
+                try handle.write(contentsOf: bytes)
+            }
+            bytesWritten += Int64(slice.readableBytes)
+            sink = .blob(handle: handle, hasher: hasher, digest: digest, url: url)
+
+        case .metadata(let name, var data):
+            data.append(contentsOf: slice.readableBytesView)
+            sink = .metadata(name: name, data: data)
+
+        case .extendedHeader(var data, let global):
+            guard data.count + slice.readableBytes <= Self.maxMetadataSize else {
+                throw ImageManagerError.tarExtractionFailed("PAX header too large")
+            }
+            data.append(contentsOf: slice.readableBytesView)
+            sink = .extendedHeader(data: data, global: global)
+
+        case .longName(var data):
+            guard data.count + slice.readableBytes <= Self.maxMetadataSize else {
+                throw ImageManagerError.tarExtractionFailed("GNU long name too large")
+            }
+            data.append(contentsOf: slice.readableBytesView)
+            sink = .longName(data: data)
+
+        case .discard:
+            break
+        }
+    }
+
+    private func finishEntry() throws {
+        let completed = sink
+        sink = .discard
+
+        switch completed {
+        case .blob(let handle, let hasher, let digest, let url):
+            try handle.close()
+            let actual = hasher.finalize().map { String(format: "%02x", $0) }.joined()
+            guard actual == digest else {
+                try? FileManager.default.removeItem(at: url)
+                throw ImageManagerError.tarExtractionFailed("Blob digest mismatch: expected sha256:\(digest), got sha256:\(actual)")
+            }
+            blobsWritten += 1
+
+        case .metadata(let name, let data):
+            try data.write(to: layoutDirectory.appendingPathComponent(name))
+
+        case .extendedHeader(let data, let global):
+            // Global headers apply to the whole archive; only per-entry path/size matter here
+            guard !global else { return }
+            for (key, value) in Self.parsePAXRecords(data) {
+                switch key {
+                case "path":
+                    pendingPath = value
+                case "size":
+                    pendingSize = Int(value)
+                default:
+                    break
+                }
+            }
+
+        case .longName(let data):
+            pendingPath = Self.parseString(Array(data)[...])
+
+        case .discard:
+            break
+        }
+    }
+
+    // MARK: - Field Helpers
+
+    /// Parse a NUL-terminated string field
+    private static func parseString(_ field: ArraySlice<UInt8>) -> String {
+        let bytes = field.prefix { $0 != 0 }
+        return String(decoding: bytes, as: UTF8.self)
+    }
+
+    /// Parse an octal numeric field, or a base-256 field for values that exceed octal range
+    private static func parseNumeric(_ field: ArraySlice<UInt8>) -> Int? {
+        guard let first = field.first else { return nil }
+
+        if first & 0x80 != 0 {
+            var value = Int(first & 0x7f)
+            for byte in field.dropFirst() {
+                value = (value << 8) | Int(byte)
+            }
+            return value
+        }
+
+        let digits = field.filter { $0 != 0 && $0 != UInt8(ascii: " ") }
+        if digits.isEmpty { return 0 }
+        return Int(String(decoding: digits, as: UTF8.self), radix: 8)
+    }
+
+    /// Parse PAX extended header records ("<len> <key>=<value>\n")
+    private static func parsePAXRecords(_ data: Data) -> [(String, String)] {
+        var records: [(String, String)] = []
+        let text = String(decoding: data, as: UTF8.self)
+
+        for line in text.split(separator: "\n") {
+            guard let space = line.firstIndex(of: " "),
+                  let equals = line[space...].firstIndex(of: "=") else {
+                continue
+            }
+            let key = String(line[line.index(after: space)..<equals])
+            let value = String(line[line.index(after: equals)...])
+            records.append((key, value))
+        }
+        return records
+    }
+
+    /// Normalize an entry path ("./blobs/sha256/x" -> "blobs/sha256/x")
+    private static func normalize(_ path: String) -> String {
+        var normalized = Substring(path)
+        while normalized.hasPrefix("./") {
+            normalized = normalized.dropFirst(2)
+        }
+        while normalized.hasPrefix("/") {
+            normalized = normalized.dropFirst()
+        }
+        return String(normalized)
+    }
+}
@@ -1,5 +1,6 @@
 import Foundation
 import Logging
+import NIO
 import Containerization
 import ContainerizationOCI
 import ContainerizationExtras
@@ -12,9 +13,12 @@ public actor ImageManager {
     private let imageStore: ImageStore
     private let defaultPlatform: Platform
     private var eventEmitter: EventEmitter?
+    private var layerPrefetcher: LayerPrefetcher?
+    private let pullCoordinator: PullCoordinator<Containerization.Image>
 
-    public init(logger: Logger, imageStorePath: URL? = nil) throws {
+    public init(logger: Logger, imageStorePath: URL? = nil, pullConfig: PullConfig? = nil) throws {
         self.logger = logger
+        self.pullCoordinator = PullCoordinator(config: pullConfig)
 
         // Initialize ImageStore with default or custom path
         if let path = imageStorePath {
@@ -42,6 +46,16 @@ public actor ImageManager {
         self.eventEmitter = emitter
     }
 
+    /// Set the LayerPrefetcher that unpacks pulled images ahead of container creation
+    public func setLayerPrefetcher(_ prefetcher: LayerPrefetcher) {
+        self.layerPrefetcher = prefetcher
+    }
+
+    /// Registry transfers in flight and the pulls waiting on them
+    public func pullActivity() async -> (transfers: Int, watchers: Int) {
+        await pullCoordinator.activity()
+    }
+
     /// Load images from an OCI Image Layout directory into the ImageStore
     public func loadFromOCILayout(directory: URL) async throws -> [Containerization.Image] {
         logger.info("Loading images from OCI layout", metadata: [
@@ -66,6 +80,113 @@ public actor ImageManager {
             "size_bytes": "\(tarData.count)"
         ])
 
+        // Write tar data to temp file
+        let tarPath = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-image-load-\(UUID().uuidString).tar")
+        defer { try? FileManager.default.removeItem(at: tarPath) }
+
+        try tarData.write(to: tarPath)
+        logger.debug("Wrote tar archive", metadata: ["path": "\(tarPath.path)"])
+
+        return try await loadImageFromTarFile(at: tarPath)
+    }
+
+    /// Load images from a tar archive streamed in chunks (e.g. an HTTP request body)
+    ///
+    /// Entries are parsed as they arrive and blobs are hashed and written straight into an
+    /// OCI layout, skipping blobs the content store already has, so load time is bounded by
+    /// disk writes rather than by buffering, spooling and extracting the archive in turn.
+    /// Compressed archives can't be parsed incrementally and fall back to spooling + `tar`.
+    /// - Parameter chunks: The archive bytes, in order
+    /// - Returns: Array of loaded images
+    public func loadImageFromTarStream<Chunks: AsyncSequence & Sendable>(
+        _ chunks: Chunks
+    ) async throws -> [Containerization.Image] where Chunks.Element == ByteBuffer {
+        let tempDir = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-image-load-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: tempDir, withIntermediateDirectories: true)
+        defer { try? FileManager.default.removeItem(at: tempDir) }
+
+        let layoutDir = tempDir.appendingPathComponent("layout")
+        try FileManager.default.createDirectory(at: layoutDir, withIntermediateDirectories: true)
+
+        let ingester = ImageArchiveIngester(
+            layoutDirectory: layoutDir,
+            contentBlobsDirectory: imageStore.path.appendingPathComponent("content").appendingPathComponent("blobs"),
+            logger: logger
+        )
+
+        var iterator = chunks.makeAsyncIterator()
+        var spool: FileHandle?
+        var spoolPath: URL?
+        var firstChunk = true
+
+        do {
+            while let chunk = try await iterator.next() {
+                if firstChunk {
+                    firstChunk = false
+                    if Self.isCompressedArchive(chunk) {
+                        logger.debug("Compressed image archive, spooling to disk for extraction")
+                        let path = tempDir.appendingPathComponent("image.tar")
+                        FileManager.default.createFile(atPath: path.path, contents: nil)
+                        spool = try FileHandle(forWritingTo: path)
+                        spoolPath = path
+                    }
+                }
+
+                if let spool = spool {
+                    try chunk.withUnsafeReadableBytes { try spool.write(contentsOf: $0) }
+                } else {
+                    try ingester.ingest(chunk)
+                }
+            }
+        } catch {
+            ingester.cancel()
+            try? spool?.close()
+            logger.error("Failed to receive image archive", metadata: ["error": "\(error)"])
+            throw error
+        }
+
+        if let spool = spool, let spoolPath = spoolPath {
+            try spool.close()
+            return try await loadImageFromTarFile(at: spoolPath)
+        }
+
+        let result = try ingester.finish()
+        logger.info("Ingested image archive", metadata: [
+            "blobs_written": "\(result.blobsWritten)",
+            "blobs_deduplicated": "\(result.blobsDeduplicated)",
+            "bytes_written": "\(result.bytesWritten)",
+            "bytes_skipped": "\(result.bytesSkipped)"
+        ])
+
+        // Register manifests once every blob is in place
+        return try await loadFromOCILayout(directory: result.layoutDirectory)
+    }
+
+    /// Detect gzip, bzip2, xz and zstd magic numbers at the start of an archive
+    private static func isCompressedArchive(_ chunk: ByteBuffer) -> Bool {
+        guard let magic = chunk.getBytes(at: chunk.readerIndex, length: min(6, chunk.readableBytes)) else {
+            return false
+        }
+        let signatures: [[UInt8]] = [
+            [0x1f, 0x8b],                          // gzip
+            [0x42, 0x5a, 0x68],                    // bzip2 ("BZh")
+            [0xfd, 0x37, 0x7a, 0x58, 0x5a, 0x00],  // xz
+            [0x28, 0xb5, 0x2f, 0xfd],              // zstd
+        ]
+        return signatures.contains { magic.starts(with: $0) }
+    }
+
+    /// Load images from a tar archive (OCI or Docker format) already on disk
+    /// Used by `POST /images/load`, which spools the streamed request body straight to a file
+    /// - Parameter tarPath: Path to the tar archive (left in place; caller owns cleanup)
+    /// - Returns: Array of loaded images
+    public func loadImageFromTarFile(at tarPath: URL) async throws -> [Containerization.Image] {
+        logger.info("Loading images from tar file", metadata: [
+            "path": "\(tarPath.path)"
+        ])
+
         // Create temp directory for extraction
         let tempDir = FileManager.default.temporaryDirectory
             .appendingPathComponent("arca-image-load-\(UUID().uuidString)")
@@ -74,11 +195,6 @@ public actor ImageManager {
             try FileManager.default.createDirectory(at: tempDir, withIntermediateDirectories: true)
             logger.debug("Created temp directory", metadata: ["path": "\(tempDir.path)"])
 
-            // Write tar data to temp file
-            let tarPath = tempDir.appendingPathComponent("image.tar")
-            try tarData.write(to: tarPath)
-            logger.debug("Wrote tar archive", metadata: ["path": "\(tarPath.path)"])
-
             // Extract tar archive
             let extractDir = tempDir.appendingPathComponent("extracted")
             try FileManager.default.createDirectory(at: extractDir, withIntermediateDirectories: true)
@@ -329,14 +445,50 @@ public actor ImageManager {
             authentication = BasicAuthentication(username: username, password: password)
         }
 
+        // Resolve the manifest first so pulls of the same content (under any tag) share one
+        // transfer and pulls sharing most of their layers don't download them twice
+        let resolved = try? await resolveManifestLayersWithDigest(reference: reference, auth: auth)
+        let platformKey = "\(defaultPlatform.os)/\(defaultPlatform.architecture)"
+        let pullKey = "\(resolved?.manifestDigest ?? normalizedRef)@\(platformKey)"
+        let layers = resolved.map {
+            Dictionary(zip($0.layerDigests, $0.layerSizes), uniquingKeysWith: { first, _ in first })
+        } ?? [:]
+        let registry = String(normalizedRef.split(separator: "/").first ?? "docker.io")
+
         // Pull image using ImageStore with normalized reference
-        let image = try await imageStore.pull(
-            reference: normalizedRef,
-            platform: defaultPlatform,
-            insecure: false,
-            auth: authentication,
+        let (pulled, shared) = try await pullCoordinator.pull(
+            key: pullKey,
+            registry: registry,
+            layers: layers,
             progress: progress
-        )
+        ) { [imageStore, defaultPlatform] progress in
+            try await imageStore.pull(
+                reference: normalizedRef,
+                platform: defaultPlatform,
+                insecure: false,
+                auth: authentication,
+                progress: progress
+            )
+        }
+
+        // A transfer started for another tag of the same manifest stored it under that tag
+        var image = pulled
+        if shared && pulled.reference != normalizedRef {
+            image = try await imageStore.tag(existing: pulled.reference, new: normalizedRef)
+        }
+
+        if shared {
+            logger.debug("Pull joined an in-flight transfer", metadata: [
+                "reference": "\(normalizedRef)",
+                "key": "\(pullKey)"
+            ])
+        }
+
+        // Unpack layers to ext4 now, like Docker's extract step, so the first run
+        // doesn't pay for it (failures are logged and left to container creation)
+        if let prefetcher = layerPrefetcher {
+            await prefetcher.prefetchLayers(of: image, platform: defaultPlatform)
+        }
 
         // Get image details
         let manifest = try await image.manifest(for: defaultPlatform)
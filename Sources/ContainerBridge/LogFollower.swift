@@ -0,0 +1,177 @@
+import Foundation
+import Containerization
+
+/// A chunk of live container output delivered to a log follower
+public struct LogChunk: Sendable {
+    public let stream: LogStream
+    public let data: Data
+    public let timestamp: Date
+    /// Log file offset the chunk starts at, nil when the container has no position-aware log
+    /// (for the shared local-driver log, records of the other stream may lie before it)
+    public let start: UInt64?
+    /// Log file offset just past this chunk
+    public let end: UInt64?
+
+    /// Split into lines the same way the log writers split a chunk into entries
+    public func lines() -> [Data] {
+        BinaryLogFormat.splitLines(data)
+    }
+}
+
+/// Live subscription to a container's stdout/stderr (docker logs -f)
+///
+/// The container's BroadcastWriters push each chunk the moment it is logged - no polling, no
+/// file stats, and no CPU while the container is quiet. ContainerManager finishes the
+/// follower when the container stops.
+///
+/// Chunks are stamped with the log offsets they span. ContainerManager subscribes the
+/// follower first and then records each log's committed end in `replayEnds`; a replay
+/// bounded by those offsets and the live chunks past them cover the output exactly once,
+/// with nothing lost in between.
+///
+/// Chunks wait in a buffer bounded by the output buffer size and never hold up the
+/// container. When the client falls that far behind, the slow-subscriber policy applies:
+/// drop-oldest discards the oldest chunks and reports them as `.dropped`; replay-from-log re-reads
+/// them from the log as `.history` once the client gets there.
+/// @unchecked Sendable: Safe because the queue and flags are protected by NSLock, and
+/// `catchingUp` is only touched by the single task consuming `next()`
+public final class LogFollower: @unchecked Sendable {
+    /// What the follower delivers next
+    public enum Event: Sendable {
+        case output(LogChunk)
+        /// Output the client fell behind on, re-read from the log
+        case history([LogLine])
+        /// Output discarded because the client fell more than the buffer behind
+        case dropped(stream: LogStream, bytes: Int)
+    }
+
+    public let id = UUID()
+
+    private let lock = NSLock()
+    private var pending: OutputQueue
+    private var ends: [LogStream: UInt64]?
+    private var logs: [LogStream: LogPositionWriter] = [:]
+    private var waiter: CheckedContinuation<Void, Never>?
+    private var finished = false
+    private var catchingUp: LogLineCursor?
+
+    init(policy: SlowSubscriberPolicy = .dropOldest, maxBytes: Int) {
+        self.pending = OutputQueue(policy: policy, maxBytes: maxBytes)
+    }
+
+    /// Log offsets the history replay should stop at; live output starts right after them
+    public var replayEnds: [LogStream: UInt64] {
+        lock.lock()
+        defer { lock.unlock() }
+        return ends ?? [:]
+    }
+
+    /// Record where each log ended once the follower was subscribed, and the logs to catch
+    /// up from. Chunks at or before these offsets are part of the replay and are not
+    /// delivered live.
+    func start(replayEnds: [LogStream: UInt64], logs: [LogStream: LogPositionWriter] = [:]) {
+        lock.lock()
+        defer { lock.unlock() }
+        ends = replayEnds
+        self.logs = logs
+        pending.removeAll { isCovered($0) }
+    }
+
+    /// Called by a BroadcastWriter for each chunk it logged; never blocks
+    func receive(_ chunk: LogChunk) {
+        lock.lock()
+        guard !finished, !chunk.data.isEmpty, !isCovered(chunk) else {
+            lock.unlock()
+            return
+        }
+        pending.append(chunk)
+        let waiter = self.waiter
+        self.waiter = nil
+        lock.unlock()
+
+        waiter?.resume()
+    }
+
+    /// Wait for the next event; nil once the follower is finished and drained
+    /// Cancelling the waiting task finishes the follower.
+    public func next() async -> Event? {
+        while !Task.isCancelled {
+            if let cursor = catchingUp {
+                if let lines = readHistory(cursor) {
+                    return .history(lines)
+                }
+                catchingUp = nil
+            }
+
+            lock.lock()
+            let item = pending.next()
+            let done = finished
+            let log = item.flatMap { item -> LogPositionWriter? in
+                if case .gap(let stream, _, _, _) = item { return logs[stream] }
+                return nil
+            }
+            lock.unlock()
+
+            switch item {
+            case .chunk(let chunk):
+                return .output(chunk)
+            case .dropped(let stream, let bytes):
+                return .dropped(stream: stream, bytes: bytes)
+            case .gap(let stream, let after, let through, let bytes):
+                guard let log = log, let cursor = try? log.lines(after: after, through: through) else {
+                    return .dropped(stream: stream, bytes: bytes)
+                }
+                catchingUp = cursor
+            case nil:
+                if done { return nil }
+                await waitForOutput()
+            }
+        }
+        return nil
+    }
+
+    /// End the follower; buffered chunks are still delivered
+    public func finish() {
+        lock.lock()
+        finished = true
+        let waiter = self.waiter
+        self.waiter = nil
+        lock.unlock()
+
+        waiter?.resume()
+    }
+
+    private func waitForOutput() async {
+        await withTaskCancellationHandler {
+            await withCheckedContinuation { (continuation: CheckedContinuation<Void, Never>) in
+                lock.lock()
+                if finished || !pending.isEmpty {
+                    lock.unlock()
+                    continuation.resume()
+                } else {
+                    waiter = continuation
+                    lock.unlock()
+                }
+            }
+        } onCancel: {
+            finish()
+        }
+    }
+
+    /// Up to one read window of lines from the log being caught up on, nil when done
+    private func readHistory(_ cursor: LogLineCursor) -> [LogLine]? {
+        var lines: [LogLine] = []
+        var bytes = 0
+        while bytes < 64 * 1024, let line = try? cursor.next() {
+            lines.append(line)
+            bytes += line.message.count
+        }
+        return lines.isEmpty ? nil : lines
+    }
+
+    /// Caller holds the lock
+    private func isCovered(_ chunk: LogChunk) -> Bool {
+        guard let chunkEnd = chunk.end, let replayEnd = ends?[chunk.stream] else { return false }
+        return chunkEnd <= replayEnd
+    }
+}
@@ -0,0 +1,556 @@
+import Foundation
+
+/// One line of stored container output, from either log driver
+public struct LogLine: Sendable {
+    public let stream: LogStream
+    public let timestamp: Date
+    public let message: Data
+
+    public init(stream: LogStream, timestamp: Date, message: Data) {
+        self.stream = stream
+        self.timestamp = timestamp
+        self.message = message
+    }
+
+    /// Append this line as a Docker multiplexed stream frame
+    /// Format: [stream_type (1 byte)][padding (3 bytes)][size (4 bytes big-endian)][payload]
+    /// - Parameter timestamps: Prefix the payload with an RFC 3339 timestamp (`docker logs -t`)
+    public func appendFrame(to buffer: inout Data, timestamps: Bool) {
+        let prefix = timestamps ? Array((LogTimestamp.format(timestamp) + " ").utf8) : []
+        let size = UInt32(prefix.count + message.count)
+
+        buffer.append(stream.rawValue)
+        buffer.append(contentsOf: [0, 0, 0])
+        buffer.append(UInt8((size >> 24) & 0xFF))
+        buffer.append(UInt8((size >> 16) & 0xFF))
+        buffer.append(UInt8((size >> 8) & 0xFF))
+        buffer.append(UInt8(size & 0xFF))
+        buffer.append(contentsOf: prefix)
+        buffer.append(message)
+    }
+}
+
+/// Streaming replay of a container's stored logs, oldest first
+///
+/// Used for `docker logs` and for the history sent on attach with `logs=1`. The JSON
+/// driver's stdout.log and stderr.log are each already in time order, so they are merged
+/// k-way by holding one pending line per file instead of loading and sorting everything.
+/// Binary (local driver) logs interleave both streams in one file and are read straight
+/// through from an index-derived start offset. Memory stays bounded by the read windows,
+/// plus the last `tail` lines when tail is set.
+///
+/// Callers pull lines with `next()` (or frames with `nextFrames`) and write them out as
+/// they go, so a 500 MB log never has to exist in memory at once.
+public final class LogReplay {
+    private var sources: [LogLineCursor]
+    private var heads: [LogLine?]
+    private var primed = false
+    private var exhausted = false
+
+    private let since: Date?
+    private let until: Date?
+    private let tail: Int?
+    private var tailBuffer: [LogLine]?
+    private var tailPosition = 0
+
+    /// - Parameter through: Per-stream log offsets to stop at (a follower's `replayEnds`);
+    ///   without it each source stops at the end of its file when opened
+    public init(
+        logPaths: ContainerLogManager.LogPaths,
+        streams: Set<LogStream>,
+        since: Date? = nil,
+        until: Date? = nil,
+        tail: Int? = nil,
+        through: [LogStream: UInt64]? = nil
+    ) throws {
+        let tail = tail.map { max($0, 0) }
+        self.since = since
+        self.until = until
+        self.tail = tail
+
+        // A follower's live output starts exactly after `through`, so replay and follow
+        // together cover every line once
+        switch logPaths.driver {
+        case .local:
+            let reader = try BinaryLogReader(directory: logPaths.logDir)
+            let start = try reader.startOffset(streams: streams, since: since, until: until, tail: tail)
+            var limit = try reader.fileSize()
+            if let through = through, let end = through.values.max() {
+                limit = min(limit, end)
+            }
+            let records = try reader.records(from: start, limit: limit)
+            sources = [BinaryLogLineCursor(records: records, streams: streams, through: through)]
+
+        case .jsonFile:
+            var cursors: [LogLineCursor] = []
+            for (stream, path) in [(LogStream.stdout, logPaths.stdoutPath), (LogStream.stderr, logPaths.stderrPath)]
+            where streams.contains(stream) && FileManager.default.fileExists(atPath: path.path) {
+                // The merged tail is contained in the union of each file's own tail
+                let end = through?[stream]
+                var start: UInt64 = 0
+                if let tail = tail, until == nil {
+                    start = try JSONLogFileCursor.tailOffset(path: path, lines: tail, end: end)
+                }
+                cursors.append(try JSONLogFileCursor(path: path, stream: stream, offset: start, limit: end))
+            }
+            sources = cursors
+        }
+        heads = Array(repeating: nil, count: sources.count)
+    }
+
+    /// Next line passing the since/until/tail filters, or nil when the replay is done
+    public func next() throws -> LogLine? {
+        if let tail = tail {
+            if tailBuffer == nil {
+                tailBuffer = try collectTail(tail)
+            }
+            guard let buffer = tailBuffer, tailPosition < buffer.count else { return nil }
+            defer { tailPosition += 1 }
+            return buffer[tailPosition]
+        }
+        return try nextFiltered()
+    }
+
+    /// Encode lines as multiplexed frames until roughly `maxBytes` are buffered
+    /// - Returns: Frames to write, or nil when the replay is done
+    public func nextFrames(maxBytes: Int = 64 * 1024, timestamps: Bool) throws -> Data? {
+        var frames = Data()
+        while frames.count < maxBytes, let line = try next() {
+            line.appendFrame(to: &frames, timestamps: timestamps)
+        }
+        return frames.isEmpty ? nil : frames
+    }
+
+    /// Keep only the last `count` filtered lines, bounded by a small multiple of `count`
+    private func collectTail(_ count: Int) throws -> [LogLine] {
+        guard count > 0 else { return [] }
+
+        var lines: [LogLine] = []
+        while let line = try nextFiltered() {
+            lines.append(line)
+            if lines.count > count * 2 + 1024 {
+                lines.removeFirst(lines.count - count)
+            }
+        }
+        return Array(lines.suffix(count))
+    }
+
+    private func nextFiltered() throws -> LogLine? {
+        while let line = try nextMerged() {
+            if let until = until, line.timestamp > until {
+                // Sources are time-ordered, so nothing later can match
+                exhausted = true
+                return nil
+            }
+            if let since = since, line.timestamp < since {
+                continue
+            }
+            return line
+        }
+        return nil
+    }
+
+    /// k-way merge: emit the oldest pending line across sources (ties go to stdout)
+    private func nextMerged() throws -> LogLine? {
+        guard !exhausted else { return nil }
+
+        if !primed {
+            for i in sources.indices {
+                heads[i] = try sources[i].next()
+            }
+            primed = true
+        }
+
+        var oldest: Int?
+        for i in heads.indices {
+            guard let head = heads[i] else { continue }
+            if let current = oldest, let best = heads[current], best.timestamp <= head.timestamp {
+                continue
+            }
+            oldest = i
+        }
+
+        guard let index = oldest, let line = heads[index] else {
+            exhausted = true
+            return nil
+        }
+        heads[index] = try sources[index].next()
+        return line
+    }
+}
+
+// MARK: - Sources
+
+/// Time-ordered source of log lines
+protocol LogLineCursor: AnyObject {
+    func next() throws -> LogLine?
+}
+
+/// Lines of a binary log, expanded from records of the selected streams
+final class BinaryLogLineCursor: LogLineCursor {
+    private let records: BinaryLogRecordCursor
+    private let streams: Set<LogStream>
+    private let through: [LogStream: UInt64]?
+    private var pending: [LogLine] = []
+    private var pendingPosition = 0
+
+    init(records: BinaryLogRecordCursor, streams: Set<LogStream>, through: [LogStream: UInt64]? = nil) {
+        self.records = records
+        self.streams = streams
+        self.through = through
+    }
+
+    func next() throws -> LogLine? {
+        while pendingPosition >= pending.count {
+            guard let record = try records.next() else { return nil }
+            guard streams.contains(record.stream) else { continue }
+            if let end = through?[record.stream], record.end > end { continue }
+
+            let date = record.date
+            pending = record.lines().map { LogLine(stream: record.stream, timestamp: date, message: $0) }
+            pendingPosition = 0
+        }
+        defer { pendingPosition += 1 }
+        return pending[pendingPosition]
+    }
+}
+
+/// Lines of one JSON (json-file driver) log file
+/// Malformed lines are skipped, as are lines still being written at end of file.
+final class JSONLogFileCursor: LogLineCursor {
+    private static let readChunkSize = 256 * 1024
+
+    private let handle: FileHandle
+    private let stream: LogStream
+    private let limit: UInt64  // File size when the cursor was opened, or the given limit
+    private var position: UInt64  // File offset of the next read
+    private var buffer: [UInt8] = []
+    private var cursor = 0
+    private var reachedEOF = false
+
+    init(path: URL, stream: LogStream, offset: UInt64, limit: UInt64? = nil) throws {
+        let handle = try FileHandle(forReadingFrom: path)
+        self.handle = handle
+        self.stream = stream
+        let size = try handle.seekToEnd()
+        self.limit = min(size, limit ?? size)
+        self.position = min(offset, self.limit)
+        try handle.seek(toOffset: position)
+    }
+
+    deinit {
+        try? handle.close()
+    }
+
+    func next() throws -> LogLine? {
+        while true {
+            if let newline = buffer[cursor...].firstIndex(of: UInt8(ascii: "\n")) {
+                let line = buffer[cursor..<newline]
+                cursor = newline + 1
+                if let parsed = JSONLogLineParser.parse(line, stream: stream) {
+                    return parsed
+                }
+                continue
+            }
+
+            if reachedEOF {
+                return nil
+            }
+
+            if cursor > 0 {
+                buffer.removeSubrange(0..<cursor)
+                cursor = 0
+            }
+            let length = Int(min(UInt64(Self.readChunkSize), limit - position))
+            guard length > 0, let chunk = try handle.read(upToCount: length), !chunk.isEmpty else {
+                reachedEOF = true
+                continue
+            }
+            position += UInt64(chunk.count)
+            buffer.append(contentsOf: chunk)
+        }
+    }
+
+    /// Offset of the start of the `lines`-th last line, scanning backwards from the end
+    /// (or from `end` when given)
+    static func tailOffset(path: URL, lines: Int, end: UInt64? = nil) throws -> UInt64 {
+        let handle = try FileHandle(forReadingFrom: path)
+        defer { try? handle.close() }
+
+        let fileSize = try handle.seekToEnd()
+        let size = min(fileSize, end ?? fileSize)
+        guard lines > 0 else { return size }
+
+        var remaining = lines
+        var position = size
+        while position > 0 {
+            let length = min(UInt64(readChunkSize), position)
+            position -= length
+            try handle.seek(toOffset: position)
+            guard let chunk = try handle.read(upToCount: Int(length)) else { break }
+
+            let bytes = [UInt8](chunk)
+            for i in stride(from: bytes.count - 1, through: 0, by: -1) where bytes[i] == UInt8(ascii: "\n") {
+                let absolute = position + UInt64(i)
+                // The newline ending the last line doesn't start a new one
+                if absolute == size - 1 { continue }
+                remaining -= 1
+                if remaining == 0 {
+                    return absolute + 1
+                }
+            }
+        }
+        return 0
+    }
+}
+
+// MARK: - JSON Log Line Parser
+
+/// Hand-rolled parser for the fixed shape FileLogWriter emits:
+///   {"stream":"stdout","log":"message\n","time":"2025-01-17T12:34:56Z"}
+/// Accepts any key order and ignores unknown string fields; anything else (non-string
+/// values, truncated lines) is rejected so the caller can skip the line.
+enum JSONLogLineParser {
+    private static let logKey = Array("log".utf8)
+    private static let timeKey = Array("time".utf8)
+
+    static func parse(_ line: ArraySlice<UInt8>, stream: LogStream) -> LogLine? {
+        return line.withUnsafeBufferPointer { bytes -> LogLine? in
+            var i = 0
+            var message: [UInt8]?
+            var timestamp: Date?
+
+            func skipWhitespace() {
+                while i < bytes.count, bytes[i] == 0x20 || bytes[i] == 0x09 || bytes[i] == 0x0D {
+                    i += 1
+                }
+            }
+
+            skipWhitespace()
+            guard i < bytes.count, bytes[i] == UInt8(ascii: "{") else { return nil }
+            i += 1
+
+            while true {
+                skipWhitespace()
+                guard i < bytes.count else { return nil }
+                if bytes[i] == UInt8(ascii: "}") { break }
+
+                guard let key = parseString(bytes, at: &i) else { return nil }
+                skipWhitespace()
+                guard i < bytes.count, bytes[i] == UInt8(ascii: ":") else { return nil }
+                i += 1
+                skipWhitespace()
+                guard let value = parseString(bytes, at: &i) else { return nil }
+
+                if key == logKey {
+                    message = value
+                } else if key == timeKey {
+                    timestamp = LogTimestamp.parse(value)
+                }
+
+                skipWhitespace()
+                guard i < bytes.count else { return nil }
+                if bytes[i] == UInt8(ascii: ",") {
+                    i += 1
+                } else if bytes[i] == UInt8(ascii: "}") {
+                    break
+                } else {
+                    return nil
+                }
+            }
+
+            guard let message = message, let timestamp = timestamp else { return nil }
+            return LogLine(stream: stream, timestamp: timestamp, message: Data(message))
+        }
+    }
+
+    /// Parse a JSON string starting at the opening quote, unescaping into UTF-8 bytes
+    private static func parseString(_ bytes: UnsafeBufferPointer<UInt8>, at i: inout Int) -> [UInt8]? {
+        guard i < bytes.count, bytes[i] == UInt8(ascii: "\"") else { return nil }
+        i += 1
+
+        // Fast path: no escapes before the closing quote
+        var end = i
+        while end < bytes.count, bytes[end] != UInt8(ascii: "\""), bytes[end] != UInt8(ascii: "\\") {
+            end += 1
+        }
+        guard end < bytes.count else { return nil }
+        var result = Array(bytes[i..<end])
+        i = end
+
+        while i < bytes.count {
+            let byte = bytes[i]
+            if byte == UInt8(ascii: "\"") {
+                i += 1
+                return result
+            }
+            guard byte == UInt8(ascii: "\\") else {
+                result.append(byte)
+                i += 1
+                continue
+            }
+
+            guard i + 1 < bytes.count else { return nil }
+            let escape = bytes[i + 1]
+            i += 2
+            switch escape {
+            case UInt8(ascii: "\""): result.append(UInt8(ascii: "\""))
+            case UInt8(ascii: "\\"): result.append(UInt8(ascii: "\\"))
+            case UInt8(ascii: "/"): result.append(UInt8(ascii: "/"))
+            case UInt8(ascii: "b"): result.append(0x08)
+            case UInt8(ascii: "f"): result.append(0x0C)
+            case UInt8(ascii: "n"): result.append(0x0A)
+            case UInt8(ascii: "r"): result.append(0x0D)
+            case UInt8(ascii: "t"): result.append(0x09)
+            case UInt8(ascii: "u"):
+                guard var scalar = parseHex4(bytes, at: i) else { return nil }
+                i += 4
+                // Surrogate pair
+                if (0xD800...0xDBFF).contains(scalar),
+                   i + 6 <= bytes.count, bytes[i] == UInt8(ascii: "\\"), bytes[i + 1] == UInt8(ascii: "u"),
+                   let low = parseHex4(bytes, at: i + 2), (0xDC00...0xDFFF).contains(low) {
+                    scalar = 0x10000 + ((scalar - 0xD800) << 10) + (low - 0xDC00)
+                    i += 6
+                }
+                let unicode = Unicode.Scalar(scalar) ?? "\u{FFFD}"
+                result.append(contentsOf: Array(String(Character(unicode)).utf8))
+            default:
+                return nil
+            }
+        }
+        return nil
+    }
+
+    private static func parseHex4(_ bytes: UnsafeBufferPointer<UInt8>, at start: Int) -> UInt32? {
+        guard start + 4 <= bytes.count else { return nil }
+        var value: UInt32 = 0
+        for byte in bytes[start..<(start + 4)] {
+            let digit: UInt32
+            switch byte {
+            case UInt8(ascii: "0")...UInt8(ascii: "9"): digit = UInt32(byte - UInt8(ascii: "0"))
+            case UInt8(ascii: "a")...UInt8(ascii: "f"): digit = UInt32(byte - UInt8(ascii: "a") + 10)
+            case UInt8(ascii: "A")...UInt8(ascii: "F"): digit = UInt32(byte - UInt8(ascii: "A") + 10)
+            default: return nil
+            }
+            value = value << 4 | digit
+        }
+        return value
+    }
+}
+
+// MARK: - Timestamps
+
+/// RFC 3339 timestamp parsing and formatting without DateFormatter
+/// ISO8601DateFormatter is costly to create and was previously built once per log line.
+public enum LogTimestamp {
+    /// Parse `YYYY-MM-DDTHH:MM:SS[.fraction](Z|±HH:MM)`
+    public static func parse<Bytes: RandomAccessCollection>(_ bytes: Bytes) -> Date? where Bytes.Element == UInt8, Bytes.Index == Int {
+        let s = bytes.startIndex
+        guard bytes.count >= 20 else { return nil }
+
+        func digits(_ offset: Int, _ count: Int) -> Int? {
+            var value = 0
+            for k in 0..<count {
+                let byte = bytes[s + offset + k]
+                guard byte >= UInt8(ascii: "0"), byte <= UInt8(ascii: "9") else { return nil }
+                value = value * 10 + Int(byte - UInt8(ascii: "0"))
+            }
+            return value
+        }
+
+        guard let year = digits(0, 4), bytes[s + 4] == UInt8(ascii: "-"),
+              let month = digits(5, 2), bytes[s + 7] == UInt8(ascii: "-"),
+              let day = digits(8, 2), bytes[s + 10] == UInt8(ascii: "T") || bytes[s + 10] == UInt8(ascii: " "),
+              let hour = digits(11, 2), bytes[s + 13] == UInt8(ascii: ":"),
+              let minute = digits(14, 2), bytes[s + 16] == UInt8(ascii: ":"),
+              let second = digits(17, 2),
+              (1...12).contains(month), (1...31).contains(day) else {
+            return nil
+        }
+
+        var offset = 19
+        var nanoseconds = 0
+        if offset < bytes.count, bytes[s + offset] == UInt8(ascii: ".") {
+            offset += 1
+            var scale = 100_000_000
+            while offset < bytes.count,
+                  bytes[s + offset] >= UInt8(ascii: "0"), bytes[s + offset] <= UInt8(ascii: "9") {
+                nanoseconds += Int(bytes[s + offset] - UInt8(ascii: "0")) * scale
+                scale /= 10
+                offset += 1
+            }
+        }
+
+        guard offset < bytes.count else { return nil }
+        var zoneSeconds = 0
+        switch bytes[s + offset] {
+        case UInt8(ascii: "Z"), UInt8(ascii: "z"):
+            break
+        case UInt8(ascii: "+"), UInt8(ascii: "-"):
+            guard offset + 6 <= bytes.count,
+                  let zoneHour = digits(offset + 1, 2),
+                  bytes[s + offset + 3] == UInt8(ascii: ":"),
+                  let zoneMinute = digits(offset + 4, 2) else {
+                return nil
+            }
+            zoneSeconds = (zoneHour * 3600 + zoneMinute * 60) * (bytes[s + offset] == UInt8(ascii: "+") ? 1 : -1)
+        default:
+            return nil
+        }
+
+        let days = daysFromCivil(year: year, month: month, day: day)
+        let seconds = days * 86_400 + hour * 3600 + minute * 60 + second - zoneSeconds
+        return Date(timeIntervalSince1970: TimeInterval(seconds) + TimeInterval(nanoseconds) / 1_000_000_000)
+    }
+
+    /// Format as `YYYY-MM-DDTHH:MM:SS.nnnnnnnnnZ` (Docker's RFC3339NanoFixed)
+    public static func format(_ date: Date) -> String {
+        let totalNanoseconds = BinaryLogFormat.nanoseconds(date)
+        var seconds = totalNanoseconds / 1_000_000_000
+        var nanoseconds = totalNanoseconds % 1_000_000_000
+        if nanoseconds < 0 {
+            nanoseconds += 1_000_000_000
+            seconds -= 1
+        }
+
+        var days = seconds / 86_400
+        var secondOfDay = seconds % 86_400
+        if secondOfDay < 0 {
+            secondOfDay += 86_400
+            days -= 1
+        }
+        let (year, month, day) = civilFromDays(Int(days))
+
+        func pad(_ value: Int, _ width: Int) -> String {
+            let digits = String(value)
+            return digits.count >= width ? digits : String(repeating: "0", count: width - digits.count) + digits
+        }
+
+        return "\(pad(year, 4))-\(pad(month, 2))-\(pad(day, 2))T"
+            + "\(pad(Int(secondOfDay / 3600), 2)):\(pad(Int(secondOfDay % 3600 / 60), 2)):\(pad(Int(secondOfDay % 60), 2))"
+            + ".\(pad(Int(nanoseconds), 9))Z"
+    }
+
+    /// Days since 1970-01-01 for a proleptic Gregorian date
+    static func daysFromCivil(year: Int, month: Int, day: Int) -> Int {
+        let y = month <= 2 ? year - 1 : year
+        let era = (y >= 0 ? y : y - 399) / 400
+        let yearOfEra = y - era * 400
+        let dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1
+        let dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear
+        return era * 146_097 + dayOfEra - 719_468
+    }
+
+    /// Proleptic Gregorian date for days since 1970-01-01
+    static func civilFromDays(_ days: Int) -> (year: Int, month: Int, day: Int) {
+        let z = days + 719_468
+        let era = (z >= 0 ? z : z - 146_096) / 146_097
+        let dayOfEra = z - era * 146_097
+        let yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36_524 - dayOfEra / 146_096) / 365
+        let dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100)
+        let mp = (5 * dayOfYear + 2) / 153
+        let day = dayOfYear - (153 * mp + 2) / 5 + 1
+        let month = mp < 10 ? mp + 3 : mp - 9
+        return (month <= 2 ? yearOfEra + era * 400 + 1 : yearOfEra + era * 400, month, day)
+    }
+}
@@ -2,18 +2,33 @@ import Foundation
 import Containerization
 import Logging
 
+/// A log writer that can say how far its log file extends
+/// Output subscribers use the offsets to line live chunks up with what a replay of the
+/// file already covers, and to re-read output they fell too far behind to buffer.
+protocol LogPositionWriter: Writer {
+    /// Write one chunk of output and return the log's end offset just after it
+    func writeReturningEnd(_ data: Data) throws -> UInt64
+    /// End offset of the last completed write
+    func committedEnd() -> UInt64
+    /// This stream's lines in records ending in (after, through]
+    func lines(after: UInt64, through: UInt64) throws -> LogLineCursor
+}
+
 /// A Writer implementation that persists container stdout/stderr to log files
 /// Implements Docker-compatible JSON log format for OCI compliance
-public final class FileLogWriter: Writer, @unchecked Sendable {
+public final class FileLogWriter: LogPositionWriter, @unchecked Sendable {
     private let fileHandle: FileHandle
+    private let path: URL
     private let stream: String  // "stdout" or "stderr"
     private let lock = NSLock()
+    private var endOffset: UInt64
 
     /// Create a new FileLogWriter
     /// - Parameters:
     ///   - path: Path to the log file
     ///   - stream: Stream identifier ("stdout" or "stderr")
     public init(path: URL, stream: String) throws {
+        self.path = path
         self.stream = stream
 
         // Ensure parent directory exists
@@ -33,47 +48,67 @@ public final class FileLogWriter: Writer, @unchecked Sendable {
             throw LogWriterError.cannotOpenFile(path.path)
         }
 
+        self.endOffset = try handle.seekToEnd()
         self.fileHandle = handle
-        try self.fileHandle.seekToEnd()
     }
 
     /// Write data to the log file in Docker JSON format
-    /// Format: {"stream":"stdout","log":"message\n","time":"2025-01-17T12:34:56.789Z"}
+    /// Format: {"stream":"stdout","log":"message\n","time":"2025-01-17T12:34:56.789012345Z"}
     public func write(_ data: Data) throws {
+        _ = try writeReturningEnd(data)
+    }
+
+    /// Write a chunk's entries with a single write, so a chunk is never split across a
+    /// `committedEnd()` snapshot
+    public func writeReturningEnd(_ data: Data) throws -> UInt64 {
         lock.lock()
         defer { lock.unlock() }
 
+        var entries = Data()
+
         // Convert data to string (container output is typically UTF-8 text)
-        guard let message = String(data: data, encoding: .utf8) else {
+        if let message = String(data: data, encoding: .utf8) {
+            // Split into lines to write each as separate log entry
+            // This matches Docker's behavior
+            let lines = message.components(separatedBy: .newlines)
+            for (index, line) in lines.enumerated() {
+                // Skip empty last line (happens when message ends with \n)
+                if index == lines.count - 1 && line.isEmpty {
+                    continue
+                }
+
+                // Preserve original line endings
+                let logLine = (index < lines.count - 1) ? line + "\n" : line
+                entries.append(createLogEntry(message: logLine))
+            }
+        } else {
             // If not valid UTF-8, write raw bytes as base64 encoded log entry
             let base64 = data.base64EncodedString()
-            let logEntry = createLogEntry(message: "[binary data: \(data.count) bytes, base64: \(base64)]")
-            try writeLogEntry(logEntry)
-            return
+            entries.append(createLogEntry(message: "[binary data: \(data.count) bytes, base64: \(base64)]"))
         }
 
-        // Split into lines to write each as separate log entry
-        // This matches Docker's behavior
-        let lines = message.components(separatedBy: .newlines)
-        for (index, line) in lines.enumerated() {
-            // Skip empty last line (happens when message ends with \n)
-            if index == lines.count - 1 && line.isEmpty {
-                continue
-            }
+        try writeLogEntry(entries)
+        endOffset += UInt64(entries.count)
+        return endOffset
+    }
 
-            // Preserve original line endings
-            let logLine = (index < lines.count - 1) ? line + "\n" : line
-            let logEntry = createLogEntry(message: logLine)
-            try writeLogEntry(logEntry)
-        }
+    public func committedEnd() -> UInt64 {
+        lock.lock()
+        defer { lock.unlock() }
+        return endOffset
+    }
+
+    func lines(after: UInt64, through: UInt64) throws -> LogLineCursor {
+        try JSONLogFileCursor(path: path, stream: stream == "stderr" ? .stderr : .stdout, offset: after, limit: through)
     }
 
     /// Create a Docker-compatible JSON log entry
     private func createLogEntry(message: String) -> Data {
-        let timestamp = ISO8601DateFormatter().string(from: Date())
+        // Nanosecond timestamps keep stdout/stderr lines in order when replay merges the files
+        let timestamp = LogTimestamp.format(Date())
 
         // Build JSON manually to avoid encoding overhead
-        // Format: {"stream":"stdout","log":"message","time":"2025-01-17T12:34:56.789Z"}
+        // Format: {"stream":"stdout","log":"message","time":"2025-01-17T12:34:56.789012345Z"}
         let escapedMessage = message
             .replacingOccurrences(of: "\\", with: "\\\\")
             .replacingOccurrences(of: "\"", with: "\\\"")
@@ -85,8 +120,9 @@ public final class FileLogWriter: Writer, @unchecked Sendable {
         return jsonString.data(using: .utf8) ?? Data()
     }
 
-    /// Write a log entry to the file
+    /// Write log entries to the file
     private func writeLogEntry(_ data: Data) throws {
+        guard !data.isEmpty else { return }
         try fileHandle.write(contentsOf: data)
     }
 
@@ -102,11 +138,20 @@ public final class FileLogWriter: Writer, @unchecked Sendable {
     }
 }
 
+/// Log driver used to persist container stdout/stderr
+public enum LogDriver: String, Codable, Sendable {
+    /// Docker-compatible JSON lines, one file per stream (FileLogWriter)
+    case jsonFile = "json-file"
+    /// Compact framed binary records with a sparse time index (BinaryLogStore)
+    case local
+}
+
 /// Container log manager - tracks log file locations for containers
 /// @unchecked Sendable: Safe because logPaths dictionary is protected by NSLock
 public final class ContainerLogManager: @unchecked Sendable {
     private let logger: Logger
     private let baseLogDir: URL
+    private let defaultDriver: LogDriver
     private var logPaths: [String: LogPaths] = [:]  // Docker ID -> LogPaths
     private let lock = NSLock()
 
@@ -114,10 +159,16 @@ public final class ContainerLogManager: @unchecked Sendable {
         public let stdoutPath: URL
         public let stderrPath: URL
         public let combinedPath: URL
+        public let driver: LogDriver
+        /// Log directory holding the binary log and index (local driver)
+        public let logDir: URL
     }
 
-    public init(logger: Logger) {
+    /// - Parameter defaultDriver: Driver for containers that have no logs yet;
+    ///   containers keep the driver their existing logs were written with
+    public init(logger: Logger, defaultDriver: LogDriver = .jsonFile) {
         self.logger = logger
+        self.defaultDriver = defaultDriver
 
         // Use ~/Library/Application Support/com.apple.arca/logs/
         let appSupport = FileManager.default.urls(
@@ -134,32 +185,58 @@ public final class ContainerLogManager: @unchecked Sendable {
         baseLogDir.appendingPathComponent(dockerID)
     }
 
+    /// Driver for a container's log directory
+    /// Sticks to whatever format is already on disk so a driver change never hides old logs
+    public func existingDriver(logDir: URL) -> LogDriver? {
+        let fileManager = FileManager.default
+        if fileManager.fileExists(atPath: logDir.appendingPathComponent(BinaryLogFormat.logFileName).path) {
+            return .local
+        }
+        if fileManager.fileExists(atPath: logDir.appendingPathComponent("stdout.log").path) {
+            return .jsonFile
+        }
+        return nil
+    }
+
     /// Create log writers for a container
     /// Returns (stdout writer, stderr writer)
-    public func createLogWriters(dockerID: String) throws -> (FileLogWriter, FileLogWriter) {
+    public func createLogWriters(dockerID: String) throws -> (Writer, Writer) {
         let logDir = containerLogDir(dockerID: dockerID)
 
         let stdoutPath = logDir.appendingPathComponent("stdout.log")
         let stderrPath = logDir.appendingPathComponent("stderr.log")
         let combinedPath = logDir.appendingPathComponent("combined.log")
+        let driver = existingDriver(logDir: logDir) ?? defaultDriver
 
         logger.debug("Creating log writers", metadata: [
             "docker_id": "\(dockerID)",
-            "log_dir": "\(logDir.path)"
+            "log_dir": "\(logDir.path)",
+            "driver": "\(driver.rawValue)"
         ])
 
-        let stdoutWriter = try FileLogWriter(path: stdoutPath, stream: "stdout")
-        let stderrWriter = try FileLogWriter(path: stderrPath, stream: "stderr")
+        let writers: (Writer, Writer)
+        switch driver {
+        case .jsonFile:
+            writers = (
+                try FileLogWriter(path: stdoutPath, stream: "stdout"),
+                try FileLogWriter(path: stderrPath, stream: "stderr")
+            )
+        case .local:
+            let store = try BinaryLogStore(directory: logDir)
+            writers = (store.makeWriter(stream: .stdout), store.makeWriter(stream: .stderr))
+        }
 
         lock.lock()
         logPaths[dockerID] = LogPaths(
             stdoutPath: stdoutPath,
             stderrPath: stderrPath,
-            combinedPath: combinedPath
+            combinedPath: combinedPath,
+            driver: driver,
+            logDir: logDir
         )
         lock.unlock()
 
-        return (stdoutWriter, stderrWriter)
+        return writers
     }
 
     /// Get log paths for a container
@@ -175,7 +252,8 @@ public final class ContainerLogManager: @unchecked Sendable {
         dockerID: String,
         stdoutPath: URL,
         stderrPath: URL,
-        combinedPath: URL
+        combinedPath: URL,
+        driver: LogDriver = .jsonFile
     ) throws {
         lock.lock()
         defer { lock.unlock() }
@@ -183,13 +261,16 @@ public final class ContainerLogManager: @unchecked Sendable {
         logPaths[dockerID] = LogPaths(
             stdoutPath: stdoutPath,
             stderrPath: stderrPath,
-            combinedPath: combinedPath
+            combinedPath: combinedPath,
+            driver: driver,
+            logDir: stdoutPath.deletingLastPathComponent()
         )
 
         logger.debug("Registered existing log paths", metadata: [
             "docker_id": "\(dockerID)",
             "stdout": "\(stdoutPath.path)",
-            "stderr": "\(stderrPath.path)"
+            "stderr": "\(stderrPath.path)",
+            "driver": "\(driver.rawValue)"
         ])
     }
 
@@ -0,0 +1,293 @@
+import Foundation
+
+/// Daemon metrics in the Prometheus text exposition format (served at GET /metrics)
+///
+/// Latency histograms are recorded inline by the code they measure: an observation is one
+/// bucket search and a locked increment, with no allocation once a label set has been seen.
+/// Gauges and counters that already live in other components (proxy byte counts, subscriber
+/// counts, live VMs) are not mirrored here; collectors registered by the daemon read them
+/// when the endpoint is scraped, so they cost nothing between scrapes.
+/// @unchecked Sendable: Safe because the collector list is protected by NSLock
+public final class Metrics: @unchecked Sendable {
+    public static let shared = Metrics()
+
+    /// API request latency by route pattern, measured to the response head
+    public let httpRequestDuration = Histogram(
+        name: "arca_http_request_duration_seconds",
+        help: "Docker API request latency by route, to the response head for streaming responses",
+        labelNames: ["method", "route", "status"],
+        buckets: Histogram.latencyBuckets
+    )
+
+    /// Container create/start phases (image resolve, layer unpack, VM boot, network attach, ...)
+    public let containerPhaseDuration = Histogram(
+        name: "arca_container_phase_duration_seconds",
+        help: "Duration of container lifecycle phases that completed successfully",
+        labelNames: ["phase"],
+        buckets: Histogram.phaseBuckets
+    )
+
+    /// StateStore group commits, from BEGIN to COMMIT returning
+    public let stateStoreCommitDuration = Histogram(
+        name: "arca_state_store_commit_duration_seconds",
+        help: "StateStore group commit latency, including the fsync",
+        labelNames: [],
+        buckets: Histogram.latencyBuckets
+    )
+
+    /// Writes carried by each StateStore group commit
+    public let stateStoreCommitWrites = Histogram(
+        name: "arca_state_store_commit_writes",
+        help: "Writes batched into each StateStore group commit",
+        labelNames: [],
+        buckets: [1, 2, 4, 8, 16, 32, 64, 128]
+    )
+
+    /// gRPC calls from the daemon into guest services
+    public let guestRPCDuration = Histogram(
+        name: "arca_guest_rpc_duration_seconds",
+        help: "Latency of gRPC calls into guest services",
+        labelNames: ["method", "result"],
+        buckets: Histogram.latencyBuckets
+    )
+
+    private let lock = NSLock()
+    private var collectors: [@Sendable () async -> [MetricFamily]] = []
+
+    init() {}
+
+    /// Add a source of metrics read at scrape time
+    public func register(collector: @escaping @Sendable () async -> [MetricFamily]) {
+        lock.withLock { collectors.append(collector) }
+    }
+
+    /// Current value of every metric in text exposition format 0.0.4
+    public func render() async -> String {
+        var families = [
+            httpRequestDuration,
+            containerPhaseDuration,
+            stateStoreCommitDuration,
+            stateStoreCommitWrites,
+            guestRPCDuration
+        ].map { $0.family() }
+
+        for collector in lock.withLock({ collectors }) {
+            families += await collector()
+        }
+
+        var output = ""
+        for family in families {
+            family.render(into: &output)
+        }
+        return output
+    }
+}
+
+/// One named metric and its samples, as written to the exposition
+public struct MetricFamily: Sendable {
+    public enum Kind: String, Sendable {
+        case counter
+        case gauge
+        case histogram
+    }
+
+    public struct Sample: Sendable {
+        /// Appended to the family name (`_bucket`, `_sum`, `_count` for histograms)
+        public let suffix: String
+        public let labels: [(name: String, value: String)]
+        public let value: Double
+
+        public init(suffix: String = "", labels: [(name: String, value: String)] = [], value: Double) {
+            self.suffix = suffix
+            self.labels = labels
+            self.value = value
+        }
+    }
+
+    public let name: String
+    public let help: String
+    public let kind: Kind
+    public let samples: [Sample]
+
+    public init(name: String, help: String, kind: Kind, samples: [Sample]) {
+        self.name = name
+        self.help = help
+        self.kind = kind
+        self.samples = samples
+    }
+
+    /// Single unlabelled gauge
+    public static func gauge(_ name: String, help: String, value: Double) -> MetricFamily {
+        MetricFamily(name: name, help: help, kind: .gauge, samples: [Sample(value: value)])
+    }
+
+    func render(into output: inout String) {
+        output += "# HELP \(name) \(help)\n"
+        output += "# TYPE \(name) \(kind.rawValue)\n"
+        for sample in samples {
+            output += name
+            output += sample.suffix
+            if !sample.labels.isEmpty {
+                output += "{"
+                for (index, label) in sample.labels.enumerated() {
+                    if index > 0 { output += "," }
+                    output += label.name
+                    output += "=\""
+                    output += Self.escape(label.value)
+                    output += "\""
+                }
+                output += "}"
+            }
+            output += " "
+            output += Self.format(sample.value)
+            output += "\n"
+        }
+    }
+
+    static func format(_ value: Double) -> String {
+        if value == .infinity { return "+Inf" }
+        if value == -.infinity { return "-Inf" }
+        if value.isNaN { return "NaN" }
+        if value == value.rounded(), abs(value) < 1e15 {
+            return String(Int64(value))
+        }
+        return String(value)
+    }
+
+    static func escape(_ value: String) -> String {
+        guard value.contains(where: { $0 == "\\" || $0 == "\"" || $0 == "\n" }) else {
+            return value
+        }
+        var escaped = ""
+        for character in value {
+            switch character {
+            case "\\": escaped += "\\\\"
+            case "\"": escaped += "\\\""
+            case "\n": escaped += "\\n"
+            default: escaped.append(character)
+            }
+        }
+        return escaped
+    }
+}
+
+/// Fixed-bucket histogram partitioned by label values
+/// @unchecked Sendable: Safe because all series are protected by NSLock
+public final class Histogram: @unchecked Sendable {
+    /// 1 ms to 10 s, for request and RPC latency
+    public static let latencyBuckets: [Double] = [
+        0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10
+    ]
+    /// 10 ms to 2 min, for lifecycle phases such as image unpack and VM boot
+    public static let phaseBuckets: [Double] = [
+        0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 120
+    ]
+
+    private struct Series {
+        /// Per-bucket counts (not cumulative); the last entry is the +Inf overflow
+        var counts: [UInt64]
+        var sum: Double = 0
+        var count: UInt64 = 0
+
+        mutating func record(_ value: Double, bucket: Int) {
+            counts[bucket] += 1
+            sum += value
+            count += 1
+        }
+    }
+
+    public let name: String
+    public let help: String
+    public let labelNames: [String]
+    private let buckets: [Double]
+
+    private let lock = NSLock()
+    private var series: [[String]: Series] = [:]
+
+    public init(name: String, help: String, labelNames: [String], buckets: [Double]) {
+        self.name = name
+        self.help = help
+        self.labelNames = labelNames
+        self.buckets = buckets.sorted()
+    }
+
+    /// Record one observation
+    /// - Parameter labels: Values for `labelNames`, in order
+    public func observe(_ value: Double, labels: [String] = []) {
+        var bucket = buckets.count
+        for (index, bound) in buckets.enumerated() where value <= bound {
+            bucket = index
+            break
+        }
+
+        let slots = buckets.count + 1
+        lock.withLock {
+            series[labels, default: Series(counts: Array(repeating: 0, count: slots))].record(value, bucket: bucket)
+        }
+    }
+
+    /// Record the seconds elapsed since `start`
+    public func observe(since start: ContinuousClock.Instant, labels: [String] = []) {
+        let elapsed = ContinuousClock.now - start
+        let seconds = Double(elapsed.components.seconds) + Double(elapsed.components.attoseconds) / 1e18
+        observe(seconds, labels: labels)
+    }
+
+    /// Observations so far for one label set: cumulative bucket counts, sum and count
+    func snapshot(labels: [String] = []) -> (buckets: [UInt64], sum: Double, count: UInt64)? {
+        guard let entry = lock.withLock({ series[labels] }) else { return nil }
+        var running: UInt64 = 0
+        let cumulative = entry.counts.map { count -> UInt64 in
+            running += count
+            return running
+        }
+        return (cumulative, entry.sum, entry.count)
+    }
+
+    func family() -> MetricFamily {
+        let current = lock.withLock { series }
+        var samples: [MetricFamily.Sample] = []
+        samples.reserveCapacity(current.count * (buckets.count + 3))
+
+        // Sorted so series appear in a stable order between scrapes
+        for (values, entry) in current.sorted(by: { $0.key.lexicographicallyPrecedes($1.key) }) {
+            let labels = Array(zip(labelNames, values)).map { (name: $0.0, value: $0.1) }
+            var running: UInt64 = 0
+            for (index, count) in entry.counts.enumerated() {
+                running += count
+                let bound = index < buckets.count ? MetricFamily.format(buckets[index]) : "+Inf"
+                samples.append(MetricFamily.Sample(
+                    suffix: "_bucket",
+                    labels: labels + [(name: "le", value: bound)],
+                    value: Double(running)
+                ))
+            }
+            samples.append(MetricFamily.Sample(suffix: "_sum", labels: labels, value: entry.sum))
+            samples.append(MetricFamily.Sample(suffix: "_count", labels: labels, value: Double(entry.count)))
+        }
+
+        return MetricFamily(name: name, help: help, kind: .histogram, samples: samples)
+    }
+}
+
+/// One container lifecycle phase, timed into `containerPhaseDuration` and traced as a span
+/// A phase that throws before `end()` is not recorded.
+public struct ContainerPhase: Sendable {
+    private let name: String
+    private let started = ContinuousClock.now
+    private let span: Span?
+
+    public static func begin(_ name: String, containerID: String) -> ContainerPhase {
+        ContainerPhase(name: name, span: Tracing.start("phase \(name)", metadata: ["container": "\(containerID)"]))
+    }
+
+    private init(name: String, span: Span?) {
+        self.name = name
+        self.span = span
+    }
+
+    public func end() {
+        Metrics.shared.containerPhaseDuration.observe(since: started, labels: [name])
+        span?.finish()
+    }
+}
@@ -18,10 +18,12 @@ public final class MultiWriter: Writer, @unchecked Sendable {
         defer { lock.unlock() }
 
         var lastError: Error?
+        var delivered = false
 
         for writer in writers {
             do {
                 try writer.write(data)
+                delivered = true
             } catch {
                 // Store error but continue writing to other writers
                 // This ensures one failing destination doesn't break others
@@ -30,15 +32,7 @@ public final class MultiWriter: Writer, @unchecked Sendable {
         }
 
         // If all writers failed, throw the last error
-        if let error = lastError, writers.allSatisfy({ writer in
-            // Check if this writer failed by attempting a zero-byte write
-            do {
-                try writer.write(Data())
-                return false  // Succeeded
-            } catch {
-                return true  // Failed
-            }
-        }) {
+        if let error = lastError, !delivered {
             throw error
         }
     }
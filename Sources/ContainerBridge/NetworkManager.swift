@@ -58,6 +58,9 @@ public actor NetworkManager {
                     throw NetworkManagerError.containerNotFound(containerID)
                 }
                 return container
+            },
+            getControlChannels: { [weak self] containerID in
+                await self?.containerManager.getControlChannels(id: containerID)
             }
         )
         self.wireGuardBackend = backend
@@ -634,10 +637,14 @@ public actor NetworkManager {
             return nil
         }
 
-        // Create client
+        // Create client over the container's persistent WireGuard channel when it has one
         let client = WireGuardClient(logger: logger)
         do {
-            try await client.connect(container: container, vsockPort: 51820)
+            if let channels = await containerManager.getControlChannels(id: containerID) {
+                try await client.connect(channels: channels)
+            } else {
+                try await client.connect(container: container, vsockPort: 51820)
+            }
             return client
         } catch {
             logger.error("Failed to create WireGuard client for port mapping", metadata: [
@@ -661,6 +668,17 @@ public actor NetworkManager {
         }
     }
 
+    /// Start configuring WireGuard mesh links among `containerIDs` together
+    /// See WireGuardNetworkBackend.beginMeshBatch(containerIDs:)
+    public func beginMeshBatch(containerIDs: Set<String>) async {
+        await wireGuardBackend?.beginMeshBatch(containerIDs: containerIDs)
+    }
+
+    /// Configure the mesh links deferred since beginMeshBatch(containerIDs:)
+    public func finishMeshBatch() async {
+        await wireGuardBackend?.finishMeshBatch()
+    }
+
     // MARK: - Helper Methods
 
     /// Generate a Docker-compatible network ID (64-char hex)
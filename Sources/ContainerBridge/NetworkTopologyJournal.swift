@@ -0,0 +1,185 @@
+import Foundation
+
+/// Versioned peer and DNS membership of each WireGuard network
+///
+/// Every join and leave bumps the network's version. The journal remembers which version
+/// each member's guest has applied, so a guest is sent only what changed since then
+/// (`delta(networkID:for:)`) instead of one RPC per peer per change. Scaling a service from
+/// 1 to 20 replicas is then one delta per container carrying the new replicas, rather than
+/// one AddPeer per pair.
+///
+/// Added peers are derived from the current membership (each member is stamped with the
+/// version it joined at), so only removals are logged. The log keeps the most recent
+/// `retention` removals; a guest older than the log gets a full sync instead.
+struct NetworkTopologyJournal: Sendable {
+    struct Peer: Sendable, Equatable {
+        let containerID: String
+        let publicKey: String
+        let endpoint: String
+        let ipAddress: String
+        let name: String
+        let aliases: [String]
+    }
+
+    /// What a guest needs to go from `baseVersion` to `version`
+    struct Delta: Sendable, Equatable {
+        let baseVersion: UInt64
+        let version: UInt64
+        /// `added` is the complete peer set; the guest drops peers not listed
+        let fullSync: Bool
+        let added: [Peer]
+        /// Peers to remove, applied before `added`
+        let removed: [Peer]
+        /// The subscriber's own public key when the delta was taken (see acknowledge)
+        let subscriberKey: String
+    }
+
+    private struct Member {
+        let peer: Peer
+        let version: UInt64  // Version the peer joined at
+        var applied: UInt64?  // Version the member's guest has; nil until its first sync
+        var active = true  // False while the container is stopped
+    }
+
+    private struct Removal {
+        let peer: Peer
+        let addedVersion: UInt64
+        let version: UInt64
+    }
+
+    private struct Network {
+        var version: UInt64 = 0
+        var members: [String: Member] = [:]  // containerID -> member
+        var removals: [Removal] = []
+        var floor: UInt64 = 0  // Removals at or below this version were discarded
+    }
+
+    private var networks: [String: Network] = [:]
+    private let retention: Int
+
+    init(retention: Int = 1024) {
+        self.retention = max(retention, 1)
+    }
+
+    /// Current version of a network's topology (0 if it has no members)
+    func version(networkID: String) -> UInt64 {
+        networks[networkID]?.version ?? 0
+    }
+
+    /// Add a container to a network, replacing its previous interface if it rejoins
+    /// The container's guest starts over with a full sync.
+    @discardableResult
+    mutating func join(networkID: String, peer: Peer) -> UInt64 {
+        var network = networks[networkID] ?? Network()
+        network.version += 1
+        if let previous = network.members[peer.containerID] {
+            appendRemoval(Removal(peer: previous.peer, addedVersion: previous.version, version: network.version), to: &network)
+        }
+        network.members[peer.containerID] = Member(peer: peer, version: network.version)
+        networks[networkID] = network
+        return network.version
+    }
+
+    /// Remove a container from a network
+    /// - Returns: The new version, nil if the container was not a member
+    @discardableResult
+    mutating func leave(networkID: String, containerID: String) -> UInt64? {
+        guard var network = networks[networkID],
+              let member = network.members.removeValue(forKey: containerID) else {
+            return nil
+        }
+        guard !network.members.isEmpty else {
+            networks.removeValue(forKey: networkID)
+            return nil
+        }
+        network.version += 1
+        appendRemoval(Removal(peer: member.peer, addedVersion: member.version, version: network.version), to: &network)
+        networks[networkID] = network
+        return network.version
+    }
+
+    /// Stop delivering to a container whose VM stopped
+    /// Guests that already have its peer entry keep it until it rejoins or leaves, but it is
+    /// not sent to anyone else meanwhile. Its own guest state is gone, so it gets a full sync
+    /// when it rejoins.
+    mutating func suspend(containerID: String) {
+        for networkID in Array(networks.keys) where networks[networkID]?.members[containerID] != nil {
+            networks[networkID]?.members[containerID]?.active = false
+            networks[networkID]?.members[containerID]?.applied = nil
+        }
+    }
+
+    /// Active members whose guests are behind the network's version
+    func pending(networkID: String) -> [String] {
+        guard let network = networks[networkID] else { return [] }
+        return network.members.filter { $0.value.active && $0.value.applied != network.version }.keys.sorted()
+    }
+
+    /// Changes a member's guest has not applied, nil if it is current
+    /// Added peers (and a full sync's peer set) cover active members only; a stopped member
+    /// has no WireGuard interface or address to reach.
+    func delta(networkID: String, for containerID: String) -> Delta? {
+        guard let network = networks[networkID],
+              let member = network.members[containerID],
+              member.applied != network.version else {
+            return nil
+        }
+
+        guard let since = member.applied, since >= network.floor else {
+            return Delta(
+                baseVersion: 0,
+                version: network.version,
+                fullSync: true,
+                added: Self.peers(network.members.filter { $0.key != containerID && $0.value.active }.values.map(\.peer)),
+                removed: [],
+                subscriberKey: member.peer.publicKey
+            )
+        }
+
+        let added = network.members.filter {
+            $0.key != containerID && $0.value.active && $0.value.version > since
+        }.values.map(\.peer)
+        // Peers added and removed since `since` were never seen by this guest
+        let removed = network.removals.filter {
+            $0.version > since && $0.addedVersion <= since && $0.peer.containerID != containerID
+        }.map(\.peer)
+
+        return Delta(
+            baseVersion: since,
+            version: network.version,
+            fullSync: false,
+            added: Self.peers(added),
+            removed: removed,
+            subscriberKey: member.peer.publicKey
+        )
+    }
+
+    /// Record the version a member's guest reported after applying a delta
+    /// Ignored if the member rejoined (new interface key) since the delta was taken.
+    mutating func acknowledge(networkID: String, containerID: String, subscriberKey: String, version: UInt64) {
+        guard let member = networks[networkID]?.members[containerID],
+              member.peer.publicKey == subscriberKey,
+              member.applied.map({ $0 < version }) ?? true else {
+            return
+        }
+        networks[networkID]?.members[containerID]?.applied = version
+    }
+
+    /// Forget a member's applied version so its next delta is a full sync
+    mutating func resync(networkID: String, containerID: String) {
+        networks[networkID]?.members[containerID]?.applied = nil
+    }
+
+    private mutating func appendRemoval(_ removal: Removal, to network: inout Network) {
+        network.removals.append(removal)
+        let excess = network.removals.count - retention
+        if excess > 0 {
+            network.floor = network.removals[excess - 1].version
+            network.removals.removeFirst(excess)
+        }
+    }
+
+    private static func peers(_ peers: [Peer]) -> [Peer] {
+        peers.sorted { $0.containerID < $1.containerID }
+    }
+}
@@ -0,0 +1,224 @@
+import Foundation
+import Logging
+import ContainerizationEXT4
+import SystemPackage
+
+/// Pre-formatted empty EXT4 images, cloned to create writable layers and block volumes
+///
+/// Formatting a thin-provisioned filesystem still writes its superblocks, group descriptors
+/// and inode tables, which takes long enough to show up on every `docker run` and
+/// `docker volume create`. The store formats one empty image per size class the first time
+/// it is asked for, then hands out APFS clones of it: `clonefile` shares the template's
+/// extents, so a new filesystem costs one metadata operation and no data writes, and
+/// blocks are only copied as the guest writes to them.
+///
+/// Clones share the template's filesystem UUID. Guests mount writable layers and volumes
+/// by device path, never by UUID, so this is harmless.
+///
+/// When the destination is not on the template's APFS volume (or not on APFS at all) the
+/// clone fails and the image is formatted in place, as before.
+///
+/// @unchecked Sendable: Safe because the usage tables are protected by `lock`, and each
+/// size class's format by its own NSLock
+public final class EXT4TemplateStore: @unchecked Sendable {
+    private static let templateExtension = "ext4"
+    private static let partialExtension = "partial"
+
+    private let directory: URL
+    private let maxTemplates: Int
+    private let logger: Logger?
+
+    private let lock = NSLock()
+    private var lastUsed: [String: Date] = [:]  // Template file name -> last clone
+    private var cloning: [String: Int] = [:]  // Template file name -> clones in progress (never evicted)
+    private var formatLocks: [String: NSLock] = [:]  // Template file name -> held while formatting it
+    private var cloneUnsupported: Set<dev_t> = []  // Destination volumes that can't be cloned into
+
+    /// - Parameters:
+    ///   - directory: Where templates live; must be on the same APFS volume as clone destinations
+    ///   - maxTemplates: Size classes kept on disk; the least recently used is removed beyond this
+    public init(directory: URL, maxTemplates: Int = 8, logger: Logger? = nil) {
+        self.directory = directory
+        self.maxTemplates = max(maxTemplates, 1)
+        self.logger = logger
+
+        // An interrupted format leaves a .partial behind; finished templates are adopted
+        let entries = (try? FileManager.default.contentsOfDirectory(at: directory, includingPropertiesForKeys: nil)) ?? []
+        for entry in entries {
+            if entry.pathExtension == Self.templateExtension {
+                lastUsed[entry.lastPathComponent] = .distantPast
+            } else {
+                try? FileManager.default.removeItem(at: entry)
+            }
+        }
+    }
+
+    /// Create an empty EXT4 filesystem at `path`, cloned from the template for its size class
+    /// - Parameters:
+    ///   - sizeBytes: Minimum disk size passed to the formatter
+    ///   - blockSize: Filesystem block size; the formatter's default when nil
+    /// - Returns: true if the filesystem was cloned, false if it had to be formatted in place
+    /// - Throws: If neither cloning nor formatting succeeds, or `path` already exists
+    @discardableResult
+    public func createFilesystem(at path: String, sizeBytes: UInt64, blockSize: UInt32? = nil) throws -> Bool {
+        let destinationDirectory = (path as NSString).deletingLastPathComponent
+        guard !FileManager.default.fileExists(atPath: path) else {
+            throw EXT4TemplateError.destinationExists(path)
+        }
+
+        let volume = Self.volume(of: destinationDirectory)
+        if !lock.withLock({ volume.map { cloneUnsupported.contains($0) } ?? false }) {
+            do {
+                let template = try acquireTemplate(sizeBytes: sizeBytes, blockSize: blockSize)
+                defer { release(template) }
+                if try Self.clone(template, to: path) {
+                    return true
+                }
+                if let volume = volume {
+                    lock.withLock { _ = cloneUnsupported.insert(volume) }
+                }
+                logger?.warning("Destination does not support cloning, formatting in place", metadata: [
+                    "template": "\(template.path)",
+                    "destination": "\(destinationDirectory)"
+                ])
+            } catch let error as EXT4TemplateError {
+                throw error
+            } catch {
+                logger?.warning("EXT4 template unavailable, formatting in place", metadata: [
+                    "size_bytes": "\(sizeBytes)",
+                    "error": "\(error)"
+                ])
+            }
+        }
+
+        try Self.format(at: path, sizeBytes: sizeBytes, blockSize: blockSize)
+        return false
+    }
+
+    /// Clone an existing filesystem image, e.g. a stopped container's writable layer
+    /// - Returns: false if the volume does not support cloning; nothing is created then
+    public static func clone(_ source: URL, to path: String) throws -> Bool {
+        #if os(macOS)
+        guard clonefile(source.path, path, 0) != 0 else {
+            return true
+        }
+        let code = errno
+        switch code {
+        case ENOTSUP, EXDEV:
+            return false
+        default:
+            throw EXT4TemplateError.cloneFailed(source: source.path, destination: path, errno: code)
+        }
+        #else
+        return false
+        #endif
+    }
+
+    /// Template for a size class, formatting it on first use
+    ///
+    /// The template is protected from eviction until `release(_:)`, so it can't disappear
+    /// before the caller has cloned it. Concurrent callers for the same missing template wait
+    /// for one format instead of each running it. Callers for other size classes don't wait.
+    private func acquireTemplate(sizeBytes: UInt64, blockSize: UInt32?) throws -> URL {
+        let name = "empty-\(sizeBytes)-\(blockSize.map { "\($0)" } ?? "default").\(Self.templateExtension)"
+        let url = directory.appendingPathComponent(name)
+
+        let formatLock = lock.withLock { () -> NSLock in
+            if let existing = formatLocks[name] {
+                return existing
+            }
+            let created = NSLock()
+            formatLocks[name] = created
+            return created
+        }
+
+        return try formatLock.withLock {
+            let ready = lock.withLock { () -> Bool in
+                guard lastUsed[name] != nil, FileManager.default.fileExists(atPath: url.path) else { return false }
+                protectLocked(name)
+                return true
+            }
+            if !ready {
+                try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+
+                // Format into a .partial file and rename when complete, so an interrupted
+                // format is never adopted as a template
+                let partial = url.deletingPathExtension().appendingPathExtension(Self.partialExtension)
+                try? FileManager.default.removeItem(at: partial)
+                do {
+                    try Self.format(at: partial.path, sizeBytes: sizeBytes, blockSize: blockSize)
+                    try FileManager.default.moveItem(at: partial, to: url)
+                } catch {
+                    try? FileManager.default.removeItem(at: partial)
+                    throw error
+                }
+
+                logger?.info("Created EXT4 template", metadata: [
+                    "path": "\(url.path)",
+                    "size_bytes": "\(sizeBytes)"
+                ])
+                lock.withLock { protectLocked(name) }
+            }
+            return url
+        }
+    }
+
+    /// End the protection `acquireTemplate` gave a template
+    private func release(_ template: URL) {
+        let name = template.lastPathComponent
+        lock.withLock {
+            let count = cloning[name] ?? 1
+            cloning[name] = count > 1 ? count - 1 : nil
+        }
+    }
+
+    /// Mark a template used and protect it from eviction until released
+    private func protectLocked(_ name: String) {
+        lastUsed[name] = Date()
+        cloning[name, default: 0] += 1
+        evictLocked()
+    }
+
+    /// Remove the least recently used templates beyond `maxTemplates`, skipping any being cloned
+    /// Removing a template never affects its clones; they keep the extents they share with it.
+    private func evictLocked() {
+        while lastUsed.count > maxTemplates,
+              let oldest = lastUsed.filter({ cloning[$0.key] == nil }).min(by: { $0.value < $1.value })?.key {
+            lastUsed.removeValue(forKey: oldest)
+            try? FileManager.default.removeItem(at: directory.appendingPathComponent(oldest))
+        }
+    }
+
+    /// Device of the volume holding `path`, nil if it can't be determined
+    private static func volume(of path: String) -> dev_t? {
+        var info = stat()
+        guard stat(path, &info) == 0 else { return nil }
+        return info.st_dev
+    }
+
+    private static func format(at path: String, sizeBytes: UInt64, blockSize: UInt32?) throws {
+        let formatter: EXT4.Formatter
+        if let blockSize = blockSize {
+            formatter = try EXT4.Formatter(FilePath(path), blockSize: blockSize, minDiskSize: sizeBytes)
+        } else {
+            formatter = try EXT4.Formatter(FilePath(path), minDiskSize: sizeBytes)
+        }
+        try formatter.close()
+    }
+}
+
+/// Errors creating filesystems from EXT4 templates
+public enum EXT4TemplateError: Error, CustomStringConvertible {
+    case destinationExists(String)
+    /// clonefile failed for a reason other than the volume lacking clone support
+    case cloneFailed(source: String, destination: String, errno: Int32)
+
+    public var description: String {
+        switch self {
+        case .destinationExists(let path):
+            return "Filesystem image already exists: \(path)"
+        case .cloneFailed(let source, let destination, let code):
+            return "Failed to clone \(source) to \(destination): \(String(cString: strerror(code)))"
+        }
+    }
+}
@@ -155,13 +155,16 @@ public struct OverlayFSMounter: Sendable {
     /// Creates an EXT4 filesystem file that will be mounted in the guest
     /// as /dev/vdc and used for OverlayFS upper and work directories.
     ///
-    /// Uses Apple's ContainerizationEXT4 framework for filesystem creation.
+    /// Uses Apple's ContainerizationEXT4 framework for filesystem creation. With a template
+    /// store the filesystem is an APFS clone of a pre-formatted template instead, which
+    /// writes no data.
     ///
     /// - Parameters:
     ///   - path: Path where to create writable.ext4
     ///   - sizeMB: Size in megabytes (default: 65536 MB = 64 GB, thin-provisioned)
+    ///   - templates: Clone from this store's template for the size; format directly when nil
     /// - Throws: If filesystem creation fails
-    public func createWritableFilesystem(at path: String, sizeMB: Int = 65536) throws {
+    public func createWritableFilesystem(at path: String, sizeMB: Int = 65536, templates: EXT4TemplateStore? = nil) throws {
         logger?.info("Creating writable filesystem", metadata: [
             "path": "\(path)",
             "size_mb": "\(sizeMB)"
@@ -174,9 +177,19 @@ public struct OverlayFSMounter: Sendable {
             withIntermediateDirectories: true
         )
 
+        let sizeBytes = UInt64(sizeMB) * 1024 * 1024  // Convert MB to bytes
+        if let templates = templates {
+            let cloned = try templates.createFilesystem(at: path, sizeBytes: sizeBytes)
+            logger?.info("Writable filesystem created successfully", metadata: [
+                "path": "\(path)",
+                "size_mb": "\(sizeMB)",
+                "cloned": "\(cloned)"
+            ])
+            return
+        }
+
         // Create EXT4 filesystem using Apple's ContainerizationEXT4 framework
         // This is the same method used for creating temp-rootfs.ext4
-        let sizeBytes = UInt64(sizeMB) * 1024 * 1024  // Convert MB to bytes
         let formatter = try ContainerizationEXT4.EXT4.Formatter(
             FilePath(path),
             minDiskSize: sizeBytes
@@ -1,28 +1,74 @@
-#if os(macOS)
-
 import Foundation
 import Logging
 import Containerization
 import ContainerizationOCI
 
+/// Layer cache settings
+public struct LayerCacheConfig: Codable, Sendable {
+    /// Evict least recently used layers not in use by any container above this size; 32 GB when unset
+    public let maxSizeMB: Int?
+    /// Unpack layers to ext4 as part of `docker pull` so the first run doesn't; on when unset
+    public let prefetchOnPull: Bool?
+
+    public init(maxSizeMB: Int? = nil, prefetchOnPull: Bool? = nil) {
+        self.maxSizeMB = maxSizeMB
+        self.prefetchOnPull = prefetchOnPull
+    }
+}
+
+/// Receives freshly pulled images so their layers can be prepared ahead of `docker run`
+/// This allows ImageManager to hand off images without depending on the OverlayFS unpacker
+public protocol LayerPrefetcher: Sendable {
+    func prefetchLayers(of image: Containerization.Image, platform: ContainerizationOCI.Platform) async
+}
+
+#if os(macOS)
+
 /// Arca-specific OverlayFS unpacker with layer caching and database integration
 ///
 /// This wrapper extends Apple's Containerization framework with:
 /// - Layer caching at ~/.arca/layers/{digest}/layer.ext4
 /// - Database integration for cache tracking
 /// - Parallel layer unpacking for performance
+/// - Single-flight layer preparation: concurrent creates (and the pull-time prefetch) of
+///   images sharing layers build each layer.ext4 once and wait for each other
+/// - Size-bounded LRU eviction of layers no container uses
 ///
 /// Follows the WireGuard pattern: all Arca-specific logic stays in ContainerBridge.
-public actor OverlayFSUnpacker {
+public actor OverlayFSUnpacker: LayerPrefetcher {
     private let logger: Logger
     private let baseUnpacker: Containerization.OverlayFSUnpacker
     private let layerCachePath: URL
     private let stateStore: StateStore
+    private let maxCacheBytes: Int64
 
-    public init(layerCachePath: URL, stateStore: StateStore, logger: Logger) {
+    /// Digests of layers referenced by existing containers (never evicted)
+    private let layersInUse: @Sendable () async -> Set<String>
+
+    /// Layer preparation in progress, keyed by image digest and platform
+    private var preparing: [String: Task<Void, Error>] = [:]
+    /// Layer digest -> preparation key that is building it
+    private var layerOwners: [String: String] = [:]
+    /// Layer digest -> unpacks and prefetches currently relying on it, cached or not
+    private var pinned: [String: Int] = [:]
+    /// Layer digest -> `pinSequence` when it was last pinned, so a collection can tell which
+    /// layers were pinned (and maybe already unpinned) after it started
+    private var lastPinned: [String: UInt64] = [:]
+    private var pinSequence: UInt64 = 0
+    private var collection: Task<Void, Never>?
+
+    public init(
+        layerCachePath: URL,
+        stateStore: StateStore,
+        config: LayerCacheConfig? = nil,
+        layersInUse: @escaping @Sendable () async -> Set<String> = { [] },
+        logger: Logger
+    ) {
         self.logger = logger
         self.layerCachePath = layerCachePath
         self.stateStore = stateStore
+        self.maxCacheBytes = Int64(config?.maxSizeMB ?? 32 * 1024) * 1024 * 1024
+        self.layersInUse = layersInUse
 
         // Initialize base unpacker from containerization framework
         self.baseUnpacker = Containerization.OverlayFSUnpacker(
@@ -52,6 +98,16 @@ public actor OverlayFSUnpacker {
             "platform": "\(platform.os)/\(platform.architecture)"
         ])
 
+        // Pinned until the unpack returns; the caller keeps the image in `layersInUse` from
+        // then until the container is registered
+        let layers = try await image.manifest(for: platform).layers.map { $0.digest }
+        pin(layers)
+        defer { unpin(layers) }
+
+        // Build (or join the build of) any missing layers first, so the base unpacker
+        // below only has to link cached layers into this container
+        try await prepareLayers(of: image, platform: platform, layers: layers)
+
         // Delegate to base unpacker - it handles parallel unpacking and caching
         let config = try await baseUnpacker.unpack(
             image,
@@ -60,6 +116,8 @@ public actor OverlayFSUnpacker {
             progress: nil
         )
 
+        try? await stateStore.touchLayers(digests: layers)
+
         logger.info("OverlayFS unpack complete", metadata: [
             "layers": "\(config.lowerLayers.count)",
             "upper": "\(config.upperDir.path)",
@@ -68,6 +126,189 @@ public actor OverlayFSUnpacker {
 
         return config
     }
+
+    /// Build an image's layer cache right after it is pulled
+    public func prefetchLayers(of image: Containerization.Image, platform: ContainerizationOCI.Platform) async {
+        let start = Date()
+        do {
+            let layers = try await image.manifest(for: platform).layers.map { $0.digest }
+            pin(layers)
+            defer { unpin(layers) }
+            try await prepareLayers(of: image, platform: platform, layers: layers)
+            logger.info("Prefetched image layers", metadata: [
+                "image": "\(image.reference)",
+                "layers": "\(layers.count)",
+                "duration_seconds": "\(String(format: "%.2f", Date().timeIntervalSince(start)))"
+            ])
+        } catch {
+            // The first create unpacks instead
+            logger.warning("Layer prefetch failed", metadata: [
+                "image": "\(image.reference)",
+                "error": "\(error)"
+            ])
+        }
+    }
+
+    // MARK: - Single-flight preparation
+
+    /// Ensure every layer of `image` (`layers`, its layer digests) is in the cache
+    private func prepareLayers(
+        of image: Containerization.Image,
+        platform: ContainerizationOCI.Platform,
+        layers: [String]
+    ) async throws {
+        let key = "\(image.digest)@\(platform.os)/\(platform.architecture)"
+
+        if let running = preparing[key] {
+            try await running.value
+            return
+        }
+
+        var missing = false
+        for digest in layers {
+            if !(await isCached(digest)) {
+                missing = true
+                break
+            }
+        }
+        // Re-check after the awaits above: another caller may have started meanwhile
+        if let running = preparing[key] {
+            try await running.value
+            return
+        }
+        guard missing else { return }
+
+        // Images sharing a layer that another image is already building wait for it;
+        // the base unpacker then finds that layer cached and skips it
+        let blockers = Set(layers.compactMap { layerOwners[$0] }).compactMap { preparing[$0] }
+        let scratchRoot = layerCachePath.appendingPathComponent(".prefetch")
+        let baseUnpacker = self.baseUnpacker
+        let task = Task<Void, Error> {
+            for blocker in blockers {
+                try? await blocker.value
+            }
+
+            // Upper/work directories of the throwaway unpack go to a scratch container path
+            let scratch = scratchRoot.appendingPathComponent(UUID().uuidString)
+            try FileManager.default.createDirectory(at: scratch, withIntermediateDirectories: true)
+            defer { try? FileManager.default.removeItem(at: scratch) }
+            _ = try await baseUnpacker.unpack(image, for: platform, at: scratch, progress: nil)
+        }
+
+        preparing[key] = task
+        for digest in layers where layerOwners[digest] == nil {
+            layerOwners[digest] = key
+        }
+        defer {
+            preparing.removeValue(forKey: key)
+            for digest in layers where layerOwners[digest] == key {
+                layerOwners.removeValue(forKey: digest)
+            }
+        }
+
+        try await task.value
+        scheduleCollection()
+    }
+
+    func pin(_ layers: [String]) {
+        pinSequence += 1
+        for digest in layers {
+            pinned[digest, default: 0] += 1
+            lastPinned[digest] = pinSequence
+        }
+    }
+
+    func unpin(_ layers: [String]) {
+        for digest in layers {
+            guard let count = pinned[digest] else { continue }
+            pinned[digest] = count > 1 ? count - 1 : nil
+        }
+    }
+
+    private func isCached(_ digest: String) async -> Bool {
+        guard let entry = try? await stateStore.loadLayerCache(digest: digest) else { return false }
+        return FileManager.default.fileExists(atPath: entry.path)
+    }
+
+    // MARK: - Garbage collection
+
+    /// Evict least recently used layers until the cache fits its size bound
+    ///
+    /// Layers referenced by existing containers, being built, or pinned by an unpack in
+    /// progress are never evicted.
+    /// - Returns: Bytes reclaimed
+    @discardableResult
+    public func collectGarbage() async -> Int64 {
+        let started = pinSequence
+        let cached: [(digest: String, path: String, size: Int64, refCount: Int, lastUsed: Date)]
+        do {
+            cached = try await stateStore.loadAllCachedLayers()
+        } catch {
+            logger.warning("Failed to load layer cache for eviction", metadata: ["error": "\(error)"])
+            return 0
+        }
+
+        var total = cached.reduce(Int64(0)) { $0 + $1.size }
+        guard total > maxCacheBytes else { return 0 }
+
+        let protected = await layersInUse()
+        var reclaimed: Int64 = 0
+        var evicted = 0
+        for layer in cached.sorted(by: { $0.lastUsed < $1.lastUsed }) where !protected.contains(layer.digest) {
+            guard total > maxCacheBytes else { break }
+
+            // Checked again for every layer, with no suspension before the removal: an unpack
+            // may have pinned it (or a build claimed it) while an earlier eviction was awaited
+            guard !isProtected(layer.digest, since: started) else { continue }
+
+            let layerDir = URL(fileURLWithPath: layer.path).deletingLastPathComponent()
+            lastPinned.removeValue(forKey: layer.digest)
+            do {
+                if FileManager.default.fileExists(atPath: layerDir.path) {
+                    try FileManager.default.removeItem(at: layerDir)
+                }
+                try await stateStore.deleteLayerCache(digest: layer.digest)
+            } catch {
+                logger.warning("Failed to evict cached layer", metadata: [
+                    "digest": "\(layer.digest.prefix(19))...",
+                    "error": "\(error)"
+                ])
+                continue
+            }
+
+            total -= layer.size
+            reclaimed += layer.size
+            evicted += 1
+        }
+
+        logger.info("Layer cache eviction complete", metadata: [
+            "evicted": "\(evicted)",
+            "reclaimed_mb": "\(reclaimed / 1024 / 1024)",
+            "cache_mb": "\(total / 1024 / 1024)",
+            "limit_mb": "\(maxCacheBytes / 1024 / 1024)"
+        ])
+        return reclaimed
+    }
+
+    /// Whether a layer is pinned, being built, or was pinned after `sequence`
+    /// The last covers an unpack that started and finished during a collection: its container
+    /// may not have been in `layersInUse` when the collection read it.
+    private func isProtected(_ digest: String, since sequence: UInt64) -> Bool {
+        pinned[digest] != nil || layerOwners[digest] != nil || (lastPinned[digest] ?? 0) > sequence
+    }
+
+    /// Run a collection in the background unless one is already running
+    public func scheduleCollection() {
+        guard collection == nil else { return }
+        collection = Task { [weak self] in
+            await self?.collectGarbage()
+            await self?.collectionFinished()
+        }
+    }
+
+    private func collectionFinished() {
+        collection = nil
+    }
 }
 
-#endif
\ No newline at end of file
+#endif
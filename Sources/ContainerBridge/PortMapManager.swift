@@ -1,5 +1,6 @@
 import Foundation
 import Logging
+import NIOPosix
 #if canImport(Darwin)
 import Darwin
 #endif
@@ -12,9 +13,12 @@ import Darwin
 /// - Call WireGuard gRPC for nftables rules (non-localhost bindings)
 /// - Track proxy processes and port mappings per container
 /// - Clean up proxies when containers stop
+///
+/// All proxies share one event loop group sized to the host's cores.
 public actor PortMapManager {
     private let logger: Logger
     private let dumpNftablesOnPublish: Bool
+    private let proxyEventLoopGroup: MultiThreadedEventLoopGroup
 
     /// Internal port binding information for a container
     private struct InternalPortBinding: Sendable {
@@ -35,6 +39,15 @@ public actor PortMapManager {
     private enum ProxyInstance: Sendable {
         case tcp(TCPProxy)
         case udp(UDPProxy)
+
+        var counters: ProxyCounters {
+            switch self {
+            case .tcp(let proxy):
+                return proxy.counters
+            case .udp(let proxy):
+                return proxy.counters
+            }
+        }
     }
 
     /// Per-container port mappings and proxy PIDs
@@ -47,6 +60,38 @@ public actor PortMapManager {
     public init(logger: Logger, dumpNftablesOnPublish: Bool = false) {
         self.logger = logger
         self.dumpNftablesOnPublish = dumpNftablesOnPublish
+        self.proxyEventLoopGroup = MultiThreadedEventLoopGroup(numberOfThreads: System.coreCount)
+    }
+
+    /// Stop the shared proxy event loops (daemon shutdown)
+    public func shutdown() async {
+        try? await proxyEventLoopGroup.shutdownGracefully()
+    }
+
+    // MARK: - Statistics
+
+    /// Traffic counters for proxied mappings, optionally for one container
+    public func mappingStats(containerID: String? = nil) -> [PortMappingStats] {
+        var stats: [PortMappingStats] = []
+        for (id, mappings) in containerMappings where containerID == nil || id == containerID {
+            for mapping in mappings {
+                guard let counters = mapping.proxy?.counters else { continue }  // nftables-only mapping
+                let snapshot = counters.snapshot()
+                stats.append(PortMappingStats(
+                    containerID: id,
+                    proto: mapping.binding.proto,
+                    hostIP: mapping.binding.hostIP,
+                    hostPort: mapping.binding.hostPort,
+                    containerPort: mapping.binding.containerPort,
+                    bytesToContainer: snapshot.bytesToContainer,
+                    bytesFromContainer: snapshot.bytesFromContainer,
+                    connectionsTotal: snapshot.connectionsTotal,
+                    connectionsActive: snapshot.connectionsActive,
+                    connectionsFailed: snapshot.connectionsFailed
+                ))
+            }
+        }
+        return stats
     }
 
     // MARK: - Port Publishing
@@ -275,6 +320,7 @@ public actor PortMapManager {
                 listenPort: Int(binding.hostPort),
                 targetAddress: vmnetIP,
                 targetPort: Int(binding.hostPort), // Host connects to vmnet_ip:host_port, DNAT handles rest
+                group: proxyEventLoopGroup,
                 logger: logger,
                 onConnectionFailed: onConnectionFailed
             )
@@ -286,6 +332,7 @@ public actor PortMapManager {
                 listenPort: Int(binding.hostPort),
                 targetAddress: vmnetIP,
                 targetPort: Int(binding.hostPort), // Host connects to vmnet_ip:host_port, DNAT handles rest
+                group: proxyEventLoopGroup,
                 logger: logger
             )
             try await udpProxy.start()
@@ -347,6 +394,70 @@ public actor PortMapManager {
     }
 }
 
+// MARK: - Statistics
+
+/// Traffic through one proxied port mapping
+public struct PortMappingStats: Sendable {
+    public let containerID: String
+    public let proto: String
+    public let hostIP: String
+    public let hostPort: UInt16
+    public let containerPort: UInt16
+    public let bytesToContainer: UInt64
+    public let bytesFromContainer: UInt64
+    public let connectionsTotal: UInt64
+    public let connectionsActive: UInt64
+    public let connectionsFailed: UInt64
+}
+
+/// Counters updated from proxy event loops
+/// @unchecked Sendable: Safe because all counters are protected by NSLock
+public final class ProxyCounters: @unchecked Sendable {
+    struct Snapshot {
+        var bytesToContainer: UInt64 = 0
+        var bytesFromContainer: UInt64 = 0
+        var connectionsTotal: UInt64 = 0
+        var connectionsActive: UInt64 = 0
+        var connectionsFailed: UInt64 = 0
+    }
+
+    private let lock = NSLock()
+    private var values = Snapshot()
+
+    public init() {}
+
+    func recordToContainer(bytes: Int) {
+        lock.withLock { values.bytesToContainer &+= UInt64(bytes) }
+    }
+
+    func recordFromContainer(bytes: Int) {
+        lock.withLock { values.bytesFromContainer &+= UInt64(bytes) }
+    }
+
+    func connectionOpened() {
+        lock.withLock {
+            values.connectionsTotal &+= 1
+            values.connectionsActive &+= 1
+        }
+    }
+
+    func connectionClosed() {
+        lock.withLock {
+            if values.connectionsActive > 0 {
+                values.connectionsActive -= 1
+            }
+        }
+    }
+
+    func connectionFailed() {
+        lock.withLock { values.connectionsFailed &+= 1 }
+    }
+
+    func snapshot() -> Snapshot {
+        lock.withLock { values }
+    }
+}
+
 // MARK: - Errors
 
 enum PortMapError: Error, CustomStringConvertible {
@@ -48,6 +48,11 @@ public protocol Arca_Process_V1_ProcessServiceClientProtocol: GRPCClient {
     _ request: Arca_Process_V1_ListProcessesRequest,
     callOptions: CallOptions?
   ) -> UnaryCall<Arca_Process_V1_ListProcessesRequest, Arca_Process_V1_ListProcessesResponse>
+
+  func probe(
+    _ request: Arca_Process_V1_ProbeRequest,
+    callOptions: CallOptions?
+  ) -> UnaryCall<Arca_Process_V1_ProbeRequest, Arca_Process_V1_ProbeResponse>
 }
 
 extension Arca_Process_V1_ProcessServiceClientProtocol {
@@ -136,6 +141,24 @@ extension Arca_Process_V1_ProcessServiceClientProtocol {
       interceptors: self.interceptors?.makeListProcessesInterceptors() ?? []
     )
   }
+
+  /// Run a health probe inside the container without a new exec session
+  ///
+  /// - Parameters:
+  ///   - request: Request to send to Probe.
+  ///   - callOptions: Call options.
+  /// - Returns: A `UnaryCall` with futures for the metadata, status and response.
+  public func probe(
+    _ request: Arca_Process_V1_ProbeRequest,
+    callOptions: CallOptions? = nil
+  ) -> UnaryCall<Arca_Process_V1_ProbeRequest, Arca_Process_V1_ProbeResponse> {
+    return self.makeUnaryCall(
+      path: Arca_Process_V1_ProcessServiceClientMetadata.Methods.probe.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeProbeInterceptors() ?? []
+    )
+  }
 }
 
 @available(*, deprecated)
@@ -231,6 +254,11 @@ public protocol Arca_Process_V1_ProcessServiceAsyncClientProtocol: GRPCClient {
     _ request: Arca_Process_V1_ListProcessesRequest,
     callOptions: CallOptions?
   ) -> GRPCAsyncUnaryCall<Arca_Process_V1_ListProcessesRequest, Arca_Process_V1_ListProcessesResponse>
+
+  func makeProbeCall(
+    _ request: Arca_Process_V1_ProbeRequest,
+    callOptions: CallOptions?
+  ) -> GRPCAsyncUnaryCall<Arca_Process_V1_ProbeRequest, Arca_Process_V1_ProbeResponse>
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -290,6 +318,18 @@ extension Arca_Process_V1_ProcessServiceAsyncClientProtocol {
       interceptors: self.interceptors?.makeListProcessesInterceptors() ?? []
     )
   }
+
+  public func makeProbeCall(
+    _ request: Arca_Process_V1_ProbeRequest,
+    callOptions: CallOptions? = nil
+  ) -> GRPCAsyncUnaryCall<Arca_Process_V1_ProbeRequest, Arca_Process_V1_ProbeResponse> {
+    return self.makeAsyncUnaryCall(
+      path: Arca_Process_V1_ProcessServiceClientMetadata.Methods.probe.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeProbeInterceptors() ?? []
+    )
+  }
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -341,6 +381,18 @@ extension Arca_Process_V1_ProcessServiceAsyncClientProtocol {
       interceptors: self.interceptors?.makeListProcessesInterceptors() ?? []
     )
   }
+
+  public func probe(
+    _ request: Arca_Process_V1_ProbeRequest,
+    callOptions: CallOptions? = nil
+  ) async throws -> Arca_Process_V1_ProbeResponse {
+    return try await self.performAsyncUnaryCall(
+      path: Arca_Process_V1_ProcessServiceClientMetadata.Methods.probe.path,
+      request: request,
+      callOptions: callOptions ?? self.defaultCallOptions,
+      interceptors: self.interceptors?.makeProbeInterceptors() ?? []
+    )
+  }
 }
 
 @available(macOS 10.15, iOS 13, tvOS 13, watchOS 6, *)
@@ -373,6 +425,9 @@ public protocol Arca_Process_V1_ProcessServiceClientInterceptorFactoryProtocol:
 
   /// - Returns: Interceptors to use when invoking 'listProcesses'.
   func makeListProcessesInterceptors() -> [ClientInterceptor<Arca_Process_V1_ListProcessesRequest, Arca_Process_V1_ListProcessesResponse>]
+
+  /// - Returns: Interceptors to use when invoking 'probe'.
+  func makeProbeInterceptors() -> [ClientInterceptor<Arca_Process_V1_ProbeRequest, Arca_Process_V1_ProbeResponse>]
 }
 
 public enum Arca_Process_V1_ProcessServiceClientMetadata {
@@ -384,6 +439,7 @@ public enum Arca_Process_V1_ProcessServiceClientMetadata {
       Arca_Process_V1_ProcessServiceClientMetadata.Methods.startProcess,
       Arca_Process_V1_ProcessServiceClientMetadata.Methods.getProcessStatus,
       Arca_Process_V1_ProcessServiceClientMetadata.Methods.listProcesses,
+      Arca_Process_V1_ProcessServiceClientMetadata.Methods.probe,
     ]
   )
 
@@ -411,6 +467,12 @@ public enum Arca_Process_V1_ProcessServiceClientMetadata {
       path: "/arca.process.v1.ProcessService/ListProcesses",
       type: GRPCCallType.unary
     )
+
+    public static let probe = GRPCMethodDescriptor(
+      name: "Probe",
+      path: "/arca.process.v1.ProcessService/Probe",
+      type: GRPCCallType.unary
+    )
   }
 }
 
@@ -153,6 +153,49 @@ public struct Arca_Process_V1_ProcessInfo: Sendable {
   public init() {}
 }
 
+/// Health probe run by the service inside the container.
+/// Exactly one of command, tcp_address or http_url is set.
+public struct Arca_Process_V1_ProbeRequest: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  /// Command to run in the container's namespaces, environment and working directory
+  public var command: [String] = []
+
+  /// "host:port" to open a TCP connection to (native probe)
+  public var tcpAddress: String = String()
+
+  /// URL to GET; 2xx/3xx is healthy (native probe)
+  public var httpURL: String = String()
+
+  /// Probe timeout in milliseconds
+  public var timeoutMs: UInt32 = 0
+
+  public var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  public init() {}
+}
+
+public struct Arca_Process_V1_ProbeResponse: Sendable {
+  // SwiftProtobuf.Message conformance is added in an extension below. See the
+  // `Message` and `Message+*Additions` files in the SwiftProtobuf library for
+  // methods supported on all messages.
+
+  /// Command exit code, or 0/1 for native probes
+  public var exitCode: Int32 = 0
+
+  /// Combined stdout/stderr (truncated by the service), or a native probe summary
+  public var output: String = String()
+
+  /// True if the probe was killed after timeout_ms
+  public var timedOut: Bool = false
+
+  public var unknownFields = SwiftProtobuf.UnknownStorage()
+
+  public init() {}
+}
+
 // MARK: - Code below here is support for the SwiftProtobuf runtime.
 
 fileprivate let _protobuf_package = "arca.process.v1"
@@ -428,3 +471,88 @@ extension Arca_Process_V1_ProcessInfo: SwiftProtobuf.Message, SwiftProtobuf._Mes
     return true
   }
 }
+
+extension Arca_Process_V1_ProbeRequest: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  public static let protoMessageName: String = _protobuf_package + ".ProbeRequest"
+  public static let _protobuf_nameMap = SwiftProtobuf._NameMap(bytecode: "\0\u{1}command\0\u{3}tcp_address\0\u{3}http_url\0\u{3}timeout_ms\0")
+
+  public mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeRepeatedStringField(value: &self.command) }()
+      case 2: try { try decoder.decodeSingularStringField(value: &self.tcpAddress) }()
+      case 3: try { try decoder.decodeSingularStringField(value: &self.httpURL) }()
+      case 4: try { try decoder.decodeSingularUInt32Field(value: &self.timeoutMs) }()
+      default: break
+      }
+    }
+  }
+
+  public func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if !self.command.isEmpty {
+      try visitor.visitRepeatedStringField(value: self.command, fieldNumber: 1)
+    }
+    if !self.tcpAddress.isEmpty {
+      try visitor.visitSingularStringField(value: self.tcpAddress, fieldNumber: 2)
+    }
+    if !self.httpURL.isEmpty {
+      try visitor.visitSingularStringField(value: self.httpURL, fieldNumber: 3)
+    }
+    if self.timeoutMs != 0 {
+      try visitor.visitSingularUInt32Field(value: self.timeoutMs, fieldNumber: 4)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  public static func ==(lhs: Arca_Process_V1_ProbeRequest, rhs: Arca_Process_V1_ProbeRequest) -> Bool {
+    if lhs.command != rhs.command {return false}
+    if lhs.tcpAddress != rhs.tcpAddress {return false}
+    if lhs.httpURL != rhs.httpURL {return false}
+    if lhs.timeoutMs != rhs.timeoutMs {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
+
+extension Arca_Process_V1_ProbeResponse: SwiftProtobuf.Message, SwiftProtobuf._MessageImplementationBase, SwiftProtobuf._ProtoNameProviding {
+  public static let protoMessageName: String = _protobuf_package + ".ProbeResponse"
+  public static let _protobuf_nameMap = SwiftProtobuf._NameMap(bytecode: "\0\u{3}exit_code\0\u{1}output\0\u{3}timed_out\0")
+
+  public mutating func decodeMessage<D: SwiftProtobuf.Decoder>(decoder: inout D) throws {
+    while let fieldNumber = try decoder.nextFieldNumber() {
+      // The use of inline closures is to circumvent an issue where the compiler
+      // allocates stack space for every case branch when no optimizations are
+      // enabled. https://github.com/apple/swift-protobuf/issues/1034
+      switch fieldNumber {
+      case 1: try { try decoder.decodeSingularInt32Field(value: &self.exitCode) }()
+      case 2: try { try decoder.decodeSingularStringField(value: &self.output) }()
+      case 3: try { try decoder.decodeSingularBoolField(value: &self.timedOut) }()
+      default: break
+      }
+    }
+  }
+
+  public func traverse<V: SwiftProtobuf.Visitor>(visitor: inout V) throws {
+    if self.exitCode != 0 {
+      try visitor.visitSingularInt32Field(value: self.exitCode, fieldNumber: 1)
+    }
+    if !self.output.isEmpty {
+      try visitor.visitSingularStringField(value: self.output, fieldNumber: 2)
+    }
+    if self.timedOut != false {
+      try visitor.visitSingularBoolField(value: self.timedOut, fieldNumber: 3)
+    }
+    try unknownFields.traverse(visitor: &visitor)
+  }
+
+  public static func ==(lhs: Arca_Process_V1_ProbeResponse, rhs: Arca_Process_V1_ProbeResponse) -> Bool {
+    if lhs.exitCode != rhs.exitCode {return false}
+    if lhs.output != rhs.output {return false}
+    if lhs.timedOut != rhs.timedOut {return false}
+    if lhs.unknownFields != rhs.unknownFields {return false}
+    return true
+  }
+}
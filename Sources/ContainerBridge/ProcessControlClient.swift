@@ -4,6 +4,7 @@
 // Provides process control operations for containers:
 // - List processes (reads /proc directly without spawning /bin/ps)
 // - Process status checking
+// - Health probes (commands, TCP connects and HTTP GETs run by the service)
 //
 // Connects via vsock port 51822
 
@@ -24,10 +25,18 @@ public actor ProcessControlClient {
     private var eventLoopGroup: EventLoopGroup?
     private var client: Arca_Process_V1_ProcessServiceAsyncClient?
     private var vsockFileHandle: FileHandle?  // Keep FileHandle alive for the connection
-
-    public init(containerID: String, container: Containerization.LinuxContainer, logger: Logger) {
+    private let channelPool: ControlChannelPool?
+
+    /// - Parameter channelPool: The container's persistent channels; when nil the client dials its own
+    public init(
+        containerID: String,
+        container: Containerization.LinuxContainer,
+        channelPool: ControlChannelPool? = nil,
+        logger: Logger
+    ) {
         self.containerID = containerID
         self.container = container
+        self.channelPool = channelPool
         self.logger = logger
     }
 
@@ -93,6 +102,11 @@ public actor ProcessControlClient {
 
     /// Get or create gRPC client connection
     private func getClient() async throws -> Arca_Process_V1_ProcessServiceAsyncClient {
+        // Pooled channels are health-checked (and re-dialed) by the pool on every request
+        if let pool = channelPool {
+            return Arca_Process_V1_ProcessServiceAsyncClient(channel: try await pool.channel(for: .processControl))
+        }
+
         if let existing = client {
             return existing
         }
@@ -147,7 +161,9 @@ public actor ProcessControlClient {
         var request = Arca_Process_V1_ListProcessesRequest()
         request.psArgs = psArgs ?? ""
 
-        let response = try await client.listProcesses(request)
+        let response = try await Tracing.guestCall("process/ListProcesses") { options in
+            try await client.listProcesses(request, callOptions: options)
+        }
 
         logger.debug("List processes complete", metadata: [
             "container": "\(containerID)",
@@ -159,6 +175,57 @@ public actor ProcessControlClient {
             processes: response.processes.map { $0.values }
         )
     }
+
+    /// Run a health probe inside the container over the control channel
+    /// - Returns: nil if the guest service predates the Probe RPC (caller falls back to exec)
+    public func probe(_ probe: HealthProbe, timeout: TimeInterval) async throws -> HealthProbeResult? {
+        let client = try await getClient()
+        var request = Arca_Process_V1_ProbeRequest()
+        switch probe {
+        case .command(let command):
+            request.command = command
+        case .tcp(let address):
+            request.tcpAddress = address
+        case .http(let url):
+            request.httpURL = url
+        }
+        request.timeoutMs = UInt32(clamping: Int(timeout * 1000))
+
+        // The service enforces timeout_ms; the deadline only covers a lost channel
+        let options = CallOptions(timeLimit: .timeout(.milliseconds(Int64(timeout * 1000) + 2000)))
+        do {
+            let response = try await Tracing.guestCall("process/Probe", options: options) { options in
+                try await client.probe(request, callOptions: options)
+            }
+            return HealthProbeResult(
+                exitCode: Int(response.exitCode),
+                output: response.output,
+                timedOut: response.timedOut
+            )
+        } catch let status as GRPCStatus where status.code == .unimplemented {
+            logger.debug("Process service does not support Probe", metadata: [
+                "container": "\(containerID)"
+            ])
+            return nil
+        }
+    }
+}
+
+/// What a health probe runs inside the container
+public enum HealthProbe: Sendable, Equatable {
+    /// Run a command (argv) in the container
+    case command([String])
+    /// Open a TCP connection to "host:port"
+    case tcp(String)
+    /// GET the URL; 2xx/3xx is healthy
+    case http(String)
+}
+
+/// Outcome of a health probe run by the process service
+public struct HealthProbeResult: Sendable {
+    public let exitCode: Int
+    public let output: String
+    public let timedOut: Bool
 }
 
 /// Process list response in ps -ef format
@@ -0,0 +1,209 @@
+import Foundation
+import Containerization
+import ContainerizationExtras
+
+/// Image pull settings
+public struct PullConfig: Codable, Sendable {
+    /// Pulls transferring from one registry at once; 4 when unset
+    public let maxConcurrentPullsPerRegistry: Int?
+
+    public init(maxConcurrentPullsPerRegistry: Int? = nil) {
+        self.maxConcurrentPullsPerRegistry = maxConcurrentPullsPerRegistry
+    }
+}
+
+/// Process-wide coordination of image pulls
+///
+/// - Concurrent pulls of the same manifest share one transfer; every caller gets the
+///   shared transfer's progress, with totals so far replayed to late joiners.
+/// - A pull whose layers are mostly already being downloaded by another pull waits for
+///   that pull, then finds those blobs in the content store instead of fetching them again.
+/// - Transfers per registry are bounded so a `compose pull` of many images queues instead
+///   of opening every transfer at once.
+///
+/// Generic over the transfer's result so the coordination can be exercised without a registry.
+actor PullCoordinator<Value: Sendable> {
+    typealias Operation = @Sendable (@escaping ProgressHandler) async throws -> Value
+
+    /// Share of an image's layer bytes an in-flight pull must carry before waiting for it pays off
+    static var sharedLayerThreshold: Double { 0.5 }
+
+    private struct Transfer {
+        let token: UUID
+        let task: Task<Value, Error>
+        let layers: [String: Int64]
+        var watchers: [UUID: ProgressHandler] = [:]
+        var totals = ProgressTotals()
+    }
+
+    private let maxPerRegistry: Int
+    private var transfers: [String: Transfer] = [:]
+    private var activeTransfers: [String: Int] = [:]  // Registry -> transfers holding a slot
+    private var slotWaiters: [String: [CheckedContinuation<Void, Never>]] = [:]
+
+    init(config: PullConfig? = nil) {
+        self.maxPerRegistry = max(config?.maxConcurrentPullsPerRegistry ?? 4, 1)
+    }
+
+    /// Run `operation` for `key`, or join the transfer already running for it
+    /// - Parameters:
+    ///   - key: Identity of the pulled content (manifest digest and platform when known)
+    ///   - registry: Registry host, for the per-registry transfer bound
+    ///   - layers: Layer digest -> size, for overlap with other in-flight pulls
+    ///   - progress: Progress handler for this caller
+    ///   - operation: The transfer itself, reporting progress to the handler it is given
+    /// - Returns: The pulled image and whether it came from another caller's transfer
+    func pull(
+        key: String,
+        registry: String,
+        layers: [String: Int64],
+        progress: ProgressHandler?,
+        operation: @escaping Operation
+    ) async throws -> (image: Value, shared: Bool) {
+        let watcherID = UUID()
+
+        if var transfer = transfers[key] {
+            if let progress = progress {
+                transfer.watchers[watcherID] = progress
+                transfers[key] = transfer
+                await progress(transfer.totals.replay)
+            }
+            defer { transfers[key]?.watchers.removeValue(forKey: watcherID) }
+            return (try await transfer.task.value, true)
+        }
+
+        let dependencies = overlappingTransfers(with: layers)
+        let token = UUID()
+        let task = Task<Value, Error> {
+            for dependency in dependencies {
+                _ = try? await dependency.value
+            }
+
+            await self.acquireSlot(registry)
+            do {
+                let image = try await operation { events in
+                    await self.forward(events, key: key, token: token)
+                }
+                await self.releaseSlot(registry)
+                await self.finish(key: key, token: token)
+                return image
+            } catch {
+                await self.releaseSlot(registry)
+                await self.finish(key: key, token: token)
+                throw error
+            }
+        }
+
+        var transfer = Transfer(token: token, task: task, layers: layers)
+        if let progress = progress {
+            transfer.watchers[watcherID] = progress
+        }
+        transfers[key] = transfer
+
+        return (try await task.value, false)
+    }
+
+    /// Number of transfers in flight and callers attached to them
+    func activity() -> (transfers: Int, watchers: Int) {
+        (transfers.count, transfers.values.reduce(0) { $0 + $1.watchers.count })
+    }
+
+    // MARK: - Private
+
+    /// In-flight pulls that together carry enough of `layers` to be worth waiting for
+    private func overlappingTransfers(with layers: [String: Int64]) -> [Task<Value, Error>] {
+        let total = layers.values.reduce(0, +)
+        guard total > 0 else { return [] }
+
+        var shared: Int64 = 0
+        var dependencies: [Task<Value, Error>] = []
+        for transfer in transfers.values {
+            let overlap = layers.reduce(Int64(0)) { sum, layer in
+                transfer.layers[layer.key] != nil ? sum + layer.value : sum
+            }
+            if overlap > 0 {
+                shared += overlap
+                dependencies.append(transfer.task)
+            }
+        }
+        return Double(shared) >= Double(total) * Self.sharedLayerThreshold ? dependencies : []
+    }
+
+    private func forward(_ events: [ProgressEvent], key: String, token: UUID) async {
+        guard var transfer = transfers[key], transfer.token == token else { return }
+        transfer.totals.record(events)
+        transfers[key] = transfer
+
+        let watchers = Array(transfer.watchers.values)
+        await withTaskGroup(of: Void.self) { group in
+            for watcher in watchers {
+                group.addTask { await watcher(events) }
+            }
+        }
+    }
+
+    private func finish(key: String, token: UUID) {
+        if transfers[key]?.token == token {
+            transfers.removeValue(forKey: key)
+        }
+    }
+
+    private func acquireSlot(_ registry: String) async {
+        if activeTransfers[registry, default: 0] < maxPerRegistry {
+            activeTransfers[registry, default: 0] += 1
+            return
+        }
+        await withCheckedContinuation { continuation in
+            slotWaiters[registry, default: []].append(continuation)
+        }
+    }
+
+    private func releaseSlot(_ registry: String) {
+        if var waiters = slotWaiters[registry], !waiters.isEmpty {
+            // Hand the slot straight to the next waiter
+            let next = waiters.removeFirst()
+            slotWaiters[registry] = waiters.isEmpty ? nil : waiters
+            next.resume()
+            return
+        }
+        activeTransfers[registry, default: 1] -= 1
+        if activeTransfers[registry] == 0 {
+            activeTransfers.removeValue(forKey: registry)
+        }
+    }
+}
+
+/// Running totals of a transfer's progress events, replayable to a caller that joins late
+struct ProgressTotals: Sendable {
+    private(set) var totalSize: Int64 = 0
+    private(set) var totalItems = 0
+    private(set) var size: Int64 = 0
+    private(set) var items = 0
+
+    mutating func record(_ events: [ProgressEvent]) {
+        for event in events {
+            switch event.event {
+            case "add-total-size":
+                totalSize += event.value as? Int64 ?? 0
+            case "add-total-items":
+                totalItems += event.value as? Int ?? 0
+            case "add-size":
+                size += event.value as? Int64 ?? 0
+            case "add-items":
+                items += event.value as? Int ?? 0
+            default:
+                break
+            }
+        }
+    }
+
+    /// Events that bring a fresh progress consumer to the current totals
+    var replay: [ProgressEvent] {
+        var events: [ProgressEvent] = []
+        if totalSize > 0 { events.append(ProgressEvent(event: "add-total-size", value: totalSize)) }
+        if totalItems > 0 { events.append(ProgressEvent(event: "add-total-items", value: totalItems)) }
+        if size > 0 { events.append(ProgressEvent(event: "add-size", value: size)) }
+        if items > 0 { events.append(ProgressEvent(event: "add-items", value: items)) }
+        return events
+    }
+}
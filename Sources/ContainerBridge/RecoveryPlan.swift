@@ -0,0 +1,119 @@
+import Foundation
+
+/// Order in which containers are restarted when the daemon starts
+///
+/// Containers are grouped into waves: a container's wave comes after the waves of every
+/// container it depends on through compose's `com.docker.compose.depends_on` label (services
+/// of the same project that are also being restarted). Containers within a wave are
+/// independent of each other and start in parallel; within a wave those sharing a network
+/// are kept adjacent, so their WireGuard mesh links are configured in one batch per wave.
+///
+/// Dependencies on services that are not being restarted (already running, or without a
+/// restart policy) are ignored. Containers caught in a dependency cycle go in a final wave.
+struct RecoveryPlan: Sendable {
+    struct Member: Sendable {
+        let id: String
+        let labels: [String: String]
+        let networkIDs: [String]
+    }
+
+    /// Container IDs per wave, in start order
+    let waves: [[String]]
+    /// Containers placed in the last wave because their dependencies form a cycle
+    let cyclic: [String]
+
+    static let projectLabel = "com.docker.compose.project"
+    static let serviceLabel = "com.docker.compose.service"
+    static let dependsOnLabel = "com.docker.compose.depends_on"
+
+    init(_ members: [Member]) {
+        // project -> service -> member IDs (a scaled service has several)
+        var services: [String: [String: [String]]] = [:]
+        for member in members {
+            if let project = member.labels[Self.projectLabel], let service = member.labels[Self.serviceLabel] {
+                services[project, default: [:]][service, default: []].append(member.id)
+            }
+        }
+
+        var dependencies: [String: Set<String>] = [:]
+        var dependents: [String: [String]] = [:]
+        for member in members {
+            guard let project = member.labels[Self.projectLabel],
+                  let dependsOn = member.labels[Self.dependsOnLabel] else { continue }
+            for service in Self.services(in: dependsOn) {
+                for dependency in services[project]?[service] ?? [] where dependency != member.id {
+                    if dependencies[member.id, default: []].insert(dependency).inserted {
+                        dependents[dependency, default: []].append(member.id)
+                    }
+                }
+            }
+        }
+
+        // Kahn's algorithm, one wave per level
+        var remaining = dependencies.mapValues { $0.count }
+        var current = members.map(\.id).filter { remaining[$0, default: 0] == 0 }
+        var placed = Set<String>()
+        var waves: [[String]] = []
+        while !current.isEmpty {
+            waves.append(current)
+            placed.formUnion(current)
+            var next: [String] = []
+            for id in current {
+                for dependent in dependents[id] ?? [] {
+                    remaining[dependent, default: 0] -= 1
+                    if remaining[dependent] == 0 {
+                        next.append(dependent)
+                    }
+                }
+            }
+            current = next
+        }
+
+        let cyclic = members.map(\.id).filter { !placed.contains($0) }
+        if !cyclic.isEmpty {
+            waves.append(cyclic)
+        }
+
+        let networks = Dictionary(members.map { ($0.id, $0.networkIDs.sorted()) }, uniquingKeysWith: { first, _ in first })
+        self.waves = waves.map { wave in
+            wave.sorted { (networks[$0]?.first ?? "", $0) < (networks[$1]?.first ?? "", $1) }
+        }
+        self.cyclic = cyclic
+    }
+
+    /// Service names in a depends_on label: "db:service_started:false,cache:service_healthy:true"
+    static func services(in dependsOn: String) -> [String] {
+        dependsOn.split(separator: ",").compactMap { entry in
+            let service = entry.split(separator: ":", maxSplits: 1).first.map {
+                $0.trimmingCharacters(in: .whitespaces)
+            }
+            return service?.isEmpty == false ? service : nil
+        }
+    }
+
+    /// Restarts run at once: one per core, and no more than one per 2 GiB of host memory so
+    /// booting VMs don't push the host into swap
+    static func defaultConcurrency(
+        cores: Int = ProcessInfo.processInfo.activeProcessorCount,
+        memoryBytes: UInt64 = ProcessInfo.processInfo.physicalMemory
+    ) -> Int {
+        let memoryGiB = Int(memoryBytes >> 30)
+        return max(1, min(cores, memoryGiB / 2))
+    }
+}
+
+/// Progress of restarting containers after daemon startup
+public struct RecoveryProgress: Sendable {
+    /// Containers with a restart policy found at startup
+    public let total: Int
+    public let started: Int
+    public let failed: Int
+    /// False until all restarts have been attempted
+    public let complete: Bool
+
+    public var pending: Int {
+        total - started - failed
+    }
+
+    static let idle = RecoveryProgress(total: 0, started: 0, failed: 0, complete: false)
+}
@@ -0,0 +1,80 @@
+import Foundation
+
+/// Fixed-capacity FIFO that overwrites its oldest element when full
+///
+/// Storage is allocated once; appends and reads are O(1) and never move elements.
+/// Iteration runs from the oldest to the newest element.
+public struct RingBuffer<Element>: Sequence {
+    private var storage: [Element?]
+    private var head = 0  // Index of the oldest element
+    public private(set) var count = 0
+
+    public init(capacity: Int) {
+        precondition(capacity > 0, "RingBuffer capacity must be positive")
+        self.storage = Array(repeating: nil, count: capacity)
+    }
+
+    public var capacity: Int { storage.count }
+    public var isEmpty: Bool { count == 0 }
+    public var isFull: Bool { count == storage.count }
+
+    /// The most recently appended element
+    public var last: Element? {
+        count == 0 ? nil : storage[(head + count - 1) % storage.count]
+    }
+
+    /// The oldest retained element
+    public var first: Element? {
+        count == 0 ? nil : storage[head]
+    }
+
+    /// Element at `offset` from the oldest (0) to the newest (count - 1)
+    public subscript(offset: Int) -> Element {
+        precondition(offset >= 0 && offset < count, "RingBuffer offset out of range")
+        return storage[(head + offset) % storage.count]!
+    }
+
+    /// Append, evicting and returning the oldest element if the buffer was full
+    @discardableResult
+    public mutating func append(_ element: Element) -> Element? {
+        if count < storage.count {
+            storage[(head + count) % storage.count] = element
+            count += 1
+            return nil
+        }
+        let evicted = storage[head]
+        storage[head] = element
+        head = (head + 1) % storage.count
+        return evicted
+    }
+
+    /// Remove and return the oldest element
+    @discardableResult
+    public mutating func popFirst() -> Element? {
+        guard count > 0 else { return nil }
+        let element = storage[head]
+        storage[head] = nil
+        head = (head + 1) % storage.count
+        count -= 1
+        return element
+    }
+
+    public mutating func removeAll() {
+        for index in storage.indices {
+            storage[index] = nil
+        }
+        head = 0
+        count = 0
+    }
+
+    public func makeIterator() -> AnyIterator<Element> {
+        var offset = 0
+        return AnyIterator {
+            guard offset < count else { return nil }
+            defer { offset += 1 }
+            return self[offset]
+        }
+    }
+}
+
+extension RingBuffer: Sendable where Element: Sendable {}
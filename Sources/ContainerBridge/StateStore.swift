@@ -7,10 +7,30 @@ import IP
 /// StateStore manages persistent container and network state in SQLite
 /// All operations are atomic and thread-safe via actor isolation
 /// SQLite.swift Connection objects have internal serial queues for thread safety
+///
+/// The database runs in WAL mode with two connections: `db` is the writer and `reader`
+/// serves queries, so reads never wait behind a commit. Writes go through a group-commit
+/// queue: writes issued within `groupCommitWindow` of each other run in one transaction,
+/// each under its own savepoint, and every caller resumes once that transaction commits.
 public actor StateStore {
-    private nonisolated(unsafe) let db: Connection
+    private nonisolated(unsafe) let db: Connection      // Writer; only used by commit and schema setup
+    private nonisolated(unsafe) let reader: Connection  // Read-only queries
     private let logger: Logger
 
+    /// Writes issued within this window of each other share one transaction (and one fsync)
+    private static let groupCommitWindow: Duration = .milliseconds(2)
+
+    /// A queued write; `apply` runs inside the batch transaction under its own savepoint
+    private struct PendingWrite: Sendable {
+        let apply: @Sendable () throws -> Void
+        let complete: @Sendable (Error?) -> Void
+    }
+
+    private var pendingWrites: [PendingWrite] = []
+    private var isFlushing = false
+    // Prepared statements on the writer; only touched by write blocks, which run one batch at a time
+    private nonisolated(unsafe) var statementCache: [String: Statement] = [:]
+
     // Table definitions (nonisolated - immutable and thread-safe)
     private nonisolated(unsafe) let containers = Table("containers")
     private nonisolated(unsafe) let networks = Table("networks")
@@ -156,6 +176,15 @@ public actor StateStore {
             // This prevents SQLITE_BUSY errors when multiple operations happen concurrently
             self.db.busyTimeout = 5.0
 
+            // WAL lets the reader connection query while a batch commits.
+            // synchronous=FULL keeps every acknowledged commit durable across power loss;
+            // group commit is what amortizes the fsync.
+            try self.db.execute("PRAGMA journal_mode = WAL")
+            try self.db.execute("PRAGMA synchronous = FULL")
+
+            self.reader = try Connection(expandedPath, readonly: true)
+            self.reader.busyTimeout = 5.0
+
             logger.info("Connected to state database", metadata: ["path": "\(expandedPath)"])
         } catch {
             throw StateStoreError.databaseInitFailed("Failed to connect: \(error)")
@@ -381,8 +410,120 @@ public actor StateStore {
         }
     }
 
+    // MARK: - Group Commit
+
+    /// Queue a write and wait until the transaction containing it has committed
+    /// A write that throws is rolled back to its savepoint without affecting the rest of its batch
+    private func write<T: Sendable>(_ body: @escaping @Sendable () throws -> T) async throws -> T {
+        let outcome = WriteOutcome<T>()
+        return try await withCheckedThrowingContinuation { continuation in
+            pendingWrites.append(PendingWrite(
+                apply: {
+                    do {
+                        outcome.result = .success(try body())
+                    } catch {
+                        outcome.result = .failure(error)
+                        throw error
+                    }
+                },
+                complete: { commitError in
+                    if let commitError = commitError {
+                        continuation.resume(throwing: commitError)
+                    } else {
+                        continuation.resume(with: outcome.result ?? .failure(StateStoreError.transactionFailed("Write did not run")))
+                    }
+                }
+            ))
+
+            if !isFlushing {
+                isFlushing = true
+                Task { await self.flushWrites() }
+            }
+        }
+    }
+
+    /// Commit queued writes until the queue is empty
+    /// Writes that arrive while a batch commits form the next batch
+    private func flushWrites() async {
+        try? await Task.sleep(for: Self.groupCommitWindow)
+
+        while !pendingWrites.isEmpty {
+            let batch = pendingWrites
+            pendingWrites.removeAll()
+            await commit(batch)
+        }
+        isFlushing = false
+    }
+
+    /// Run a batch in one transaction, off the actor so queries are not held up by the fsync
+    private nonisolated func commit(_ batch: [PendingWrite]) async {
+        let start = ContinuousClock.now
+        do {
+            try db.transaction {
+                for (index, write) in batch.enumerated() {
+                    // A failed write is reported to its own caller through `complete`
+                    try? db.savepoint("write_\(index)") {
+                        try write.apply()
+                    }
+                }
+            }
+            Metrics.shared.stateStoreCommitDuration.observe(since: start)
+            Metrics.shared.stateStoreCommitWrites.observe(Double(batch.count))
+            for write in batch {
+                write.complete(nil)
+            }
+        } catch {
+            logger.error("Group commit failed", metadata: [
+                "writes": "\(batch.count)",
+                "error": "\(error)"
+            ])
+            for write in batch {
+                write.complete(error)
+            }
+        }
+    }
+
+    /// Cached prepared statement on the writer connection; call only from write blocks
+    private nonisolated func statement(_ sql: String) throws -> Statement {
+        if let cached = statementCache[sql] {
+            return cached
+        }
+        let prepared = try db.prepare(sql)
+        statementCache[sql] = prepared
+        return prepared
+    }
+
+    /// Run queries against one consistent snapshot of the database
+    private func readSnapshot<T>(_ block: () throws -> T) throws -> T {
+        var result: T?
+        try reader.transaction(.deferred) {
+            result = try block()
+        }
+        guard let result = result else {
+            throw StateStoreError.transactionFailed("Snapshot read did not run")
+        }
+        return result
+    }
+
     // MARK: - Container Operations
 
+    private static let upsertContainerSQL = """
+        INSERT INTO containers (
+            id, name, image, image_id, created_at, status,
+            running, paused, restarting, pid, exit_code,
+            started_at, finished_at, stopped_by_user,
+            entrypoint_json, config_json, host_config_json
+        ) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+        ON CONFLICT(id) DO UPDATE SET
+            name = excluded.name, image = excluded.image, image_id = excluded.image_id,
+            created_at = excluded.created_at, status = excluded.status,
+            running = excluded.running, paused = excluded.paused, restarting = excluded.restarting,
+            pid = excluded.pid, exit_code = excluded.exit_code,
+            started_at = excluded.started_at, finished_at = excluded.finished_at,
+            stopped_by_user = excluded.stopped_by_user, entrypoint_json = excluded.entrypoint_json,
+            config_json = excluded.config_json, host_config_json = excluded.host_config_json
+        """
+
     /// Save container state to database
     public func saveContainer(
         id: String,
@@ -402,7 +543,7 @@ public actor StateStore {
         entrypoint: [String]?,
         configJSON: String,
         hostConfigJSON: String
-    ) throws {
+    ) async throws {
         // Serialize entrypoint to JSON if provided
         let entrypointString: String?
         if let entrypoint = entrypoint {
@@ -412,51 +553,17 @@ public actor StateStore {
             entrypointString = nil
         }
 
-        // Check if container exists
-        let existing = try db.scalar(containers.filter(self.id == id).count)
-
-        if existing > 0 {
-            // Update existing container (preserves CASCADE relationships like filesystem_baselines)
-            let container = containers.filter(self.id == id)
-            try db.run(container.update(
-                self.name <- name,
-                self.image <- image,
-                self.imageID <- imageID,
-                self.createdAt <- createdAt.iso8601String,
-                self.status <- status,
-                self.running <- running,
-                self.paused <- paused,
-                self.restarting <- restarting,
-                self.pid <- pid,
-                self.exitCode <- exitCode,
-                self.startedAt <- startedAt?.iso8601String,
-                self.finishedAt <- finishedAt?.iso8601String,
-                self.stoppedByUser <- stoppedByUser,
-                self.entrypointJSON <- entrypointString,
-                self.configJSON <- configJSON,
-                self.hostConfigJSON <- hostConfigJSON
-            ))
-        } else {
-            // Insert new container
-            try db.run(containers.insert(
-                self.id <- id,
-                self.name <- name,
-                self.image <- image,
-                self.imageID <- imageID,
-                self.createdAt <- createdAt.iso8601String,
-                self.status <- status,
-                self.running <- running,
-                self.paused <- paused,
-                self.restarting <- restarting,
-                self.pid <- pid,
-                self.exitCode <- exitCode,
-                self.startedAt <- startedAt?.iso8601String,
-                self.finishedAt <- finishedAt?.iso8601String,
-                self.stoppedByUser <- stoppedByUser,
-                self.entrypointJSON <- entrypointString,
-                self.configJSON <- configJSON,
-                self.hostConfigJSON <- hostConfigJSON
-            ))
+        // Upsert keeps the row (and CASCADE children like filesystem_baselines) when it exists
+        let createdAtString = createdAt.iso8601String
+        let startedAtString = startedAt?.iso8601String
+        let finishedAtString = finishedAt?.iso8601String
+        try await write { [self] in
+            try statement(Self.upsertContainerSQL).run(
+                id, name, image, imageID, createdAtString, status,
+                running, paused, restarting, pid, exitCode,
+                startedAtString, finishedAtString, stoppedByUser,
+                entrypointString, configJSON, hostConfigJSON
+            )
         }
 
         logger.debug("Container state saved", metadata: [
@@ -467,23 +574,29 @@ public actor StateStore {
     }
 
     /// Update container status in database
-    public func updateContainerStatus(id: String, status: String, exitCode: Int? = nil, finishedAt: Date? = nil) throws {
-        let container = containers.filter(self.id == id)
-
-        var setters: [SQLite.Setter] = [
-            self.status <- status,
-            self.running <- (status == "running")
-        ]
-
-        if let exitCode = exitCode {
-            setters.append(self.exitCode <- exitCode)
+    public func updateContainerStatus(id: String, status: String, exitCode: Int? = nil, finishedAt: Date? = nil) async throws {
+        // At most four statement shapes, each prepared once
+        var columns = ["status = ?", "running = ?"]
+        if exitCode != nil {
+            columns.append("exit_code = ?")
         }
-
-        if let finishedAt = finishedAt {
-            setters.append(self.finishedAt <- finishedAt.iso8601String)
+        if finishedAt != nil {
+            columns.append("finished_at = ?")
         }
+        let sql = "UPDATE containers SET \(columns.joined(separator: ", ")) WHERE id = ?"
+        let finishedAtString = finishedAt?.iso8601String
 
-        try db.run(container.update(setters))
+        try await write { [self] in
+            var bindings: [Binding?] = [status, status == "running"]
+            if let exitCode = exitCode {
+                bindings.append(exitCode)
+            }
+            if let finishedAtString = finishedAtString {
+                bindings.append(finishedAtString)
+            }
+            bindings.append(id)
+            try statement(sql).run(bindings)
+        }
 
         logger.debug("Container status updated", metadata: [
             "id": "\(id)",
@@ -494,10 +607,11 @@ public actor StateStore {
 
     /// Update container name in the database
     /// Throws error if new name is already in use (UNIQUE constraint violation)
-    public func updateContainerName(id: String, newName: String) throws {
-        let container = containers.filter(self.id == id)
-
-        try db.run(container.update(self.name <- newName))
+    public func updateContainerName(id: String, newName: String) async throws {
+        try await write { [self] in
+            let container = containers.filter(self.id == id)
+            try db.run(container.update(self.name <- newName))
+        }
 
         logger.debug("Container name updated", metadata: [
             "id": "\(id)",
@@ -505,8 +619,7 @@ public actor StateStore {
         ])
     }
 
-    /// Load all containers from database
-    public func loadAllContainers() throws -> [(
+    public typealias PersistedContainer = (
         id: String,
         name: String,
         image: String,
@@ -524,16 +637,27 @@ public actor StateStore {
         entrypoint: [String]?,
         configJSON: String,
         hostConfigJSON: String
-    )] {
-        var result: [(
-            id: String, name: String, image: String, imageID: String,
-            createdAt: Date, status: String, running: Bool, paused: Bool,
-            restarting: Bool, pid: Int, exitCode: Int, startedAt: Date?,
-            finishedAt: Date?, stoppedByUser: Bool, entrypoint: [String]?,
-            configJSON: String, hostConfigJSON: String
-        )] = []
+    )
+
+    public typealias PersistedAttachment = (
+        networkID: String,
+        ipAddress: String,
+        macAddress: String,
+        aliases: [String]
+    )
+
+    /// Load every container and its network attachments from one snapshot (daemon startup)
+    public func loadContainerSnapshot() throws -> (containers: [PersistedContainer], attachments: [String: [PersistedAttachment]]) {
+        try readSnapshot {
+            (containers: try loadAllContainers(), attachments: try loadAllNetworkAttachments())
+        }
+    }
 
-        for row in try db.prepare(containers) {
+    /// Load all containers from database
+    public func loadAllContainers() throws -> [PersistedContainer] {
+        var result: [PersistedContainer] = []
+
+        for row in try reader.prepare(containers) {
             let createdDate = Date(iso8601String: row[createdAt]) ?? Date()
             let startedDate = row[startedAt].flatMap { Date(iso8601String: $0) }
             let finishedDate = row[finishedAt].flatMap { Date(iso8601String: $0) }
@@ -575,9 +699,11 @@ public actor StateStore {
     }
 
     /// Delete container from database
-    public func deleteContainer(id: String) throws {
-        let container = containers.filter(self.id == id)
-        try db.run(container.delete())
+    public func deleteContainer(id: String) async throws {
+        try await write { [self] in
+            let container = containers.filter(self.id == id)
+            try db.run(container.delete())
+        }
 
         logger.debug("Container deleted from database", metadata: ["id": "\(id)"])
     }
@@ -587,7 +713,7 @@ public actor StateStore {
         var result: [(id: String, name: String, policy: String, exitCode: Int)] = []
 
         // Query containers that are exited and have a restart policy
-        for row in try db.prepare(containers.filter(status == "exited")) {
+        for row in try reader.prepare(containers.filter(status == "exited")) {
             // Extract values for logging (avoid Sendable issues)
             let containerId = row[id]
             let containerName = row[name]
@@ -681,21 +807,23 @@ public actor StateStore {
         optionsJSON: String?,
         labelsJSON: String?,
         isDefault: Bool
-    ) throws {
-        try db.run(networks.insert(or: .replace,
-            self.networkID <- id,
-            self.networkName <- name,
-            self.driver <- driver,
-            self.scope <- scope,
-            self.networkCreatedAt <- createdAt.iso8601String,
-            self.subnet <- subnet,
-            self.gateway <- gateway,
-            self.ipRange <- ipRange,
-            self.nextIPOctet <- 2,  // Legacy column - no longer used, kept for schema compatibility
-            self.optionsJSON <- optionsJSON,
-            self.labelsJSON <- labelsJSON,
-            self.isDefault <- isDefault
-        ))
+    ) async throws {
+        try await write { [self] in
+            try db.run(networks.insert(or: .replace,
+                self.networkID <- id,
+                self.networkName <- name,
+                self.driver <- driver,
+                self.scope <- scope,
+                self.networkCreatedAt <- createdAt.iso8601String,
+                self.subnet <- subnet,
+                self.gateway <- gateway,
+                self.ipRange <- ipRange,
+                self.nextIPOctet <- 2,  // Legacy column - no longer used, kept for schema compatibility
+                self.optionsJSON <- optionsJSON,
+                self.labelsJSON <- labelsJSON,
+                self.isDefault <- isDefault
+            ))
+        }
 
         logger.debug("Network saved", metadata: [
             "id": "\(id)",
@@ -725,7 +853,7 @@ public actor StateStore {
             isDefault: Bool
         )] = []
 
-        for row in try db.prepare(networks) {
+        for row in try reader.prepare(networks) {
             let createdDate = Date(iso8601String: row[networkCreatedAt]) ?? Date()
 
             result.append((
@@ -751,9 +879,11 @@ public actor StateStore {
     }
 
     /// Delete network from database
-    public func deleteNetwork(id: String) throws {
-        let network = networks.filter(self.networkID == id)
-        try db.run(network.delete())
+    public func deleteNetwork(id: String) async throws {
+        try await write { [self] in
+            let network = networks.filter(self.networkID == id)
+            try db.run(network.delete())
+        }
 
         logger.debug("Network deleted from database", metadata: ["id": "\(id)"])
     }
@@ -773,7 +903,7 @@ public actor StateStore {
         isDefault: Bool
     )? {
         let query = networks.filter(self.networkID == id)
-        guard let row = try db.pluck(query) else {
+        guard let row = try reader.pluck(query) else {
             return nil
         }
 
@@ -799,7 +929,7 @@ public actor StateStore {
         let query = networkAttachments.filter(self.attachedNetworkID == networkID)
         var containerIDs = Set<String>()
 
-        for row in try db.prepare(query) {
+        for row in try reader.prepare(query) {
             containerIDs.insert(row[containerID])
         }
 
@@ -811,7 +941,7 @@ public actor StateStore {
         let query = networkAttachments.filter(self.containerID == containerID)
         var networkIDs = Set<String>()
 
-        for row in try db.prepare(query) {
+        for row in try reader.prepare(query) {
             networkIDs.insert(row[attachedNetworkID])
         }
 
@@ -820,6 +950,12 @@ public actor StateStore {
 
     // MARK: - Network Attachment Operations
 
+    private static let saveAttachmentSQL = """
+        INSERT OR REPLACE INTO network_attachments
+            (container_id, network_id, ip_address, ip_address_int, mac_address, aliases_json, attached_at)
+        VALUES (?, ?, ?, ?, ?, ?, ?)
+        """
+
     /// Save network attachment
     public func saveNetworkAttachment(
         containerID: String,
@@ -827,7 +963,7 @@ public actor StateStore {
         ipAddress: String,
         macAddress: String,
         aliases: [String]
-    ) throws {
+    ) async throws {
         let aliasesData = try JSONEncoder().encode(aliases)
         let aliasesString = String(data: aliasesData, encoding: .utf8)
 
@@ -839,15 +975,12 @@ public actor StateStore {
             ipInt = 0  // Fallback for invalid IPs
         }
 
-        try db.run(networkAttachments.insert(or: .replace,
-            self.containerID <- containerID,
-            self.attachedNetworkID <- networkID,
-            self.ipAddress <- ipAddress,
-            self.ipAddressInt <- ipInt,
-            self.macAddress <- macAddress,
-            self.aliasesJSON <- aliasesString,
-            self.attachedAt <- Date().iso8601String
-        ))
+        let attachedAtString = Date().iso8601String
+        try await write { [self] in
+            try statement(Self.saveAttachmentSQL).run(
+                containerID, networkID, ipAddress, ipInt, macAddress, aliasesString, attachedAtString
+            )
+        }
 
         logger.debug("Network attachment saved", metadata: [
             "container": "\(containerID)",
@@ -865,7 +998,7 @@ public actor StateStore {
         var result: [(networkID: String, ipAddress: String, macAddress: String, aliases: [String])] = []
 
         let query = networkAttachments.filter(self.containerID == containerID)
-        for row in try db.prepare(query) {
+        for row in try reader.prepare(query) {
             let aliases: [String]
             if let aliasesData = row[aliasesJSON]?.data(using: .utf8) {
                 aliases = (try? JSONDecoder().decode([String].self, from: aliasesData)) ?? []
@@ -884,6 +1017,29 @@ public actor StateStore {
         return result
     }
 
+    /// Load every network attachment, keyed by container ID
+    public func loadAllNetworkAttachments() throws -> [String: [PersistedAttachment]] {
+        var result: [String: [PersistedAttachment]] = [:]
+
+        for row in try reader.prepare(networkAttachments) {
+            let aliases: [String]
+            if let aliasesData = row[aliasesJSON]?.data(using: .utf8) {
+                aliases = (try? JSONDecoder().decode([String].self, from: aliasesData)) ?? []
+            } else {
+                aliases = []
+            }
+
+            result[row[containerID], default: []].append((
+                networkID: row[attachedNetworkID],
+                ipAddress: row[ipAddress],
+                macAddress: row[macAddress],
+                aliases: aliases
+            ))
+        }
+
+        return result
+    }
+
     /// Load container attachments for a network
     public func loadAttachmentsForNetwork(networkID: String) throws -> [(
         containerID: String,
@@ -894,7 +1050,7 @@ public actor StateStore {
         var result: [(containerID: String, ipAddress: String, macAddress: String, aliases: [String])] = []
 
         let query = networkAttachments.filter(self.attachedNetworkID == networkID)
-        for row in try db.prepare(query) {
+        for row in try reader.prepare(query) {
             let aliases: [String]
             if let aliasesData = row[aliasesJSON]?.data(using: .utf8) {
                 aliases = (try? JSONDecoder().decode([String].self, from: aliasesData)) ?? []
@@ -914,10 +1070,12 @@ public actor StateStore {
     }
 
     /// Delete network attachment
-    public func deleteNetworkAttachment(containerID: String, networkID: String) throws {
-        let attachment = networkAttachments
-            .filter(self.containerID == containerID && self.attachedNetworkID == networkID)
-        try db.run(attachment.delete())
+    public func deleteNetworkAttachment(containerID: String, networkID: String) async throws {
+        try await write { [self] in
+            let attachment = networkAttachments
+                .filter(self.containerID == containerID && self.attachedNetworkID == networkID)
+            try db.run(attachment.delete())
+        }
 
         logger.debug("Network attachment deleted", metadata: [
             "container": "\(containerID)",
@@ -933,7 +1091,7 @@ public actor StateStore {
             .select(ipAddress)
 
         var allocatedIPs = Set<String>()
-        for row in try db.prepare(query) {
+        for row in try reader.prepare(query) {
             allocatedIPs.insert(row[ipAddress])
         }
 
@@ -944,7 +1102,7 @@ public actor StateStore {
     public func isIPAllocated(networkID: String, ip: String) throws -> Bool {
         let query = networkAttachments
             .filter(self.attachedNetworkID == networkID && ipAddress == ip)
-        return try db.scalar(query.count) > 0
+        return try reader.scalar(query.count) > 0
     }
 
     /// Atomically allocate and reserve an IP address for a container on a network
@@ -969,10 +1127,9 @@ public actor StateStore {
         gatewayInt: Int64,
         macAddress: String,
         aliases: [String]
-    ) throws -> String {
-        var allocatedIP: String?
-
-        try db.transaction {
+    ) async throws -> String {
+        // The write's savepoint makes the lookup and insert atomic
+        let ip = try await write { [self] () throws -> String in
             // Find the first available IP using SQL
             // Strategy: Find MIN(ip + 1) where (ip + 1) is not already allocated
             // Start from rangeStart - 1 so we can find rangeStart itself if available
@@ -1047,11 +1204,7 @@ public actor StateStore {
                 attachedAt <- Date().iso8601String
             ))
 
-            allocatedIP = ipStr
-        }
-
-        guard let ip = allocatedIP else {
-            throw StateStoreError.transactionFailed("IP allocation failed for network \(networkID)")
+            return ipStr
         }
 
         logger.debug("IP allocated and reserved atomically", metadata: [
@@ -1071,7 +1224,7 @@ public actor StateStore {
         ip: String,
         macAddress: String,
         aliases: [String]
-    ) throws {
+    ) async throws {
         guard let ipv4 = IP.V4(ip) else {
             throw StateStoreError.transactionFailed("Invalid IP address: \(ip)")
         }
@@ -1081,15 +1234,17 @@ public actor StateStore {
 
         do {
             // The unique index on (network_id, ip_address_int) ensures this fails if IP is taken
-            try db.run(networkAttachments.insert(
-                self.containerID <- containerID,
-                attachedNetworkID <- networkID,
-                self.ipAddress <- ip,
-                self.ipAddressInt <- Int64(ipv4.value),
-                self.macAddress <- macAddress,
-                aliasesJSON <- aliasesString,
-                attachedAt <- Date().iso8601String
-            ))
+            try await write { [self] in
+                try db.run(networkAttachments.insert(
+                    self.containerID <- containerID,
+                    attachedNetworkID <- networkID,
+                    self.ipAddress <- ip,
+                    self.ipAddressInt <- Int64(ipv4.value),
+                    self.macAddress <- macAddress,
+                    aliasesJSON <- aliasesString,
+                    attachedAt <- Date().iso8601String
+                ))
+            }
 
             logger.debug("Specific IP reserved", metadata: [
                 "container": "\(containerID)",
@@ -1104,23 +1259,27 @@ public actor StateStore {
     // MARK: - Subnet Allocation Operations
 
     /// Get next available subnet byte for auto-allocation
-    public func getNextSubnetByte() throws -> Int {
-        guard let row = try db.pluck(subnetAllocation.filter(allocationID == 1)) else {
-            // Initialize if not exists
+    public func getNextSubnetByte() async throws -> Int {
+        if let row = try reader.pluck(subnetAllocation.filter(allocationID == 1)) {
+            return row[nextSubnetByte]
+        }
+
+        // Initialize if not exists
+        try await write { [self] in
             try db.run(subnetAllocation.insert(or: .replace,
                 allocationID <- 1,
                 nextSubnetByte <- 18
             ))
-            return 18
         }
-
-        return row[nextSubnetByte]
+        return 18
     }
 
     /// Update next available subnet byte
-    public func updateNextSubnetByte(_ value: Int) throws {
-        let allocation = subnetAllocation.filter(allocationID == 1)
-        try db.run(allocation.update(nextSubnetByte <- value))
+    public func updateNextSubnetByte(_ value: Int) async throws {
+        try await write { [self] in
+            let allocation = subnetAllocation.filter(allocationID == 1)
+            try db.run(allocation.update(nextSubnetByte <- value))
+        }
 
         logger.debug("Subnet allocation updated", metadata: ["nextSubnetByte": "\(value)"])
     }
@@ -1131,7 +1290,7 @@ public actor StateStore {
     public func getAllocatedSubnetBytes() throws -> Set<UInt8> {
         var allocatedBytes = Set<UInt8>()
 
-        for row in try db.prepare(networks) {
+        for row in try reader.prepare(networks) {
             let subnetStr = row[subnet]
 
             // Parse subnet like "172.18.0.0/16" -> extract second octet (18)
@@ -1165,16 +1324,18 @@ public actor StateStore {
         createdAt: Date,
         labelsJSON: String?,
         optionsJSON: String?
-    ) throws {
-        try db.run(volumes.insert(or: .replace,
-            self.volumeName <- name,
-            self.volumeDriver <- driver,
-            self.volumeFormat <- format,
-            self.volumeMountpoint <- mountpoint,
-            self.volumeCreatedAt <- createdAt.iso8601String,
-            self.volumeLabelsJSON <- labelsJSON,
-            self.volumeOptionsJSON <- optionsJSON
-        ))
+    ) async throws {
+        try await write { [self] in
+            try db.run(volumes.insert(or: .replace,
+                self.volumeName <- name,
+                self.volumeDriver <- driver,
+                self.volumeFormat <- format,
+                self.volumeMountpoint <- mountpoint,
+                self.volumeCreatedAt <- createdAt.iso8601String,
+                self.volumeLabelsJSON <- labelsJSON,
+                self.volumeOptionsJSON <- optionsJSON
+            ))
+        }
 
         logger.debug("Volume saved", metadata: [
             "name": "\(name)",
@@ -1198,7 +1359,7 @@ public actor StateStore {
             createdAt: Date, labelsJSON: String?, optionsJSON: String?
         )] = []
 
-        for row in try db.prepare(volumes) {
+        for row in try reader.prepare(volumes) {
             let createdDate = Date(iso8601String: row[volumeCreatedAt]) ?? Date()
 
             result.append((
@@ -1217,9 +1378,11 @@ public actor StateStore {
     }
 
     /// Delete a volume from the database
-    public func deleteVolume(name: String) throws {
-        let volume = volumes.filter(volumeName == name)
-        let deleted = try db.run(volume.delete())
+    public func deleteVolume(name: String) async throws {
+        let deleted = try await write { [self] in
+            let volume = volumes.filter(volumeName == name)
+            return try db.run(volume.delete())
+        }
 
         if deleted == 0 {
             throw StateStoreError.volumeNotFound(name)
@@ -1236,14 +1399,16 @@ public actor StateStore {
         volumeName: String,
         containerPath: String,
         isAnonymous: Bool
-    ) throws {
-        try db.run(volumeMounts.insert(
-            mountContainerID <- containerID,
-            mountVolumeName <- volumeName,
-            mountContainerPath <- containerPath,
-            mountIsAnonymous <- isAnonymous,
-            mountedAt <- Date().iso8601String
-        ))
+    ) async throws {
+        try await write { [self] in
+            try db.run(volumeMounts.insert(
+                mountContainerID <- containerID,
+                mountVolumeName <- volumeName,
+                mountContainerPath <- containerPath,
+                mountIsAnonymous <- isAnonymous,
+                mountedAt <- Date().iso8601String
+            ))
+        }
 
         logger.debug("Volume mount saved", metadata: [
             "container": "\(containerID)",
@@ -1259,7 +1424,7 @@ public actor StateStore {
             .filter(mountContainerID == containerID)
             .order(mountedAt)
 
-        return try db.prepare(query).map { row in
+        return try reader.prepare(query).map { row in
             (
                 volumeName: row[mountVolumeName],
                 containerPath: row[mountContainerPath],
@@ -1282,7 +1447,7 @@ public actor StateStore {
                 .filter(running == true)
                 .select(distinct: mountContainerID)
 
-            return try db.prepare(query).map { row in
+            return try reader.prepare(query).map { row in
                 row[mountContainerID]
             }
         } else {
@@ -1290,16 +1455,18 @@ public actor StateStore {
                 .filter(mountVolumeName == volumeName)
                 .select(distinct: mountContainerID)
 
-            return try db.prepare(query).map { row in
+            return try reader.prepare(query).map { row in
                 row[mountContainerID]
             }
         }
     }
 
     /// Delete volume mounts for a container
-    public func deleteVolumeMounts(containerID: String) throws {
-        let mounts = volumeMounts.filter(mountContainerID == containerID)
-        let deleted = try db.run(mounts.delete())
+    public func deleteVolumeMounts(containerID: String) async throws {
+        let deleted = try await write { [self] in
+            let mounts = volumeMounts.filter(mountContainerID == containerID)
+            return try db.run(mounts.delete())
+        }
 
         logger.debug("Volume mounts deleted", metadata: [
             "container": "\(containerID)",
@@ -1314,58 +1481,54 @@ public actor StateStore {
         let allVolumes = volumes.select(volumeName)
 
         // SQLite doesn't support EXCEPT, so we do it manually
-        let used = try Set(db.prepare(usedVolumes).map { $0[mountVolumeName] })
-        let all = try db.prepare(allVolumes).map { $0[volumeName] }
+        let used = try Set(reader.prepare(usedVolumes).map { $0[mountVolumeName] })
+        let all = try reader.prepare(allVolumes).map { $0[volumeName] }
 
         return all.filter { !used.contains($0) }
     }
 
     // MARK: - Transaction Support
 
-    /// Execute operations in a transaction
-    public func transaction<T>(_ block: () throws -> T) throws -> T {
-        var result: T!
-        try db.transaction {
-            result = try block()
-        }
-        return result
+    /// Execute operations atomically on the writer connection
+    /// The block runs under its own savepoint inside the next group commit
+    public func transaction<T: Sendable>(_ block: @escaping @Sendable () throws -> T) async throws -> T {
+        try await write(block)
     }
 
     // MARK: - Filesystem Baseline Operations
 
+    private static let insertBaselineSQL = """
+        INSERT INTO filesystem_baselines (container_id, file_path, file_type, file_size, file_mtime, captured_at)
+        VALUES (?, ?, ?, ?, ?, ?)
+        """
+
     /// Save filesystem baseline for a container
     /// This stores the initial filesystem state for diff comparison
-    public func saveFilesystemBaseline(containerID: String, files: [(path: String, type: String, size: Int64, mtime: Int64)]) throws {
+    public func saveFilesystemBaseline(containerID: String, files: [(path: String, type: String, size: Int64, mtime: Int64)]) async throws {
         logger.debug("Starting baseline save transaction", metadata: [
             "container": "\(containerID)",
             "files_to_save": "\(files.count)"
         ])
 
-        try db.transaction {
+        let rows = files.map { (path: $0.path, type: $0.type, size: $0.size, mtime: $0.mtime) }
+        let deleted = try await write { [self] in
             // Delete existing baseline for this container
             let existingBaseline = filesystemBaselines.filter(baselineContainerID == containerID)
             let deleted = try db.run(existingBaseline.delete())
-            logger.debug("Deleted existing baseline entries", metadata: ["deleted": "\(deleted)"])
 
             // Insert new baseline entries
-            var inserted = 0
-            for file in files {
-                try db.run(filesystemBaselines.insert(
-                    baselineContainerID <- containerID,
-                    filePath <- file.path,
-                    fileType <- file.type,
-                    fileSize <- file.size,
-                    fileMtime <- file.mtime,
-                    capturedAt <- Date().iso8601String
-                ))
-                inserted += 1
+            let capturedAtValue = Date().iso8601String
+            let insert = try statement(Self.insertBaselineSQL)
+            for file in rows {
+                try insert.run(containerID, file.path, file.type, file.size, file.mtime, capturedAtValue)
             }
-            logger.debug("Inserted baseline entries", metadata: ["inserted": "\(inserted)"])
+            return deleted
         }
+        logger.debug("Replaced baseline entries", metadata: ["deleted": "\(deleted)", "inserted": "\(files.count)"])
 
         // Verify the data persisted
         let query = filesystemBaselines.filter(baselineContainerID == containerID)
-        let count = try db.scalar(query.count)
+        let count = try reader.scalar(query.count)
 
         logger.debug("Filesystem baseline saved and verified", metadata: [
             "container": "\(containerID)",
@@ -1380,7 +1543,7 @@ public actor StateStore {
             .filter(baselineContainerID == containerID)
             .order(filePath)
 
-        return try db.prepare(query).map { row in
+        return try reader.prepare(query).map { row in
             (
                 path: row[filePath],
                 type: row[fileType],
@@ -1393,13 +1556,15 @@ public actor StateStore {
     /// Check if filesystem baseline exists for a container
     public func hasFilesystemBaseline(containerID: String) throws -> Bool {
         let query = filesystemBaselines.filter(baselineContainerID == containerID)
-        return try db.scalar(query.count) > 0
+        return try reader.scalar(query.count) > 0
     }
 
     /// Delete filesystem baseline for a container
-    public func deleteFilesystemBaseline(containerID: String) throws {
-        let baseline = filesystemBaselines.filter(baselineContainerID == containerID)
-        let deleted = try db.run(baseline.delete())
+    public func deleteFilesystemBaseline(containerID: String) async throws {
+        let deleted = try await write { [self] in
+            let baseline = filesystemBaselines.filter(baselineContainerID == containerID)
+            return try db.run(baseline.delete())
+        }
 
         logger.debug("Filesystem baseline deleted", metadata: [
             "container": "\(containerID)",
@@ -1410,16 +1575,8 @@ public actor StateStore {
     // MARK: - Layer Cache Operations
 
     /// Record a cached layer in the database
-    public func recordLayerCache(digest: String, path: String, size: Int64) throws {
-        let now = Date()
-        try db.run(layerCache.insert(or: .replace,
-            layerDigest <- digest,
-            layerPath <- path,
-            layerSize <- size,
-            layerCreatedAt <- now.iso8601String,
-            layerLastUsed <- now.iso8601String,
-            layerRefCount <- 0
-        ))
+    public func recordLayerCache(digest: String, path: String, size: Int64) async throws {
+        try await recordLayer(digest: digest, path: path, size: size)
 
         logger.debug("Layer cache recorded", metadata: [
             "digest": "\(digest.prefix(19))...",
@@ -1427,23 +1584,12 @@ public actor StateStore {
         ])
     }
 
-    /// Increment reference count for a layer
-    public func incrementLayerRefCount(digest: String) throws {
-        let layer = layerCache.filter(layerDigest == digest)
-        try db.run(layer.update(
-            layerRefCount += 1,
-            layerLastUsed <- Date().iso8601String
-        ))
-
-        logger.debug("Layer ref count incremented", metadata: [
-            "digest": "\(digest.prefix(19))..."
-        ])
-    }
-
     /// Decrement reference count for a layer
-    public func decrementLayerRefCount(digest: String) throws {
-        let layer = layerCache.filter(layerDigest == digest)
-        let updated = try db.run(layer.update(layerRefCount -= 1))
+    public func decrementLayerRefCount(digest: String) async throws {
+        let updated = try await write { [self] in
+            let layer = layerCache.filter(layerDigest == digest)
+            return try db.run(layer.update(layerRefCount -= 1))
+        }
 
         if updated > 0 {
             logger.debug("Layer ref count decremented", metadata: [
@@ -1452,9 +1598,19 @@ public actor StateStore {
         }
     }
 
+    /// Mark layers as used now (drives least-recently-used eviction)
+    public func touchLayers(digests: [String]) async throws {
+        guard !digests.isEmpty else { return }
+        let now = Date().iso8601String
+        try await write { [self] in
+            let layers = layerCache.filter(digests.contains(layerDigest))
+            try db.run(layers.update(layerLastUsed <- now))
+        }
+    }
+
     /// Load layer cache information
     public func loadLayerCache(digest: String) throws -> (path: String, size: Int64, refCount: Int)? {
-        guard let row = try db.pluck(layerCache.filter(layerDigest == digest)) else {
+        guard let row = try reader.pluck(layerCache.filter(layerDigest == digest)) else {
             return nil
         }
         return (
@@ -1467,7 +1623,7 @@ public actor StateStore {
     /// Load all cached layers
     public func loadAllCachedLayers() throws -> [(digest: String, path: String, size: Int64, refCount: Int, lastUsed: Date)] {
         var result: [(String, String, Int64, Int, Date)] = []
-        for row in try db.prepare(layerCache) {
+        for row in try reader.prepare(layerCache) {
             if let lastUsedDate = Date(iso8601String: row[layerLastUsed]) {
                 result.append((
                     row[layerDigest],
@@ -1484,16 +1640,18 @@ public actor StateStore {
     /// Get unreferenced layers (ref_count == 0)
     public func getUnreferencedLayers() throws -> [String] {
         var digests: [String] = []
-        for row in try db.prepare(layerCache.filter(layerRefCount == 0)) {
+        for row in try reader.prepare(layerCache.filter(layerRefCount == 0)) {
             digests.append(row[layerDigest])
         }
         return digests
     }
 
     /// Delete a cached layer from database
-    public func deleteLayerCache(digest: String) throws {
-        let layer = layerCache.filter(layerDigest == digest)
-        let deleted = try db.run(layer.delete())
+    public func deleteLayerCache(digest: String) async throws {
+        let deleted = try await write { [self] in
+            let layer = layerCache.filter(layerDigest == digest)
+            return try db.run(layer.delete())
+        }
 
         if deleted > 0 {
             logger.debug("Layer cache entry deleted", metadata: [
@@ -1508,25 +1666,41 @@ public actor StateStore {
 extension StateStore: Containerization.LayerCacheRecorder {
     public nonisolated func recordLayer(digest: String, path: String, size: Int64) async throws {
         let now = Date()
-        try db.run(layerCache.insert(or: .replace,
-            layerDigest <- digest,
-            layerPath <- path,
-            layerSize <- size,
-            layerCreatedAt <- now.iso8601String,
-            layerLastUsed <- now.iso8601String,
-            layerRefCount <- 0
-        ))
+        try await write { [self] in
+            try db.run(layerCache.insert(or: .replace,
+                layerDigest <- digest,
+                layerPath <- path,
+                layerSize <- size,
+                layerCreatedAt <- now.iso8601String,
+                layerLastUsed <- now.iso8601String,
+                layerRefCount <- 0
+            ))
+        }
     }
 
+    /// Increment reference count for a layer
     public nonisolated func incrementLayerRefCount(digest: String) async throws {
-        let layer = layerCache.filter(layerDigest == digest)
-        try db.run(layer.update(
-            layerRefCount += 1,
-            layerLastUsed <- Date().iso8601String
-        ))
+        try await write { [self] in
+            let layer = layerCache.filter(layerDigest == digest)
+            try db.run(layer.update(
+                layerRefCount += 1,
+                layerLastUsed <- Date().iso8601String
+            ))
+        }
+
+        logger.debug("Layer ref count incremented", metadata: [
+            "digest": "\(digest.prefix(19))..."
+        ])
     }
 }
 
+/// Result slot filled in by a queued write inside its batch transaction
+/// @unchecked Sendable: Safe because `result` is set by `apply` and then read by `complete`,
+/// sequentially within one commit
+private final class WriteOutcome<T: Sendable>: @unchecked Sendable {
+    var result: Result<T, Error>?
+}
+
 // MARK: - Helper Extensions
 
 extension Date {
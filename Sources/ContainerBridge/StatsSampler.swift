@@ -0,0 +1,224 @@
+import Foundation
+import Logging
+import Containerization
+
+/// Shared resource-usage sampler for running containers
+///
+/// Every `docker stats` stream used to poll its container's VM on its own, so N clients
+/// meant N statistics RPCs per container per second. The sampler keeps one sampling loop per
+/// container with at least one subscriber and fans each sample out to all of them. It keeps a
+/// short history per container so each reading carries the previous sample for CPU deltas.
+public actor StatsSampler {
+    /// One statistics sample from a container's VM
+    public struct Sample: Sendable {
+        public let stats: Containerization.ContainerStatistics
+        public let timestamp: Date
+    }
+
+    /// A sample together with the one before it (nil for a container's first sample)
+    public struct Reading: Sendable {
+        public let current: Sample
+        public let previous: Sample?
+    }
+
+    private struct Subject {
+        var history: RingBuffer<Sample>
+        var subscribers: [UUID: AsyncStream<Reading>.Continuation] = [:]
+        var loop: Task<Void, Never>?
+        var loopToken: UUID?  // Identifies the current loop so a cancelled one can't clear its successor
+        var inFlight: Task<Reading, Error>?  // One-shot sample shared by concurrent callers
+    }
+
+    private let containerManager: ContainerManager
+    private let interval: Duration
+    private let historySize: Int
+    private let logger: Logger
+
+    private var subjects: [String: Subject] = [:]  // Docker ID -> sampling state
+
+    /// - Parameters:
+    ///   - interval: Sampling period (Docker streams stats once per second)
+    ///   - historySize: Samples retained per container
+    public init(containerManager: ContainerManager, interval: Duration = .seconds(1), historySize: Int = 8, logger: Logger) {
+        var logger = logger
+        logger[metadataKey: "component"] = "StatsSampler"
+        self.containerManager = containerManager
+        self.interval = interval
+        self.historySize = max(historySize, 2)
+        self.logger = logger
+    }
+
+    /// Live readings for a container, one per interval, until it stops running
+    ///
+    /// A slow subscriber only ever has the newest reading queued; it never delays the others.
+    public func subscribe(dockerID: String) -> AsyncStream<Reading> {
+        let (stream, continuation) = AsyncStream.makeStream(of: Reading.self, bufferingPolicy: .bufferingNewest(1))
+        let subscriberID = UUID()
+
+        var subject = subjects[dockerID] ?? Subject(history: RingBuffer(capacity: historySize))
+        subject.subscribers[subscriberID] = continuation
+
+        // A late subscriber gets the latest reading right away instead of waiting a tick
+        if let reading = Self.latestReading(subject.history), isFresh(reading.current) {
+            continuation.yield(reading)
+        }
+
+        if subject.loop == nil {
+            let token = UUID()
+            subject.loopToken = token
+            subject.loop = Task { [weak self] in
+                await self?.run(dockerID: dockerID, token: token)
+            }
+        }
+        subjects[dockerID] = subject
+
+        continuation.onTermination = { [weak self] _ in
+            Task { await self?.unsubscribe(dockerID: dockerID, subscriberID: subscriberID) }
+        }
+
+        logger.debug("Stats subscriber added", metadata: [
+            "container": "\(dockerID)",
+            "subscribers": "\(subject.subscribers.count)"
+        ])
+        return stream
+    }
+
+    /// A single reading, reusing the shared loop's latest sample when it is recent enough
+    public func reading(dockerID: String) async throws -> Reading {
+        if let subject = subjects[dockerID] {
+            if let reading = Self.latestReading(subject.history), isFresh(reading.current) {
+                return reading
+            }
+            if let pending = subject.inFlight {
+                return try await pending.value
+            }
+        }
+
+        let pending = Task { [containerManager] in
+            let stats = try await containerManager.getContainerStats(id: dockerID)
+            return await self.record(Sample(stats: stats, timestamp: Date()), for: dockerID)
+        }
+        subjects[dockerID, default: Subject(history: RingBuffer(capacity: historySize))].inFlight = pending
+        defer {
+            // A stop (or a later caller after it) may have replaced the subject meanwhile
+            if subjects[dockerID]?.inFlight == pending {
+                subjects[dockerID]?.inFlight = nil
+                // A failed fetch (e.g. the container is gone) leaves nothing worth keeping
+                if let subject = subjects[dockerID], subject.history.isEmpty, subject.subscribers.isEmpty, subject.loop == nil {
+                    subjects[dockerID] = nil
+                }
+            }
+        }
+
+        return try await pending.value
+    }
+
+    /// Readings for several containers at once (bulk stats); containers that fail are omitted
+    public func readings(dockerIDs: [String]) async -> [String: Reading] {
+        await withTaskGroup(of: (String, Reading?).self) { group in
+            for dockerID in dockerIDs {
+                group.addTask {
+                    (dockerID, try? await self.reading(dockerID: dockerID))
+                }
+            }
+
+            var results: [String: Reading] = [:]
+            for await (dockerID, reading) in group {
+                if let reading = reading {
+                    results[dockerID] = reading
+                }
+            }
+            return results
+        }
+    }
+
+    /// Stop sampling a container and end its streams (container stopped or removed)
+    public func stop(dockerID: String) {
+        guard let subject = subjects.removeValue(forKey: dockerID) else { return }
+        subject.loop?.cancel()
+        for continuation in subject.subscribers.values {
+            continuation.finish()
+        }
+    }
+
+    /// Number of containers with an active sampling loop and their total subscribers
+    public func activity() -> (containers: Int, subscribers: Int) {
+        let active = subjects.values.filter { $0.loop != nil }
+        return (active.count, active.reduce(0) { $0 + $1.subscribers.count })
+    }
+
+    // MARK: - Sampling loop
+
+    private func run(dockerID: String, token: UUID) async {
+        while !Task.isCancelled {
+            guard let subject = subjects[dockerID], subject.loopToken == token, !subject.subscribers.isEmpty else { break }
+
+            guard await containerManager.isContainerRunning(dockerID: dockerID) else {
+                logger.debug("Container no longer running, ending stats streams", metadata: [
+                    "container": "\(dockerID)"
+                ])
+                stop(dockerID: dockerID)
+                return
+            }
+
+            do {
+                let stats = try await containerManager.getContainerStats(id: dockerID)
+                let reading = record(Sample(stats: stats, timestamp: Date()), for: dockerID)
+                if let subscribers = subjects[dockerID]?.subscribers {
+                    for continuation in subscribers.values {
+                        continuation.yield(reading)
+                    }
+                }
+            } catch {
+                logger.warning("Failed to sample container stats", metadata: [
+                    "container": "\(dockerID)",
+                    "error": "\(error)"
+                ])
+            }
+
+            try? await Task.sleep(for: interval)
+        }
+
+        // Last subscriber left; keep the history for one-shot readers
+        if subjects[dockerID]?.loopToken == token {
+            subjects[dockerID]?.loop = nil
+            subjects[dockerID]?.loopToken = nil
+        }
+    }
+
+    private func unsubscribe(dockerID: String, subscriberID: UUID) {
+        guard subjects[dockerID]?.subscribers.removeValue(forKey: subscriberID) != nil else { return }
+        if subjects[dockerID]?.subscribers.isEmpty == true {
+            // The loop notices on its next tick; cancel so it doesn't sleep out the interval
+            subjects[dockerID]?.loop?.cancel()
+            subjects[dockerID]?.loop = nil
+            subjects[dockerID]?.loopToken = nil
+        }
+    }
+
+    /// Append a sample to the container's history
+    /// A sample that lands after `stop(dockerID:)` is returned but not kept, so a removed
+    /// container's entry isn't recreated by a request that was already in flight.
+    @discardableResult
+    private func record(_ sample: Sample, for dockerID: String) -> Reading {
+        guard var subject = subjects[dockerID] else {
+            return Reading(current: sample, previous: nil)
+        }
+        let previous = subject.history.last
+        subject.history.append(sample)
+        subjects[dockerID] = subject
+        return Reading(current: sample, previous: previous)
+    }
+
+    private func isFresh(_ sample: Sample) -> Bool {
+        let components = interval.components
+        let seconds = Double(components.seconds) + Double(components.attoseconds) / 1e18
+        return Date().timeIntervalSince(sample.timestamp) < seconds
+    }
+
+    private static func latestReading(_ history: RingBuffer<Sample>) -> Reading? {
+        guard let current = history.last else { return nil }
+        let previous = history.count > 1 ? history[history.count - 2] : nil
+        return Reading(current: current, previous: previous)
+    }
+}
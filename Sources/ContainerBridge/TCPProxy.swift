@@ -5,22 +5,33 @@ import Logging
 
 /// TCP proxy that forwards connections from localhost to a target address
 /// Used for `-p 127.0.0.1:8080:80` style port mappings
-actor TCPProxy {
+///
+/// Proxies run on an event loop group shared by all of PortMapManager's mappings. Each
+/// accepted connection and its backend connection live on the same event loop and are
+/// joined by a pair of GlueHandlers, which forward buffers without copying, flush once
+/// per read burst, and stop reading from one side while the other side is not writable.
+public actor TCPProxy {
     private let logger: Logger
     private let listenAddress: String
     private let listenPort: Int
     private let targetAddress: String
     private let targetPort: Int
 
+    private let group: EventLoopGroup  // Shared; owned by PortMapManager
+    private let connections = TCPProxyConnections()
     private var serverChannel: Channel?
-    private var eventLoopGroup: MultiThreadedEventLoopGroup?
     private let onConnectionFailed: (@Sendable () async -> String?)?
 
-    init(
+    /// Byte and connection counters for this mapping
+    public nonisolated let counters: ProxyCounters
+
+    public init(
         listenAddress: String,
         listenPort: Int,
         targetAddress: String,
         targetPort: Int,
+        group: EventLoopGroup,
+        counters: ProxyCounters = ProxyCounters(),
         logger: Logger,
         onConnectionFailed: (@Sendable () async -> String?)? = nil
     ) {
@@ -28,29 +39,40 @@ actor TCPProxy {
         self.listenPort = listenPort
         self.targetAddress = targetAddress
         self.targetPort = targetPort
+        self.group = group
+        self.counters = counters
         self.logger = logger
         self.onConnectionFailed = onConnectionFailed
     }
 
     /// Start the TCP proxy server
-    func start() async throws {
-        let group = MultiThreadedEventLoopGroup(numberOfThreads: 2)
-        self.eventLoopGroup = group
+    public func start() async throws {
+        let targetAddress = self.targetAddress
+        let targetPort = self.targetPort
+        let logger = self.logger
+        let onConnectionFailed = self.onConnectionFailed
+        let counters = self.counters
+        let connections = self.connections
 
         let bootstrap = ServerBootstrap(group: group)
             .serverChannelOption(ChannelOptions.backlog, value: 256)
             .serverChannelOption(ChannelOptions.socketOption(.so_reuseaddr), value: 1)
             .childChannelInitializer { channel in
-                channel.pipeline.addHandler(
+                connections.insert(channel)
+                return channel.pipeline.addHandler(
                     TCPProxyHandler(
-                        targetAddress: self.targetAddress,
-                        targetPort: self.targetPort,
-                        logger: self.logger,
-                        onConnectionFailed: self.onConnectionFailed
+                        targetAddress: targetAddress,
+                        targetPort: targetPort,
+                        counters: counters,
+                        logger: logger,
+                        onConnectionFailed: onConnectionFailed
                     )
                 )
             }
             .childChannelOption(ChannelOptions.socketOption(.so_reuseaddr), value: 1)
+            .childChannelOption(ChannelOptions.socketOption(.tcp_nodelay), value: 1)
+            // Reads start once the connection is glued to its backend, so nothing is buffered while connecting
+            .childChannelOption(ChannelOptions.autoRead, value: false)
             .childChannelOption(ChannelOptions.maxMessagesPerRead, value: 16)
             .childChannelOption(ChannelOptions.recvAllocator, value: AdaptiveRecvByteBufferAllocator())
 
@@ -64,86 +86,95 @@ actor TCPProxy {
                                  "targetAddress": "\(targetAddress)",
                                  "targetPort": "\(targetPort)"])
         } catch {
-            try? await group.shutdownGracefully()
             throw TCPProxyError.bindFailed(address: listenAddress, port: listenPort, error: error)
         }
     }
 
     /// Stop the TCP proxy server
-    func stop() async throws {
+    /// The event loop group is shared, so open connections are closed explicitly
+    public func stop() async throws {
         if let channel = serverChannel {
             try await channel.close()
             serverChannel = nil
         }
 
-        if let group = eventLoopGroup {
-            try await group.shutdownGracefully()
-            eventLoopGroup = nil
+        let open = connections.removeAll()
+        for channel in open {
+            channel.close(promise: nil)
         }
 
         logger.info("TCP proxy stopped",
                    metadata: ["listenAddress": "\(listenAddress)",
-                             "listenPort": "\(listenPort)"])
+                             "listenPort": "\(listenPort)",
+                             "connectionsClosed": "\(open.count)"])
+    }
+}
+
+// MARK: - Connection Tracking
+
+/// Accepted client channels of one proxy, so stop() can close them
+/// @unchecked Sendable: Safe because channels dictionary is protected by NSLock
+private final class TCPProxyConnections: @unchecked Sendable {
+    private let lock = NSLock()
+    private var channels: [ObjectIdentifier: Channel] = [:]
+
+    func insert(_ channel: Channel) {
+        let id = ObjectIdentifier(channel)
+        lock.withLock { channels[id] = channel }
+        channel.closeFuture.whenComplete { [weak self] _ in
+            self?.lock.withLock { _ = self?.channels.removeValue(forKey: id) }
+        }
+    }
+
+    func removeAll() -> [Channel] {
+        lock.withLock {
+            let open = Array(channels.values)
+            channels.removeAll()
+            return open
+        }
     }
 }
 
 // MARK: - TCP Proxy Handler
 
-/// Channel handler that forwards TCP data bidirectionally
-private final class TCPProxyHandler: ChannelInboundHandler {
+/// Connects an accepted client to the target, then replaces itself with a GlueHandler
+private final class TCPProxyHandler: ChannelInboundHandler, RemovableChannelHandler {
     typealias InboundIn = ByteBuffer
     typealias OutboundOut = ByteBuffer
 
     private let targetAddress: String
     private let targetPort: Int
+    private let counters: ProxyCounters
     private let logger: Logger
     private let onConnectionFailed: (@Sendable () async -> String?)?
 
-    private var outboundChannel: Channel?
-    private var inboundContext: ChannelHandlerContext?
-    private var pendingWrites: [ByteBuffer] = []  // Buffer for data received before target connected
-
-    init(targetAddress: String, targetPort: Int, logger: Logger, onConnectionFailed: (@Sendable () async -> String?)? = nil) {
+    init(
+        targetAddress: String,
+        targetPort: Int,
+        counters: ProxyCounters,
+        logger: Logger,
+        onConnectionFailed: (@Sendable () async -> String?)? = nil
+    ) {
         self.targetAddress = targetAddress
         self.targetPort = targetPort
+        self.counters = counters
         self.logger = logger
         self.onConnectionFailed = onConnectionFailed
     }
 
     func channelActive(context: ChannelHandlerContext) {
-        self.inboundContext = context
-
         // When a client connects, establish connection to target
         let clientAddress = context.remoteAddress?.description ?? "unknown"
         logger.debug("TCP proxy: Client connected",
                     metadata: ["clientAddress": "\(clientAddress)"])
 
-        connectToTarget(context: context)
-    }
-
-    func channelRead(context: ChannelHandlerContext, data: NIOAny) {
-        let buffer = self.unwrapInboundIn(data)
-
-        guard let outbound = outboundChannel else {
-            // Target not connected yet, buffer data for later
-            pendingWrites.append(buffer)
-            logger.debug("TCP proxy: Buffering data until target connects",
-                        metadata: ["bytes": "\(buffer.readableBytes)"])
-            return
+        counters.connectionOpened()
+        context.channel.closeFuture.whenComplete { [counters] _ in
+            counters.connectionClosed()
         }
 
-        // Forward data from client to target
-        outbound.writeAndFlush(buffer, promise: nil)
-    }
-
-    func channelInactive(context: ChannelHandlerContext) {
-        logger.debug("TCP proxy: Client disconnected")
-
-        // Close target connection when client disconnects
-        if let outbound = outboundChannel {
-            outbound.close(promise: nil)
-            outboundChannel = nil
-        }
+        connectToTarget(context: context)
+        context.fireChannelActive()
     }
 
     func errorCaught(context: ChannelHandlerContext, error: Error) {
@@ -153,113 +184,203 @@ private final class TCPProxyHandler: ChannelInboundHandler {
     }
 
     private func connectToTarget(context: ChannelHandlerContext) {
+        // Same event loop as the client channel: the glue handlers call each other directly
         let bootstrap = ClientBootstrap(group: context.eventLoop)
-            .channelInitializer { channel in
-                channel.pipeline.addHandler(
-                    TCPProxyBackendHandler(
-                        inboundChannel: context.channel,
-                        logger: self.logger,
-                        onDisconnect: self.onConnectionFailed
-                    )
-                )
-            }
+            .channelOption(ChannelOptions.socketOption(.tcp_nodelay), value: 1)
+            .channelOption(ChannelOptions.maxMessagesPerRead, value: 16)
+            .channelOption(ChannelOptions.recvAllocator, value: AdaptiveRecvByteBufferAllocator())
 
         bootstrap.connect(host: targetAddress, port: targetPort).whenComplete { result in
             switch result {
-            case .success(let channel):
-                self.outboundChannel = channel
+            case .success(let backend):
                 self.logger.debug("TCP proxy: Connected to target",
                                 metadata: ["targetAddress": "\(self.targetAddress)",
                                           "targetPort": "\(self.targetPort)"])
-
-                // Flush any buffered data that arrived before connection completed
-                if !self.pendingWrites.isEmpty {
-                    self.logger.debug("TCP proxy: Flushing buffered data",
-                                    metadata: ["buffers": "\(self.pendingWrites.count)"])
-                    for buffer in self.pendingWrites {
-                        channel.write(buffer, promise: nil)
-                    }
-                    channel.flush()
-                    self.pendingWrites.removeAll()
-                }
+                self.glue(context: context, to: backend)
             case .failure(let error):
-                // Dump nftables state on connection failure (for debugging)
-                if let dumpFn = self.onConnectionFailed {
-                    Task {
-                        if let ruleset = await dumpFn() {
-                            self.logger.error("TCP proxy: Failed to connect to target",
-                                            metadata: ["error": "\(error)",
-                                                      "targetAddress": "\(self.targetAddress)",
-                                                      "targetPort": "\(self.targetPort)",
-                                                      "nftables": "\n\(ruleset)"])
-                        } else {
-                            self.logger.warning("TCP proxy: Failed to connect to target",
-                                              metadata: ["error": "\(error)",
-                                                        "targetAddress": "\(self.targetAddress)",
-                                                        "targetPort": "\(self.targetPort)"])
-                        }
+                self.counters.connectionFailed()
+                self.logConnectFailure(error)
+                context.close(promise: nil)
+            }
+        }
+    }
+
+    private func glue(context: ChannelHandlerContext, to backend: Channel) {
+        // Client went away while the backend was connecting
+        guard context.channel.isActive else {
+            backend.close(promise: nil)
+            return
+        }
+
+        let (clientGlue, backendGlue) = GlueHandler.matchedPair(counters: counters)
+        do {
+            try context.pipeline.syncOperations.addHandler(clientGlue)
+            try backend.pipeline.syncOperations.addHandler(backendGlue)
+        } catch {
+            logger.debug("TCP proxy: Failed to join connections", metadata: ["error": "\(error)"])
+            backend.close(promise: nil)
+            context.close(promise: nil)
+            return
+        }
+
+        if let dumpFn = onConnectionFailed {
+            // Dump nftables state on disconnect (for debugging)
+            let logger = self.logger
+            backend.closeFuture.whenComplete { _ in
+                Task.detached {
+                    if let ruleset = await dumpFn() {
+                        logger.debug("TCP proxy: Target disconnected",
+                                    metadata: ["nftables": "\n\(ruleset)"])
+                    } else {
+                        logger.debug("TCP proxy: Target disconnected")
                     }
-                } else {
-                    self.logger.warning("TCP proxy: Failed to connect to target",
-                                      metadata: ["error": "\(error)",
-                                                "targetAddress": "\(self.targetAddress)",
-                                                "targetPort": "\(self.targetPort)"])
                 }
-                context.close(promise: nil)
+            }
+        }
+
+        context.pipeline.syncOperations.removeHandler(context: context, promise: nil)
+        context.channel.setOption(ChannelOptions.autoRead, value: true).whenFailure { _ in
+            context.close(promise: nil)
+        }
+    }
+
+    private func logConnectFailure(_ error: Error) {
+        let metadata: Logger.Metadata = [
+            "error": "\(error)",
+            "targetAddress": "\(targetAddress)",
+            "targetPort": "\(targetPort)"
+        ]
+
+        // Dump nftables state on connection failure (for debugging)
+        guard let dumpFn = onConnectionFailed else {
+            logger.warning("TCP proxy: Failed to connect to target", metadata: metadata)
+            return
+        }
+        let logger = self.logger
+        Task {
+            if let ruleset = await dumpFn() {
+                var withRuleset = metadata
+                withRuleset["nftables"] = "\n\(ruleset)"
+                logger.error("TCP proxy: Failed to connect to target", metadata: withRuleset)
+            } else {
+                logger.warning("TCP proxy: Failed to connect to target", metadata: metadata)
             }
         }
     }
 }
 
-// MARK: - TCP Proxy Backend Handler
+// MARK: - Glue Handler
 
-/// Channel handler for the target (backend) connection
-private final class TCPProxyBackendHandler: ChannelInboundHandler {
+/// One half of a client/backend pair; forwards reads to its partner's channel
+///
+/// Writes are flushed on channelReadComplete rather than per read. Backpressure follows
+/// the partner's writability: while the partner channel is not writable, `read` is held
+/// back so the kernel buffer (and TCP flow control) pushes back on the sender instead of
+/// NIO queueing unbounded writes.
+private final class GlueHandler: ChannelDuplexHandler {
     typealias InboundIn = ByteBuffer
+    typealias OutboundIn = ByteBuffer
     typealias OutboundOut = ByteBuffer
 
-    private let inboundChannel: Channel
-    private let logger: Logger
-    private let onDisconnect: (@Sendable () async -> String?)?
+    /// Which way data read by this half flows
+    private enum Direction {
+        case toContainer    // Read from the client, written to the backend
+        case fromContainer  // Read from the backend, written to the client
+    }
 
-    init(inboundChannel: Channel, logger: Logger, onDisconnect: (@Sendable () async -> String?)?) {
-        self.inboundChannel = inboundChannel
-        self.logger = logger
-        self.onDisconnect = onDisconnect
+    private let direction: Direction
+    private let counters: ProxyCounters
+    private var partner: GlueHandler?
+    private var context: ChannelHandlerContext?
+    private var pendingRead = false
+
+    private init(direction: Direction, counters: ProxyCounters) {
+        self.direction = direction
+        self.counters = counters
+    }
+
+    /// Handlers for the client pipeline and the backend pipeline, in that order
+    static func matchedPair(counters: ProxyCounters) -> (GlueHandler, GlueHandler) {
+        let client = GlueHandler(direction: .toContainer, counters: counters)
+        let backend = GlueHandler(direction: .fromContainer, counters: counters)
+        client.partner = backend
+        backend.partner = client
+        return (client, backend)
+    }
+
+    func handlerAdded(context: ChannelHandlerContext) {
+        self.context = context
+    }
+
+    func handlerRemoved(context: ChannelHandlerContext) {
+        self.context = nil
+        self.partner = nil
+    }
+
+    // MARK: Partner operations
+
+    private func partnerWrite(_ data: NIOAny) {
+        context?.write(data, promise: nil)
+    }
+
+    private func partnerFlush() {
+        context?.flush()
+    }
+
+    private func partnerCloseFull() {
+        context?.close(promise: nil)
     }
 
+    private var partnerWritable: Bool {
+        context?.channel.isWritable ?? false
+    }
+
+    private func partnerBecameWritable() {
+        if pendingRead {
+            pendingRead = false
+            context?.read()
+        }
+    }
+
+    // MARK: Inbound
+
     func channelRead(context: ChannelHandlerContext, data: NIOAny) {
-        let buffer = self.unwrapInboundIn(data)
+        let bytes = unwrapInboundIn(data).readableBytes
+        switch direction {
+        case .toContainer:
+            counters.recordToContainer(bytes: bytes)
+        case .fromContainer:
+            counters.recordFromContainer(bytes: bytes)
+        }
+        partner?.partnerWrite(data)
+    }
 
-        // Forward data from target back to client
-        inboundChannel.writeAndFlush(buffer, promise: nil)
+    func channelReadComplete(context: ChannelHandlerContext) {
+        partner?.partnerFlush()
     }
 
     func channelInactive(context: ChannelHandlerContext) {
-        // Dump nftables state on disconnect (for debugging)
-        if let dumpFn = self.onDisconnect {
-            let logger = self.logger
-            Task.detached {
-                if let ruleset = await dumpFn() {
-                    logger.debug("TCP proxy: Target disconnected",
-                                    metadata: ["nftables": "\n\(ruleset)"])
-                } else {
-                    logger.debug("TCP proxy: Target disconnected")
-                }
-            }
-        } else {
-            logger.debug("TCP proxy: Target disconnected")
-        }
+        partner?.partnerCloseFull()
+    }
 
-        // Close client connection when target disconnects
-        inboundChannel.close(promise: nil)
+    func channelWritabilityChanged(context: ChannelHandlerContext) {
+        if context.channel.isWritable {
+            partner?.partnerBecameWritable()
+        }
     }
 
     func errorCaught(context: ChannelHandlerContext, error: Error) {
-        logger.debug("TCP proxy backend error",
-                    metadata: ["error": "\(error)"])
         context.close(promise: nil)
-        inboundChannel.close(promise: nil)
+    }
+
+    // MARK: Outbound
+
+    func read(context: ChannelHandlerContext) {
+        if let partner = partner, partner.partnerWritable {
+            context.read()
+        } else {
+            pendingRead = true
+        }
     }
 }
 
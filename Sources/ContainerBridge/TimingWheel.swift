@@ -0,0 +1,76 @@
+import Foundation
+
+/// Hashed timing wheel for coarse-grained expiry of many keys
+///
+/// Time is measured in ticks driven by the owner calling `advance(to:)`. Refreshing a
+/// key's deadline is a dictionary write; the key stays in the slot it was first placed in
+/// and is moved forward lazily when that slot comes up, so advancing costs
+/// O(keys in the visited slots) rather than a scan of every key.
+///
+/// Not thread-safe: the owner confines it to one actor or event loop.
+struct TimingWheel<Key: Hashable> {
+    private var slots: [[Key]]
+    private var deadlines: [Key: UInt64] = [:]
+
+    /// Last tick processed by `advance(to:)`
+    private(set) var now: UInt64 = 0
+
+    var count: Int { deadlines.count }
+
+    init(slotCount: Int) {
+        self.slots = Array(repeating: [], count: max(slotCount, 1))
+    }
+
+    /// Schedule `key` to expire at `tick`, or push its existing deadline later
+    /// A deadline that is already due expires on the next tick
+    mutating func schedule(_ key: Key, at tick: UInt64) {
+        let deadline = max(tick, now + 1)
+        if let existing = deadlines[key], existing <= deadline {
+            // Already slotted no later than the new deadline; it is re-slotted when reached
+            deadlines[key] = deadline
+            return
+        }
+        deadlines[key] = deadline
+        slots[slot(for: deadline)].append(key)
+    }
+
+    /// Stop tracking `key`; stale slot entries are skipped when reached
+    mutating func remove(_ key: Key) {
+        deadlines.removeValue(forKey: key)
+    }
+
+    func deadline(of key: Key) -> UInt64? {
+        deadlines[key]
+    }
+
+    /// Process every tick up to `tick` and return the keys whose deadline passed
+    mutating func advance(to tick: UInt64) -> [Key] {
+        guard tick > now else { return [] }
+
+        var expired: [Key] = []
+        // Visiting more than a full revolution would only revisit the same slots
+        let first = max(now + 1, tick >= UInt64(slots.count) ? tick - UInt64(slots.count) + 1 : 1)
+        for current in first...tick {
+            let index = slot(for: current)
+            let entries = slots[index]
+            guard !entries.isEmpty else { continue }
+            slots[index] = []
+
+            for key in entries {
+                guard let deadline = deadlines[key] else { continue }  // Removed
+                if deadline <= tick {
+                    deadlines.removeValue(forKey: key)
+                    expired.append(key)
+                } else {
+                    slots[slot(for: deadline)].append(key)  // Deadline was pushed later
+                }
+            }
+        }
+        now = tick
+        return expired
+    }
+
+    private func slot(for tick: UInt64) -> Int {
+        Int(tick % UInt64(slots.count))
+    }
+}
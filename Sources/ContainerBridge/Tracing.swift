@@ -0,0 +1,206 @@
+import Foundation
+import GRPC
+import Logging
+
+/// Request tracing configuration
+public struct TracingConfig: Codable, Sendable {
+    /// Log a span for every API request, lifecycle phase and guest RPC; false when unset
+    public let enabled: Bool?
+
+    public init(enabled: Bool? = nil) {
+        self.enabled = enabled
+    }
+}
+
+/// W3C trace context identifying one span
+public struct SpanContext: Sendable, Equatable {
+    /// 32 lowercase hex digits shared by every span of one trace
+    public let traceID: String
+    /// 16 lowercase hex digits
+    public let spanID: String
+
+    /// `traceparent` header value for this span
+    public var traceparent: String {
+        "00-\(traceID)-\(spanID)-01"
+    }
+
+    init(traceID: String, spanID: String) {
+        self.traceID = traceID
+        self.spanID = spanID
+    }
+
+    /// Parse a `traceparent` header; nil if it is malformed or carries all-zero IDs
+    public init?(traceparent: String) {
+        let parts = traceparent.split(separator: "-")
+        guard parts.count >= 4, parts[0].count == 2,
+              parts[1].count == 32, parts[2].count == 16,
+              parts[1].allSatisfy(\.isHexDigit), parts[2].allSatisfy(\.isHexDigit),
+              parts[1].contains(where: { $0 != "0" }), parts[2].contains(where: { $0 != "0" }) else {
+            return nil
+        }
+        self.traceID = parts[1].lowercased()
+        self.spanID = parts[2].lowercased()
+    }
+
+    /// New span in the same trace
+    func child() -> SpanContext {
+        SpanContext(traceID: traceID, spanID: Self.randomID(bytes: 8))
+    }
+
+    /// New span starting a new trace
+    static func root() -> SpanContext {
+        SpanContext(traceID: randomID(bytes: 16), spanID: randomID(bytes: 8))
+    }
+
+    private static func randomID(bytes: Int) -> String {
+        var id = ""
+        id.reserveCapacity(bytes * 2)
+        for _ in 0..<bytes {
+            let byte = UInt8.random(in: 0...255)
+            id += String(byte >> 4, radix: 16)
+            id += String(byte & 0x0f, radix: 16)
+        }
+        return id
+    }
+}
+
+/// Span tracing for API requests and the work they cause
+///
+/// The router opens a span per request (continuing the caller's trace when the request has
+/// a `traceparent` header) and binds it to the task, so lifecycle phases and guest gRPC
+/// calls made while handling the request become its children. Guest calls carry the
+/// span's `traceparent` in their gRPC metadata so guest-side logs can be joined to it.
+/// Finished spans are logged at info level with their trace, span and parent IDs.
+///
+/// When tracing is disabled no IDs are generated and `withSpan` just runs its body.
+public enum Tracing {
+    /// Span the current task is running in
+    @TaskLocal public static var current: SpanContext?
+
+    private static let state = State()
+
+    /// Enable or disable tracing (disabled until configured)
+    public static func configure(_ config: TracingConfig?, logger: Logger) {
+        state.set(logger: (config?.enabled ?? false) ? logger : nil)
+    }
+
+    public static var isEnabled: Bool {
+        state.logger != nil
+    }
+
+    /// Run `body` in a child span of the current one (or a new trace)
+    /// - Parameter traceparent: Continue this remote trace instead when there is no current span
+    public static func withSpan<T>(
+        _ name: String,
+        traceparent: String? = nil,
+        metadata: Logger.Metadata = [:],
+        isolation: isolated (any Actor)? = #isolation,
+        _ body: () async throws -> T
+    ) async rethrows -> T {
+        guard let span = start(name, traceparent: traceparent, metadata: metadata) else {
+            return try await body()
+        }
+        do {
+            let result = try await $current.withValue(span.context) {
+                try await body()
+            }
+            span.finish()
+            return result
+        } catch {
+            span.finish(error: error)
+            throw error
+        }
+    }
+
+    /// Open a span without binding it to the task; nil when tracing is disabled
+    /// Used for phases that do not wrap a single expression. Work done before `finish` is
+    /// attributed to the enclosing span rather than this one.
+    public static func start(_ name: String, traceparent: String? = nil, metadata: Logger.Metadata = [:]) -> Span? {
+        guard let logger = state.logger else { return nil }
+        let parent = current ?? traceparent.flatMap { SpanContext(traceparent: $0) }
+        return Span(
+            name: name,
+            context: parent?.child() ?? .root(),
+            parentID: parent?.spanID,
+            metadata: metadata,
+            logger: logger
+        )
+    }
+
+    /// Call options carrying the current span as `traceparent` metadata
+    public static func callOptions(_ options: CallOptions = CallOptions()) -> CallOptions {
+        guard let span = current else { return options }
+        var options = options
+        options.customMetadata.replaceOrAdd(name: "traceparent", value: span.traceparent)
+        return options
+    }
+
+    /// Make a gRPC call into a guest service: timed, traced and tagged with `traceparent` metadata
+    /// - Parameter method: "service/Method", used as the metric label and span name
+    public static func guestCall<T>(
+        _ method: String,
+        options: CallOptions = CallOptions(),
+        isolation: isolated (any Actor)? = #isolation,
+        _ body: (CallOptions) async throws -> T
+    ) async rethrows -> T {
+        let start = ContinuousClock.now
+        do {
+            let result = try await withSpan("grpc \(method)") {
+                try await body(callOptions(options))
+            }
+            Metrics.shared.guestRPCDuration.observe(since: start, labels: [method, "ok"])
+            return result
+        } catch {
+            Metrics.shared.guestRPCDuration.observe(since: start, labels: [method, "error"])
+            throw error
+        }
+    }
+
+    /// @unchecked Sendable: Safe because the logger is protected by NSLock
+    private final class State: @unchecked Sendable {
+        private let lock = NSLock()
+        private var configuredLogger: Logger?
+
+        var logger: Logger? {
+            lock.withLock { configuredLogger }
+        }
+
+        func set(logger: Logger?) {
+            lock.withLock { configuredLogger = logger }
+        }
+    }
+}
+
+/// An open span; logged when finished
+public struct Span: Sendable {
+    public let name: String
+    public let context: SpanContext
+    public let parentID: String?
+    private let metadata: Logger.Metadata
+    private let logger: Logger
+    private let started = ContinuousClock.now
+
+    init(name: String, context: SpanContext, parentID: String?, metadata: Logger.Metadata, logger: Logger) {
+        self.name = name
+        self.context = context
+        self.parentID = parentID
+        self.metadata = metadata
+        self.logger = logger
+    }
+
+    public func finish(error: Error? = nil) {
+        let elapsed = ContinuousClock.now - started
+        let milliseconds = Double(elapsed.components.seconds) * 1000 + Double(elapsed.components.attoseconds) / 1e15
+
+        var fields = metadata
+        fields["span"] = "\(name)"
+        fields["trace_id"] = "\(context.traceID)"
+        fields["span_id"] = "\(context.spanID)"
+        fields["parent_id"] = "\(parentID ?? "")"
+        fields["duration_ms"] = "\(String(format: "%.2f", milliseconds))"
+        if let error = error {
+            fields["error"] = "\(error)"
+        }
+        logger.info("Span finished", metadata: fields)
+    }
+}
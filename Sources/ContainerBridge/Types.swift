@@ -17,6 +17,9 @@ public struct ContainerSummary: Sendable {
     public let labels: [String: String]
     public let sizeRw: Int64?
     public let sizeRootFs: Int64?
+    /// Registry generation of the container's last change; equal values mean an equal summary
+    /// apart from the time-dependent status text
+    public let generation: UInt64
 
     public init(
         id: String,
@@ -31,7 +34,8 @@ public struct ContainerSummary: Sendable {
         ports: [PortMapping] = [],
         labels: [String: String] = [:],
         sizeRw: Int64? = nil,
-        sizeRootFs: Int64? = nil
+        sizeRootFs: Int64? = nil,
+        generation: UInt64 = 0
     ) {
         self.id = id
         self.nativeID = nativeID
@@ -46,6 +50,7 @@ public struct ContainerSummary: Sendable {
         self.labels = labels
         self.sizeRw = sizeRw
         self.sizeRootFs = sizeRootFs
+        self.generation = generation
     }
 }
 
@@ -482,6 +487,22 @@ public struct FilesystemChange: Codable, Sendable {
         self.kind = kind.rawValue
     }
 
+    /// Change for an OverlayFS upperdir entry, nil for an unknown entry type
+    public init?(upperdirEntry entry: UpperdirEntry) {
+        switch entry.type {
+        case "whiteout":
+            // Whiteout = deleted file
+            self.init(path: entry.path, kind: .deleted)
+        case "file", "dir", "symlink":
+            // Present in upperdir = added or modified
+            // We can't distinguish without a baseline, so mark as modified
+            // Docker behavior: upperdir presence = change (could be add or modify)
+            self.init(path: entry.path, kind: .modified)
+        default:
+            return nil
+        }
+    }
+
     /// Kind of filesystem change
     public enum ChangeKind: Int {
         case modified = 0  // "C" - Modified
@@ -9,7 +9,13 @@ import Logging
 /// Implements NAT-style connection tracking:
 /// - Tracks client endpoints for reply routing
 /// - Expires idle mappings after timeout
-actor UDPProxy {
+///
+/// The client table belongs to the listener's channel handler and is only touched on the
+/// listener's event loop, so the per-datagram path takes no locks and never hops through
+/// an actor. Each client's outbound socket is placed on the next loop of the shared group,
+/// spreading reply traffic across cores. Reads are vectored (recvmmsg) and writes are
+/// flushed once per read burst, which lets NIO batch them into sendmmsg.
+public actor UDPProxy {
     private let logger: Logger
     private let listenAddress: String
     private let listenPort: Int
@@ -17,19 +23,21 @@ actor UDPProxy {
     private let targetPort: Int
     private let idleTimeout: TimeInterval
 
+    private let group: EventLoopGroup  // Shared; owned by PortMapManager
     private var serverChannel: Channel?
-    private var eventLoopGroup: MultiThreadedEventLoopGroup?
-    private var cleanupTask: Task<Void, Never>?
 
-    /// Client mapping for NAT-style tracking
-    private var clientMappings: [SocketAddress: ClientMapping] = [:]
+    /// Byte and client-mapping counters for this mapping
+    /// A "connection" is one tracked client endpoint
+    public nonisolated let counters: ProxyCounters
 
-    init(
+    public init(
         listenAddress: String,
         listenPort: Int,
         targetAddress: String,
         targetPort: Int,
         idleTimeout: TimeInterval = 60.0,
+        group: EventLoopGroup,
+        counters: ProxyCounters = ProxyCounters(),
         logger: Logger
     ) {
         self.listenAddress = listenAddress
@@ -37,23 +45,35 @@ actor UDPProxy {
         self.targetAddress = targetAddress
         self.targetPort = targetPort
         self.idleTimeout = idleTimeout
+        self.group = group
+        self.counters = counters
         self.logger = logger
     }
 
     /// Start the UDP proxy server
-    func start() async throws {
-        let group = MultiThreadedEventLoopGroup(numberOfThreads: 1)
-        self.eventLoopGroup = group
+    public func start() async throws {
+        let target: SocketAddress
+        do {
+            target = try SocketAddress.makeAddressResolvingHost(targetAddress, port: targetPort)
+        } catch {
+            throw UDPProxyError.invalidTarget(address: targetAddress, port: targetPort, error: error)
+        }
 
-        let bootstrap = DatagramBootstrap(group: group)
+        let group = self.group
+        let counters = self.counters
+        let logger = self.logger
+        let idleTicks = UInt64(max(idleTimeout.rounded(.up), 1))
+
+        let bootstrap = UDPProxySockets.configure(DatagramBootstrap(group: group))
             .channelOption(ChannelOptions.socketOption(.so_reuseaddr), value: 1)
             .channelInitializer { channel in
                 channel.pipeline.addHandler(
                     UDPProxyHandler(
-                        proxy: self,
-                        targetAddress: self.targetAddress,
-                        targetPort: self.targetPort,
-                        logger: self.logger
+                        target: target,
+                        group: group,
+                        idleTicks: idleTicks,
+                        counters: counters,
+                        logger: logger
                     )
                 )
             }
@@ -62,9 +82,6 @@ actor UDPProxy {
             let channel = try await bootstrap.bind(host: listenAddress, port: listenPort).get()
             self.serverChannel = channel
 
-            // Start cleanup task for idle mappings
-            startCleanupTask()
-
             logger.info("UDP proxy started",
                        metadata: ["listenAddress": "\(listenAddress)",
                                  "listenPort": "\(listenPort)",
@@ -72,170 +89,124 @@ actor UDPProxy {
                                  "targetPort": "\(targetPort)",
                                  "idleTimeout": "\(idleTimeout)s"])
         } catch {
-            try? await group.shutdownGracefully()
             throw UDPProxyError.bindFailed(address: listenAddress, port: listenPort, error: error)
         }
     }
 
     /// Stop the UDP proxy server
-    func stop() async throws {
-        // Cancel cleanup task
-        cleanupTask?.cancel()
-        cleanupTask = nil
-
+    /// Closing the listener closes every client's outbound socket
+    public func stop() async throws {
         if let channel = serverChannel {
             try await channel.close()
             serverChannel = nil
         }
 
-        if let group = eventLoopGroup {
-            try await group.shutdownGracefully()
-            eventLoopGroup = nil
-        }
-
-        clientMappings.removeAll()
-
         logger.info("UDP proxy stopped",
                    metadata: ["listenAddress": "\(listenAddress)",
                              "listenPort": "\(listenPort)"])
     }
+}
 
-    /// Track a client endpoint for reply routing
-    func trackClient(_ clientAddress: SocketAddress, outboundChannel: Channel) {
-        let mapping = ClientMapping(
-            clientAddress: clientAddress,
-            outboundChannel: outboundChannel,
-            lastActivity: Date()
-        )
-        clientMappings[clientAddress] = mapping
-
-        logger.debug("UDP proxy: Tracked client",
-                    metadata: ["clientAddress": "\(clientAddress.description)"])
-    }
-
-    /// Get outbound channel for a client
-    func getOutboundChannel(for clientAddress: SocketAddress) -> Channel? {
-        // Update last activity time
-        if var mapping = clientMappings[clientAddress] {
-            mapping.lastActivity = Date()
-            clientMappings[clientAddress] = mapping
-        }
-        return clientMappings[clientAddress]?.outboundChannel
-    }
-
-    /// Start periodic cleanup task for idle mappings
-    private func startCleanupTask() {
-        cleanupTask = Task {
-            while !Task.isCancelled {
-                try? await Task.sleep(nanoseconds: UInt64(10 * 1_000_000_000)) // 10 seconds
-
-                await cleanupIdleMappings()
-            }
-        }
-    }
-
-    /// Remove idle client mappings
-    private func cleanupIdleMappings() {
-        let now = Date()
-        var expiredClients: [SocketAddress] = []
-
-        for (clientAddress, mapping) in clientMappings {
-            if now.timeIntervalSince(mapping.lastActivity) > idleTimeout {
-                expiredClients.append(clientAddress)
-            }
-        }
-
-        for clientAddress in expiredClients {
-            if let mapping = clientMappings.removeValue(forKey: clientAddress) {
-                mapping.outboundChannel.close(promise: nil)
-                logger.debug("UDP proxy: Expired idle mapping",
-                            metadata: ["clientAddress": "\(clientAddress.description)",
-                                      "idleTime": "\(now.timeIntervalSince(mapping.lastActivity))s"])
-            }
-        }
-    }
-
-    /// Client mapping for NAT-style tracking
-    private struct ClientMapping {
-        let clientAddress: SocketAddress
-        let outboundChannel: Channel
-        var lastActivity: Date
+// MARK: - Socket Options
+
+private enum UDPProxySockets {
+    /// Datagrams per vectored read
+    static let messagesPerRead = 16
+    /// Receive slot per datagram; larger datagrams would be truncated
+    static let maxDatagramSize = 9216
+
+    static func configure(_ bootstrap: DatagramBootstrap) -> DatagramBootstrap {
+        bootstrap
+            .channelOption(ChannelOptions.datagramVectorReadMessageCount, value: messagesPerRead)
+            .channelOption(
+                ChannelOptions.recvAllocator,
+                value: FixedSizeRecvByteBufferAllocator(capacity: messagesPerRead * maxDatagramSize)
+            )
     }
 }
 
 // MARK: - UDP Proxy Handler
 
-/// Channel handler that forwards UDP datagrams bidirectionally
+/// Listener-side handler; owns the client table and its idle-expiry wheel
+///
+/// All state is confined to the listener channel's event loop.
 private final class UDPProxyHandler: ChannelInboundHandler {
     typealias InboundIn = AddressedEnvelope<ByteBuffer>
     typealias OutboundOut = AddressedEnvelope<ByteBuffer>
 
-    private weak var proxy: UDPProxy?
-    private let targetAddress: String
-    private let targetPort: Int
-    private let logger: Logger
+    /// Datagrams held per client while its outbound socket binds
+    private static let maxPendingDatagrams = 64
 
-    private var targetSocketAddress: SocketAddress?
-    private var context: ChannelHandlerContext?
+    private struct Flow {
+        var channel: Channel?           // nil while the outbound socket is binding
+        var pending: [ByteBuffer] = []  // Datagrams received while binding
+    }
 
-    init(proxy: UDPProxy, targetAddress: String, targetPort: Int, logger: Logger) {
-        self.proxy = proxy
-        self.targetAddress = targetAddress
-        self.targetPort = targetPort
+    private let target: SocketAddress
+    private let group: EventLoopGroup
+    private let idleTicks: UInt64
+    private let counters: ProxyCounters
+    private let logger: Logger
+
+    private var flows: [SocketAddress: Flow] = [:]
+    private var expiry = TimingWheel<SocketAddress>(slotCount: 64)
+    private var tick: UInt64 = 0  // Seconds since the listener became active
+    private var expiryTimer: Scheduled<Void>?
+    private var unflushed: [ObjectIdentifier: Channel] = [:]
+
+    init(target: SocketAddress, group: EventLoopGroup, idleTicks: UInt64, counters: ProxyCounters, logger: Logger) {
+        self.target = target
+        self.group = group
+        self.idleTicks = idleTicks
+        self.counters = counters
         self.logger = logger
     }
 
     func channelActive(context: ChannelHandlerContext) {
-        self.context = context
+        scheduleExpiryTick(context: context)
+        context.fireChannelActive()
+    }
 
-        // Resolve target address
-        do {
-            self.targetSocketAddress = try SocketAddress.makeAddressResolvingHost(targetAddress, port: targetPort)
-        } catch {
-            logger.error("UDP proxy: Failed to resolve target address",
-                        metadata: ["error": "\(error)",
-                                  "targetAddress": "\(targetAddress)",
-                                  "targetPort": "\(targetPort)"])
-            context.close(promise: nil)
+    func channelInactive(context: ChannelHandlerContext) {
+        expiryTimer?.cancel()
+        expiryTimer = nil
+        for flow in flows.values {
+            flow.channel?.close(promise: nil)
         }
+        flows.removeAll()
+        unflushed.removeAll()
+        context.fireChannelInactive()
     }
 
     func channelRead(context: ChannelHandlerContext, data: NIOAny) {
         let envelope = self.unwrapInboundIn(data)
         let clientAddress = envelope.remoteAddress
-        var buffer = envelope.data
+        counters.recordToContainer(bytes: envelope.data.readableBytes)
+        expiry.schedule(clientAddress, at: tick + idleTicks)
 
-        guard let targetAddr = targetSocketAddress else {
-            logger.warning("UDP proxy: Target address not resolved, dropping datagram")
+        guard var flow = flows[clientAddress] else {
+            flows[clientAddress] = Flow(pending: [envelope.data])
+            counters.connectionOpened()
+            openFlow(for: clientAddress, context: context)
             return
         }
 
-        // Use NIO's event loop instead of Task for better concurrency handling
-        context.eventLoop.execute {
-            Task { [weak self, clientAddress, targetAddr, buffer] in
-                // Track client for reply routing
-                guard let self = self, let proxy = self.proxy else { return }
-
-                // Check if we already have an outbound channel for this client
-                let outboundChannel: Channel
-                if let existing = await proxy.getOutboundChannel(for: clientAddress) {
-                    outboundChannel = existing
-                } else {
-                    // Create new outbound channel for this client
-                    do {
-                        outboundChannel = try await self.createOutboundChannel(context: context, clientAddress: clientAddress)
-                        await proxy.trackClient(clientAddress, outboundChannel: outboundChannel)
-                    } catch {
-                        self.logger.error("Failed to create outbound channel", metadata: ["error": "\(error)"])
-                        return
-                    }
-                }
-
-                // Forward datagram to target
-                let outboundEnvelope = AddressedEnvelope(remoteAddress: targetAddr, data: buffer)
-                outboundChannel.writeAndFlush(self.wrapOutboundOut(outboundEnvelope), promise: nil)
-            }
+        if let channel = flow.channel {
+            channel.write(AddressedEnvelope(remoteAddress: target, data: envelope.data), promise: nil)
+            unflushed[ObjectIdentifier(channel)] = channel
+        } else if flow.pending.count < Self.maxPendingDatagrams {
+            flow.pending.append(envelope.data)
+            flows[clientAddress] = flow
+        }
+        // Otherwise drop: UDP gives no delivery guarantee and the backlog stays bounded
+    }
+
+    func channelReadComplete(context: ChannelHandlerContext) {
+        for channel in unflushed.values {
+            channel.flush()
         }
+        unflushed.removeAll(keepingCapacity: true)
+        context.fireChannelReadComplete()
     }
 
     func errorCaught(context: ChannelHandlerContext, error: Error) {
@@ -243,52 +214,155 @@ private final class UDPProxyHandler: ChannelInboundHandler {
                     metadata: ["error": "\(error)"])
     }
 
-    private func createOutboundChannel(context: ChannelHandlerContext, clientAddress: SocketAddress) async throws -> Channel {
-        let bootstrap = DatagramBootstrap(group: context.eventLoop)
+    /// Reply traffic keeps a mapping alive too
+    func noteReply(from clientAddress: SocketAddress) {
+        guard flows[clientAddress] != nil else { return }
+        expiry.schedule(clientAddress, at: tick + idleTicks)
+    }
+
+    private func openFlow(for clientAddress: SocketAddress, context: ChannelHandlerContext) {
+        let listener = NIOLoopBound(self, eventLoop: context.eventLoop)
+        let inboundChannel = context.channel
+        let counters = self.counters
+        let logger = self.logger
+
+        UDPProxySockets.configure(DatagramBootstrap(group: group.next()))
             .channelInitializer { channel in
                 channel.pipeline.addHandler(
                     UDPProxyBackendHandler(
-                        inboundChannel: context.channel,
+                        inboundChannel: inboundChannel,
                         clientAddress: clientAddress,
-                        logger: self.logger
+                        listener: listener,
+                        counters: counters,
+                        logger: logger
                     )
                 )
             }
+            .bind(host: "0.0.0.0", port: 0)
+            .hop(to: context.eventLoop)
+            .assumeIsolated()
+            .whenComplete { result in
+                self.flowOpened(result, for: clientAddress, context: context)
+            }
+    }
+
+    private func flowOpened(_ result: Result<Channel, Error>, for clientAddress: SocketAddress, context: ChannelHandlerContext) {
+        switch result {
+        case .success(let channel):
+            // Expired (or the listener closed) while binding
+            guard var flow = flows[clientAddress] else {
+                counters.connectionClosed()
+                channel.close(promise: nil)
+                return
+            }
+
+            for buffer in flow.pending {
+                channel.write(AddressedEnvelope(remoteAddress: target, data: buffer), promise: nil)
+            }
+            channel.flush()
+            flow.pending.removeAll()
+            flow.channel = channel
+            flows[clientAddress] = flow
 
-        let channel = try await bootstrap.bind(host: "0.0.0.0", port: 0).get()
+            channel.closeFuture.hop(to: context.eventLoop).assumeIsolated().whenComplete { _ in
+                self.flowClosed(channel, for: clientAddress)
+            }
+
+            logger.debug("UDP proxy: Created outbound channel",
+                        metadata: ["clientAddress": "\(clientAddress.description)",
+                                  "localPort": "\(channel.localAddress?.port ?? 0)"])
+
+        case .failure(let error):
+            flows.removeValue(forKey: clientAddress)
+            expiry.remove(clientAddress)
+            counters.connectionFailed()
+            counters.connectionClosed()
+            logger.error("Failed to create outbound channel", metadata: ["error": "\(error)"])
+        }
+    }
+
+    private func flowClosed(_ channel: Channel, for clientAddress: SocketAddress) {
+        counters.connectionClosed()
+        unflushed.removeValue(forKey: ObjectIdentifier(channel))
+        if let flow = flows[clientAddress], flow.channel === channel {
+            flows.removeValue(forKey: clientAddress)
+            expiry.remove(clientAddress)
+        }
+    }
+
+    // MARK: Idle expiry
 
-        logger.debug("UDP proxy: Created outbound channel",
-                    metadata: ["clientAddress": "\(clientAddress.description)",
-                              "localPort": "\(channel.localAddress?.port ?? 0)"])
+    private func scheduleExpiryTick(context: ChannelHandlerContext) {
+        expiryTimer = context.eventLoop.assumeIsolated().scheduleTask(in: .seconds(1)) {
+            self.expireIdleMappings(context: context)
+        }
+    }
 
-        return channel
+    private func expireIdleMappings(context: ChannelHandlerContext) {
+        tick += 1
+        for clientAddress in expiry.advance(to: tick) {
+            guard let flow = flows.removeValue(forKey: clientAddress) else { continue }
+            // A flow still binding is closed by flowOpened once the bind completes
+            flow.channel?.close(promise: nil)
+            logger.debug("UDP proxy: Expired idle mapping",
+                        metadata: ["clientAddress": "\(clientAddress.description)",
+                                  "idleTime": "\(idleTicks)s"])
+        }
+        scheduleExpiryTick(context: context)
     }
 }
 
 // MARK: - UDP Proxy Backend Handler
 
-/// Channel handler for the target (backend) connection
+/// Channel handler for one client's outbound socket
+/// Replies are handed to the listener's event loop once per read burst
 private final class UDPProxyBackendHandler: ChannelInboundHandler {
     typealias InboundIn = AddressedEnvelope<ByteBuffer>
     typealias OutboundOut = AddressedEnvelope<ByteBuffer>
 
     private let inboundChannel: Channel
     private let clientAddress: SocketAddress
+    private let listener: NIOLoopBound<UDPProxyHandler>
+    private let counters: ProxyCounters
     private let logger: Logger
+    private var replies: [ByteBuffer] = []
 
-    init(inboundChannel: Channel, clientAddress: SocketAddress, logger: Logger) {
+    init(
+        inboundChannel: Channel,
+        clientAddress: SocketAddress,
+        listener: NIOLoopBound<UDPProxyHandler>,
+        counters: ProxyCounters,
+        logger: Logger
+    ) {
         self.inboundChannel = inboundChannel
         self.clientAddress = clientAddress
+        self.listener = listener
+        self.counters = counters
         self.logger = logger
     }
 
     func channelRead(context: ChannelHandlerContext, data: NIOAny) {
         let envelope = self.unwrapInboundIn(data)
-        var buffer = envelope.data
+        counters.recordFromContainer(bytes: envelope.data.readableBytes)
+        replies.append(envelope.data)
+    }
 
-        // Forward datagram from target back to original client
-        let outboundEnvelope = AddressedEnvelope(remoteAddress: clientAddress, data: buffer)
-        inboundChannel.writeAndFlush(self.wrapOutboundOut(outboundEnvelope), promise: nil)
+    func channelReadComplete(context: ChannelHandlerContext) {
+        guard !replies.isEmpty else { return }
+        let batch = replies
+        replies.removeAll(keepingCapacity: true)
+
+        // Forward datagrams from target back to original client
+        let inboundChannel = self.inboundChannel
+        let clientAddress = self.clientAddress
+        let listener = self.listener
+        inboundChannel.eventLoop.execute {
+            for buffer in batch {
+                inboundChannel.write(AddressedEnvelope(remoteAddress: clientAddress, data: buffer), promise: nil)
+            }
+            inboundChannel.flush()
+            listener.value.noteReply(from: clientAddress)
+        }
     }
 
     func errorCaught(context: ChannelHandlerContext, error: Error) {
@@ -301,11 +375,14 @@ private final class UDPProxyBackendHandler: ChannelInboundHandler {
 
 enum UDPProxyError: Error, CustomStringConvertible {
     case bindFailed(address: String, port: Int, error: Error)
+    case invalidTarget(address: String, port: Int, error: Error)
 
     var description: String {
         switch self {
         case .bindFailed(let address, let port, let error):
             return "Failed to bind UDP proxy to \(address):\(port): \(error)"
+        case .invalidTarget(let address, let port, let error):
+            return "Failed to resolve UDP proxy target \(address):\(port): \(error)"
         }
     }
 }
@@ -0,0 +1,59 @@
+import Foundation
+
+/// Maps Docker's cgroup-style resource settings onto VM sizing
+///
+/// Each container has its own VM, so there is no shared cgroup tree for `--cpu-quota` or
+/// `--cpuset-cpus` to act in; the nearest equivalent is the VM's vCPU count. Relative
+/// settings (`--cpu-shares`, `--memory-reservation`) only matter between VMs and have no
+/// equivalent here.
+enum VMResources {
+    /// VM memory when `--memory` is not set
+    static let defaultMemory: Int64 = 4 * 1024 * 1024 * 1024  // 4GB
+
+    /// Docker's default CFS period when `--cpu-quota` is given without `--cpu-period`
+    static let defaultCPUPeriod: Int64 = 100_000
+
+    /// vCPUs for a container, nil to keep the framework's default
+    /// The smallest of `--cpus`, quota/period (rounded up) and the size of `--cpuset-cpus`.
+    static func vcpuCount(
+        nanoCpus: Int64?,
+        cpuQuota: Int64?,
+        cpuPeriod: Int64?,
+        cpusetCpus: String?,
+        hostCPUs: Int = ProcessInfo.processInfo.activeProcessorCount
+    ) -> Int? {
+        var limits: [Int] = []
+        if let nanoCpus = nanoCpus, nanoCpus > 0 {
+            limits.append(Int((nanoCpus + 999_999_999) / 1_000_000_000))
+        }
+        if let cpuQuota = cpuQuota, cpuQuota > 0 {
+            let period = (cpuPeriod ?? 0) > 0 ? cpuPeriod! : defaultCPUPeriod
+            limits.append(Int((cpuQuota + period - 1) / period))
+        }
+        if let cpusetCpus = cpusetCpus, let count = cpusetCount(cpusetCpus) {
+            limits.append(count)
+        }
+        return limits.min().map { min(max($0, 1), max(hostCPUs, 1)) }
+    }
+
+    /// CPUs in a cpuset list such as "0-3,6", nil if it can't be parsed
+    static func cpusetCount(_ cpuset: String) -> Int? {
+        var cpus = Set<Int>()
+        for part in cpuset.split(separator: ",") {
+            let bounds = part.split(separator: "-", omittingEmptySubsequences: false).map {
+                Int($0.trimmingCharacters(in: .whitespaces))
+            }
+            switch bounds.count {
+            case 1:
+                guard let cpu = bounds[0] else { return nil }
+                cpus.insert(cpu)
+            case 2:
+                guard let low = bounds[0], let high = bounds[1], low <= high else { return nil }
+                cpus.formUnion(low...high)
+            default:
+                return nil
+            }
+        }
+        return cpus.isEmpty ? nil : cpus.count
+    }
+}
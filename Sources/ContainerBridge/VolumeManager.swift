@@ -1,7 +1,5 @@
 import Foundation
 import Logging
-import ContainerizationEXT4
-import SystemPackage
 
 /// Manages Docker named volumes
 /// Volumes are stored as EXT4-formatted block devices at ~/.arca/volumes/{name}/volume.img
@@ -10,10 +8,17 @@ public actor VolumeManager {
     private let logger: Logger
     private let volumesBasePath: String
     private let stateStore: StateStore
+    private let blockTemplates: EXT4TemplateStore  // Empty block volume images, cloned per volume
 
     // In-memory volume tracking: [name: VolumeMetadata]
     private var volumes: [String: VolumeMetadata] = [:]
 
+    // Cached disk usage per volume, refreshed in the background when older than usageMaxAge
+    private var usageCache: [String: VolumeUsage] = [:]
+    private var usageRefreshes: [String: Task<VolumeUsage?, Never>] = [:]
+    private let usageMaxAge: TimeInterval = 60
+    private let usageScanBudget: Duration = .seconds(30)
+
     /// Volume metadata for in-memory tracking
     public struct VolumeMetadata: Codable, Sendable {
         public let name: String
@@ -43,6 +48,17 @@ public actor VolumeManager {
         }
     }
 
+    /// Disk usage of a volume as of its last measurement
+    public struct VolumeUsage: Sendable {
+        public let bytes: Int64  // Allocated bytes (sparse block images count only written blocks)
+        public let measuredAt: Date
+        public let complete: Bool  // False if the scan ran out of time; bytes is a lower bound
+
+        public var age: TimeInterval {
+            Date().timeIntervalSince(measuredAt)
+        }
+    }
+
     /// Initialize VolumeManager
     /// - Parameters:
     ///   - volumesBasePath: Base directory for storing volumes (default: ~/.arca/volumes)
@@ -58,6 +74,13 @@ public actor VolumeManager {
         } else {
             self.volumesBasePath = NSString(string: "~/.arca/volumes").expandingTildeInPath
         }
+
+        // Inside the volumes directory so clones never cross volumes; the leading dot keeps it
+        // clear of volume names, which must start with an alphanumeric character
+        self.blockTemplates = EXT4TemplateStore(
+            directory: URL(fileURLWithPath: self.volumesBasePath).appendingPathComponent(".templates"),
+            logger: logger
+        )
     }
 
     /// Initialize the volume manager
@@ -81,6 +104,11 @@ public actor VolumeManager {
         // Load existing volumes from database
         try await loadVolumesFromDatabase()
 
+        // Warm the usage cache so the first listing doesn't report unknown sizes
+        for metadata in volumes.values {
+            scheduleUsageRefresh(metadata)
+        }
+
         logger.info("VolumeManager initialized", metadata: [
             "volumeCount": "\(volumes.count)"
         ])
@@ -189,16 +217,17 @@ public actor VolumeManager {
                     "size": "\(sizeInBytes) bytes"
                 ])
 
-                let formatter = try EXT4.Formatter(
-                    FilePath(blockImagePath),
-                    blockSize: 4096,
-                    minDiskSize: sizeInBytes
+                // Cloned from the template for this size, formatted in place if cloning fails
+                let cloned = try blockTemplates.createFilesystem(
+                    at: blockImagePath,
+                    sizeBytes: sizeInBytes,
+                    blockSize: 4096
                 )
-                try formatter.close()
 
                 logger.info("EXT4 block device created", metadata: [
                     "name": "\(volumeName)",
-                    "path": "\(blockImagePath)"
+                    "path": "\(blockImagePath)",
+                    "cloned": "\(cloned)"
                 ])
             } catch {
                 // Clean up on failure
@@ -229,6 +258,7 @@ public actor VolumeManager {
 
         // Persist to database
         try await saveVolumeToDatabase(metadata: metadata)
+        scheduleUsageRefresh(metadata)
 
         logger.info("Volume created", metadata: [
             "name": "\(volumeName)",
@@ -346,6 +376,8 @@ public actor VolumeManager {
 
         // Remove from memory
         volumes.removeValue(forKey: name)
+        usageCache.removeValue(forKey: name)
+        usageRefreshes.removeValue(forKey: name)?.cancel()
 
         // Delete from database
         try await stateStore.deleteVolume(name: name)
@@ -374,8 +406,14 @@ public actor VolumeManager {
 
         for volume in volumesToPrune {
             do {
-                // Calculate space used by volume
-                let volumeSize = calculateVolumeSize(path: volume.mountpoint)
+                // Space used by volume: block images are a single stat, local volumes use the
+                // cached scan unless there is none yet
+                let volumeSize: Int64
+                if volume.driver != "block", let cached = usageCache[volume.name] {
+                    volumeSize = cached.bytes
+                } else {
+                    volumeSize = await refreshUsage(name: volume.name)?.bytes ?? 0
+                }
 
                 // Delete volume
                 try await deleteVolume(name: volume.name, force: false)
@@ -436,6 +474,35 @@ public actor VolumeManager {
         }
     }
 
+    /// Cached disk usage for volumes, without waiting on any measurement
+    ///
+    /// Volumes with no cached value, or one older than `usageMaxAge`, are refreshed in the
+    /// background; callers see the previous value (or none) until that finishes.
+    /// - Parameter names: Volume names to look up
+    /// - Returns: Usage by volume name for volumes that have been measured
+    public func usage(names: [String]) -> [String: VolumeUsage] {
+        var result: [String: VolumeUsage] = [:]
+        for name in names {
+            guard let metadata = volumes[name] else { continue }
+            let cached = usageCache[name]
+            if let cached = cached {
+                result[name] = cached
+            }
+            if cached.map({ $0.age > usageMaxAge }) ?? true {
+                scheduleUsageRefresh(metadata)
+            }
+        }
+        return result
+    }
+
+    /// Measure a volume now (joining a background refresh if one is running)
+    /// - Parameter name: Volume name
+    /// - Returns: Fresh usage, or nil if the volume doesn't exist
+    public func refreshUsage(name: String) async -> VolumeUsage? {
+        guard let metadata = volumes[name] else { return nil }
+        return await scheduleUsageRefresh(metadata).value
+    }
+
     // MARK: - Private Helpers
 
     /// Generate a random volume name
@@ -445,22 +512,51 @@ public actor VolumeManager {
         return "\(timestamp)_\(random)"
     }
 
-    /// Calculate size of volume directory in bytes
-    private func calculateVolumeSize(path: String) -> Int64 {
-        let fileManager = FileManager.default
-        var totalSize: Int64 = 0
-
-        if let enumerator = fileManager.enumerator(atPath: path) {
-            for case let file as String in enumerator {
-                let filePath = "\(path)/\(file)"
-                if let attrs = try? fileManager.attributesOfItem(atPath: filePath),
-                   let fileSize = attrs[.size] as? Int64 {
-                    totalSize += fileSize
-                }
-            }
+    /// Measure a volume's disk usage
+    private static func measureUsage(_ metadata: VolumeMetadata, budget: Duration) async -> VolumeUsage {
+        let bytes: Int64
+        let complete: Bool
+        if metadata.driver == "block" {
+            bytes = DiskUsage.allocatedSize(ofFile: metadata.mountpoint) ?? 0
+            complete = true
+        } else {
+            let scan = await DiskUsage.scan(directory: metadata.mountpoint, deadline: .now + budget)
+            bytes = scan.bytes
+            complete = scan.complete
         }
+        return VolumeUsage(bytes: bytes, measuredAt: Date(), complete: complete)
+    }
 
-        return totalSize
+    /// Start measuring a volume in the background unless a measurement is already running
+    @discardableResult
+    private func scheduleUsageRefresh(_ metadata: VolumeMetadata) -> Task<VolumeUsage?, Never> {
+        if let running = usageRefreshes[metadata.name] {
+            return running
+        }
+
+        let budget = usageScanBudget
+        let task = Task<VolumeUsage?, Never> { [weak self] in
+            let usage = await Self.measureUsage(metadata, budget: budget)
+            guard !Task.isCancelled else { return nil }
+            await self?.storeUsage(usage, for: metadata.name)
+            return usage
+        }
+        usageRefreshes[metadata.name] = task
+        return task
+    }
+
+    private func storeUsage(_ usage: VolumeUsage, for name: String) {
+        usageRefreshes.removeValue(forKey: name)
+        // The volume may have been deleted while it was being measured
+        guard volumes[name] != nil else { return }
+        usageCache[name] = usage
+
+        if !usage.complete {
+            logger.warning("Volume usage scan hit its time budget", metadata: [
+                "name": "\(name)",
+                "bytes_counted": "\(usage.bytes)"
+            ])
+        }
     }
 
     /// Load volumes from database
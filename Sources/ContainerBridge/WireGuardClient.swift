@@ -6,12 +6,45 @@ import NIOPosix
 import Containerization
 import ContainerizationOS
 
+/// A peer to add to a container's WireGuard interface (see `WireGuardClient.addPeers`)
+public struct WireGuardPeer: Sendable {
+    public let networkID: String
+    public let networkIndex: UInt32
+    public let publicKey: String
+    public let endpoint: String
+    public let ipAddress: String
+    public let name: String
+    public let containerID: String
+    public let aliases: [String]
+
+    public init(
+        networkID: String,
+        networkIndex: UInt32,
+        publicKey: String,
+        endpoint: String,
+        ipAddress: String,
+        name: String,
+        containerID: String,
+        aliases: [String] = []
+    ) {
+        self.networkID = networkID
+        self.networkIndex = networkIndex
+        self.publicKey = publicKey
+        self.endpoint = endpoint
+        self.ipAddress = ipAddress
+        self.name = name
+        self.containerID = containerID
+        self.aliases = aliases
+    }
+}
+
 /// WireGuardClient handles gRPC communication with the container's WireGuard service via vsock
 public actor WireGuardClient {
     private let logger: Logger
     private var channel: GRPCChannel?
     private var eventLoopGroup: EventLoopGroup?
     private var client: Arca_Wireguard_V1_WireGuardServiceNIOClient?
+    private var pooled = false  // Channel belongs to a ControlChannelPool and outlives this client
     // Note: SwiftNIO takes ownership of the file descriptor when using .connectedSocket()
     // We must NOT keep the FileHandle alive as it would cause dual ownership and crashes
 
@@ -90,12 +123,28 @@ public actor WireGuardClient {
         throw lastError ?? WireGuardClientError.connectionFailed("Connection timed out after \(maxRetries) attempts")
     }
 
+    /// Use the container's persistent WireGuard channel instead of dialing a new connection
+    public func connect(channels: ControlChannelPool) async throws {
+        let channel = try await channels.channel(for: .wireGuard)
+        self.channel = channel
+        self.client = Arca_Wireguard_V1_WireGuardServiceNIOClient(channel: channel)
+        self.pooled = true
+    }
+
     /// Disconnect from the container's WireGuard service
+    /// A pooled channel stays open for the container's other clients
     public func disconnect() async throws {
         guard let channel = channel else {
             return
         }
 
+        if pooled {
+            self.channel = nil
+            self.client = nil
+            self.pooled = false
+            return
+        }
+
         logger.info("Disconnecting from container WireGuard service")
 
         // Close the gRPC channel - SwiftNIO will automatically close the underlying fd
@@ -157,8 +206,9 @@ public actor WireGuardClient {
         request.hostIp = hostIP
         request.extraHosts = extraHosts
 
-        let call = client.addNetwork(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/AddNetwork") { options in
+            try await client.addNetwork(request, callOptions: options).response.get()
+        }
 
         guard response.success else {
             throw WireGuardClientError.operationFailed(response.error)
@@ -190,8 +240,9 @@ public actor WireGuardClient {
         request.networkID = networkID
         request.networkIndex = networkIndex
 
-        let call = client.removeNetwork(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/RemoveNetwork") { options in
+            try await client.removeNetwork(request, callOptions: options).response.get()
+        }
 
         guard response.success else {
             throw WireGuardClientError.operationFailed(response.error)
@@ -235,8 +286,9 @@ public actor WireGuardClient {
         request.peerContainerID = peerContainerID
         request.peerAliases = peerAliases
 
-        let call = client.addPeer(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/AddPeer") { options in
+            try await client.addPeer(request, callOptions: options).response.get()
+        }
 
         guard response.success else {
             throw WireGuardClientError.operationFailed(response.error)
@@ -249,6 +301,158 @@ public actor WireGuardClient {
         return response.totalPeers
     }
 
+    /// Add several peers in one round trip (full mesh setup when joining a network)
+    /// Falls back to one AddPeer per peer when the guest predates AddPeers
+    /// - Returns: Number of peers added
+    public func addPeers(_ peers: [WireGuardPeer]) async throws -> UInt32 {
+        guard let client = client else {
+            throw WireGuardClientError.notConnected
+        }
+        guard !peers.isEmpty else { return 0 }
+
+        logger.info("Adding peers to WireGuard interfaces", metadata: [
+            "count": "\(peers.count)"
+        ])
+
+        var request = Arca_Wireguard_V1_AddPeersRequest()
+        request.peers = peers.map { peer in
+            var entry = Arca_Wireguard_V1_AddPeerRequest()
+            entry.networkID = peer.networkID
+            entry.networkIndex = peer.networkIndex
+            entry.peerPublicKey = peer.publicKey
+            entry.peerEndpoint = peer.endpoint
+            entry.peerIpAddress = peer.ipAddress
+            entry.peerName = peer.name
+            entry.peerContainerID = peer.containerID
+            entry.peerAliases = peer.aliases
+            return entry
+        }
+
+        let response: Arca_Wireguard_V1_AddPeersResponse
+        do {
+            response = try await Tracing.guestCall("wireguard/AddPeers") { options in
+                try await client.addPeers(request, callOptions: options).response.get()
+            }
+        } catch let status as GRPCStatus where status.code == .unimplemented {
+            logger.debug("AddPeers not supported by guest, adding peers one at a time")
+            for peer in peers {
+                _ = try await addPeer(
+                    networkID: peer.networkID,
+                    networkIndex: peer.networkIndex,
+                    peerPublicKey: peer.publicKey,
+                    peerEndpoint: peer.endpoint,
+                    peerIPAddress: peer.ipAddress,
+                    peerName: peer.name,
+                    peerContainerID: peer.containerID,
+                    peerAliases: peer.aliases
+                )
+            }
+            return UInt32(peers.count)
+        }
+
+        guard response.success else {
+            throw WireGuardClientError.operationFailed(
+                "\(response.error) (failed peers: \(response.failedPeerPublicKeys.count))"
+            )
+        }
+
+        logger.info("Peers added to WireGuard interfaces successfully (DNS registered)", metadata: [
+            "added": "\(response.added)"
+        ])
+
+        return response.added
+    }
+
+    /// Apply a topology journal delta to one network interface (peers and DNS records)
+    /// Falls back to RemovePeer and AddPeers when the guest predates ApplyTopologyDelta; such a
+    /// guest keeps stale peers across a full sync, which only happens after it fell behind the
+    /// journal's removal log.
+    /// - Returns: The version the guest now has, nil if it needs a full sync first
+    func applyTopologyDelta(
+        networkID: String,
+        networkIndex: UInt32,
+        delta: NetworkTopologyJournal.Delta
+    ) async throws -> UInt64? {
+        guard let client = client else {
+            throw WireGuardClientError.notConnected
+        }
+
+        logger.debug("Applying topology delta", metadata: [
+            "networkID": "\(networkID)",
+            "networkIndex": "\(networkIndex)",
+            "baseVersion": "\(delta.baseVersion)",
+            "version": "\(delta.version)",
+            "fullSync": "\(delta.fullSync)",
+            "added": "\(delta.added.count)",
+            "removed": "\(delta.removed.count)"
+        ])
+
+        var request = Arca_Wireguard_V1_ApplyTopologyDeltaRequest()
+        request.networkID = networkID
+        request.networkIndex = networkIndex
+        request.baseVersion = delta.baseVersion
+        request.version = delta.version
+        request.fullSync = delta.fullSync
+        request.added = delta.added.map { peer in
+            var entry = Arca_Wireguard_V1_AddPeerRequest()
+            entry.networkID = networkID
+            entry.networkIndex = networkIndex
+            entry.peerPublicKey = peer.publicKey
+            entry.peerEndpoint = peer.endpoint
+            entry.peerIpAddress = peer.ipAddress
+            entry.peerName = peer.name
+            entry.peerContainerID = peer.containerID
+            entry.peerAliases = peer.aliases
+            return entry
+        }
+        request.removed = delta.removed.map { peer in
+            var entry = Arca_Wireguard_V1_RemovePeerRequest()
+            entry.networkID = networkID
+            entry.networkIndex = networkIndex
+            entry.peerPublicKey = peer.publicKey
+            entry.peerName = peer.name
+            return entry
+        }
+
+        let response: Arca_Wireguard_V1_ApplyTopologyDeltaResponse
+        do {
+            response = try await Tracing.guestCall("wireguard/ApplyTopologyDelta") { options in
+                try await client.applyTopologyDelta(request, callOptions: options).response.get()
+            }
+        } catch let status as GRPCStatus where status.code == .unimplemented {
+            logger.debug("ApplyTopologyDelta not supported by guest, applying peers individually")
+            for peer in delta.removed {
+                _ = try? await removePeer(
+                    networkID: networkID,
+                    networkIndex: networkIndex,
+                    peerPublicKey: peer.publicKey,
+                    peerName: peer.name
+                )
+            }
+            _ = try await addPeers(delta.added.map { peer in
+                WireGuardPeer(
+                    networkID: networkID,
+                    networkIndex: networkIndex,
+                    publicKey: peer.publicKey,
+                    endpoint: peer.endpoint,
+                    ipAddress: peer.ipAddress,
+                    name: peer.name,
+                    containerID: peer.containerID,
+                    aliases: peer.aliases
+                )
+            })
+            return delta.version
+        }
+
+        if response.resyncRequired {
+            return nil
+        }
+        guard response.success else {
+            throw WireGuardClientError.operationFailed(response.error)
+        }
+        return response.version
+    }
+
     /// Remove a peer from a WireGuard interface (also removes DNS entry)
     public func removePeer(
         networkID: String,
@@ -272,8 +476,9 @@ public actor WireGuardClient {
         request.peerPublicKey = peerPublicKey
         request.peerName = peerName
 
-        let call = client.removePeer(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/RemovePeer") { options in
+            try await client.removePeer(request, callOptions: options).response.get()
+        }
 
         guard response.success else {
             throw WireGuardClientError.operationFailed(response.error)
@@ -293,8 +498,9 @@ public actor WireGuardClient {
         }
 
         let request = Arca_Wireguard_V1_GetStatusRequest()
-        let call = client.getStatus(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/GetStatus") { options in
+            try await client.getStatus(request, callOptions: options).response.get()
+        }
 
         logger.debug("WireGuard status", metadata: [
             "version": "\(response.version)",
@@ -314,8 +520,9 @@ public actor WireGuardClient {
         logger.debug("Getting vmnet endpoint from container")
 
         let request = Arca_Wireguard_V1_GetVmnetEndpointRequest()
-        let call = client.getVmnetEndpoint(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/GetVmnetEndpoint") { options in
+            try await client.getVmnetEndpoint(request, callOptions: options).response.get()
+        }
 
         guard response.success else {
             throw WireGuardClientError.operationFailed(response.error)
@@ -350,8 +557,9 @@ public actor WireGuardClient {
         request.containerIp = containerIP
         request.containerPort = containerPort
 
-        let call = client.publishPort(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/PublishPort") { options in
+            try await client.publishPort(request, callOptions: options).response.get()
+        }
 
         guard response.success else {
             throw WireGuardClientError.operationFailed(response.error)
@@ -382,8 +590,9 @@ public actor WireGuardClient {
         request.`protocol` = proto
         request.hostPort = hostPort
 
-        let call = client.unpublishPort(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/UnpublishPort") { options in
+            try await client.unpublishPort(request, callOptions: options).response.get()
+        }
 
         guard response.success else {
             throw WireGuardClientError.operationFailed(response.error)
@@ -405,8 +614,9 @@ public actor WireGuardClient {
         logger.debug("Dumping nftables ruleset from container")
 
         let request = Arca_Wireguard_V1_DumpNftablesRequest()
-        let call = client.dumpNftables(request)
-        let response = try await call.response.get()
+        let response = try await Tracing.guestCall("wireguard/DumpNftables") { options in
+            try await client.dumpNftables(request, callOptions: options).response.get()
+        }
 
         guard response.success else {
             throw WireGuardClientError.operationFailed(response.error)
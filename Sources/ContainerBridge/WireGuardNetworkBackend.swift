@@ -10,6 +10,7 @@ import IP
 /// - Each network the container joins becomes a peer on that hub
 /// - WireGuard allowed-ips routing handles multi-network scenarios
 /// - All configuration done via gRPC over vsock to WireGuard service in container
+/// - Peer and DNS changes pushed to guests as versioned deltas (NetworkTopologyJournal)
 ///
 /// **Features:**
 /// - Dynamic network attachment (docker network connect/disconnect)
@@ -26,6 +27,7 @@ public actor WireGuardNetworkBackend {
     private let logger: Logger
     private let stateStore: StateStore
     private let getContainer: (String) async throws -> Containerization.LinuxContainer
+    private let getControlChannels: (String) async -> ControlChannelPool?
 
     // WireGuard runtime state (ephemeral - recreated on container start)
     // This state does NOT persist across daemon restarts - it's rebuilt when containers start
@@ -36,8 +38,32 @@ public actor WireGuardNetworkBackend {
     // Track public keys per interface: containerID -> networkID -> publicKey
     private var containerInterfaceKeys: [String: [String: String]] = [:]
 
-    // Container names for DNS resolution (Phase 3.1): containerID -> containerName
-    private var containerNames: [String: String] = [:]
+    // Cached vmnet endpoints (eth0 IP:port) per running container: containerID -> endpoint
+    // Stable for the VM's lifetime; dropped when the container stops or leaves its last network
+    private var containerEndpoints: [String: String] = [:]
+
+    // Versioned peer/DNS membership per network; guests are sent deltas since the version they have
+    private var topology = NetworkTopologyJournal()
+
+    // Delivery round in progress per network (see syncTopology)
+    private var topologyRounds: [String: Task<Void, Never>] = [:]
+
+    // Scheduled retry per network for members whose delta failed, and consecutive failed
+    // rounds (for the backoff); see scheduleTopologyRetry
+    private var topologyRetries: [String: Task<Void, Never>] = [:]
+    private var topologyRetryAttempts: [String: Int] = [:]
+
+    // Guests sent deltas in parallel during a delivery round
+    private static let meshFanOut = 8
+
+    // Retry backoff for failed topology deliveries: doubles from the first delay up to the cap
+    private static let topologyRetryDelay: Double = 0.5
+    private static let topologyRetryMaxDelay: Double = 30
+
+    // Containers starting together (daemon recovery): deltas to members that already have a
+    // topology are held until finishMeshBatch(), so each gets one delta for the whole batch
+    private var meshBatch: Set<String> = []
+    private var batchNetworks: Set<String> = []
 
     // Subnet allocation tracking (simple counter for auto-allocation)
     private var nextSubnetByte: UInt8 = 18  // Start at 172.18.0.0/16
@@ -48,11 +74,13 @@ public actor WireGuardNetworkBackend {
     public init(
         logger: Logger,
         stateStore: StateStore,
-        getContainer: @escaping (String) async throws -> Containerization.LinuxContainer
+        getContainer: @escaping (String) async throws -> Containerization.LinuxContainer,
+        getControlChannels: @escaping (String) async -> ControlChannelPool?
     ) {
         self.logger = logger
         self.stateStore = stateStore
         self.getContainer = getContainer
+        self.getControlChannels = getControlChannels
     }
 
     /// Restore network state from database on daemon startup
@@ -414,8 +442,11 @@ public actor WireGuardNetworkBackend {
         }
 
         // Create WireGuard client for this container
-        let wgClient = WireGuardClient(logger: logger)
-        try await wgClient.connect(container: container, vsockPort: 51820)
+        let wgClient = try await Self.connectClient(
+            channels: await getControlChannels(containerID),
+            container: container,
+            logger: logger
+        )
 
         // Ensure we disconnect when done
         defer {
@@ -503,7 +534,13 @@ public actor WireGuardNetworkBackend {
 
         // Phase 2.4: Configure full mesh with other containers on this network
         // Get this container's vmnet endpoint (vmnet IP:port for WireGuard UDP)
-        let thisEndpoint = try await wgClient.getVmnetEndpoint()
+        let thisEndpoint: String
+        if let cached = containerEndpoints[containerID] {
+            thisEndpoint = cached
+        } else {
+            thisEndpoint = try await wgClient.getVmnetEndpoint()
+            containerEndpoints[containerID] = thisEndpoint
+        }
 
         logger.info("Configuring full mesh for network", metadata: [
             "container_id": "\(containerID)",
@@ -513,141 +550,26 @@ public actor WireGuardNetworkBackend {
             "this_ip": "\(ipAddress)"
         ])
 
-        // Get all OTHER containers already on this network from database
-        let networkAttachments = try await stateStore.loadAttachmentsForNetwork(networkID: networkID)
-        let otherContainerIDs = networkAttachments.map { $0.containerID }.filter { $0 != containerID }
-
-        logger.debug("Found existing containers on network", metadata: [
-            "network_id": "\(networkID)",
-            "count": "\(otherContainerIDs.count)"
-        ])
-
-        // For each existing container on this network:
-        // 1. Add THIS container as a peer to THAT container
-        // 2. Add THAT container as a peer to THIS container
-        for otherContainerID in otherContainerIDs {
-            // Get peer runtime state (WireGuard keys and indices are ephemeral - recreated on start)
-            guard let otherPublicKey = containerInterfaceKeys[otherContainerID]?[networkID],
-                  let otherNetworkIndex = containerNetworkIndices[otherContainerID]?[networkID] else {
-                logger.warning("Skipping peer - missing runtime state (container likely stopped)", metadata: [
-                    "other_container_id": "\(otherContainerID)"
-                ])
-                continue
-            }
-
-            // Get IP address from database
-            guard let otherAttachment = networkAttachments.first(where: { $0.containerID == otherContainerID }) else {
-                continue
-            }
-
-            // Create WireGuard client for peer container
-            let otherContainer: Containerization.LinuxContainer
-            do {
-                otherContainer = try await getContainer(otherContainerID)
-            } catch {
-                logger.error("Failed to get peer container", metadata: [
-                    "peer_container_id": "\(otherContainerID)",
-                    "error": "\(error)"
-                ])
-                continue
-            }
-
-            let otherClient = WireGuardClient(logger: logger)
-            do {
-                try await otherClient.connect(container: otherContainer, vsockPort: 51820)
-            } catch {
-                logger.error("Failed to connect to peer container", metadata: [
-                    "peer_container_id": "\(otherContainerID)",
-                    "error": "\(error)"
-                ])
-                continue
-            }
-
-            // Ensure we disconnect when done
-            defer {
-                Task {
-                    try? await otherClient.disconnect()
-                }
-            }
-
-            // Get the other container's vmnet endpoint
-            let otherEndpoint: String
-            do {
-                otherEndpoint = try await otherClient.getVmnetEndpoint()
-            } catch {
-                logger.error("Failed to get vmnet endpoint from peer container", metadata: [
-                    "peer_container_id": "\(otherContainerID)",
-                    "error": "\(error)"
-                ])
-                continue
-            }
-
-            logger.debug("Configuring peer mesh", metadata: [
-                "container_id": "\(containerID)",
-                "peer_container_id": "\(otherContainerID)",
-                "peer_endpoint": "\(otherEndpoint)",
-                "peer_ip": "\(otherAttachment.ipAddress)"
-            ])
-
-            // Add THIS container as a peer to OTHER container
-            do {
-                let _ = try await otherClient.addPeer(
-                    networkID: networkID,
-                    networkIndex: otherNetworkIndex,
-                    peerPublicKey: result.publicKey,
-                    peerEndpoint: thisEndpoint,
-                    peerIPAddress: ipAddress,
-                    peerName: containerName,
-                    peerContainerID: containerID,
-                    peerAliases: aliases
-                )
-                logger.debug("Added this container as peer to other container (DNS registered)", metadata: [
-                    "this_container": "\(containerID)",
-                    "other_container": "\(otherContainerID)"
-                ])
-            } catch {
-                logger.error("Failed to add this container as peer to other container", metadata: [
-                    "this_container": "\(containerID)",
-                    "other_container": "\(otherContainerID)",
-                    "error": "\(error)"
-                ])
-                // Continue - try to add other peers
-            }
-
-            // Add OTHER container as a peer to THIS container
-            do {
-                // Get other container's name and aliases (stored when it was attached)
-                let otherName = containerNames[otherContainerID] ?? otherContainerID
-                let otherAliases = Array(otherAttachment.aliases.dropLast())  // Drop container name (last element)
-
-                let _ = try await wgClient.addPeer(
-                    networkID: networkID,
-                    networkIndex: networkIndex,
-                    peerPublicKey: otherPublicKey,
-                    peerEndpoint: otherEndpoint,
-                    peerIPAddress: otherAttachment.ipAddress,
-                    peerName: otherName,
-                    peerContainerID: otherContainerID,
-                    peerAliases: otherAliases
-                )
-                logger.debug("Added other container as peer to this container (DNS registered)", metadata: [
-                    "this_container": "\(containerID)",
-                    "other_container": "\(otherContainerID)"
-                ])
-            } catch {
-                logger.error("Failed to add other container as peer to this container", metadata: [
-                    "this_container": "\(containerID)",
-                    "other_container": "\(otherContainerID)",
-                    "error": "\(error)"
-                ])
-                // Continue - try to add other peers
-            }
+        // Publish this interface to the network's topology journal and push the change:
+        // this container gets a full sync of its peers, every other member gets one delta
+        let version = topology.join(networkID: networkID, peer: NetworkTopologyJournal.Peer(
+            containerID: containerID,
+            publicKey: result.publicKey,
+            endpoint: thisEndpoint,
+            ipAddress: ipAddress,
+            name: containerName,
+            aliases: aliases
+        ))
+        if meshBatch.contains(containerID) {
+            batchNetworks.insert(networkID)
         }
+        await syncTopology(networkID: networkID)
 
         logger.info("Full mesh configured for container", metadata: [
             "container_id": "\(containerID)",
             "network_id": "\(networkID)",
-            "total_peers": "\(otherContainerIDs.count)"
+            "topology_version": "\(version)",
+            "pending_guests": "\(topology.pending(networkID: networkID).count)"
         ])
 
         // Create attachment (IP already reserved atomically in database)
@@ -658,9 +580,6 @@ public actor WireGuardNetworkBackend {
             aliases: allAliases
         )
 
-        // Store container name for DNS (Phase 3.1) - still needs in-memory for WireGuard client access
-        containerNames[containerID] = containerName
-
         logger.info("Container attached to WireGuard network", metadata: [
             "container_id": "\(containerID)",
             "network_id": "\(networkID)",
@@ -702,10 +621,11 @@ public actor WireGuardNetworkBackend {
         // If we can't connect, we'll still clean up peer relationships on OTHER containers
         var targetClient: WireGuardClient?
         if let container = try? await getContainer(containerID) {
-            let client = WireGuardClient(logger: logger)
-            if (try? await client.connect(container: container, vsockPort: 51820)) != nil {
-                targetClient = client
-            }
+            targetClient = try? await Self.connectClient(
+                channels: await getControlChannels(containerID),
+                container: container,
+                logger: logger
+            )
         }
 
         // Ensure we disconnect the target client when done
@@ -724,89 +644,22 @@ public actor WireGuardNetworkBackend {
             ])
         }
 
-        // ALWAYS try to remove this container as a peer from other containers
+        // ALWAYS remove this container as a peer from other containers
         // This ensures mesh consistency even if target container is unreachable
         if let networkIndex = networkIndex,
-           let thisPublicKey = containerInterfaceKeys[containerID]?[networkID] {
-
-            // Get all OTHER containers on this network from database
-            let networkContainers = try await stateStore.getNetworkContainers(networkID: networkID)
-            let otherContainerIDs = networkContainers.filter { $0 != containerID }
-
-            logger.debug("Removing this container as peer from other containers", metadata: [
-                "container_id": "\(containerID)",
-                "network_id": "\(networkID)",
-                "peer_count": "\(otherContainerIDs.count)"
-            ])
-
-            // Remove this container as a peer from each other container
-            for otherContainerID in otherContainerIDs {
-                guard let otherNetworkIndex = containerNetworkIndices[otherContainerID]?[networkID] else {
-                    logger.warning("Skipping peer removal - missing metadata", metadata: [
-                        "other_container_id": "\(otherContainerID)"
-                    ])
-                    continue
-                }
+           containerInterfaceKeys[containerID]?[networkID] != nil {
 
-                // Get peer container
-                let otherContainer: Containerization.LinuxContainer
-                do {
-                    otherContainer = try await getContainer(otherContainerID)
-                } catch {
-                    logger.error("Failed to get peer container for removal", metadata: [
-                        "peer_container_id": "\(otherContainerID)",
-                        "error": "\(error)"
-                    ])
-                    continue
-                }
-
-                // Create WireGuard client for peer
-                let otherClient = WireGuardClient(logger: logger)
-                do {
-                    try await otherClient.connect(container: otherContainer, vsockPort: 51820)
-                } catch {
-                    logger.error("Failed to connect to peer for removal", metadata: [
-                        "peer_container_id": "\(otherContainerID)",
-                        "error": "\(error)"
-                    ])
-                    continue
-                }
-
-                // Ensure we disconnect when done
-                defer {
-                    Task {
-                        try? await otherClient.disconnect()
-                    }
-                }
-
-                do {
-                    // Get this container's name for DNS entry removal
-                    let thisName = containerNames[containerID] ?? containerID
-
-                    let _ = try await otherClient.removePeer(
-                        networkID: networkID,
-                        networkIndex: otherNetworkIndex,
-                        peerPublicKey: thisPublicKey,
-                        peerName: thisName
-                    )
-                    logger.debug("Removed this container as peer from other container (DNS unregistered)", metadata: [
-                        "this_container": "\(containerID)",
-                        "other_container": "\(otherContainerID)"
-                    ])
-                } catch {
-                    logger.error("Failed to remove this container as peer from other container", metadata: [
-                        "this_container": "\(containerID)",
-                        "other_container": "\(otherContainerID)",
-                        "error": "\(error)"
-                    ])
-                    // Continue - try to remove from other peers
-                }
+            // Other members drop this container's peer and DNS record with their next delta
+            let version = topology.leave(networkID: networkID, containerID: containerID)
+            if version != nil {
+                await syncTopology(networkID: networkID)
             }
 
             logger.info("Peer cleanup completed", metadata: [
                 "container_id": "\(containerID)",
                 "network_id": "\(networkID)",
-                "peers_cleaned": "\(otherContainerIDs.count)"
+                "topology_version": "\(version ?? 0)",
+                "pending_guests": "\(topology.pending(networkID: networkID).count)"
             ])
 
             // Remove network interface (wgN/ethN) from target container if we have a client
@@ -837,7 +690,7 @@ public actor WireGuardNetworkBackend {
 
                 containerNetworkIndices.removeValue(forKey: containerID)
                 containerInterfaceKeys.removeValue(forKey: containerID)
-                containerNames.removeValue(forKey: containerID)  // Phase 3.1: Clean up DNS name
+                containerEndpoints.removeValue(forKey: containerID)
             } else {
                 containerNetworkIndices[containerID] = updatedIndices
 
@@ -968,11 +821,289 @@ public actor WireGuardNetworkBackend {
             "container_id": "\(containerID)"
         ])
 
-        // Note: We don't cache WireGuard clients, so nothing to clean up here.
+        // The VM gets a new vmnet address when it restarts
+        containerEndpoints.removeValue(forKey: containerID)
+
+        // Its guest is gone: stop pushing deltas until it rejoins with a new interface
+        topology.suspend(containerID: containerID)
+
+        // Note: We don't cache WireGuard clients, so nothing else to clean up here.
         // The container is still "attached" to networks metadata-wise, just stopped.
         // When it restarts, we'll recreate the WireGuard hub with same IPs.
     }
 
+    // MARK: - Mesh Batches
+
+    /// Hold topology deltas to `containerIDs` until finishMeshBatch()
+    /// Each member still gets its full sync when it attaches, and containers outside the batch
+    /// still get every change as it happens, so anything already running is reachable
+    /// immediately in both directions.
+    public func beginMeshBatch(containerIDs: Set<String>) {
+        meshBatch = containerIDs
+        batchNetworks = []
+    }
+
+    /// Push the held deltas: one per batch member and network, covering every member that
+    /// joined after it
+    public func finishMeshBatch() async {
+        let networks = batchNetworks
+        meshBatch = []
+        batchNetworks = []
+
+        await withTaskGroup(of: Void.self) { group in
+            for networkID in networks {
+                group.addTask { await self.syncTopology(networkID: networkID) }
+            }
+        }
+
+        logger.info("Mesh batch configured", metadata: [
+            "networks": "\(networks.count)"
+        ])
+    }
+
+    // MARK: - Topology Delivery
+
+    /// Push a network's topology to every member whose guest is behind, and wait for it
+    ///
+    /// At most one delivery round runs per network. A round that is already running may have
+    /// taken its deltas before the caller's change, so the caller waits for it and then joins
+    /// the next round, which carries every change made in the meantime. Concurrent joins
+    /// therefore coalesce into one delta per member instead of one RPC per peer per join.
+    private func syncTopology(networkID: String) async {
+        if let running = topologyRounds[networkID] {
+            await running.value
+        }
+        // A round started while we waited took its deltas after our change
+        if let running = topologyRounds[networkID] {
+            await running.value
+            return
+        }
+        guard !topology.pending(networkID: networkID).isEmpty else { return }
+
+        let round = Task { await self.deliverTopology(networkID: networkID) }
+        topologyRounds[networkID] = round
+        await round.value
+    }
+
+    /// One delivery round: take every pending member's delta, then send them in parallel
+    private func deliverTopology(networkID: String) async {
+        defer { topologyRounds[networkID] = nil }
+
+        // Deltas are taken before the first suspension point, so the round covers every
+        // change recorded before it started
+        var deltas: [(containerID: String, networkIndex: UInt32, delta: NetworkTopologyJournal.Delta)] = []
+        for containerID in topology.pending(networkID: networkID) {
+            guard let delta = topology.delta(networkID: networkID, for: containerID),
+                  let networkIndex = containerNetworkIndices[containerID]?[networkID] else {
+                continue
+            }
+            // Held until finishMeshBatch(), unless this is the member's first sync
+            if meshBatch.contains(containerID) && !delta.fullSync {
+                continue
+            }
+            deltas.append((containerID, networkIndex, delta))
+        }
+
+        var failed = 0
+        defer {
+            if failed > 0 {
+                scheduleTopologyRetry(networkID: networkID)
+            } else {
+                topologyRetryAttempts[networkID] = nil
+            }
+        }
+
+        var targets: [TopologyTarget] = []
+        for entry in deltas {
+            do {
+                targets.append(TopologyTarget(
+                    containerID: entry.containerID,
+                    container: try await getContainer(entry.containerID),
+                    channels: await getControlChannels(entry.containerID),
+                    networkID: networkID,
+                    networkIndex: entry.networkIndex,
+                    delta: entry.delta
+                ))
+            } catch {
+                failed += 1
+                logger.error("Failed to get container for topology delta", metadata: [
+                    "container_id": "\(entry.containerID)",
+                    "network_id": "\(networkID)",
+                    "error": "\(error)"
+                ])
+            }
+        }
+        guard !targets.isEmpty else { return }
+
+        var results = await Self.deliver(targets, logger: logger)
+
+        // Guests that lost track of the topology (e.g. interface recreated) get one full sync
+        var resync: [TopologyTarget] = []
+        for (target, outcome) in zip(targets, results) where outcome == .resyncRequired {
+            topology.resync(networkID: networkID, containerID: target.containerID)
+            if let delta = topology.delta(networkID: networkID, for: target.containerID) {
+                resync.append(target.with(delta: delta))
+            }
+        }
+        if !resync.isEmpty {
+            targets += resync
+            results += await Self.deliver(resync, logger: logger)
+        }
+
+        var applied = 0
+        for (target, outcome) in zip(targets, results) {
+            if case .applied(let version) = outcome {
+                topology.acknowledge(
+                    networkID: networkID,
+                    containerID: target.containerID,
+                    subscriberKey: target.delta.subscriberKey,
+                    version: version
+                )
+                applied += 1
+            }
+        }
+        // A target that needed a resync is counted by its resync outcome
+        failed += zip(targets, results).filter { $0.1 == .failed }.count
+
+
+        logger.debug("Topology delivered", metadata: [
+            "network_id": "\(networkID)",
+            "version": "\(topology.version(networkID: networkID))",
+            "guests": "\(deltas.count)",
+            "applied": "\(applied)",
+            "resynced": "\(resync.count)",
+            "failed": "\(failed)"
+        ])
+    }
+
+    /// Retry a network's delivery after a round in which some member's delta failed
+    ///
+    /// Failed members stay pending, and without a retry they would only catch up with the
+    /// network's next change. The delay doubles with each consecutive failed round, up to
+    /// `topologyRetryMaxDelay`. A round with no failures resets it. Retries stop once no
+    /// member is pending, for example when the failing container stops or leaves.
+    private func scheduleTopologyRetry(networkID: String) {
+        guard topologyRetries[networkID] == nil else { return }
+
+        let attempt = topologyRetryAttempts[networkID, default: 0]
+        topologyRetryAttempts[networkID] = attempt + 1
+        let delay = min(Self.topologyRetryDelay * pow(2, Double(min(attempt, 16))), Self.topologyRetryMaxDelay)
+
+        logger.debug("Scheduling topology delivery retry", metadata: [
+            "network_id": "\(networkID)",
+            "attempt": "\(attempt + 1)",
+            "delay_seconds": "\(delay)"
+        ])
+
+        topologyRetries[networkID] = Task { [weak self] in
+            try? await Task.sleep(for: .seconds(delay))
+            await self?.retryTopology(networkID: networkID)
+        }
+    }
+
+    private func retryTopology(networkID: String) async {
+        topologyRetries[networkID] = nil
+        await syncTopology(networkID: networkID)
+    }
+
+    /// A member's guest and the delta it needs
+    private struct TopologyTarget: Sendable {
+        let containerID: String
+        let container: Containerization.LinuxContainer
+        let channels: ControlChannelPool?
+        let networkID: String
+        let networkIndex: UInt32
+        let delta: NetworkTopologyJournal.Delta
+
+        func with(delta: NetworkTopologyJournal.Delta) -> TopologyTarget {
+            TopologyTarget(
+                containerID: containerID,
+                container: container,
+                channels: channels,
+                networkID: networkID,
+                networkIndex: networkIndex,
+                delta: delta
+            )
+        }
+    }
+
+    private enum DeliveryOutcome: Sendable, Equatable {
+        case applied(UInt64)
+        case resyncRequired
+        case failed
+    }
+
+    /// One ApplyTopologyDelta per target with bounded concurrency
+    /// - Returns: Outcome per target, in target order
+    private static func deliver(_ targets: [TopologyTarget], logger: Logger) async -> [DeliveryOutcome] {
+        await withTaskGroup(of: (Int, DeliveryOutcome).self) { group in
+            var outcomes = [DeliveryOutcome](repeating: .failed, count: targets.count)
+            var next = 0
+
+            while next < min(targets.count, meshFanOut) {
+                let index = next
+                group.addTask { (index, await deliver(targets[index], logger: logger)) }
+                next += 1
+            }
+
+            while let result = await group.next() {
+                outcomes[result.0] = result.1
+                if next < targets.count {
+                    let index = next
+                    group.addTask { (index, await deliver(targets[index], logger: logger)) }
+                    next += 1
+                }
+            }
+            return outcomes
+        }
+    }
+
+    private static func deliver(_ target: TopologyTarget, logger: Logger) async -> DeliveryOutcome {
+        do {
+            let client = try await connectClient(channels: target.channels, container: target.container, logger: logger)
+            defer {
+                Task {
+                    try? await client.disconnect()
+                }
+            }
+            guard let version = try await client.applyTopologyDelta(
+                networkID: target.networkID,
+                networkIndex: target.networkIndex,
+                delta: target.delta
+            ) else {
+                return .resyncRequired
+            }
+            return .applied(version)
+        } catch {
+            // Left pending; the round schedules a retry, which sends everything it missed
+            logger.error("Failed to apply topology delta", metadata: [
+                "container_id": "\(target.containerID)",
+                "network_id": "\(target.networkID)",
+                "version": "\(target.delta.version)",
+                "error": "\(error)"
+            ])
+            return .failed
+        }
+    }
+
+    // MARK: - Guest Connections
+
+    /// WireGuard client over the container's persistent control channel
+    /// Dials a private connection when the container has no pool (e.g. not yet registered)
+    private static func connectClient(
+        channels: ControlChannelPool?,
+        container: Containerization.LinuxContainer,
+        logger: Logger
+    ) async throws -> WireGuardClient {
+        let client = WireGuardClient(logger: logger)
+        if let channels = channels {
+            try await client.connect(channels: channels)
+        } else {
+            try await client.connect(container: container, vsockPort: 51820)
+        }
+        return client
+    }
+
     // MARK: - Helper Methods
 
     /// Load NetworkMetadata from database
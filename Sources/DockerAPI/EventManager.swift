@@ -4,23 +4,59 @@ import ContainerBridge
 
 /// Manages Docker events - broadcasts to subscribers and stores recent history
 /// Thread-safe via actor isolation
+///
+/// History lives in a fixed-size ring of sequence-numbered events, so emit never shifts the
+/// buffer and `since` replays start from a binary search instead of a full scan. Subscribers are
+/// indexed by the event type and actor they can possibly match, so an emit only evaluates the
+/// filters of plausible candidates. Delivery is a non-blocking yield into each subscriber's
+/// bounded stream; a watcher that falls too far behind is disconnected rather than slowing the
+/// emitter or growing without bound (clients reconnect with `since` to catch up).
 public actor EventManager: EventEmitter {
     private let logger: Logger
 
     /// Recent events buffer (for `since` parameter support)
-    /// Stores last 1000 events
-    private var recentEvents: [EventMessage] = []
-    private let maxRecentEvents = 1000
+    private var history: RingBuffer<SequencedEvent>
+    private var nextSequence: UInt64 = 1
 
     /// Active event subscribers
     private var subscribers: [UUID: EventSubscriber] = [:]
 
+    /// Subscriber candidates by what their filters can match
+    private var index = SubscriberIndex()
+
+    /// Subscribers with an `until` bound, checked on every emit so they finish even when
+    /// nothing they match is emitted
+    private var boundedSubscribers: Set<UUID> = []
+
+    /// Maximum events queued for one subscriber before it is disconnected
+    private let subscriberBufferSize: Int
+
+    /// Deepest subscriber queue seen by the latest emit, and subscribers dropped for lagging
+    private var queueDepth = 0
+    private var disconnectedSubscribers: UInt64 = 0
+
+    /// Event bus counters for the metrics endpoint
+    public struct Stats: Sendable {
+        public let subscribers: Int
+        public let history: Int
+        public let emitted: UInt64
+        /// Events queued for the furthest-behind subscriber as of the latest emit
+        public let queueDepth: Int
+        public let disconnectedSubscribers: UInt64
+    }
+
+    private struct SequencedEvent {
+        let sequence: UInt64
+        let event: EventMessage
+    }
+
     /// Event subscriber
     private struct EventSubscriber {
         let id: UUID
         let continuation: AsyncStream<EventMessage>.Continuation
         let filters: EventFilters?
         let until: Date?
+        let route: SubscriberIndex.Route
 
         func matches(_ event: EventMessage) -> Bool {
             // Check until timestamp
@@ -40,54 +76,89 @@ public actor EventManager: EventEmitter {
         }
     }
 
-    public init(logger: Logger) {
+    /// - Parameters:
+    ///   - historySize: Events retained for `since` replays
+    ///   - subscriberBufferSize: Events queued per subscriber before it is disconnected
+    public init(logger: Logger, historySize: Int = 1000, subscriberBufferSize: Int = 4096) {
         self.logger = logger
+        self.history = RingBuffer(capacity: max(historySize, 1))
+        self.subscriberBufferSize = max(subscriberBufferSize, 1)
     }
 
     /// Emit an event to all subscribers and store in recent history
     public func emit(_ event: EventMessage) {
-        // Add to recent events buffer
-        recentEvents.append(event)
-        if recentEvents.count > maxRecentEvents {
-            recentEvents.removeFirst(recentEvents.count - maxRecentEvents)
-        }
+        let sequence = nextSequence
+        nextSequence += 1
+        history.append(SequencedEvent(sequence: sequence, event: event))
 
         logger.debug("Event emitted", metadata: [
             "type": "\(event.type)",
             "action": "\(event.action)",
             "id": "\(event.actor.id.prefix(12))",
+            "sequence": "\(sequence)",
             "subscribers": "\(subscribers.count)"
         ])
 
-        // Broadcast to subscribers
-        var completedSubscribers: [UUID] = []
-        for (id, subscriber) in subscribers {
-            // Check if event matches subscriber's filters
-            guard subscriber.matches(event) else {
-                continue
-            }
+        guard !subscribers.isEmpty else {
+            queueDepth = 0
+            return
+        }
 
-            // Check if we've reached the until timestamp
-            if let until = subscriber.until {
-                let eventTime = Date(timeIntervalSince1970: TimeInterval(event.time))
-                if eventTime >= until {
-                    // Stop streaming - reached until timestamp
-                    subscriber.continuation.finish()
+        // Stop streams that have reached their until timestamp
+        var completedSubscribers: [UUID] = []
+        if !boundedSubscribers.isEmpty {
+            let eventTime = Date(timeIntervalSince1970: TimeInterval(event.time))
+            for id in boundedSubscribers {
+                if let until = subscribers[id]?.until, eventTime >= until {
                     completedSubscribers.append(id)
-                    continue
                 }
             }
+        }
+        for id in completedSubscribers {
+            subscribers[id]?.continuation.finish()
+            removeSubscriber(id: id)
+        }
 
-            // Send event to subscriber
-            subscriber.continuation.yield(event)
+        // Broadcast to candidate subscribers
+        let capacity = subscriberBufferSize + history.capacity
+        var laggingSubscribers: [UUID] = []
+        var deepest = 0
+        for id in index.candidates(for: event) {
+            guard let subscriber = subscribers[id], subscriber.matches(event) else {
+                continue
+            }
+            switch subscriber.continuation.yield(event) {
+            case .enqueued(let remaining):
+                deepest = max(deepest, capacity - remaining)
+            case .dropped:
+                laggingSubscribers.append(id)
+            default:
+                break
+            }
         }
+        queueDepth = deepest
+        disconnectedSubscribers += UInt64(laggingSubscribers.count)
 
-        // Remove completed subscribers
-        for id in completedSubscribers {
-            subscribers.removeValue(forKey: id)
+        for id in laggingSubscribers {
+            logger.warning("Event subscriber fell behind, disconnecting", metadata: [
+                "id": "\(id)",
+                "buffer_size": "\(subscriberBufferSize)"
+            ])
+            subscribers[id]?.continuation.finish()
+            removeSubscriber(id: id)
         }
     }
 
+    public func stats() -> Stats {
+        Stats(
+            subscribers: subscribers.count,
+            history: history.count,
+            emitted: nextSequence - 1,
+            queueDepth: queueDepth,
+            disconnectedSubscribers: disconnectedSubscribers
+        )
+    }
+
     /// Subscribe to events
     /// - Parameters:
     ///   - since: Only return events since this timestamp
@@ -101,49 +172,78 @@ public actor EventManager: EventEmitter {
     ) -> AsyncStream<EventMessage> {
         let id = UUID()
 
-        return AsyncStream { continuation in
-            // Send historical events if `since` is specified
-            if let since = since {
-                let sinceTimestamp = Int64(since.timeIntervalSince1970)
-                for event in recentEvents {
-                    if event.time >= sinceTimestamp {
-                        // Check filters
-                        if let filters = filters, !filters.matches(event) {
-                            continue
-                        }
-                        continuation.yield(event)
-                    }
+        // The replay must fit in the buffer alongside live events
+        let (stream, continuation) = AsyncStream.makeStream(
+            of: EventMessage.self,
+            bufferingPolicy: .bufferingOldest(subscriberBufferSize + history.capacity)
+        )
+
+        // Send historical events if `since` is specified
+        if let since = since {
+            let sinceTimestamp = Int64(since.timeIntervalSince1970)
+            let untilTimestamp = until.map { Int64($0.timeIntervalSince1970) }
+            var offset = firstHistoryOffset(atOrAfter: sinceTimestamp)
+            while offset < history.count {
+                let event = history[offset].event
+                offset += 1
+                if let untilTimestamp = untilTimestamp, event.time > untilTimestamp {
+                    break
+                }
+                if let filters = filters, !filters.matches(event) {
+                    continue
                 }
+                continuation.yield(event)
             }
+        }
 
-            // Check if we should stop immediately (until in the past)
-            if let until = until, until < Date() {
-                continuation.finish()
-                return
-            }
+        // Check if we should stop immediately (until in the past)
+        if let until = until, until < Date() {
+            continuation.finish()
+            return stream
+        }
 
-            // Register subscriber for future events
-            let subscriber = EventSubscriber(
-                id: id,
-                continuation: continuation,
-                filters: filters,
-                until: until
-            )
+        // Register before returning so no event emitted after the replay is missed
+        let subscriber = EventSubscriber(
+            id: id,
+            continuation: continuation,
+            filters: filters,
+            until: until,
+            route: SubscriberIndex.Route(filters)
+        )
+        addSubscriber(id: id, subscriber: subscriber)
 
+        continuation.onTermination = { _ in
             Task { [weak self] in
-                await self?.addSubscriber(id: id, subscriber: subscriber)
+                await self?.removeSubscriber(id: id)
             }
+        }
 
-            continuation.onTermination = { _ in
-                Task { [weak self] in
-                    await self?.removeSubscriber(id: id)
-                }
+        return stream
+    }
+
+    /// Offset of the oldest retained event at or after `timestamp` (history.count if none)
+    ///
+    /// History is in emit order, which is time order barring a backwards wall-clock step.
+    private func firstHistoryOffset(atOrAfter timestamp: Int64) -> Int {
+        var low = 0
+        var high = history.count
+        while low < high {
+            let mid = (low + high) / 2
+            if history[mid].event.time < timestamp {
+                low = mid + 1
+            } else {
+                high = mid
             }
         }
+        return low
     }
 
     private func addSubscriber(id: UUID, subscriber: EventSubscriber) {
         subscribers[id] = subscriber
+        index.insert(id, route: subscriber.route)
+        if subscriber.until != nil {
+            boundedSubscribers.insert(id)
+        }
         logger.debug("Event subscriber added", metadata: [
             "id": "\(id)",
             "total_subscribers": "\(subscribers.count)"
@@ -151,7 +251,9 @@ public actor EventManager: EventEmitter {
     }
 
     private func removeSubscriber(id: UUID) {
-        subscribers.removeValue(forKey: id)
+        guard let subscriber = subscribers.removeValue(forKey: id) else { return }
+        index.remove(id, route: subscriber.route)
+        boundedSubscribers.remove(id)
         logger.debug("Event subscriber removed", metadata: [
             "id": "\(id)",
             "total_subscribers": "\(subscribers.count)"
@@ -202,3 +304,131 @@ public actor EventManager: EventEmitter {
         emit(event)
     }
 }
+
+/// Subscribers grouped by the events their filters can possibly match
+///
+/// Each subscriber's filters are compiled once into a route: everything, a set of event types,
+/// or specific actors of one type (by name or ID prefix). `candidates(for:)` returns a superset
+/// of the matching subscribers; the full filter is still evaluated on each candidate.
+struct SubscriberIndex {
+    enum Route: Equatable {
+        case all
+        case types(Set<String>)
+        case actors(type: String, keys: Set<String>)
+        case unmatchable  // Filters that no event can satisfy (e.g. a container and an image filter)
+
+        init(_ filters: EventFilters?) {
+            guard let filters = filters else {
+                self = .all
+                return
+            }
+
+            let actorFilters = [
+                ("container", filters.container),
+                ("image", filters.image),
+                ("network", filters.network),
+                ("volume", filters.volume)
+            ].compactMap { type, values -> (String, [String])? in
+                guard let values = values, !values.isEmpty else { return nil }
+                return (type, values)
+            }
+            let types = filters.type.flatMap { $0.isEmpty ? nil : Set($0) }
+
+            switch actorFilters.count {
+            case 0:
+                self = types.map { .types($0) } ?? .all
+            case 1:
+                let (type, values) = actorFilters[0]
+                if let types = types, !types.contains(type) {
+                    self = .unmatchable
+                } else {
+                    self = .actors(type: type, keys: Set(values))
+                }
+            default:
+                // Each actor filter requires its own event type
+                self = .unmatchable
+            }
+        }
+    }
+
+    /// Actor filter values for one event type
+    private struct ActorIndex {
+        var keys: [String: Set<UUID>] = [:]
+        var keyLengths: [Int: Int] = [:]  // Filter length -> number of keys, for ID prefix lookups
+    }
+
+    private var all: Set<UUID> = []
+    private var byType: [String: Set<UUID>] = [:]
+    private var byActor: [String: ActorIndex] = [:]
+
+    mutating func insert(_ id: UUID, route: Route) {
+        switch route {
+        case .all:
+            all.insert(id)
+        case .types(let types):
+            for type in types {
+                byType[type, default: []].insert(id)
+            }
+        case .actors(let type, let keys):
+            var actors = byActor[type] ?? ActorIndex()
+            for key in keys {
+                if actors.keys[key, default: []].insert(id).inserted, actors.keys[key]?.count == 1 {
+                    actors.keyLengths[key.count, default: 0] += 1
+                }
+            }
+            byActor[type] = actors
+        case .unmatchable:
+            break
+        }
+    }
+
+    mutating func remove(_ id: UUID, route: Route) {
+        switch route {
+        case .all:
+            all.remove(id)
+        case .types(let types):
+            for type in types {
+                byType[type]?.remove(id)
+                if byType[type]?.isEmpty == true {
+                    byType.removeValue(forKey: type)
+                }
+            }
+        case .actors(let type, let keys):
+            guard var actors = byActor[type] else { return }
+            for key in keys {
+                guard actors.keys[key]?.remove(id) != nil, actors.keys[key]?.isEmpty == true else { continue }
+                actors.keys.removeValue(forKey: key)
+                actors.keyLengths[key.count, default: 1] -= 1
+                if actors.keyLengths[key.count] == 0 {
+                    actors.keyLengths.removeValue(forKey: key.count)
+                }
+            }
+            byActor[type] = actors.keys.isEmpty ? nil : actors
+        case .unmatchable:
+            break
+        }
+    }
+
+    /// Subscribers that might match `event`
+    func candidates(for event: EventMessage) -> [UUID] {
+        var result = Array(all)
+        if let typed = byType[event.type] {
+            result.append(contentsOf: typed)
+        }
+
+        if let actors = byActor[event.type] {
+            // A subscriber can hit through both its name and ID keys; report it once
+            var hits: Set<UUID> = []
+            if let name = event.actor.attributes["name"], let ids = actors.keys[name] {
+                hits.formUnion(ids)
+            }
+            for length in actors.keyLengths.keys where length <= event.actor.id.count {
+                if let ids = actors.keys[String(event.actor.id.prefix(length))] {
+                    hits.formUnion(ids)
+                }
+            }
+            result.append(contentsOf: hits)
+        }
+        return result
+    }
+}
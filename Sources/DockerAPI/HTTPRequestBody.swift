@@ -0,0 +1,151 @@
+import Foundation
+import NIOCore
+
+/// Streaming HTTP request body
+///
+/// Routes registered with `streamingBody: true` receive their body as an `AsyncSequence`
+/// of `ByteBuffer`s instead of a fully buffered `Data`. Chunks are delivered as they
+/// arrive from the socket, and the connection stops reading when the consumer falls
+/// behind (high/low watermark backpressure), so large uploads use constant memory.
+///
+/// The sequence supports a single iterator. If the connection drops before the request
+/// ends, iteration throws `HTTPRequestBodyError.connectionClosed` so consumers never
+/// mistake a truncated upload for a complete one.
+public struct HTTPRequestBody: AsyncSequence, Sendable {
+    public typealias Element = ByteBuffer
+
+    typealias Producer = NIOThrowingAsyncSequenceProducer<
+        ByteBuffer,
+        Error,
+        NIOAsyncSequenceProducerBackPressureStrategies.HighLowWatermark,
+        HTTPRequestBodyDelegate
+    >
+
+    /// Source used by the HTTP layer to feed body chunks into the sequence
+    public typealias Source = NIOThrowingAsyncSequenceProducer<
+        ByteBuffer,
+        Error,
+        NIOAsyncSequenceProducerBackPressureStrategies.HighLowWatermark,
+        HTTPRequestBodyDelegate
+    >.Source
+
+    private let producer: Producer
+
+    /// Declared Content-Length of the body, if the client sent one
+    public let expectedLength: Int?
+
+    private init(producer: Producer, expectedLength: Int?) {
+        self.producer = producer
+        self.expectedLength = expectedLength
+    }
+
+    /// Create a body sequence and the source that feeds it
+    /// - Parameters:
+    ///   - expectedLength: Declared Content-Length, if known
+    ///   - lowWatermark: Buffered chunk count below which reading resumes
+    ///   - highWatermark: Buffered chunk count above which reading pauses
+    ///   - onProduceMore: Called when the consumer wants more data (resume reading)
+    ///   - onTerminate: Called when the consumer stops iterating or the sequence finishes
+    public static func makeStream(
+        expectedLength: Int?,
+        lowWatermark: Int = 2,
+        highWatermark: Int = 8,
+        onProduceMore: @escaping @Sendable () -> Void,
+        onTerminate: @escaping @Sendable () -> Void
+    ) -> (body: HTTPRequestBody, source: Source) {
+        let result = Producer.makeSequence(
+            elementType: ByteBuffer.self,
+            failureType: Error.self,
+            backPressureStrategy: .init(lowWatermark: lowWatermark, highWatermark: highWatermark),
+            finishOnDeinit: false,
+            delegate: HTTPRequestBodyDelegate(onProduceMore: onProduceMore, onTerminate: onTerminate)
+        )
+        return (HTTPRequestBody(producer: result.sequence, expectedLength: expectedLength), result.source)
+    }
+
+    public struct AsyncIterator: AsyncIteratorProtocol {
+        var base: Producer.AsyncIterator
+
+        public mutating func next() async throws -> ByteBuffer? {
+            return try await base.next()
+        }
+    }
+
+    public func makeAsyncIterator() -> AsyncIterator {
+        return AsyncIterator(base: producer.makeAsyncIterator())
+    }
+
+    // MARK: - Convenience Consumers
+
+    /// Collect the whole body into memory
+    /// Use only for bodies that are known to be small or that must be materialized anyway
+    /// - Parameter maxBytes: Maximum number of bytes to accept before failing
+    public func collect(upTo maxBytes: Int) async throws -> Data {
+        var data = Data()
+        if let expectedLength = expectedLength, expectedLength <= maxBytes {
+            data.reserveCapacity(expectedLength)
+        }
+
+        for try await buffer in self {
+            guard data.count + buffer.readableBytes <= maxBytes else {
+                throw HTTPRequestBodyError.tooLarge(limit: maxBytes)
+            }
+            data.append(contentsOf: buffer.readableBytesView)
+        }
+        return data
+    }
+
+    /// Write the body to a file as it arrives
+    /// - Parameter url: Destination file (created or truncated)
+    /// - Returns: Number of bytes written
+    @discardableResult
+    public func write(to url: URL) async throws -> Int {
+        guard FileManager.default.createFile(atPath: url.path, contents: nil) else {
+            throw HTTPRequestBodyError.fileCreationFailed(url.path)
+        }
+
+        let handle = try FileHandle(forWritingTo: url)
+        defer { try? handle.close() }
+
+        var written = 0
+        for try await buffer in self {
+            try buffer.withUnsafeReadableBytes { bytes in
+                try handle.write(contentsOf: bytes)
+            }
+            written += buffer.readableBytes
+        }
+        return written
+    }
+}
+
+/// Backpressure delegate bridging the body sequence to the connection's read state
+public struct HTTPRequestBodyDelegate: NIOAsyncSequenceProducerDelegate {
+    let onProduceMore: @Sendable () -> Void
+    let onTerminate: @Sendable () -> Void
+
+    public func produceMore() {
+        onProduceMore()
+    }
+
+    public func didTerminate() {
+        onTerminate()
+    }
+}
+
+/// Errors surfaced while consuming a streaming request body
+public enum HTTPRequestBodyError: Error, CustomStringConvertible {
+    case connectionClosed
+    case tooLarge(limit: Int)
+    case fileCreationFailed(String)
+
+    public var description: String {
+        switch self {
+        case .connectionClosed:
+            return "Connection closed before request body was complete"
+        case .tooLarge(let limit):
+            return "Request body exceeds limit of \(limit) bytes"
+        case .fileCreationFailed(let path):
+            return "Failed to create file for request body: \(path)"
+        }
+    }
+}
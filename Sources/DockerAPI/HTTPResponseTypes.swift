@@ -53,6 +53,14 @@ public struct HTTPResponse: Sendable {
         return HTTPResponse(status: status, headers: headers, body: data)
     }
 
+    /// Create a JSON response from an already encoded body
+    public static func json(encoded data: Data, status: HTTPResponseStatus = .ok) -> HTTPResponse {
+        var headers = HTTPHeaders()
+        headers.add(name: "Content-Type", value: "application/json")
+        headers.add(name: "Content-Length", value: "\(data.count)")
+        return HTTPResponse(status: status, headers: headers, body: data)
+    }
+
     /// Create a plain text response
     public static func text(_ text: String, status: HTTPResponseStatus = .ok) -> HTTPResponse {
         let data = Data(text.utf8)
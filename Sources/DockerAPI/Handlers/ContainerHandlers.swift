@@ -26,12 +26,15 @@ public struct ContainerHandlers: Sendable {
     private let containerManager: ContainerBridge.ContainerManager
     private let imageManager: ImageManager
     private let execManager: ExecManager
+    private let statsSampler: StatsSampler
     private let logger: Logger
+    private let responseCache = ContainerResponseCache()
 
-    public init(containerManager: ContainerBridge.ContainerManager, imageManager: ImageManager, execManager: ExecManager, logger: Logger) {
+    public init(containerManager: ContainerBridge.ContainerManager, imageManager: ImageManager, execManager: ExecManager, statsSampler: StatsSampler, logger: Logger) {
         self.containerManager = containerManager
         self.imageManager = imageManager
         self.execManager = execManager
+        self.statsSampler = statsSampler
         self.logger = logger
     }
 
@@ -77,29 +80,7 @@ public struct ContainerHandlers: Sendable {
             }
 
             // Convert to Docker API format
-            let dockerContainers = containers.map { summary in
-                ContainerListItem(
-                    id: summary.id,
-                    names: summary.names,
-                    image: summary.image,
-                    imageID: summary.imageID,
-                    command: summary.command,
-                    created: summary.created,
-                    state: summary.state,
-                    status: summary.status,
-                    ports: summary.ports.map { port in
-                        Port(
-                            privatePort: port.privatePort,
-                            publicPort: port.publicPort,
-                            type: port.type,
-                            ip: port.ip
-                        )
-                    },
-                    labels: summary.labels,
-                    sizeRw: size ? summary.sizeRw : nil,
-                    sizeRootFs: size ? summary.sizeRootFs : nil
-                )
-            }
+            let dockerContainers = containers.map { listItem(from: $0, size: size) }
 
             logger.info("Listed containers", metadata: [
                 "count": "\(dockerContainers.count)"
@@ -115,6 +96,93 @@ public struct ContainerHandlers: Sendable {
         }
     }
 
+    /// Handle GET /containers/json, returning the encoded JSON array
+    /// Items of containers unchanged since the last request are reused from the response
+    /// cache instead of being converted and encoded again.
+    public func handleListContainersEncoded(all: Bool = false, limit: Int? = nil, size: Bool = false, filters: [String: [String]] = [:]) async -> Result<Data, Error> {
+        logger.debug("Handling list containers request", metadata: [
+            "all": "\(all)",
+            "limit": "\(limit?.description ?? "none")",
+            "size": "\(size)",
+            "filters": "\(filters)"
+        ])
+
+        do {
+            var containers = try await containerManager.listContainers(all: all, filters: filters)
+
+            if let limit = limit, limit > 0 {
+                containers = Array(containers.prefix(limit))
+            }
+
+            let encoder = Self.makeEncoder()
+            var body = Data("[".utf8)
+            var encodedCount = 0
+            for (index, summary) in containers.enumerated() {
+                if index > 0 {
+                    body.append(UInt8(ascii: ","))
+                }
+                // Status text depends on the clock, so it is part of the key
+                let variant = "\(size ? 1 : 0)\(summary.status)"
+                if let cached = responseCache.lookup(.summary, dockerID: summary.id, generation: summary.generation, variant: variant) {
+                    body.append(cached)
+                } else {
+                    let item = try encoder.encode(listItem(from: summary, size: size))
+                    responseCache.store(item, .summary, dockerID: summary.id, generation: summary.generation, variant: variant)
+                    body.append(item)
+                    encodedCount += 1
+                }
+            }
+            body.append(UInt8(ascii: "]"))
+
+            responseCache.prune(keeping: containerManager.containerIDs)
+
+            logger.info("Listed containers", metadata: [
+                "count": "\(containers.count)",
+                "encoded": "\(encodedCount)"
+            ])
+
+            return .success(body)
+        } catch {
+            logger.error("Failed to list containers", metadata: [
+                "error": "\(error)"
+            ])
+
+            return .failure(error)
+        }
+    }
+
+    /// Convert a ContainerSummary to its Docker API list item
+    private func listItem(from summary: ContainerSummary, size: Bool) -> ContainerListItem {
+        ContainerListItem(
+            id: summary.id,
+            names: summary.names,
+            image: summary.image,
+            imageID: summary.imageID,
+            command: summary.command,
+            created: summary.created,
+            state: summary.state,
+            status: summary.status,
+            ports: summary.ports.map { port in
+                Port(
+                    privatePort: port.privatePort,
+                    publicPort: port.publicPort,
+                    type: port.type,
+                    ip: port.ip
+                )
+            },
+            labels: summary.labels,
+            sizeRw: size ? summary.sizeRw : nil,
+            sizeRootFs: size ? summary.sizeRootFs : nil
+        )
+    }
+
+    /// Same output formatting as HTTPResponse.json, so cached and direct bodies are identical
+    private static func makeEncoder() -> JSONEncoder {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.withoutEscapingSlashes]
+        return encoder
+    }
+
     /// Handle POST /containers/create
     /// Creates a new container
     public func handleCreateContainer(
@@ -565,16 +633,14 @@ public struct ContainerHandlers: Sendable {
                 return .failure(ContainerError.notFound(id))
             }
 
-            // Get statistics from container manager
-            let stats = try await containerManager.getContainerStats(id: id)
+            // Shared sampler: reuses a sample taken within the last interval
+            let reading = try await statsSampler.reading(dockerID: containerInfo.id)
 
             // Transform to Docker format
-            let now = ISO8601DateFormatter().string(from: Date())
             let dockerStats = transformToDockerStats(
-                stats: stats,
+                reading: reading,
                 containerID: containerInfo.id,
-                containerName: containerInfo.name,
-                timestamp: now
+                containerName: containerInfo.name
             )
 
             logger.info("Container stats retrieved successfully", metadata: ["id": "\(id)"])
@@ -604,6 +670,59 @@ public struct ContainerHandlers: Sendable {
         }
     }
 
+    /// Handle GET /containers/stats (Arca extension)
+    /// One stats snapshot for every running container, served from the shared sampler
+    public func handleGetAllContainerStats() async -> Result<[ContainerStatsResponse], ContainerError> {
+        logger.debug("Handling bulk container stats request")
+
+        let running: [ContainerSummary]
+        do {
+            running = try await containerManager.listContainers(all: false)
+        } catch {
+            return .failure(ContainerError.statsFailed(errorDescription(error)))
+        }
+
+        let readings = await statsSampler.readings(dockerIDs: running.map(\.id))
+        let stats = running.compactMap { summary -> ContainerStatsResponse? in
+            guard let reading = readings[summary.id] else { return nil }
+            let name = summary.names.first.map { String($0.dropFirst()) } ?? ""
+            return transformToDockerStats(reading: reading, containerID: summary.id, containerName: name)
+        }
+        return .success(stats)
+    }
+
+    /// Transform a sampler reading to Docker stats format
+    /// preread/precpu come from the previous sample when the sampler has one
+    private func transformToDockerStats(
+        reading: StatsSampler.Reading,
+        containerID: String,
+        containerName: String
+    ) -> ContainerStatsResponse {
+        let formatter = ISO8601DateFormatter()
+        let response = transformToDockerStats(
+            stats: reading.current.stats,
+            containerID: containerID,
+            containerName: containerName,
+            timestamp: formatter.string(from: reading.current.timestamp)
+        )
+        guard let previous = reading.previous else {
+            return response
+        }
+
+        return ContainerStatsResponse(
+            id: response.id,
+            name: response.name,
+            read: response.read,
+            preread: formatter.string(from: previous.timestamp),
+            pidsStats: response.pidsStats,
+            cpuStats: response.cpuStats,
+            precpuStats: buildCPUStats(from: previous.stats),
+            memoryStats: response.memoryStats,
+            blkioStats: response.blkioStats,
+            networks: response.networks
+        )
+    }
+
     /// Transform Apple ContainerStatistics to Docker stats format
     private func transformToDockerStats(
         stats: Containerization.ContainerStatistics,
@@ -741,92 +860,35 @@ public struct ContainerHandlers: Sendable {
             }
         }
 
-        // Streaming response - poll stats every 1 second
+        // Streaming response - one reading per sampler interval, shared with every other
+        // client watching this container
         var headers = HTTPHeaders()
         headers.add(name: "Content-Type", value: "application/json")
 
         return .streaming(status: .ok, headers: headers) { writer in
-            var previousStats: Containerization.ContainerStatistics?
-            var previousTimestamp: String?
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = .withoutEscapingSlashes
+            encoder.dateEncodingStrategy = .iso8601
 
             do {
-                // Poll stats until the stream is cancelled or container stops
-                while true {
-                    // Check if container is still running
-                    guard let currentInfo = try? await self.containerManager.getContainer(id: id),
-                          currentInfo.state.running else {
-                        // Container stopped, finish the stream
-                        try await writer.finish()
-                        return
-                    }
-
-                    do {
-                        // Get current stats
-                        let currentStats = try await self.containerManager.getContainerStats(id: id)
-                        let currentTimestamp = ISO8601DateFormatter().string(from: Date())
-
-                        // Build stats response with previous values for deltas
-                        var statsResponse = self.transformToDockerStats(
-                            stats: currentStats,
-                            containerID: containerInfo.id,
-                            containerName: containerInfo.name,
-                            timestamp: currentTimestamp
-                        )
-
-                        // Update preread and precpu stats if we have previous values
-                        if let prevTimestamp = previousTimestamp {
-                            statsResponse = ContainerStatsResponse(
-                                id: statsResponse.id,
-                                name: statsResponse.name,
-                                read: statsResponse.read,
-                                preread: prevTimestamp,
-                                pidsStats: statsResponse.pidsStats,
-                                cpuStats: statsResponse.cpuStats,
-                                precpuStats: previousStats.map { prevStats in
-                                    self.buildCPUStats(from: prevStats)
-                                } ?? statsResponse.cpuStats,
-                                memoryStats: statsResponse.memoryStats,
-                                blkioStats: statsResponse.blkioStats,
-                                networks: statsResponse.networks
-                            )
-                        }
-
-                        // Encode and write JSON
-                        let encoder = JSONEncoder()
-                        encoder.outputFormatting = .withoutEscapingSlashes
-                        encoder.dateEncodingStrategy = .iso8601
-                        let jsonData = try encoder.encode(statsResponse)
-
-                        // Docker stats format: newline-delimited JSON
-                        var dataWithNewline = jsonData
-                        dataWithNewline.append(contentsOf: "\n".utf8)
-
-                        try await writer.write(dataWithNewline)
-
-                        // Save for next iteration
-                        previousStats = currentStats
-                        previousTimestamp = currentTimestamp
-
-                        // Wait 1 second before next poll (standard Docker stats interval)
-                        try await Task.sleep(nanoseconds: 1_000_000_000)
+                // The sampler finishes the stream when the container stops running;
+                // iteration ends early if the client disconnects
+                for await reading in await self.statsSampler.subscribe(dockerID: containerInfo.id) {
+                    let statsResponse = self.transformToDockerStats(
+                        reading: reading,
+                        containerID: containerInfo.id,
+                        containerName: containerInfo.name
+                    )
 
-                    } catch {
-                        // Log error but continue trying
-                        self.logger.error("Failed to get stats during streaming", metadata: [
-                            "id": "\(id)",
-                            "error": "\(error)"
-                        ])
+                    // Docker stats format: newline-delimited JSON
+                    var dataWithNewline = try encoder.encode(statsResponse)
+                    dataWithNewline.append(contentsOf: "\n".utf8)
 
-                        // If we get an error, wait a bit before retrying
-                        try await Task.sleep(nanoseconds: 1_000_000_000)
-                    }
+                    try await writer.write(dataWithNewline)
                 }
-            } catch is CancellationError {
-                // Stream was cancelled (client disconnected), this is normal
-                self.logger.debug("Stats streaming cancelled", metadata: ["id": "\(id)"])
-                try? await writer.finish()
+                try await writer.finish()
             } catch {
-                self.logger.error("Stats streaming error", metadata: [
+                self.logger.debug("Stats streaming ended", metadata: [
                     "id": "\(id)",
                     "error": "\(error)"
                 ])
@@ -927,99 +989,7 @@ public struct ContainerHandlers: Sendable {
                 return .failure(ContainerError.notFound(id))
             }
 
-            // Convert internal Container type to Docker API ContainerInspect
-            let inspect = ContainerInspect(
-                id: container.id,
-                created: ISO8601DateFormatter().string(from: container.created),
-                path: container.path,
-                args: container.args,
-                state: ContainerStateInspect(
-                    status: container.state.status,
-                    running: container.state.running,
-                    paused: container.state.paused,
-                    restarting: container.state.restarting,
-                    oomKilled: container.state.oomKilled,
-                    dead: container.state.dead,
-                    pid: container.state.pid,
-                    exitCode: container.state.exitCode,
-                    error: container.state.error,
-                    startedAt: container.state.startedAt.map { ISO8601DateFormatter().string(from: $0) } ?? "0001-01-01T00:00:00Z",
-                    finishedAt: container.state.finishedAt.map { ISO8601DateFormatter().string(from: $0) } ?? "0001-01-01T00:00:00Z",
-                    health: container.state.health
-                ),
-                image: container.image,
-                name: "/\(container.name)",
-                hostConfig: HostConfigInspect(
-                    binds: container.hostConfig.binds,
-                    networkMode: container.hostConfig.networkMode,
-                    portBindings: container.hostConfig.portBindings.mapValues { bindings in
-                        bindings.map { binding in
-                            PortBindingInspect(hostIp: binding.hostIp, hostPort: binding.hostPort)
-                        }
-                    },
-                    restartPolicy: RestartPolicyInspect(
-                        name: container.hostConfig.restartPolicy.name,
-                        maximumRetryCount: container.hostConfig.restartPolicy.maximumRetryCount
-                    ),
-                    autoRemove: container.hostConfig.autoRemove,
-                    privileged: container.hostConfig.privileged,
-                    // Memory Limits (Phase 5 - Task 5.1)
-                    memory: container.hostConfig.memory,
-                    memoryReservation: container.hostConfig.memoryReservation,
-                    memorySwap: container.hostConfig.memorySwap,
-                    memorySwappiness: container.hostConfig.memorySwappiness,
-                    // CPU Limits (Phase 5 - Task 5.2)
-                    nanoCpus: container.hostConfig.nanoCpus,
-                    cpuShares: container.hostConfig.cpuShares,
-                    cpuPeriod: container.hostConfig.cpuPeriod,
-                    cpuQuota: container.hostConfig.cpuQuota,
-                    cpusetCpus: container.hostConfig.cpusetCpus,
-                    cpusetMems: container.hostConfig.cpusetMems,
-                    // User/UID Support (Phase 5 - Task 5.3)
-                    groupAdd: container.hostConfig.groupAdd,
-                    // Security Capabilities (Phase 5 - Task 5.5)
-                    capAdd: container.hostConfig.capAdd,
-                    capDrop: container.hostConfig.capDrop,
-                    securityOpt: container.hostConfig.securityOpt,
-                    // Extra Hosts (Issue #34)
-                    extraHosts: container.hostConfig.extraHosts
-                ),
-                config: ContainerConfigInspect(
-                    hostname: container.config.hostname,
-                    domainname: container.config.domainname,
-                    user: container.config.user,
-                    attachStdin: container.config.attachStdin,
-                    attachStdout: container.config.attachStdout,
-                    attachStderr: container.config.attachStderr,
-                    tty: container.config.tty,
-                    openStdin: container.config.openStdin,
-                    stdinOnce: container.config.stdinOnce,
-                    env: container.config.env,
-                    cmd: container.config.cmd,
-                    image: container.config.image,
-                    volumes: nil,
-                    workingDir: container.config.workingDir,
-                    entrypoint: container.config.entrypoint,
-                    labels: container.config.labels,
-                    healthcheck: container.config.healthcheck
-                ),
-                networkSettings: NetworkSettingsInspect(
-                    ipAddress: container.networkSettings.ipAddress,
-                    ipPrefixLen: container.networkSettings.ipPrefixLen,
-                    gateway: container.networkSettings.gateway,
-                    macAddress: container.networkSettings.macAddress,
-                    networks: container.networkSettings.networks.mapValues { endpoint in
-                        NetworkEndpointInspect(
-                            networkID: endpoint.networkID,
-                            endpointID: endpoint.endpointID,
-                            gateway: endpoint.gateway,
-                            ipAddress: endpoint.ipAddress,
-                            ipPrefixLen: endpoint.ipPrefixLen,
-                            macAddress: endpoint.macAddress
-                        )
-                    }
-                )
-            )
+            let inspect = inspectResponse(from: container)
 
             logger.info("Container inspected", metadata: [
                 "id": "\(id)"
@@ -1036,6 +1006,138 @@ public struct ContainerHandlers: Sendable {
         }
     }
 
+    /// Handle GET /containers/{id}/json, returning the encoded body
+    /// The body is reused from the response cache while the container's generation is
+    /// unchanged. Host-network containers are always rebuilt: their interfaces are read from
+    /// the VM rather than the registry, so the generation does not cover them.
+    public func handleInspectContainerEncoded(id: String) async -> Result<Data, ContainerError> {
+        // Read the generation before the container so a cached body is never newer than its stamp
+        guard let stamp = containerManager.containerGeneration(id: id) else {
+            logger.warning("Container not found", metadata: [
+                "id": "\(id)"
+            ])
+            return .failure(ContainerError.notFound(id))
+        }
+
+        if let cached = responseCache.lookup(.inspect, dockerID: stamp.dockerID, generation: stamp.generation) {
+            logger.debug("Container inspected (cached)", metadata: [
+                "id": "\(id)"
+            ])
+            return .success(cached)
+        }
+
+        switch await handleInspectContainer(id: stamp.dockerID) {
+        case .success(let inspect):
+            do {
+                let data = try Self.makeEncoder().encode(inspect)
+                if inspect.hostConfig.networkMode != "host" {
+                    responseCache.store(data, .inspect, dockerID: stamp.dockerID, generation: stamp.generation)
+                }
+                return .success(data)
+            } catch {
+                return .failure(ContainerError.inspectFailed(errorDescription(error)))
+            }
+        case .failure(let error):
+            return .failure(error)
+        }
+    }
+
+    /// Convert internal Container type to Docker API ContainerInspect
+    private func inspectResponse(from container: Container) -> ContainerInspect {
+        ContainerInspect(
+            id: container.id,
+            created: ISO8601DateFormatter().string(from: container.created),
+            path: container.path,
+            args: container.args,
+            state: ContainerStateInspect(
+                status: container.state.status,
+                running: container.state.running,
+                paused: container.state.paused,
+                restarting: container.state.restarting,
+                oomKilled: container.state.oomKilled,
+                dead: container.state.dead,
+                pid: container.state.pid,
+                exitCode: container.state.exitCode,
+                error: container.state.error,
+                startedAt: container.state.startedAt.map { ISO8601DateFormatter().string(from: $0) } ?? "0001-01-01T00:00:00Z",
+                finishedAt: container.state.finishedAt.map { ISO8601DateFormatter().string(from: $0) } ?? "0001-01-01T00:00:00Z",
+                health: container.state.health
+            ),
+            image: container.image,
+            name: "/\(container.name)",
+            hostConfig: HostConfigInspect(
+                binds: container.hostConfig.binds,
+                networkMode: container.hostConfig.networkMode,
+                portBindings: container.hostConfig.portBindings.mapValues { bindings in
+                    bindings.map { binding in
+                        PortBindingInspect(hostIp: binding.hostIp, hostPort: binding.hostPort)
+                    }
+                },
+                restartPolicy: RestartPolicyInspect(
+                    name: container.hostConfig.restartPolicy.name,
+                    maximumRetryCount: container.hostConfig.restartPolicy.maximumRetryCount
+                ),
+                autoRemove: container.hostConfig.autoRemove,
+                privileged: container.hostConfig.privileged,
+                // Memory Limits (Phase 5 - Task 5.1)
+                memory: container.hostConfig.memory,
+                memoryReservation: container.hostConfig.memoryReservation,
+                memorySwap: container.hostConfig.memorySwap,
+                memorySwappiness: container.hostConfig.memorySwappiness,
+                // CPU Limits (Phase 5 - Task 5.2)
+                nanoCpus: container.hostConfig.nanoCpus,
+                cpuShares: container.hostConfig.cpuShares,
+                cpuPeriod: container.hostConfig.cpuPeriod,
+                cpuQuota: container.hostConfig.cpuQuota,
+                cpusetCpus: container.hostConfig.cpusetCpus,
+                cpusetMems: container.hostConfig.cpusetMems,
+                // User/UID Support (Phase 5 - Task 5.3)
+                groupAdd: container.hostConfig.groupAdd,
+                // Security Capabilities (Phase 5 - Task 5.5)
+                capAdd: container.hostConfig.capAdd,
+                capDrop: container.hostConfig.capDrop,
+                securityOpt: container.hostConfig.securityOpt,
+                // Extra Hosts (Issue #34)
+                extraHosts: container.hostConfig.extraHosts
+            ),
+            config: ContainerConfigInspect(
+                hostname: container.config.hostname,
+                domainname: container.config.domainname,
+                user: container.config.user,
+                attachStdin: container.config.attachStdin,
+                attachStdout: container.config.attachStdout,
+                attachStderr: container.config.attachStderr,
+                tty: container.config.tty,
+                openStdin: container.config.openStdin,
+                stdinOnce: container.config.stdinOnce,
+                env: container.config.env,
+                cmd: container.config.cmd,
+                image: container.config.image,
+                volumes: nil,
+                workingDir: container.config.workingDir,
+                entrypoint: container.config.entrypoint,
+                labels: container.config.labels,
+                healthcheck: container.config.healthcheck
+            ),
+            networkSettings: NetworkSettingsInspect(
+                ipAddress: container.networkSettings.ipAddress,
+                ipPrefixLen: container.networkSettings.ipPrefixLen,
+                gateway: container.networkSettings.gateway,
+                macAddress: container.networkSettings.macAddress,
+                networks: container.networkSettings.networks.mapValues { endpoint in
+                    NetworkEndpointInspect(
+                        networkID: endpoint.networkID,
+                        endpointID: endpoint.endpointID,
+                        gateway: endpoint.gateway,
+                        ipAddress: endpoint.ipAddress,
+                        ipPrefixLen: endpoint.ipPrefixLen,
+                        macAddress: endpoint.macAddress
+                    )
+                }
+            )
+        )
+    }
+
     /// Handle GET /containers/{id}/logs
     /// Gets container logs
     ///
@@ -1077,24 +1179,26 @@ public struct ContainerHandlers: Sendable {
         }
 
         do {
-            // Retrieve and filter logs
-            let logs = try retrieveLogs(
+            let replay = try makeLogReplay(
                 logPaths: logPaths,
                 stdout: stdout,
                 stderr: stderr,
                 since: since,
                 until: until,
-                timestamps: timestamps,
                 tail: tail
             )
 
+            // Convert to Docker multiplexed stream format
+            var multiplexedData = Data()
+            while let frames = try replay.nextFrames(timestamps: timestamps) {
+                multiplexedData.append(frames)
+            }
+
             logger.info("Container logs retrieved", metadata: [
                 "id": "\(dockerID)",
-                "entries": "\(logs.count)"
+                "bytes": "\(multiplexedData.count)"
             ])
 
-            // Convert to Docker multiplexed stream format
-            let multiplexedData = formatMultiplexedStream(logs: logs)
             return .success(multiplexedData)
         } catch {
             logger.error("Failed to retrieve logs", metadata: [
@@ -1106,7 +1210,8 @@ public struct ContainerHandlers: Sendable {
     }
 
     /// Handle GET /containers/{id}/logs with streaming support
-    /// Streams container logs when follow=true
+    /// History is replayed in bounded batches straight onto the wire; with follow=true the
+    /// response then stays open for live output
     public func handleLogsContainerStreaming(
         idOrName: String,
         stdout: Bool,
@@ -1132,61 +1237,48 @@ public struct ContainerHandlers: Sendable {
             return .standard(HTTPResponse.error("No logs found for container", status: .notFound))
         }
 
-        // If not following, use standard response
-        if !follow {
-            do {
-                let logs = try retrieveLogs(
-                    logPaths: logPaths,
-                    stdout: stdout,
-                    stderr: stderr,
-                    since: since,
-                    until: until,
-                    timestamps: timestamps,
-                    tail: tail
-                )
-                let multiplexedData = formatMultiplexedStream(logs: logs)
-                return .standard(HTTPResponse(
-                    status: .ok,
-                    headers: HTTPHeaders([("Content-Type", "application/vnd.docker.raw-stream")]),
-                    body: multiplexedData
-                ))
-            } catch {
-                return .standard(HTTPResponse.error("Failed to retrieve logs: \(error)", status: .internalServerError))
-            }
-        }
-
-        // Streaming response
         var headers = HTTPHeaders()
         headers.add(name: "Content-Type", value: "application/vnd.docker.raw-stream")
 
         return .streaming(status: .ok, headers: headers) { writer in
             do {
-                // Stream existing logs first
-                let existingLogs = try self.retrieveLogs(
-                    logPaths: logPaths,
-                    stdout: stdout,
-                    stderr: stderr,
-                    since: since,
-                    until: until,
-                    timestamps: timestamps,
-                    tail: tail
-                )
-
-                let existingData = self.formatMultiplexedStream(logs: existingLogs)
-                if !existingData.isEmpty {
-                    try await writer.write(existingData)
-                }
+                // Subscribe before replaying: the replay stops at the log offsets taken when
+                // the follower subscribed and live output starts right after them, so nothing
+                // written in between is lost or sent twice
+                let follower = follow ? await self.containerManager.followLogs(dockerID: dockerID) : nil
 
-                // If following, watch for new log entries
-                if follow {
-                    try await self.streamNewLogs(
-                        dockerID: dockerID,
+                do {
+                    let replay = try self.makeLogReplay(
                         logPaths: logPaths,
                         stdout: stdout,
                         stderr: stderr,
-                        timestamps: timestamps,
-                        writer: writer
+                        since: since,
+                        until: until,
+                        tail: tail,
+                        through: follower?.replayEnds
                     )
+                    while let frames = try replay.nextFrames(timestamps: timestamps) {
+                        try await writer.write(frames)
+                    }
+
+                    if let follower = follower {
+                        try await self.streamNewLogs(
+                            follower: follower,
+                            stdout: stdout,
+                            stderr: stderr,
+                            timestamps: timestamps,
+                            writer: writer
+                        )
+                    }
+                } catch {
+                    if let follower = follower {
+                        await self.containerManager.stopFollowingLogs(dockerID: dockerID, follower: follower)
+                    }
+                    throw error
+                }
+
+                if let follower = follower {
+                    await self.containerManager.stopFollowingLogs(dockerID: dockerID, follower: follower)
                 }
 
                 try await writer.finish()
@@ -1197,234 +1289,72 @@ public struct ContainerHandlers: Sendable {
         }
     }
 
-    /// Stream new log entries as they appear
+    /// Stream new log entries as the container writes them
+    /// Chunks are pushed by the container's broadcast writers; the loop ends when the
+    /// container stops (ContainerManager finishes the follower) or the client goes away.
+    /// Output the client fell too far behind on is re-sent from the log or, under
+    /// drop-oldest, reported as dropped.
     private func streamNewLogs(
-        dockerID: String,
-        logPaths: ContainerBridge.ContainerLogManager.LogPaths,
+        follower: LogFollower,
         stdout: Bool,
         stderr: Bool,
         timestamps: Bool,
         writer: HTTPStreamWriter
     ) async throws {
-        // Track last read positions
-        var stdoutPosition = try? getFileSize(logPaths.stdoutPath)
-        var stderrPosition = try? getFileSize(logPaths.stderrPath)
-
-        // Poll for new log data every 100ms until container exits
-        // This works for attach before start: waits for container to start, then streams logs
-        while await containerManager.shouldStreamLogs(dockerID: dockerID) {
-            try await Task.sleep(nanoseconds: 100_000_000) // 100ms
-
-            // Check stdout for new data
-            if stdout, let currentSize = try? getFileSize(logPaths.stdoutPath),
-               currentSize > (stdoutPosition ?? 0) {
-                if let newData = try? readNewLogData(
-                    path: logPaths.stdoutPath,
-                    from: stdoutPosition ?? 0,
-                    streamType: "stdout",
-                    timestamps: timestamps
-                ) {
-                    try await writer.write(newData)
-                    stdoutPosition = currentSize
+        let streams = logStreams(stdout: stdout, stderr: stderr)
+
+        while let event = await follower.next() {
+            var frames = Data()
+            switch event {
+            case .output(let chunk):
+                guard streams.contains(chunk.stream) else { continue }
+                for line in chunk.lines() {
+                    LogLine(stream: chunk.stream, timestamp: chunk.timestamp, message: line)
+                        .appendFrame(to: &frames, timestamps: timestamps)
                 }
-            }
-
-            // Check stderr for new data
-            if stderr, let currentSize = try? getFileSize(logPaths.stderrPath),
-               currentSize > (stderrPosition ?? 0) {
-                if let newData = try? readNewLogData(
-                    path: logPaths.stderrPath,
-                    from: stderrPosition ?? 0,
-                    streamType: "stderr",
-                    timestamps: timestamps
-                ) {
-                    try await writer.write(newData)
-                    stderrPosition = currentSize
+            case .history(let lines):
+                for line in lines where streams.contains(line.stream) {
+                    line.appendFrame(to: &frames, timestamps: timestamps)
                 }
+            case .dropped(let stream, let bytes):
+                guard streams.contains(stream) else { continue }
+                let notice = Data("[arca: \(bytes) bytes of output dropped, client too slow]\n".utf8)
+                LogLine(stream: stream, timestamp: Date(), message: notice)
+                    .appendFrame(to: &frames, timestamps: timestamps)
             }
+            guard !frames.isEmpty else { continue }
+            try await writer.write(frames)
         }
     }
 
-    /// Get file size in bytes
-    private func getFileSize(_ path: URL) throws -> UInt64 {
-        let attributes = try FileManager.default.attributesOfItem(atPath: path.path)
-        return attributes[.size] as? UInt64 ?? 0
-    }
-
-    /// Read new log data from position to end of file
-    private func readNewLogData(path: URL, from position: UInt64, streamType: String, timestamps: Bool) throws -> Data {
-        let fileHandle = try FileHandle(forReadingFrom: path)
-        defer { try? fileHandle.close() }
-
-        try fileHandle.seek(toOffset: position)
-        let data = fileHandle.readDataToEndOfFile()
-
-        guard let content = String(data: data, encoding: .utf8) else {
-            return Data()
-        }
-
-        let lines = content.components(separatedBy: .newlines)
-        var logEntries: [LogEntry] = []
-
-        for line in lines {
-            guard !line.isEmpty else { continue }
-
-            guard let lineData = line.data(using: .utf8),
-                  let json = try? JSONSerialization.jsonObject(with: lineData) as? [String: Any],
-                  let logStream = json["stream"] as? String,
-                  let logMessage = json["log"] as? String,
-                  let timeString = json["time"] as? String else {
-                continue
-            }
-
-            let formatter = ISO8601DateFormatter()
-            guard let timestamp = formatter.date(from: timeString) else {
-                continue
-            }
-
-            if logStream == streamType {
-                logEntries.append(LogEntry(
-                    stream: logStream,
-                    message: logMessage,
-                    timestamp: timestamp,
-                    includeTimestamp: timestamps
-                ))
-            }
-        }
-
-        return formatMultiplexedStream(logs: logEntries)
+    /// Streams selected by the stdout/stderr query parameters
+    private func logStreams(stdout: Bool, stderr: Bool) -> Set<LogStream> {
+        var streams = Set<LogStream>()
+        if stdout { streams.insert(.stdout) }
+        if stderr { streams.insert(.stderr) }
+        return streams
     }
 
-    /// Retrieve and filter container logs from JSON log files
-    /// Returns array of log entries with stream type, message, and timestamp
-    private func retrieveLogs(
+    /// Open a merged, filtered replay of the container's log files
+    /// Works the same for json-file and local logs; since/until are UNIX seconds and
+    /// tail is Docker's string form ("all" or a line count)
+    private func makeLogReplay(
         logPaths: ContainerBridge.ContainerLogManager.LogPaths,
         stdout: Bool,
         stderr: Bool,
         since: Int?,
         until: Int?,
-        timestamps: Bool,
-        tail: String?
-    ) throws -> [LogEntry] {
-        var allLogs: [LogEntry] = []
-
-        // Helper to parse log files
-        func parseLogs(from path: URL, forStream stream: String) throws {
-            guard FileManager.default.fileExists(atPath: path.path) else {
-                return
-            }
-
-            let content = try String(contentsOf: path, encoding: .utf8)
-            let lines = content.components(separatedBy: .newlines)
-
-            for line in lines {
-                guard !line.isEmpty else { continue }
-
-                // Parse JSON log entry
-                guard let data = line.data(using: .utf8),
-                      let json = try? JSONSerialization.jsonObject(with: data) as? [String: Any],
-                      let logStream = json["stream"] as? String,
-                      let logMessage = json["log"] as? String,
-                      let timeString = json["time"] as? String else {
-                    continue
-                }
-
-                // Parse timestamp
-                let formatter = ISO8601DateFormatter()
-                guard let timestamp = formatter.date(from: timeString) else {
-                    continue
-                }
-
-                allLogs.append(LogEntry(
-                    stream: logStream,
-                    message: logMessage,
-                    timestamp: timestamp,
-                    includeTimestamp: timestamps
-                ))
-            }
-        }
-
-        // Read from stdout log file if requested
-        if stdout {
-            try parseLogs(from: logPaths.stdoutPath, forStream: "stdout")
-        }
-
-        // Read from stderr log file if requested
-        if stderr {
-            try parseLogs(from: logPaths.stderrPath, forStream: "stderr")
-        }
-
-        // Sort by timestamp (logs from different streams need to be interleaved chronologically)
-        allLogs.sort { $0.timestamp < $1.timestamp }
-
-        // Filter by time range
-        if let since = since {
-            let sinceDate = Date(timeIntervalSince1970: TimeInterval(since))
-            allLogs = allLogs.filter { $0.timestamp >= sinceDate }
-        }
-
-        if let until = until {
-            let untilDate = Date(timeIntervalSince1970: TimeInterval(until))
-            allLogs = allLogs.filter { $0.timestamp <= untilDate }
-        }
-
-        // Apply tail limit
-        if let tailStr = tail, let tailCount = Int(tailStr) {
-            allLogs = Array(allLogs.suffix(tailCount))
-        }
-
-        return allLogs
-    }
-
-    /// Format log entries as Docker multiplexed stream
-    /// Docker format: [stream_type (1 byte)][padding (3 bytes)][size (4 bytes big-endian)][payload]
-    /// Stream types: 0=stdin, 1=stdout, 2=stderr
-    private func formatMultiplexedStream(logs: [LogEntry]) -> Data {
-        var result = Data()
-        let formatter = ISO8601DateFormatter()
-
-        for entry in logs {
-            // Determine stream type
-            let streamType: UInt8 = entry.stream == "stdout" ? 1 : 2
-
-            // Format message (with timestamp if requested)
-            var message = entry.message
-            if entry.includeTimestamp {
-                let timestampStr = formatter.string(from: entry.timestamp)
-                message = "\(timestampStr) \(message)"
-            }
-
-            // Convert message to data
-            guard let messageData = message.data(using: .utf8) else {
-                continue
-            }
-
-            // Build frame header: [stream_type][padding][size]
-            var header = Data()
-            header.append(streamType)                    // 1 byte: stream type
-            header.append(contentsOf: [0, 0, 0])        // 3 bytes: padding
-
-            // 4 bytes: size (big-endian UInt32)
-            let size = UInt32(messageData.count)
-            header.append(UInt8((size >> 24) & 0xFF))
-            header.append(UInt8((size >> 16) & 0xFF))
-            header.append(UInt8((size >> 8) & 0xFF))
-            header.append(UInt8(size & 0xFF))
-
-            // Append header + payload
-            result.append(header)
-            result.append(messageData)
-        }
-
-        return result
-    }
-
-    /// Internal structure for log entry parsing
-    private struct LogEntry {
-        let stream: String
-        let message: String
-        let timestamp: Date
-        let includeTimestamp: Bool
+        tail: String?,
+        through: [LogStream: UInt64]? = nil
+    ) throws -> LogReplay {
+        return try LogReplay(
+            logPaths: logPaths,
+            streams: logStreams(stdout: stdout, stderr: stderr),
+            since: since.map { Date(timeIntervalSince1970: TimeInterval($0)) },
+            until: until.map { Date(timeIntervalSince1970: TimeInterval($0)) },
+            tail: tail.flatMap { Int($0) },
+            through: through
+        )
     }
 
     /// Handle POST /containers/{id}/wait
@@ -1491,6 +1421,7 @@ public struct ContainerHandlers: Sendable {
             let processClient = ProcessControlClient(
                 containerID: id,
                 container: nativeContainer,
+                channelPool: await containerManager.getControlChannels(id: id),
                 logger: logger
             )
 
@@ -1714,7 +1645,9 @@ public struct ContainerHandlers: Sendable {
     /// Get an archive of a filesystem resource in a container (GET /containers/{id}/archive)
     /// Uses Filesystem RPC to create tar archive via Go's archive/tar library
     /// Works universally without requiring tar in container (Phase 6.5)
-    public func handleGetArchive(id: String, path: String) async -> Result<(tarData: Data, stat: PathStat), ContainerError> {
+    /// The archive is streamed in chunks; the caller must `close()` the returned reader,
+    /// which also releases the filesystem service connection
+    public func handleGetArchive(id: String, path: String) async -> Result<(reader: ArchiveStreamReader, stat: PathStat), ContainerError> {
         logger.info("Getting archive from container", metadata: [
             "container_id": "\(id)",
             "path": "\(path)"
@@ -1736,25 +1669,25 @@ public struct ContainerHandlers: Sendable {
             return .failure(.invalidRequest("Container must be running to extract archive"))
         }
 
-        // Connect to Filesystem service and read archive via RPC
+        // Open the archive stream over the container's persistent filesystem channel
+        let client = FilesystemClient(
+            containerID: containerID,
+            container: nativeContainer,
+            channelPool: await containerManager.getControlChannels(id: containerID),
+            logger: logger
+        )
         do {
-            let client = FilesystemClient(containerID: containerID, container: nativeContainer, logger: logger)
-            defer {
-                Task {
-                    try? await client.disconnect()
-                }
-            }
-
-            let (tarData, stat) = try await client.readArchive(path: path)
+            let reader = try await client.readArchiveStream(path: path)
 
-            logger.info("Archive extracted successfully", metadata: [
+            logger.info("Archive stream opened", metadata: [
                 "container_id": "\(id)",
                 "path": "\(path)",
-                "size": "\(tarData.count) bytes"
+                "size": "\(reader.stat.size) bytes"
             ])
 
-            return .success((tarData, stat))
+            return .success((reader, reader.stat))
         } catch {
+            try? await client.disconnect()
             logger.error("Failed to extract archive", metadata: [
                 "container_id": "\(id)",
                 "path": "\(path)",
@@ -1767,14 +1700,15 @@ public struct ContainerHandlers: Sendable {
     /// Extract an archive to a directory in a container (PUT /containers/{id}/archive)
     /// Uses Filesystem RPC to extract tar archive via Go's archive/tar library
     /// Works universally without requiring tar in container (Phase 6.5)
-    public func handlePutArchive(id: String, path: String, tarData: Data) async -> Result<Void, ContainerError> {
+    /// The upload is forwarded to the guest chunk by chunk as it arrives
+    public func handlePutArchive(id: String, path: String, body: HTTPRequestBody) async -> Result<Void, ContainerError> {
         logger.info("Putting archive to container", metadata: [
             "container_id": "\(id)",
             "path": "\(path)",
-            "size": "\(tarData.count)"
+            "content_length": "\(body.expectedLength.map { "\($0)" } ?? "unknown")"
         ])
 
-        // Resolve container
+        // Resolve container before consuming the upload so bad requests fail fast
         guard let containerID = await containerManager.resolveContainer(idOrName: id) else {
             return .failure(.notFound(id))
         }
@@ -1790,16 +1724,21 @@ public struct ContainerHandlers: Sendable {
             return .failure(.invalidRequest("Container must be running to write archive"))
         }
 
-        // Connect to Filesystem service and write archive via RPC
+        // Stream the archive over the container's persistent filesystem channel
         do {
-            let client = FilesystemClient(containerID: containerID, container: nativeContainer, logger: logger)
+            let client = FilesystemClient(
+                containerID: containerID,
+                container: nativeContainer,
+                channelPool: await containerManager.getControlChannels(id: containerID),
+                logger: logger
+            )
             defer {
                 Task {
                     try? await client.disconnect()
                 }
             }
 
-            try await client.writeArchive(path: path, tarData: tarData)
+            try await client.writeArchive(path: path, chunks: body)
 
             logger.info("Archive written successfully", metadata: [
                 "container_id": "\(id)",
@@ -1818,20 +1757,18 @@ public struct ContainerHandlers: Sendable {
     }
 
     /// Handle GET /containers/{id}/changes
-    /// Returns filesystem changes since container was created
+    /// Returns filesystem changes since container was created, as a reader of upperdir pages
+    /// The first page has been received, so enumeration errors surface here rather than mid-response.
     /// Reference: Docker Engine API v1.51 - ContainerChanges operation
-    public func handleContainerChanges(id: String) async -> Result<[FilesystemChange], ContainerError> {
+    public func handleContainerChanges(id: String, query: UpperdirQuery = UpperdirQuery()) async -> Result<UpperdirStreamReader, ContainerError> {
         logger.info("Getting container filesystem changes", metadata: [
-            "container_id": "\(id)"
+            "container_id": "\(id)",
+            "path_prefix": "\(query.pathPrefix)"
         ])
 
         do {
-            let changes = try await containerManager.getContainerChanges(id: id)
-            logger.info("Container filesystem changes retrieved", metadata: [
-                "container_id": "\(id)",
-                "changes": "\(changes.count)"
-            ])
-            return .success(changes)
+            let reader = try await containerManager.streamContainerChanges(id: id, query: query)
+            return .success(reader)
         } catch let error as ContainerBridge.ContainerManagerError {
             switch error {
             case .containerNotFound:
@@ -0,0 +1,78 @@
+import Foundation
+
+/// Encoded list items and inspect bodies, reused while the container is unchanged
+///
+/// Entries are keyed by Docker ID and stamped with the registry generation they were built
+/// from; a lookup with any other generation misses, so a changed container is re-encoded on
+/// its next request and never served stale. The variant distinguishes encodings of the same
+/// generation that still differ, such as list items whose status text ("Up 5 minutes")
+/// moves with the clock.
+///
+/// @unchecked Sendable: Safe because the entry tables are protected by NSLock
+final class ContainerResponseCache: @unchecked Sendable {
+    enum Kind {
+        case summary
+        case inspect
+    }
+
+    private struct Entry {
+        let generation: UInt64
+        let variant: String
+        let data: Data
+    }
+
+    /// Hard bound for containers that are inspected but never listed, so never pruned
+    private let capacity: Int
+
+    private let lock = NSLock()
+    private var summaries: [String: Entry] = [:]
+    private var inspects: [String: Entry] = [:]
+
+    init(capacity: Int = 4096) {
+        self.capacity = capacity
+    }
+
+    func lookup(_ kind: Kind, dockerID: String, generation: UInt64, variant: String = "") -> Data? {
+        lock.withLock {
+            guard let entry = table(kind)[dockerID],
+                  entry.generation == generation, entry.variant == variant else {
+                return nil
+            }
+            return entry.data
+        }
+    }
+
+    func store(_ data: Data, _ kind: Kind, dockerID: String, generation: UInt64, variant: String = "") {
+        lock.withLock {
+            let entry = Entry(generation: generation, variant: variant, data: data)
+            switch kind {
+            case .summary:
+                if summaries.count >= capacity { summaries.removeAll(keepingCapacity: true) }
+                summaries[dockerID] = entry
+            case .inspect:
+                if inspects.count >= capacity { inspects.removeAll(keepingCapacity: true) }
+                inspects[dockerID] = entry
+            }
+        }
+    }
+
+    /// Drop entries of containers that no longer exist
+    /// Only scans when the cache holds more entries than there are containers.
+    func prune(keeping liveIDs: Set<String>) {
+        lock.withLock {
+            if summaries.count > liveIDs.count {
+                summaries = summaries.filter { liveIDs.contains($0.key) }
+            }
+            if inspects.count > liveIDs.count {
+                inspects = inspects.filter { liveIDs.contains($0.key) }
+            }
+        }
+    }
+
+    private func table(_ kind: Kind) -> [String: Entry] {
+        switch kind {
+        case .summary: return summaries
+        case .inspect: return inspects
+        }
+    }
+}
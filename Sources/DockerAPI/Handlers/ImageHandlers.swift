@@ -472,13 +472,14 @@ public struct ImageHandlers: Sendable {
     /// Request body: tar archive (application/x-tar or application/octet-stream)
     ///
     /// Response: JSON stream of load progress (similar to pull progress)
-    public func handleLoadImage(tarData: Data) async -> Result<ImageLoadResponse, ImageHandlerError> {
+    public func handleLoadImage(body: HTTPRequestBody) async -> Result<ImageLoadResponse, ImageHandlerError> {
         logger.info("Handling load image request", metadata: [
-            "tar_size_bytes": "\(tarData.count)"
+            "content_length": "\(body.expectedLength.map { "\($0)" } ?? "unknown")"
         ])
 
         do {
-            let loadedImages = try await imageManager.loadImageFromTar(tarData)
+            // Archive entries are ingested as the upload arrives - nothing is buffered whole
+            let loadedImages = try await imageManager.loadImageFromTarStream(body)
 
             // Build response with loaded image references
             let loadedRefs = loadedImages.map { $0.reference }
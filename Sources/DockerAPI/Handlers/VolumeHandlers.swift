@@ -66,8 +66,9 @@ public struct VolumeHandlers: Sendable {
 
         do {
             let volumeList = try await volumeManager.listVolumes(filters: filters)
+            let usage = await volumeManager.usage(names: volumeList.map { $0.name })
 
-            let volumes = volumeList.map { convertToDockerVolume($0) }
+            let volumes = volumeList.map { convertToDockerVolume($0, usage: usage[$0.name]) }
 
             let response = VolumeListResponse(
                 volumes: volumes.isEmpty ? nil : volumes,
@@ -89,7 +90,8 @@ public struct VolumeHandlers: Sendable {
 
         do {
             let metadata = try await volumeManager.inspectVolume(name: name)
-            let volume = convertToDockerVolume(metadata)
+            let usage = await volumeManager.usage(names: [name])[name]
+            let volume = convertToDockerVolume(metadata, usage: usage)
 
             logger.info("Inspected volume", metadata: [
                 "name": "\(volume.name)",
@@ -176,20 +178,31 @@ public struct VolumeHandlers: Sendable {
     // MARK: - Private Helpers
 
     /// Convert VolumeManager.VolumeMetadata to Docker API Volume
-    private func convertToDockerVolume(_ metadata: VolumeManager.VolumeMetadata) -> Volume {
+    /// Cached usage is reported as UsageData, with its measurement time and age in Status
+    private func convertToDockerVolume(_ metadata: VolumeManager.VolumeMetadata, usage: VolumeManager.VolumeUsage? = nil) -> Volume {
         let formatter = ISO8601DateFormatter()
         formatter.formatOptions = [.withInternetDateTime, .withFractionalSeconds]
         let createdAtString = formatter.string(from: metadata.createdAt)
 
+        var status: [String: AnyCodable]? = nil
+        if let usage = usage {
+            status = [
+                "UsageMeasuredAt": AnyCodable(formatter.string(from: usage.measuredAt)),
+                "UsageAgeSeconds": AnyCodable(Int(usage.age)),
+                "UsageComplete": AnyCodable(usage.complete)
+            ]
+        }
+
         return Volume(
             name: metadata.name,
             driver: metadata.driver,
             mountpoint: metadata.mountpoint,
             createdAt: createdAtString,
-            status: nil,
+            status: status,
             labels: metadata.labels,
             scope: "local",
-            options: metadata.options
+            options: metadata.options,
+            usageData: usage.map { VolumeUsageData(size: $0.bytes) }
         )
     }
 }
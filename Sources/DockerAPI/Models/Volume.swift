@@ -42,6 +42,7 @@ public struct Volume: Codable {
     public let labels: [String: String]
     public let scope: String
     public let options: [String: String]?
+    public let usageData: VolumeUsageData?
 
     enum CodingKeys: String, CodingKey {
         case name = "Name"
@@ -52,6 +53,7 @@ public struct Volume: Codable {
         case labels = "Labels"
         case scope = "Scope"
         case options = "Options"
+        case usageData = "UsageData"
     }
 
     public init(
@@ -62,7 +64,8 @@ public struct Volume: Codable {
         status: [String: AnyCodable]? = nil,
         labels: [String: String] = [:],
         scope: String = "local",
-        options: [String: String]? = nil
+        options: [String: String]? = nil,
+        usageData: VolumeUsageData? = nil
     ) {
         self.name = name
         self.driver = driver
@@ -72,6 +75,24 @@ public struct Volume: Codable {
         self.labels = labels
         self.scope = scope
         self.options = options
+        self.usageData = usageData
+    }
+}
+
+/// Disk usage of a volume
+/// Size and RefCount are -1 when not available
+public struct VolumeUsageData: Codable {
+    public let size: Int64
+    public let refCount: Int64
+
+    enum CodingKeys: String, CodingKey {
+        case size = "Size"
+        case refCount = "RefCount"
+    }
+
+    public init(size: Int64 = -1, refCount: Int64 = -1) {
+        self.size = size
+        self.refCount = refCount
     }
 }
 
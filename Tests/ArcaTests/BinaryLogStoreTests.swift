@@ -0,0 +1,129 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Binary Log Store Tests
+/// Verifies the "local" log driver's record format, sparse time index, and since/tail reads
+///
+/// These tests run against temporary directories and do not need a running daemon
+@Suite("Binary Log Store")
+struct BinaryLogStoreTests {
+
+    private func makeLogDir() throws -> URL {
+        let dir = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-binlog-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+        return dir
+    }
+
+    private func text(_ lines: [LogLine]) -> [String] {
+        lines.map { String(decoding: $0.message, as: UTF8.self) }
+    }
+
+    @Test("Records round-trip with both streams in write order")
+    func roundTrip() throws {
+        let dir = try makeLogDir()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        let store = try BinaryLogStore(directory: dir)
+        let stdout = store.makeWriter(stream: .stdout)
+        let stderr = store.makeWriter(stream: .stderr)
+        try stdout.write(Data("one\ntwo\n".utf8))
+        try stderr.write(Data("oops\n".utf8))
+        try stdout.write(Data("partial".utf8))
+        try stdout.close()
+        try stderr.close()
+
+        let reader = try BinaryLogReader(directory: dir)
+        let all = try reader.readLines(streams: [.stdout, .stderr])
+        #expect(text(all) == ["one\n", "two\n", "oops\n", "partial"])
+        #expect(all.map(\.stream) == [.stdout, .stdout, .stderr, .stdout])
+
+        let stderrOnly = try reader.readLines(streams: [.stderr])
+        #expect(text(stderrOnly) == ["oops\n"])
+
+        // Timestamps never go backwards
+        for (earlier, later) in zip(all, all.dropFirst()) {
+            #expect(earlier.timestamp <= later.timestamp)
+        }
+    }
+
+    @Test("Tail walks back from the end without a full scan")
+    func tail() throws {
+        let dir = try makeLogDir()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        let store = try BinaryLogStore(directory: dir)
+        let stdout = store.makeWriter(stream: .stdout)
+        let stderr = store.makeWriter(stream: .stderr)
+        for i in 0..<1000 {
+            try stdout.write(Data("line \(i)\n".utf8))
+            if i % 100 == 0 {
+                try stderr.write(Data("err \(i)\n".utf8))
+            }
+        }
+        try stdout.close()
+        try stderr.close()
+
+        let reader = try BinaryLogReader(directory: dir)
+        #expect(try reader.tailOffset(lines: 3, streams: [.stdout]) > 0)
+
+        let lines = try reader.readLines(streams: [.stdout], tail: 3)
+        #expect(text(lines) == ["line 997\n", "line 998\n", "line 999\n"])
+
+        let everything = try reader.readLines(streams: [.stdout, .stderr], tail: 5000)
+        #expect(everything.count == 1010)
+    }
+
+    @Test("Since seeks through the sparse index")
+    func since() throws {
+        let dir = try makeLogDir()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        let store = try BinaryLogStore(directory: dir)
+        let stdout = store.makeWriter(stream: .stdout)
+
+        // Enough data for several index entries before the cutoff
+        let filler = Data(repeating: UInt8(ascii: "x"), count: 1023) + Data("\n".utf8)
+        for _ in 0..<300 {
+            try stdout.write(filler)
+        }
+        Thread.sleep(forTimeInterval: 0.01)
+        let cutoff = Date()
+        try stdout.write(Data("after\n".utf8))
+        try stdout.close()
+
+        let reader = try BinaryLogReader(directory: dir)
+        #expect(reader.index.count > 1)
+        #expect(reader.offset(since: BinaryLogFormat.nanoseconds(cutoff)) > 0)
+
+        let lines = try reader.readLines(streams: [.stdout], since: cutoff)
+        #expect(text(lines) == ["after\n"])
+    }
+
+    @Test("Reopening appends after the last complete record")
+    func reopenTruncatesTornRecord() throws {
+        let dir = try makeLogDir()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        let store = try BinaryLogStore(directory: dir)
+        let writer = store.makeWriter(stream: .stdout)
+        try writer.write(Data("first\n".utf8))
+        try writer.close()
+
+        // Simulate a crash in the middle of an append
+        let logPath = dir.appendingPathComponent(BinaryLogFormat.logFileName)
+        let handle = try FileHandle(forWritingTo: logPath)
+        try handle.seekToEnd()
+        try handle.write(contentsOf: Data([BinaryLogFormat.magic, LogStream.stdout.rawValue, 0, 0, 9]))
+        try handle.close()
+
+        let reopened = try BinaryLogStore(directory: dir)
+        let again = reopened.makeWriter(stream: .stdout)
+        try again.write(Data("second\n".utf8))
+        try again.close()
+
+        let lines = try BinaryLogReader(directory: dir).readLines(streams: [.stdout])
+        #expect(text(lines) == ["first\n", "second\n"])
+    }
+}
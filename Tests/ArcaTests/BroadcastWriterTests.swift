@@ -0,0 +1,231 @@
+import Testing
+import Foundation
+import Containerization
+@testable import ContainerBridge
+
+/// Broadcast Writer Tests
+/// Verifies fan-out of container output to the log and attach subscribers, and what each
+/// slow-subscriber policy delivers to a subscriber that falls behind its buffer
+///
+/// These tests run against temporary directories and do not need a running daemon
+@Suite("Broadcast Writer")
+struct BroadcastWriterTests {
+
+    /// Records writes; optionally holds the first write until released, or fails every write
+    /// @unchecked Sendable: Safe because all mutable state is protected by NSLock
+    private final class RecordingWriter: Writer, @unchecked Sendable {
+        struct Failure: Error {}
+
+        private let lock = NSLock()
+        private let hold = DispatchSemaphore(value: 0)
+        private let holdFirstWrite: Bool
+        private let fails: Bool
+        private var chunks: [Data] = []
+        private var writes = 0
+        private var closed = false
+
+        init(holdFirstWrite: Bool = false, fails: Bool = false) {
+            self.holdFirstWrite = holdFirstWrite
+            self.fails = fails
+        }
+
+        var received: [Data] {
+            lock.lock()
+            defer { lock.unlock() }
+            return chunks
+        }
+
+        var text: String {
+            String(decoding: received.reduce(Data(), +), as: UTF8.self)
+        }
+
+        /// Writes started, including one being held
+        var started: Int {
+            lock.lock()
+            defer { lock.unlock() }
+            return writes
+        }
+
+        var isClosed: Bool {
+            lock.lock()
+            defer { lock.unlock() }
+            return closed
+        }
+
+        func release() {
+            hold.signal()
+        }
+
+        func write(_ data: Data) throws {
+            lock.lock()
+            writes += 1
+            let first = writes == 1
+            lock.unlock()
+
+            if fails { throw Failure() }
+            if first && holdFirstWrite { hold.wait() }
+
+            lock.lock()
+            chunks.append(data)
+            lock.unlock()
+        }
+
+        func close() throws {
+            lock.lock()
+            closed = true
+            lock.unlock()
+        }
+    }
+
+    private func makeLogDirectory() throws -> URL {
+        let dir = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-broadcast-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+        return dir
+    }
+
+    /// Poll `condition` until it holds or a few seconds pass
+    private func waitUntil(_ condition: () -> Bool) async throws {
+        for _ in 0..<500 {
+            if condition() { return }
+            try await Task.sleep(for: .milliseconds(10))
+        }
+        Issue.record("Condition not reached in time")
+    }
+
+    /// 16 KB line tagged with its index
+    private func line(_ index: Int) -> Data {
+        let tag = "line-\(index) "
+        return Data((tag + String(repeating: "x", count: 16 * 1024 - tag.count - 1) + "\n").utf8)
+    }
+
+    /// Hold `subscriber` on its first write, then write enough to overflow a 64 KB buffer
+    private func overflow(_ broadcast: BroadcastWriter, _ subscriber: RecordingWriter, lines: Int) async throws {
+        try broadcast.write(Data("first\n".utf8))
+        try await waitUntil { subscriber.started == 1 }
+        for index in 0..<lines {
+            try broadcast.write(line(index))
+        }
+        subscriber.release()
+    }
+
+    @Test("Every chunk reaches the log inline and each subscriber in order")
+    func fanOut() async throws {
+        let log = RecordingWriter()
+        let broadcast = BroadcastWriter(initialSubscribers: [log], stream: .stdout)
+        let first = RecordingWriter()
+        let second = RecordingWriter()
+        broadcast.addSubscriber(first)
+        broadcast.addSubscriber(second)
+
+        let chunks = (0..<50).map { Data("chunk-\($0)\n".utf8) }
+        for chunk in chunks {
+            try broadcast.write(chunk)
+        }
+        #expect(log.received == chunks)
+
+        try broadcast.close()
+        try await waitUntil { first.isClosed && second.isClosed }
+        #expect(first.received == chunks)
+        #expect(second.received == chunks)
+        #expect(log.isClosed)
+    }
+
+    @Test("A failing subscriber is dropped without affecting the log or other subscribers")
+    func failingSubscriber() async throws {
+        let log = RecordingWriter()
+        let broadcast = BroadcastWriter(initialSubscribers: [log], stream: .stdout)
+        let broken = RecordingWriter(fails: true)
+        let healthy = RecordingWriter()
+        broadcast.addSubscriber(broken)
+        broadcast.addSubscriber(healthy)
+
+        try broadcast.write(Data("a".utf8))
+        try await waitUntil { broken.started == 1 && healthy.received.count == 1 }
+        try broadcast.write(Data("b".utf8))
+        try broadcast.write(Data("c".utf8))
+
+        try broadcast.close()
+        try await waitUntil { healthy.isClosed }
+        #expect(healthy.text == "abc")
+        #expect(log.text == "abc")
+        #expect(broken.started == 1)
+    }
+
+    @Test("A removed subscriber stops receiving output")
+    func removeSubscriber() async throws {
+        let broadcast = BroadcastWriter(stream: .stdout)
+        let subscriber = RecordingWriter()
+        broadcast.addSubscriber(subscriber)
+
+        try broadcast.write(Data("kept".utf8))
+        try await waitUntil { subscriber.received.count == 1 }
+        broadcast.removeSubscriber(subscriber)
+        try broadcast.write(Data("lost".utf8))
+
+        try await Task.sleep(for: .milliseconds(50))
+        #expect(subscriber.text == "kept")
+    }
+
+    @Test("drop-oldest delivers the newest output and reports how much was discarded")
+    func dropOldest() async throws {
+        let broadcast = BroadcastWriter(
+            stream: .stdout, config: OutputBufferConfig(slowSubscribers: .dropOldest, bufferSizeKB: 64))
+        let subscriber = RecordingWriter(holdFirstWrite: true)
+        broadcast.addSubscriber(subscriber)
+
+        // Ten 16 KB lines into a 64 KB buffer: the oldest six are discarded
+        try await overflow(broadcast, subscriber, lines: 10)
+        try broadcast.close()
+        try await waitUntil { subscriber.isClosed }
+
+        let expected = "first\n"
+            + "\n[arca: \(6 * 16 * 1024) bytes of output dropped, client too slow]\n"
+            + (6..<10).map { String(decoding: line($0), as: UTF8.self) }.joined()
+        #expect(subscriber.text == expected)
+    }
+
+    @Test("replay-from-log re-reads overflowed output from the log, losing nothing")
+    func replayFromLog() async throws {
+        let dir = try makeLogDirectory()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        let log = try FileLogWriter(path: dir.appendingPathComponent("stdout.log"), stream: "stdout")
+        let broadcast = BroadcastWriter(
+            initialSubscribers: [log], stream: .stdout,
+            config: OutputBufferConfig(slowSubscribers: .replayFromLog, bufferSizeKB: 64))
+        let subscriber = RecordingWriter(holdFirstWrite: true)
+        broadcast.addSubscriber(subscriber)
+
+        try await overflow(broadcast, subscriber, lines: 10)
+        try broadcast.close()
+        try await waitUntil { subscriber.isClosed }
+
+        let expected = "first\n" + (0..<10).map { String(decoding: line($0), as: UTF8.self) }.joined()
+        #expect(subscriber.text == expected)
+    }
+
+    @Test("replay-from-log without a log to re-read from falls back to drop-oldest")
+    func replayFromLogWithoutLog() async throws {
+        let broadcast = BroadcastWriter(
+            stream: .stdout, config: OutputBufferConfig(slowSubscribers: .replayFromLog, bufferSizeKB: 64))
+        let subscriber = RecordingWriter(holdFirstWrite: true)
+        broadcast.addSubscriber(subscriber)
+
+        try await overflow(broadcast, subscriber, lines: 10)
+        try broadcast.close()
+        try await waitUntil { subscriber.isClosed }
+
+        #expect(subscriber.text.contains("[arca: \(6 * 16 * 1024) bytes of output dropped"))
+        #expect(subscriber.text.hasSuffix(String(decoding: line(9), as: UTF8.self)))
+    }
+
+    @Test("Policies round-trip through their config names")
+    func policyNames() throws {
+        let json = Data(#"{"slowSubscribers":"replay-from-log","bufferSizeKB":128}"#.utf8)
+        let config = try JSONDecoder().decode(OutputBufferConfig.self, from: json)
+        #expect(config.slowSubscribers == .replayFromLog)
+        #expect(SlowSubscriberPolicy(rawValue: "drop-oldest") == .dropOldest)
+        #expect(SlowSubscriberPolicy(rawValue: "block") == nil)
+    }
+}
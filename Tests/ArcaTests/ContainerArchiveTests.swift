@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Comprehensive tests for container archive operations (Phase 6 - Task 6.5)
 /// Validates GET/PUT /containers/{id}/archive endpoints (docker cp functionality)
@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Comprehensive tests for container filesystem diff functionality (Phase 6 - Task 6.4)
 /// Validates GET /containers/{id}/changes endpoint against Docker Engine API v1.51 spec
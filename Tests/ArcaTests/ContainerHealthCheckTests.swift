@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Comprehensive tests for container health check functionality (Phase 6 - Task 6.2)
 /// Validates health check implementation against Docker Engine API v1.51 spec
@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Container Persistence Tests
 /// Tests container state persistence across daemon restarts by:
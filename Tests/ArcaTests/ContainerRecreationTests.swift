@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Tests container recreation from persisted state after daemon restart
 /// This validates Task 2 of Phase 3.7: Container Recreation
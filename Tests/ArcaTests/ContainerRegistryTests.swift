@@ -0,0 +1,156 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Container Registry Tests
+/// Verifies ID/name resolution, copy-on-write snapshot publication, secondary indexes and generations
+@Suite("Container Registry")
+struct ContainerRegistryTests {
+
+    private struct Entry: ContainerRegistryEntry {
+        let nativeID: String
+        var name: String?
+        var state: String = "created"
+        var labels: [String: String] = [:]
+        var image: String = "alpine:latest"
+        var imageID: String = "sha256:aaaa"
+        var networkIDs: [String] = []
+    }
+
+    private let idA = String(repeating: "ab12", count: 16)
+    private let idB = String(repeating: "ab12cd34", count: 8)
+
+    @Test("Full IDs, short IDs and names resolve")
+    func resolution() {
+        let registry = ContainerRegistry<Entry>()
+        registry.publish([
+            idA: Entry(nativeID: "native-a", name: "web"),
+            idB: Entry(nativeID: "native-b", name: "/db")
+        ])
+
+        let snapshot = registry.snapshot
+        #expect(snapshot.resolve(idA) == idA)
+        #expect(snapshot.resolve("ab12ab") == idA)
+        #expect(snapshot.resolve("AB12CD") == idB)
+        #expect(snapshot.resolve("web") == idA)
+        #expect(snapshot.resolve("/web") == idA)
+        #expect(snapshot.resolve("db") == idB)
+        #expect(snapshot.resolve("cache") == nil)
+        #expect(snapshot.dockerIDs["native-b"] == idB)
+
+        // Too short to be a short ID, and no such name
+        #expect(snapshot.resolve("ab1") == nil)
+
+        // An ambiguous prefix reports the match count and picks the lowest ID
+        var ambiguous = 0
+        #expect(snapshot.resolve("ab12", ambiguous: { ambiguous = $0 }) == idA)
+        #expect(ambiguous == 2)
+    }
+
+    @Test("Taken snapshots are unaffected by later writes")
+    func snapshotIsolation() {
+        let registry = ContainerRegistry<Entry>()
+        registry.publish([idA: Entry(nativeID: "native-a", name: "web")])
+        let before = registry.snapshot
+
+        var changed = registry.entries[idA]!
+        changed.state = "running"
+        changed.name = "api"
+        registry.update(idA, with: changed)
+        registry.update(idB, with: Entry(nativeID: "native-b", name: "db"))
+
+        #expect(before.entries[idA]?.state == "created")
+        #expect(before.resolve("web") == idA)
+        #expect(before.entries[idB] == nil)
+
+        let after = registry.snapshot
+        #expect(after.entries[idA]?.state == "running")
+        #expect(after.resolve("web") == nil)
+        #expect(after.resolve("api") == idA)
+        #expect(after.resolve("db") == idB)
+    }
+
+    @Test("Indexes follow updates and removals")
+    func indexes() {
+        let registry = ContainerRegistry<Entry>()
+        registry.publish([
+            idA: Entry(nativeID: "native-a", name: "web", state: "running", labels: ["tier": "front"], networkIDs: ["net1"]),
+            idB: Entry(nativeID: "native-b", name: "db", labels: ["tier": "back"], image: "postgres:16", imageID: "sha256:bbbb")
+        ])
+
+        var snapshot = registry.snapshot
+        #expect(snapshot.byState["running"] == [idA])
+        #expect(snapshot.byState["created"] == [idB])
+        #expect(snapshot.labelled("tier") == [idA, idB])
+        #expect(snapshot.labelled("tier", value: "back") == [idB])
+        #expect(snapshot.labelled("missing").isEmpty)
+        #expect(snapshot.byNetwork["net1"] == [idA])
+        #expect(snapshot.byImage["postgres:16"] == [idB])
+        #expect(snapshot.byImageID["sha256:aaaa"] == [idA])
+
+        var changed = snapshot.entries[idA]!
+        changed.state = "exited"
+        changed.labels = [:]
+        changed.networkIDs = ["net2"]
+        registry.update(idA, with: changed)
+        registry.remove(idB)
+
+        snapshot = registry.snapshot
+        #expect(snapshot.byState["running"] == nil)
+        #expect(snapshot.byState["exited"] == [idA])
+        #expect(snapshot.byState["created"] == nil)
+        #expect(snapshot.byLabel.isEmpty)
+        #expect(snapshot.byNetwork == ["net2": [idA]])
+        #expect(snapshot.byImage["postgres:16"] == nil)
+        #expect(snapshot.resolve("db") == nil)
+        #expect(snapshot.dockerIDs["native-b"] == nil)
+    }
+
+    @Test("Generations move only for the entry that changed, including health changes")
+    func generations() throws {
+        let registry = ContainerRegistry<Entry>()
+        registry.publish([
+            idA: Entry(nativeID: "native-a", name: "web"),
+            idB: Entry(nativeID: "native-b", name: "db")
+        ])
+        let initial = registry.snapshot.generations
+
+        registry.update(idA, with: Entry(nativeID: "native-a", name: "web", state: "running"))
+        var current = registry.snapshot.generations
+        let afterUpdate = try #require(current[idA])
+        #expect(afterUpdate > initial[idA]!)
+        #expect(current[idB] == initial[idB])
+
+        registry.updateHealth(Health(status: "healthy", failingStreak: 0, log: nil), for: idA)
+        current = registry.snapshot.generations
+        #expect(current[idA]! > afterUpdate)
+        #expect(current[idB] == initial[idB])
+
+        registry.remove(idA)
+        #expect(registry.snapshot.generations[idA] == nil)
+    }
+
+    @Test("Health status is indexed and dropped with its container")
+    func health() {
+        let registry = ContainerRegistry<Entry>()
+        registry.publish([idA: Entry(nativeID: "native-a", name: "web")])
+
+        registry.updateHealth(Health(status: "starting", failingStreak: 0, log: nil), for: idA)
+        #expect(registry.snapshot.byHealth["starting"] == [idA])
+
+        registry.updateHealth(Health(status: "unhealthy", failingStreak: 3, log: nil), for: idA)
+        var snapshot = registry.snapshot
+        #expect(snapshot.byHealth["starting"] == nil)
+        #expect(snapshot.byHealth["unhealthy"] == [idA])
+        #expect(snapshot.health[idA]?.failingStreak == 3)
+
+        // Unknown containers are ignored rather than indexed
+        registry.updateHealth(Health(status: "healthy", failingStreak: 0, log: nil), for: idB)
+        #expect(registry.snapshot.health[idB] == nil)
+
+        registry.remove(idA)
+        snapshot = registry.snapshot
+        #expect(snapshot.health.isEmpty)
+        #expect(snapshot.byHealth.isEmpty)
+    }
+}
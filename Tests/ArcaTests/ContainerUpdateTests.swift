@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Tests for Container Update Endpoint (Phase 6 - Task 6.1)
 /// Validates POST /containers/{id}/update endpoint against Docker Engine API v1.51 spec
@@ -0,0 +1,64 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Disk Usage Tests
+/// Verifies allocated-size accounting for sparse files and parallel directory scans
+@Suite("Disk Usage")
+struct DiskUsageTests {
+
+    private func makeTempDirectory() throws -> URL {
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("arca-du-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: url, withIntermediateDirectories: true)
+        return url
+    }
+
+    @Test("Sparse files report allocated rather than apparent size")
+    func sparseFile() throws {
+        let dir = try makeTempDirectory()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        let path = dir.appendingPathComponent("volume.img").path
+        FileManager.default.createFile(atPath: path, contents: nil)
+        let handle = try FileHandle(forWritingTo: URL(fileURLWithPath: path))
+        try handle.truncate(atOffset: 1 << 30)
+        try handle.close()
+
+        let allocated = try #require(DiskUsage.allocatedSize(ofFile: path))
+        #expect(allocated < 1 << 20)
+        #expect(DiskUsage.allocatedSize(ofFile: dir.appendingPathComponent("missing").path) == nil)
+    }
+
+    @Test("Scans sum nested files and count hard links once")
+    func scan() async throws {
+        let dir = try makeTempDirectory()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        let data = Data(repeating: 0xAB, count: 64 * 1024)
+        for branch in 0..<4 {
+            let nested = dir.appendingPathComponent("b\(branch)/deep/er")
+            try FileManager.default.createDirectory(at: nested, withIntermediateDirectories: true)
+            try data.write(to: nested.appendingPathComponent("file"))
+        }
+        let single = await DiskUsage.scan(directory: dir.path, deadline: .now + .seconds(10))
+
+        try FileManager.default.linkItem(
+            at: dir.appendingPathComponent("b0/deep/er/file"),
+            to: dir.appendingPathComponent("b1/link")
+        )
+        let linked = await DiskUsage.scan(directory: dir.path, deadline: .now + .seconds(10), workers: 2)
+
+        #expect(single.complete)
+        #expect(single.bytes >= 4 * 64 * 1024)
+        #expect(linked.bytes == single.bytes)
+    }
+
+    @Test("An expired deadline yields an incomplete result")
+    func deadline() async throws {
+        let dir = try makeTempDirectory()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        let result = await DiskUsage.scan(directory: dir.path, deadline: .now - .seconds(1))
+        #expect(!result.complete)
+    }
+}
@@ -0,0 +1,112 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// EXT4 Template Store Tests
+/// Verifies template reuse, clone output, size-class eviction, concurrent creates and cleanup of
+/// interrupted formats
+@Suite("EXT4 Template Store")
+struct EXT4TemplateStoreTests {
+
+    private static let sizeBytes: UInt64 = 64 * 1024 * 1024
+
+    private func makeDirectory() throws -> URL {
+        let directory = FileManager.default.temporaryDirectory.appendingPathComponent("arca-ext4-templates-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        return directory
+    }
+
+    private func templates(in directory: URL) throws -> [String] {
+        try FileManager.default.contentsOfDirectory(atPath: directory.appendingPathComponent("templates").path).sorted()
+    }
+
+    @Test("One template per size class serves every filesystem of that size")
+    func templateReuse() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = EXT4TemplateStore(directory: directory.appendingPathComponent("templates"))
+
+        let first = directory.appendingPathComponent("a.ext4").path
+        let second = directory.appendingPathComponent("b.ext4").path
+        try store.createFilesystem(at: first, sizeBytes: Self.sizeBytes)
+        try store.createFilesystem(at: second, sizeBytes: Self.sizeBytes)
+
+        let templateNames = try templates(in: directory)
+        #expect(templateNames.count == 1)
+
+        // Clones (or in-place formats) are byte-identical to the template
+        let template = directory.appendingPathComponent("templates").appendingPathComponent(templateNames[0])
+        let expected = try Data(contentsOf: template)
+        #expect(try Data(contentsOf: URL(fileURLWithPath: first)) == expected)
+        #expect(try Data(contentsOf: URL(fileURLWithPath: second)) == expected)
+    }
+
+    @Test("Creating over an existing file fails instead of replacing it")
+    func existingDestination() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = EXT4TemplateStore(directory: directory.appendingPathComponent("templates"))
+
+        let path = directory.appendingPathComponent("a.ext4").path
+        #expect(FileManager.default.createFile(atPath: path, contents: Data("keep".utf8)))
+        #expect(throws: (any Error).self) {
+            try store.createFilesystem(at: path, sizeBytes: Self.sizeBytes)
+        }
+        #expect(try Data(contentsOf: URL(fileURLWithPath: path)) == Data("keep".utf8))
+    }
+
+    @Test("Least recently used size classes are removed beyond the limit")
+    func eviction() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = EXT4TemplateStore(directory: directory.appendingPathComponent("templates"), maxTemplates: 1)
+
+        try store.createFilesystem(at: directory.appendingPathComponent("a.ext4").path, sizeBytes: Self.sizeBytes)
+        try store.createFilesystem(at: directory.appendingPathComponent("b.ext4").path, sizeBytes: Self.sizeBytes * 2)
+
+        let templateNames = try templates(in: directory)
+        #expect(templateNames == ["empty-\(Self.sizeBytes * 2)-default.ext4"])
+
+        // Filesystems cloned from an evicted template are unaffected
+        #expect(FileManager.default.fileExists(atPath: directory.appendingPathComponent("a.ext4").path))
+    }
+
+    @Test("Concurrent creates of several size classes format each template once")
+    func concurrentCreates() async throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let store = EXT4TemplateStore(directory: directory.appendingPathComponent("templates"), maxTemplates: 1)
+
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for index in 0..<8 {
+                let path = directory.appendingPathComponent("\(index).ext4").path
+                let sizeBytes = Self.sizeBytes * UInt64(index % 2 + 1)
+                group.addTask {
+                    try store.createFilesystem(at: path, sizeBytes: sizeBytes)
+                }
+            }
+            try await group.waitForAll()
+        }
+
+        // Every filesystem was created even though the two size classes kept evicting each other
+        for index in 0..<8 {
+            #expect(FileManager.default.fileExists(atPath: directory.appendingPathComponent("\(index).ext4").path))
+        }
+        #expect(try templates(in: directory).allSatisfy { $0.hasSuffix(".ext4") })
+    }
+
+    @Test("Interrupted formats are discarded and finished templates adopted")
+    func adoption() throws {
+        let directory = try makeDirectory()
+        defer { try? FileManager.default.removeItem(at: directory) }
+        let templateDirectory = directory.appendingPathComponent("templates")
+
+        let store = EXT4TemplateStore(directory: templateDirectory)
+        try store.createFilesystem(at: directory.appendingPathComponent("a.ext4").path, sizeBytes: Self.sizeBytes)
+        let partial = templateDirectory.appendingPathComponent("empty-1-default.partial")
+        #expect(FileManager.default.createFile(atPath: partial.path, contents: Data()))
+
+        _ = EXT4TemplateStore(directory: templateDirectory)
+        #expect(try templates(in: directory) == ["empty-\(Self.sizeBytes)-default.ext4"])
+    }
+}
@@ -0,0 +1,88 @@
+import Testing
+import Foundation
+import Logging
+@testable import DockerAPI
+
+/// Event Manager Tests
+/// Verifies history replay, ring eviction and indexed subscriber delivery
+@Suite("Event Manager")
+struct EventManagerTests {
+
+    private func event(_ type: String, _ action: String, id: String, name: String? = nil, time: Int64) -> EventMessage {
+        let attributes = name.map { ["name": $0] } ?? [:]
+        return EventMessage(
+            type: type,
+            action: action,
+            actor: EventActor(id: id, attributes: attributes),
+            time: time,
+            timeNano: time * 1_000_000_000
+        )
+    }
+
+    private func collect(_ stream: AsyncStream<EventMessage>) async -> [String] {
+        var actions: [String] = []
+        for await event in stream {
+            actions.append("\(event.type):\(event.action):\(event.actor.id)")
+        }
+        return actions
+    }
+
+    @Test("since replays from the retained history only")
+    func replay() async {
+        let manager = EventManager(logger: Logger(label: "arca.tests.events"), historySize: 3)
+        for (offset, action) in ["create", "start", "die", "destroy"].enumerated() {
+            await manager.emit(event("container", action, id: "c1", time: 100 + Int64(offset)))
+        }
+
+        let until = Date(timeIntervalSince1970: 102)
+        let all = await manager.subscribe(since: Date(timeIntervalSince1970: 0), until: until, filters: nil)
+        #expect(await collect(all) == ["container:start:c1", "container:die:c1"])
+
+        let recent = await manager.subscribe(since: Date(timeIntervalSince1970: 103), until: Date(timeIntervalSince1970: 200), filters: nil)
+        #expect(await collect(recent) == ["container:destroy:c1"])
+    }
+
+    @Test("Live events reach only subscribers whose filters match")
+    func delivery() async {
+        let manager = EventManager(logger: Logger(label: "arca.tests.events"))
+        let now = Int64(Date().timeIntervalSince1970)
+        let until = Date(timeIntervalSince1970: TimeInterval(now + 3600))
+
+        let byName = await manager.subscribe(since: nil, until: until, filters: EventFilters(container: ["web"]))
+        let byPrefix = await manager.subscribe(since: nil, until: until, filters: EventFilters(container: ["abc"], event: ["start"]))
+        let images = await manager.subscribe(since: nil, until: until, filters: EventFilters(type: ["image"]))
+        let everything = await manager.subscribe(since: nil, until: until, filters: nil)
+
+        await manager.emit(event("container", "start", id: "abc123", name: "web", time: now))
+        await manager.emit(event("container", "stop", id: "abc123", name: "web", time: now))
+        await manager.emit(event("container", "start", id: "def456", name: "db", time: now))
+        await manager.emit(event("image", "pull", id: "alpine", time: now))
+        // Reaching until ends every bounded stream
+        await manager.emit(event("volume", "create", id: "v1", time: now + 3600))
+
+        #expect(await collect(byName) == ["container:start:abc123", "container:stop:abc123"])
+        #expect(await collect(byPrefix) == ["container:start:abc123"])
+        #expect(await collect(images) == ["image:pull:alpine"])
+        #expect(await collect(everything) == [
+            "container:start:abc123", "container:stop:abc123", "container:start:def456", "image:pull:alpine"
+        ])
+    }
+
+    @Test("Filters compile to the narrowest index route")
+    func routes() {
+        #expect(SubscriberIndex.Route(nil) == .all)
+        #expect(SubscriberIndex.Route(EventFilters(event: ["start"])) == .all)
+        #expect(SubscriberIndex.Route(EventFilters(type: ["network", "volume"])) == .types(["network", "volume"]))
+        #expect(SubscriberIndex.Route(EventFilters(container: ["web", "abc"])) == .actors(type: "container", keys: ["web", "abc"]))
+        #expect(SubscriberIndex.Route(EventFilters(container: ["web"], type: ["image"])) == .unmatchable)
+        #expect(SubscriberIndex.Route(EventFilters(container: ["web"], image: ["alpine"])) == .unmatchable)
+
+        var index = SubscriberIndex()
+        let id = UUID()
+        index.insert(id, route: .actors(type: "container", keys: ["ab"]))
+        #expect(index.candidates(for: event("container", "start", id: "abcdef", time: 0)) == [id])
+        #expect(index.candidates(for: event("image", "pull", id: "abcdef", time: 0)).isEmpty)
+        index.remove(id, route: .actors(type: "container", keys: ["ab"]))
+        #expect(index.candidates(for: event("container", "start", id: "abcdef", time: 0)).isEmpty)
+    }
+}
@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Full Persistence Integration Tests
 /// Tests complete persistence flow with networks, containers, restart policies, and volumes by:
@@ -0,0 +1,42 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Health Probe Tests
+/// Verifies which health check tests are recognised as native HTTP/TCP probes
+@Suite("Health Probes")
+struct HealthProbeTests {
+
+    @Test("curl with --fail and wget become HTTP probes")
+    func httpProbes() {
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "curl", "-f", "http://localhost:8080/health"])
+            == .http("http://localhost:8080/health"))
+        #expect(HealthChecker.nativeProbe(for: ["CMD-SHELL", "curl -fsS http://localhost/ || exit 1"])
+            == .http("http://localhost/"))
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "/usr/bin/curl", "--fail", "--silent", "-o", "/dev/null", "https://127.0.0.1/ready"])
+            == .http("https://127.0.0.1/ready"))
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "wget", "-q", "--spider", "http://localhost:3000"])
+            == .http("http://localhost:3000"))
+        #expect(HealthChecker.nativeProbe(for: ["CMD-SHELL", "wget -qO- http://localhost/ping"])
+            == .http("http://localhost/ping"))
+    }
+
+    @Test("nc -z becomes a TCP probe")
+    func tcpProbes() {
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "nc", "-z", "localhost", "5432"]) == .tcp("localhost:5432"))
+        #expect(HealthChecker.nativeProbe(for: ["CMD-SHELL", "nc -zv -w 2 127.0.0.1 6379"]) == .tcp("127.0.0.1:6379"))
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "nc", "-z", "::1", "80"]) == .tcp("[::1]:80"))
+    }
+
+    @Test("Ambiguous or shell-dependent checks keep running as commands")
+    func fallbacks() {
+        // curl without --fail succeeds on HTTP errors
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "curl", "http://localhost/"]) == nil)
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "curl", "-f", "-H", "Host: x", "http://localhost/"]) == nil)
+        #expect(HealthChecker.nativeProbe(for: ["CMD-SHELL", "curl -f http://localhost/ | grep ok"]) == nil)
+        #expect(HealthChecker.nativeProbe(for: ["CMD-SHELL", "curl -f http://$HOST/"]) == nil)
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "nc", "localhost", "80"]) == nil)
+        #expect(HealthChecker.nativeProbe(for: ["CMD", "pg_isready"]) == nil)
+        #expect(HealthChecker.nativeProbe(for: ["NONE"]) == nil)
+    }
+}
@@ -0,0 +1,257 @@
+import Testing
+import Foundation
+import Logging
+import NIO
+import CryptoKit
+@testable import ContainerBridge
+
+/// Image Archive Ingester Tests
+/// Verifies tar parsing across chunk boundaries, PAX and GNU long names, blob digest
+/// verification, and hard-linking blobs the content store already holds
+@Suite("Image Archive Ingester")
+struct ImageArchiveIngesterTests {
+
+    private static let index = Data(#"{"schemaVersion":2,"manifests":[]}"#.utf8)
+    private static let layout = Data(#"{"imageLayoutVersion":"1.0.0"}"#.utf8)
+
+    // MARK: - Tar construction
+
+    private struct Entry {
+        var name: String
+        var data: Data = Data()
+        var typeflag: UInt8 = UInt8(ascii: "0")
+        var linkName: String = ""
+    }
+
+    private static func header(_ entry: Entry) -> [UInt8] {
+        var block = [UInt8](repeating: 0, count: 512)
+        func put(_ string: String, at offset: Int, length: Int) {
+            for (index, byte) in string.utf8.prefix(length).enumerated() {
+                block[offset + index] = byte
+            }
+        }
+        func octal(_ value: Int, at offset: Int, length: Int) {
+            put(String(format: "%0\(length - 1)o", value), at: offset, length: length - 1)
+        }
+
+        put(entry.name, at: 0, length: 100)
+        octal(0o644, at: 100, length: 8)
+        octal(0, at: 108, length: 8)
+        octal(0, at: 116, length: 8)
+        octal(entry.data.count, at: 124, length: 12)
+        octal(0, at: 136, length: 12)
+        block[156] = entry.typeflag
+        put(entry.linkName, at: 157, length: 100)
+        put("ustar", at: 257, length: 6)
+        put("00", at: 263, length: 2)
+
+        // Checksum is computed with its own field set to spaces
+        for index in 148..<156 { block[index] = UInt8(ascii: " ") }
+        let sum = block.reduce(0) { $0 + Int($1) }
+        put(String(format: "%06o", sum), at: 148, length: 6)
+        block[154] = 0
+        block[155] = UInt8(ascii: " ")
+        return block
+    }
+
+    private static func tar(_ entries: [Entry]) -> Data {
+        var archive = Data()
+        for entry in entries {
+            archive.append(contentsOf: header(entry))
+            archive.append(entry.data)
+            let padding = (512 - entry.data.count % 512) % 512
+            archive.append(Data(count: padding))
+        }
+        // End-of-archive marker
+        archive.append(Data(count: 1024))
+        return archive
+    }
+
+    private static func paxRecord(_ key: String, _ value: String) -> String {
+        // The length prefix counts itself
+        let body = " \(key)=\(value)\n"
+        var length = body.utf8.count + 1
+        while "\(length)".count + body.utf8.count != length {
+            length += 1
+        }
+        return "\(length)\(body)"
+    }
+
+    private static func digest(_ data: Data) -> String {
+        SHA256.hash(data: data).map { String(format: "%02x", $0) }.joined()
+    }
+
+    private static func metadataEntries() -> [Entry] {
+        [Entry(name: "oci-layout", data: layout), Entry(name: "index.json", data: index)]
+    }
+
+    // MARK: - Harness
+
+    private func makeDirectories() throws -> (root: URL, layout: URL, content: URL) {
+        let root = FileManager.default.temporaryDirectory.appendingPathComponent("arca-ingest-\(UUID().uuidString)")
+        let layout = root.appendingPathComponent("layout")
+        let content = root.appendingPathComponent("content/blobs")
+        try FileManager.default.createDirectory(at: layout, withIntermediateDirectories: true)
+        try FileManager.default.createDirectory(at: content.appendingPathComponent("sha256"), withIntermediateDirectories: true)
+        return (root, layout, content)
+    }
+
+    /// Feed `archive` in chunks of `chunkSize` bytes and finish
+    private func ingest(_ archive: Data, layout: URL, content: URL, chunkSize: Int = 4096) throws -> ImageArchiveIngester.Result {
+        let ingester = ImageArchiveIngester(
+            layoutDirectory: layout,
+            contentBlobsDirectory: content,
+            logger: Logger(label: "arca.tests.ingest")
+        )
+        var offset = 0
+        while offset < archive.count {
+            let end = min(offset + chunkSize, archive.count)
+            try ingester.ingest(ByteBuffer(bytes: archive[offset..<end]))
+            offset = end
+        }
+        return try ingester.finish()
+    }
+
+    // MARK: - Tests
+
+    @Test("Layout files and blobs are written; legacy docker-archive entries are skipped")
+    func layoutAndBlobs() throws {
+        let (root, layout, content) = try makeDirectories()
+        defer { try? FileManager.default.removeItem(at: root) }
+
+        let blob = Data(repeating: 0x41, count: 1500)
+        let archive = Self.tar(Self.metadataEntries() + [
+            Entry(name: "manifest.json", data: Data("[]".utf8)),
+            Entry(name: "blobs/", typeflag: UInt8(ascii: "5")),
+            Entry(name: "blobs/sha256/\(Self.digest(blob))", data: blob),
+        ])
+
+        let result = try ingest(archive, layout: layout, content: content)
+        #expect(result.blobsWritten == 1)
+        #expect(result.bytesWritten == Int64(blob.count))
+        #expect(result.bytesSkipped == 2)
+        #expect(try Data(contentsOf: layout.appendingPathComponent("index.json")) == Self.index)
+        #expect(try Data(contentsOf: layout.appendingPathComponent("blobs/sha256/\(Self.digest(blob))")) == blob)
+        #expect(!FileManager.default.fileExists(atPath: layout.appendingPathComponent("manifest.json").path))
+    }
+
+    @Test("Headers and bodies split across one-byte chunks parse the same")
+    func tinyChunks() throws {
+        let (root, layout, content) = try makeDirectories()
+        defer { try? FileManager.default.removeItem(at: root) }
+
+        let blob = Data((0..<700).map { UInt8($0 % 251) })
+        let archive = Self.tar(Self.metadataEntries() + [
+            Entry(name: "./blobs/sha256/\(Self.digest(blob))", data: blob),
+        ])
+
+        let result = try ingest(archive, layout: layout, content: content, chunkSize: 1)
+        #expect(result.blobsWritten == 1)
+        #expect(try Data(contentsOf: layout.appendingPathComponent("blobs/sha256/\(Self.digest(blob))")) == blob)
+    }
+
+    @Test("A blob whose content doesn't match its path digest is rejected and removed")
+    func digestMismatch() throws {
+        let (root, layout, content) = try makeDirectories()
+        defer { try? FileManager.default.removeItem(at: root) }
+
+        let claimed = Self.digest(Data("expected".utf8))
+        let archive = Self.tar(Self.metadataEntries() + [
+            Entry(name: "blobs/sha256/\(claimed)", data: Data("tampered".utf8)),
+        ])
+
+        #expect(throws: ImageManagerError.self) {
+            try ingest(archive, layout: layout, content: content)
+        }
+        #expect(!FileManager.default.fileExists(atPath: layout.appendingPathComponent("blobs/sha256/\(claimed)").path))
+    }
+
+    @Test("Blobs already in the content store are hard-linked and their bytes skipped")
+    func contentStoreHardLink() throws {
+        let (root, layout, content) = try makeDirectories()
+        defer { try? FileManager.default.removeItem(at: root) }
+
+        let blob = Data(repeating: 0x42, count: 2048)
+        let digest = Self.digest(blob)
+        let stored = content.appendingPathComponent("sha256/\(digest)")
+        try blob.write(to: stored)
+
+        let archive = Self.tar(Self.metadataEntries() + [Entry(name: "blobs/sha256/\(digest)", data: blob)])
+        let result = try ingest(archive, layout: layout, content: content)
+
+        #expect(result.blobsDeduplicated == 1)
+        #expect(result.blobsWritten == 0)
+        #expect(result.bytesWritten == 0)
+        #expect(result.bytesSkipped == Int64(blob.count))
+
+        // Same inode as the content store's copy: linked, not rewritten
+        let linked = layout.appendingPathComponent("blobs/sha256/\(digest)")
+        let storedInode = try FileManager.default.attributesOfItem(atPath: stored.path)[.systemFileNumber] as? Int
+        let linkedInode = try FileManager.default.attributesOfItem(atPath: linked.path)[.systemFileNumber] as? Int
+        #expect(storedInode != nil && storedInode == linkedInode)
+    }
+
+    @Test("Tar hard-link entries are skipped without consuming the following entry")
+    func tarHardLinkEntry() throws {
+        let (root, layout, content) = try makeDirectories()
+        defer { try? FileManager.default.removeItem(at: root) }
+
+        let blob = Data(repeating: 0x43, count: 600)
+        let digest = Self.digest(blob)
+        let archive = Self.tar(Self.metadataEntries() + [
+            Entry(name: "blobs/sha256/\(digest)", data: blob),
+            Entry(name: "legacy/layer.tar", typeflag: UInt8(ascii: "1"), linkName: "blobs/sha256/\(digest)"),
+        ])
+
+        let result = try ingest(archive, layout: layout, content: content)
+        #expect(result.blobsWritten == 1)
+        #expect(!FileManager.default.fileExists(atPath: layout.appendingPathComponent("legacy").path))
+    }
+
+    @Test("PAX and GNU long names replace the header name of the next entry")
+    func longNames() throws {
+        let (root, layout, content) = try makeDirectories()
+        defer { try? FileManager.default.removeItem(at: root) }
+
+        let paxBlob = Data("pax".utf8)
+        let gnuBlob = Data("gnu".utf8)
+        let pax = Data(Self.paxRecord("path", "blobs/sha256/\(Self.digest(paxBlob))").utf8)
+        let gnu = Data(("blobs/sha256/\(Self.digest(gnuBlob))" + "\0").utf8)
+
+        let archive = Self.tar(Self.metadataEntries() + [
+            Entry(name: "PaxHeaders/x", data: pax, typeflag: UInt8(ascii: "x")),
+            Entry(name: "truncated-name", data: paxBlob),
+            Entry(name: "././@LongLink", data: gnu, typeflag: UInt8(ascii: "L")),
+            Entry(name: "truncated-name", data: gnuBlob),
+        ])
+
+        let result = try ingest(archive, layout: layout, content: content)
+        #expect(result.blobsWritten == 2)
+        #expect(FileManager.default.fileExists(atPath: layout.appendingPathComponent("blobs/sha256/\(Self.digest(paxBlob))").path))
+        #expect(FileManager.default.fileExists(atPath: layout.appendingPathComponent("blobs/sha256/\(Self.digest(gnuBlob))").path))
+    }
+
+    @Test("Corrupt headers, truncated archives and missing index.json are rejected")
+    func malformedArchives() throws {
+        let (root, layout, content) = try makeDirectories()
+        defer { try? FileManager.default.removeItem(at: root) }
+
+        var corrupt = Self.tar(Self.metadataEntries())
+        corrupt[0] ^= 0xff
+        #expect(throws: ImageManagerError.self) {
+            try ingest(corrupt, layout: layout, content: content)
+        }
+
+        let truncated = Self.tar(Self.metadataEntries()).prefix(512 + 10)
+        #expect(throws: ImageManagerError.self) {
+            try ingest(Data(truncated), layout: layout, content: content)
+        }
+
+        let noIndex = Self.tar([Entry(name: "oci-layout", data: Self.layout)])
+        let emptyLayout = root.appendingPathComponent("empty")
+        try FileManager.default.createDirectory(at: emptyLayout, withIntermediateDirectories: true)
+        #expect(throws: ImageManagerError.self) {
+            try ingest(noIndex, layout: emptyLayout, content: content)
+        }
+    }
+}
@@ -0,0 +1,85 @@
+import Testing
+import Foundation
+import Logging
+@testable import ContainerBridge
+
+/// Layer Cache Eviction Tests
+/// Verifies that eviction skips layers pinned by an unpack, including pins taken while a
+/// collection is already running
+@Suite("Layer Cache Eviction")
+struct LayerCacheEvictionTests {
+
+    /// Set once the unpacker exists, so `layersInUse` can act on it mid-collection
+    private final class UnpackerBox: @unchecked Sendable {
+        var unpacker: OverlayFSUnpacker?
+    }
+
+    private func makeCache(layers: [String]) async throws -> (StateStore, URL, [String: URL]) {
+        let dir = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-layer-eviction-\(UUID().uuidString)")
+        let store = try StateStore(path: dir.appendingPathComponent("state.db").path, logger: Logger(label: "arca.tests.layers"))
+
+        var directories: [String: URL] = [:]
+        for digest in layers {
+            let layerDir = dir.appendingPathComponent("layers").appendingPathComponent(UUID().uuidString)
+            try FileManager.default.createDirectory(at: layerDir, withIntermediateDirectories: true)
+            let layerFile = layerDir.appendingPathComponent("layer.ext4")
+            #expect(FileManager.default.createFile(atPath: layerFile.path, contents: Data(count: 1024)))
+            try await store.recordLayerCache(digest: digest, path: layerFile.path, size: 1024)
+            directories[digest] = layerDir
+        }
+        return (store, dir, directories)
+    }
+
+    private func makeUnpacker(
+        store: StateStore,
+        dir: URL,
+        layersInUse: @escaping @Sendable () async -> Set<String> = { [] }
+    ) -> OverlayFSUnpacker {
+        // A zero limit evicts every layer that isn't protected
+        OverlayFSUnpacker(
+            layerCachePath: dir.appendingPathComponent("layers"),
+            stateStore: store,
+            config: LayerCacheConfig(maxSizeMB: 0, prefetchOnPull: false),
+            layersInUse: layersInUse,
+            logger: Logger(label: "arca.tests.layers")
+        )
+    }
+
+    @Test("Pinned layers survive a collection and are evicted once unpinned")
+    func pinnedLayers() async throws {
+        let (store, dir, directories) = try await makeCache(layers: ["sha256:pinned", "sha256:idle"])
+        defer { try? FileManager.default.removeItem(at: dir) }
+        let unpacker = makeUnpacker(store: store, dir: dir)
+
+        await unpacker.pin(["sha256:pinned"])
+        await unpacker.collectGarbage()
+        #expect(FileManager.default.fileExists(atPath: directories["sha256:pinned"]!.path))
+        #expect(!FileManager.default.fileExists(atPath: directories["sha256:idle"]!.path))
+        #expect(try await store.loadLayerCache(digest: "sha256:pinned") != nil)
+
+        await unpacker.unpin(["sha256:pinned"])
+        await unpacker.collectGarbage()
+        #expect(!FileManager.default.fileExists(atPath: directories["sha256:pinned"]!.path))
+        #expect(try await store.loadLayerCache(digest: "sha256:pinned") == nil)
+    }
+
+    @Test("A layer pinned after a collection started is kept, even if already unpinned")
+    func pinDuringCollection() async throws {
+        let (store, dir, directories) = try await makeCache(layers: ["sha256:racing", "sha256:idle"])
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        // An unpack runs to completion while the collection waits for `layersInUse`
+        let box = UnpackerBox()
+        let unpacker = makeUnpacker(store: store, dir: dir) {
+            await box.unpacker?.pin(["sha256:racing"])
+            await box.unpacker?.unpin(["sha256:racing"])
+            return []
+        }
+        box.unpacker = unpacker
+
+        await unpacker.collectGarbage()
+        #expect(FileManager.default.fileExists(atPath: directories["sha256:racing"]!.path))
+        #expect(!FileManager.default.fileExists(atPath: directories["sha256:idle"]!.path))
+    }
+}
@@ -0,0 +1,194 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Log Replay Tests
+/// Verifies the merge of json-file stdout/stderr logs, the JSON line parser, tail/since filters,
+/// the handoff from replay to a live follower, and follower overflow handling
+///
+/// These tests run against temporary directories and do not need a running daemon
+@Suite("Log Replay")
+struct LogReplayTests {
+
+    private func makeLogPaths() throws -> ContainerLogManager.LogPaths {
+        let dir = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-replay-\(UUID().uuidString)")
+        try FileManager.default.createDirectory(at: dir, withIntermediateDirectories: true)
+        return ContainerLogManager.LogPaths(
+            stdoutPath: dir.appendingPathComponent("stdout.log"),
+            stderrPath: dir.appendingPathComponent("stderr.log"),
+            combinedPath: dir.appendingPathComponent("combined.log"),
+            driver: .jsonFile,
+            logDir: dir
+        )
+    }
+
+    private func entry(_ stream: String, _ log: String, _ time: String) -> String {
+        "{\"stream\":\"\(stream)\",\"log\":\"\(log)\",\"time\":\"\(time)\"}\n"
+    }
+
+    private func text(_ replay: LogReplay) throws -> [String] {
+        var lines: [String] = []
+        while let line = try replay.next() {
+            lines.append(String(decoding: line.message, as: UTF8.self))
+        }
+        return lines
+    }
+
+    @Test("Streams are merged in timestamp order")
+    func mergeOrder() throws {
+        let paths = try makeLogPaths()
+        defer { try? FileManager.default.removeItem(at: paths.logDir) }
+
+        try (entry("stdout", "a\\n", "2025-01-17T12:00:00.100000000Z")
+            + entry("stdout", "c\\n", "2025-01-17T12:00:00.300000000Z")
+            + "not json\n"
+            + entry("stdout", "e\\n", "2025-01-17T12:00:01Z"))
+            .write(to: paths.stdoutPath, atomically: true, encoding: .utf8)
+        try (entry("stderr", "b\\n", "2025-01-17T12:00:00.200000000Z")
+            + entry("stderr", "d\\n", "2025-01-17T14:00:00.400+02:00"))
+            .write(to: paths.stderrPath, atomically: true, encoding: .utf8)
+
+        let replay = try LogReplay(logPaths: paths, streams: [.stdout, .stderr])
+        #expect(try text(replay) == ["a\n", "b\n", "c\n", "d\n", "e\n"])
+
+        let stderrOnly = try LogReplay(logPaths: paths, streams: [.stderr])
+        #expect(try text(stderrOnly) == ["b\n", "d\n"])
+    }
+
+    @Test("JSON escapes decode to the original bytes")
+    func escapes() throws {
+        let paths = try makeLogPaths()
+        defer { try? FileManager.default.removeItem(at: paths.logDir) }
+
+        try entry("stdout", "say \\\"hi\\\"\\t\\u00e9\\ud83d\\ude00\\\\\\n", "2025-01-17T12:00:00Z")
+            .write(to: paths.stdoutPath, atomically: true, encoding: .utf8)
+
+        let replay = try LogReplay(logPaths: paths, streams: [.stdout])
+        #expect(try text(replay) == ["say \"hi\"\t\u{e9}\u{1F600}\\\n"])
+    }
+
+    @Test("Tail and since select from the merged stream")
+    func tailAndSince() throws {
+        let paths = try makeLogPaths()
+        defer { try? FileManager.default.removeItem(at: paths.logDir) }
+
+        var stdout = ""
+        var stderr = ""
+        for i in 0..<500 {
+            let time = LogTimestamp.format(Date(timeIntervalSince1970: 1_700_000_000 + Double(i)))
+            if i % 2 == 0 {
+                stdout += entry("stdout", "\(i)\\n", time)
+            } else {
+                stderr += entry("stderr", "\(i)\\n", time)
+            }
+        }
+        try stdout.write(to: paths.stdoutPath, atomically: true, encoding: .utf8)
+        try stderr.write(to: paths.stderrPath, atomically: true, encoding: .utf8)
+
+        let tail = try LogReplay(logPaths: paths, streams: [.stdout, .stderr], tail: 3)
+        #expect(try text(tail) == ["497\n", "498\n", "499\n"])
+
+        let since = try LogReplay(
+            logPaths: paths,
+            streams: [.stdout, .stderr],
+            since: Date(timeIntervalSince1970: 1_700_000_496),
+            until: Date(timeIntervalSince1970: 1_700_000_498)
+        )
+        #expect(try text(since) == ["496\n", "497\n", "498\n"])
+    }
+
+    @Test("A follower and its bounded replay cover the output exactly once")
+    func followerHandoff() async throws {
+        let paths = try makeLogPaths()
+        defer { try? FileManager.default.removeItem(at: paths.logDir) }
+
+        let broadcast = BroadcastWriter(
+            initialSubscribers: [try FileLogWriter(path: paths.stdoutPath, stream: "stdout")],
+            stream: .stdout
+        )
+        try broadcast.write(Data("before\n".utf8))
+
+        // Subscribed, but output arrives before the replay offsets are taken
+        let follower = LogFollower(maxBytes: 64 * 1024)
+        broadcast.addFollower(follower)
+        try broadcast.write(Data("between\n".utf8))
+        follower.start(replayEnds: [.stdout: try #require(broadcast.committedEnd())])
+        try broadcast.write(Data("after\n".utf8))
+        follower.finish()
+
+        let replay = try LogReplay(logPaths: paths, streams: [.stdout], through: follower.replayEnds)
+        #expect(try text(replay) == ["before\n", "between\n"])
+
+        var live: [String] = []
+        while let event = await follower.next() {
+            if case .output(let chunk) = event {
+                live.append(String(decoding: chunk.data, as: UTF8.self))
+            }
+        }
+        #expect(live == ["after\n"])
+    }
+
+    @Test("A follower that falls behind drops the oldest output and reports it")
+    func followerDrops() async {
+        let follower = LogFollower(maxBytes: 8)
+        follower.start(replayEnds: [:])
+        for text in ["aaaa", "bbbb", "cccc"] {
+            follower.receive(LogChunk(stream: .stdout, data: Data(text.utf8), timestamp: Date(), start: nil, end: nil))
+        }
+        follower.finish()
+
+        guard case .dropped(let stream, let bytes)? = await follower.next() else {
+            Issue.record("Expected a drop notice first")
+            return
+        }
+        #expect(stream == .stdout && bytes == 4)
+
+        var live: [String] = []
+        while case .output(let chunk)? = await follower.next() {
+            live.append(String(decoding: chunk.data, as: UTF8.self))
+        }
+        #expect(live == ["bbbb", "cccc"])
+    }
+
+    @Test("Under replay-from-log a follower that falls behind catches up from the log")
+    func followerCatchUp() async throws {
+        let paths = try makeLogPaths()
+        defer { try? FileManager.default.removeItem(at: paths.logDir) }
+
+        let log = try FileLogWriter(path: paths.stdoutPath, stream: "stdout")
+        let broadcast = BroadcastWriter(initialSubscribers: [log], stream: .stdout)
+        let follower = LogFollower(policy: .replayFromLog, maxBytes: 8)
+        broadcast.addFollower(follower)
+        follower.start(replayEnds: [.stdout: log.committedEnd()], logs: [.stdout: log])
+
+        for text in ["aaaa\n", "bbbb\n", "cccc\n"] {
+            try broadcast.write(Data(text.utf8))
+        }
+        follower.finish()
+
+        var received: [String] = []
+        while let event = await follower.next() {
+            switch event {
+            case .output(let chunk):
+                received.append(String(decoding: chunk.data, as: UTF8.self))
+            case .history(let lines):
+                received += lines.map { String(decoding: $0.message, as: UTF8.self) }
+            case .dropped:
+                Issue.record("Nothing should be dropped under replay-from-log")
+            }
+        }
+        #expect(received == ["aaaa\n", "bbbb\n", "cccc\n"])
+    }
+
+    @Test("Timestamps format and parse with nanosecond precision")
+    func timestamps() throws {
+        let date = Date(timeIntervalSince1970: 1_737_117_296.5)
+        let formatted = LogTimestamp.format(date)
+        #expect(formatted.hasPrefix("2025-01-17T12:34:56.500"))
+        #expect(formatted.count == 30)
+
+        let parsed = try #require(LogTimestamp.parse(Array(formatted.utf8)))
+        #expect(abs(parsed.timeIntervalSince(date)) < 0.000_001)
+    }
+}
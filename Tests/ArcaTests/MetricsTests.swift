@@ -0,0 +1,99 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Metrics Tests
+/// Verifies histogram bucketing, text exposition rendering and trace context parsing
+@Suite("Metrics")
+struct MetricsTests {
+
+    @Test("Observations land in the first bucket whose bound they do not exceed")
+    func bucketing() throws {
+        let histogram = Histogram(name: "test_seconds", help: "Test", labelNames: ["route"], buckets: [0.25, 1, 10])
+        histogram.observe(0.125, labels: ["/a"])
+        histogram.observe(0.25, labels: ["/a"])
+        histogram.observe(5, labels: ["/a"])
+        histogram.observe(50, labels: ["/a"])
+        histogram.observe(1, labels: ["/b"])
+
+        let a = try #require(histogram.snapshot(labels: ["/a"]))
+        #expect(a.buckets == [2, 2, 3, 4])
+        #expect(a.count == 4)
+        #expect(a.sum == 55.375)
+
+        let b = try #require(histogram.snapshot(labels: ["/b"]))
+        #expect(b.buckets == [0, 1, 1, 1])
+        #expect(histogram.snapshot(labels: ["/c"]) == nil)
+    }
+
+    @Test("Histograms render cumulative buckets, sum and count per label set")
+    func histogramRendering() {
+        let histogram = Histogram(name: "test_seconds", help: "Test latency", labelNames: ["method"], buckets: [0.5, 2.5])
+        histogram.observe(0.25, labels: ["GET"])
+        histogram.observe(2, labels: ["GET"])
+
+        var output = ""
+        histogram.family().render(into: &output)
+        #expect(output == """
+            # HELP test_seconds Test latency
+            # TYPE test_seconds histogram
+            test_seconds_bucket{method="GET",le="0.5"} 1
+            test_seconds_bucket{method="GET",le="2.5"} 2
+            test_seconds_bucket{method="GET",le="+Inf"} 2
+            test_seconds_sum{method="GET"} 2.25
+            test_seconds_count{method="GET"} 2
+
+            """)
+    }
+
+    @Test("Label values are escaped")
+    func labelEscaping() {
+        let family = MetricFamily(name: "test_total", help: "Test", kind: .counter, samples: [
+            MetricFamily.Sample(labels: [(name: "path", value: "a\"b\\c\nd")], value: 3)
+        ])
+        var output = ""
+        family.render(into: &output)
+        #expect(output.hasSuffix("test_total{path=\"a\\\"b\\\\c\\nd\"} 3\n"))
+    }
+
+    @Test("Collectors are read on every render")
+    func collectors() async {
+        let metrics = Metrics()
+        let counter = ProxyCounters()
+        metrics.register {
+            [.gauge("test_connections", help: "Test", value: Double(counter.snapshot().connectionsActive))]
+        }
+
+        #expect(await metrics.render().contains("test_connections 0\n"))
+        counter.connectionOpened()
+        #expect(await metrics.render().contains("test_connections 1\n"))
+    }
+
+    @Test("traceparent round-trips and malformed headers are rejected")
+    func traceContext() throws {
+        let header = "00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01"
+        let context = try #require(SpanContext(traceparent: header))
+        #expect(context.traceID == "4bf92f3577b34da6a3ce929d0e0e4736")
+        #expect(context.spanID == "00f067aa0ba902b7")
+        #expect(context.traceparent == header)
+
+        let child = context.child()
+        #expect(child.traceID == context.traceID)
+        #expect(child.spanID != context.spanID)
+        #expect(child.spanID.count == 16)
+
+        #expect(SpanContext(traceparent: "00-4bf92f3577b34da6-00f067aa0ba902b7-01") == nil)
+        #expect(SpanContext(traceparent: "00-00000000000000000000000000000000-00f067aa0ba902b7-01") == nil)
+        #expect(SpanContext(traceparent: "not a header") == nil)
+    }
+
+    @Test("Guest call options carry the current span")
+    func callOptionsPropagation() {
+        #expect(Tracing.callOptions().customMetadata.first(name: "traceparent") == nil)
+
+        let context = SpanContext.root()
+        Tracing.$current.withValue(context) {
+            #expect(Tracing.callOptions().customMetadata.first(name: "traceparent") == context.traceparent)
+        }
+    }
+}
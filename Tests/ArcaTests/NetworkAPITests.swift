@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Comprehensive tests for Docker Network API compatibility (Phases 1-5)
 /// Validates complete implementation against Docker Engine API v1.51 spec
@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Comprehensive IPAM (IP Address Management) test suite
 /// Tests subnet allocation, IP allocation, IP ranges, and IP reclamation
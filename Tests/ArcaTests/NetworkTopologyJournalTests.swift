@@ -0,0 +1,153 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Network Topology Journal Tests
+/// Verifies full syncs on join, incremental deltas, rejoin replacement, log compaction and acknowledgements
+@Suite("Network Topology Journal")
+struct NetworkTopologyJournalTests {
+
+    private func peer(_ id: String, key: String? = nil) -> NetworkTopologyJournal.Peer {
+        NetworkTopologyJournal.Peer(
+            containerID: id,
+            publicKey: key ?? "key-\(id)",
+            endpoint: "192.168.64.2:51820",
+            ipAddress: "172.18.0.2",
+            name: id,
+            aliases: []
+        )
+    }
+
+    /// Deliver and acknowledge every pending delta
+    private func sync(_ journal: inout NetworkTopologyJournal, _ networkID: String = "net") {
+        for containerID in journal.pending(networkID: networkID) {
+            let delta = journal.delta(networkID: networkID, for: containerID)!
+            journal.acknowledge(networkID: networkID, containerID: containerID, subscriberKey: delta.subscriberKey, version: delta.version)
+        }
+    }
+
+    @Test("A joining container gets a full sync of the other members")
+    func joinFullSync() {
+        var journal = NetworkTopologyJournal()
+        journal.join(networkID: "net", peer: peer("a"))
+        journal.join(networkID: "net", peer: peer("b"))
+
+        let delta = journal.delta(networkID: "net", for: "b")
+        #expect(delta?.fullSync == true)
+        #expect(delta?.added.map(\.containerID) == ["a"])
+        #expect(delta?.version == 2)
+    }
+
+    @Test("Members get only what changed since their version")
+    func incremental() {
+        var journal = NetworkTopologyJournal()
+        journal.join(networkID: "net", peer: peer("a"))
+        journal.join(networkID: "net", peer: peer("b"))
+        sync(&journal)
+        #expect(journal.pending(networkID: "net").isEmpty)
+
+        // Scaling out: one delta per existing member carries every new replica
+        for id in ["c", "d", "e"] {
+            journal.join(networkID: "net", peer: peer(id))
+        }
+        let delta = journal.delta(networkID: "net", for: "a")
+        #expect(delta?.fullSync == false)
+        #expect(delta?.baseVersion == 2)
+        #expect(delta?.added.map(\.containerID) == ["c", "d", "e"])
+        #expect(delta?.removed.isEmpty == true)
+    }
+
+    @Test("Leaving removes the peer; peers never seen are not removed")
+    func removals() {
+        var journal = NetworkTopologyJournal()
+        journal.join(networkID: "net", peer: peer("a"))
+        journal.join(networkID: "net", peer: peer("b"))
+        sync(&journal)
+
+        journal.leave(networkID: "net", containerID: "b")
+        journal.join(networkID: "net", peer: peer("c"))
+        journal.leave(networkID: "net", containerID: "c")
+
+        let delta = journal.delta(networkID: "net", for: "a")
+        #expect(delta?.removed.map(\.containerID) == ["b"])
+        #expect(delta?.added.isEmpty == true)
+    }
+
+    @Test("Rejoining replaces the old interface and resets the member's guest")
+    func rejoin() {
+        var journal = NetworkTopologyJournal()
+        journal.join(networkID: "net", peer: peer("a"))
+        journal.join(networkID: "net", peer: peer("b"))
+        sync(&journal)
+
+        journal.join(networkID: "net", peer: peer("b", key: "key-b2"))
+
+        let delta = journal.delta(networkID: "net", for: "a")
+        #expect(delta?.removed.map(\.publicKey) == ["key-b"])
+        #expect(delta?.added.map(\.publicKey) == ["key-b2"])
+        #expect(journal.delta(networkID: "net", for: "b")?.fullSync == true)
+    }
+
+    @Test("Acknowledgements for a replaced interface are ignored")
+    func staleAcknowledgement() {
+        var journal = NetworkTopologyJournal()
+        journal.join(networkID: "net", peer: peer("a"))
+        journal.join(networkID: "net", peer: peer("b"))
+        let stale = journal.delta(networkID: "net", for: "b")!
+
+        journal.join(networkID: "net", peer: peer("b", key: "key-b2"))
+        journal.acknowledge(networkID: "net", containerID: "b", subscriberKey: stale.subscriberKey, version: stale.version)
+
+        #expect(journal.delta(networkID: "net", for: "b")?.fullSync == true)
+    }
+
+    @Test("Members older than the removal log get a full sync")
+    func compaction() {
+        var journal = NetworkTopologyJournal(retention: 2)
+        journal.join(networkID: "net", peer: peer("a"))
+        journal.join(networkID: "net", peer: peer("b"))
+        sync(&journal)
+
+        for id in ["c", "d", "e"] {
+            journal.join(networkID: "net", peer: peer(id))
+            journal.leave(networkID: "net", containerID: id)
+        }
+
+        let delta = journal.delta(networkID: "net", for: "a")
+        #expect(delta?.fullSync == true)
+        #expect(delta?.added.map(\.containerID) == ["b"])
+    }
+
+    @Test("Stopped members are skipped until they rejoin")
+    func suspend() {
+        var journal = NetworkTopologyJournal()
+        journal.join(networkID: "net", peer: peer("a"))
+        journal.join(networkID: "net", peer: peer("b"))
+        sync(&journal)
+
+        journal.suspend(containerID: "b")
+        journal.join(networkID: "net", peer: peer("c"))
+        #expect(journal.pending(networkID: "net") == ["a", "c"])
+        // A container joining meanwhile gets no peer or DNS record for the stopped one
+        #expect(journal.delta(networkID: "net", for: "c")?.added.map(\.containerID) == ["a"])
+
+        journal.join(networkID: "net", peer: peer("b", key: "key-b2"))
+        #expect(journal.pending(networkID: "net").contains("b"))
+        #expect(journal.delta(networkID: "net", for: "b")?.fullSync == true)
+    }
+
+    @Test("Members that stop after joining are left out of incremental deltas")
+    func suspendedNotAdded() {
+        var journal = NetworkTopologyJournal()
+        journal.join(networkID: "net", peer: peer("a"))
+        sync(&journal)
+
+        journal.join(networkID: "net", peer: peer("b"))
+        journal.join(networkID: "net", peer: peer("c"))
+        journal.suspend(containerID: "b")
+
+        let delta = journal.delta(networkID: "net", for: "a")
+        #expect(delta?.fullSync == false)
+        #expect(delta?.added.map(\.containerID) == ["c"])
+    }
+}
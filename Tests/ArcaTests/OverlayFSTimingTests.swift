@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 @testable import ArcaDaemon
 @testable import ContainerBridge
 @testable import DockerAPI
@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Tests port mapping features (Phase 4.1)
 /// Validates TCP/UDP port forwarding, conflict detection, and persistence
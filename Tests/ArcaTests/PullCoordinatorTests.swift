@@ -0,0 +1,225 @@
+import Testing
+import Foundation
+import Containerization
+@testable import ContainerBridge
+
+/// Pull Coordinator Tests
+/// Verifies single-flight sharing of identical pulls, the per-registry transfer bound, and
+/// progress replay to callers that join a transfer late, using a stub fetcher
+@Suite("Pull Coordinator")
+struct PullCoordinatorTests {
+
+    /// Holds stub transfers open until the test releases them
+    private actor Gate {
+        private var isOpen = false
+        private var waiters: [CheckedContinuation<Void, Never>] = []
+
+        func wait() async {
+            guard !isOpen else { return }
+            await withCheckedContinuation { waiters.append($0) }
+        }
+
+        func open() {
+            isOpen = true
+            waiters.forEach { $0.resume() }
+            waiters.removeAll()
+        }
+    }
+
+    /// Counts stub fetches and how many ran at once
+    private actor Fetches {
+        private(set) var started = 0
+        private(set) var running = 0
+        private(set) var peak = 0
+
+        func begin() {
+            started += 1
+            running += 1
+            peak = max(peak, running)
+        }
+
+        func end() {
+            running -= 1
+        }
+    }
+
+    /// Progress events received by one caller
+    private actor ProgressLog {
+        private(set) var batches: [[ProgressEvent]] = []
+
+        func append(_ events: [ProgressEvent]) {
+            batches.append(events)
+        }
+
+        func total(_ event: String) -> Int64 {
+            batches.joined().filter { $0.event == event }.reduce(0) { $0 + ($1.value as? Int64 ?? 0) }
+        }
+    }
+
+    /// A fetcher that reports `events`, then waits for `gate` before returning `value`
+    private func stubFetcher(
+        _ value: String,
+        fetches: Fetches,
+        gate: Gate,
+        events: [ProgressEvent] = []
+    ) -> PullCoordinator<String>.Operation {
+        { progress in
+            await fetches.begin()
+            if !events.isEmpty {
+                await progress(events)
+            }
+            await gate.wait()
+            await fetches.end()
+            return value
+        }
+    }
+
+    /// Poll `condition` until it holds or a few seconds pass
+    private func waitUntil(_ condition: () async -> Bool) async throws {
+        for _ in 0..<500 {
+            if await condition() { return }
+            try await Task.sleep(for: .milliseconds(10))
+        }
+        Issue.record("Condition not reached in time")
+    }
+
+    @Test("Concurrent pulls of the same key share one transfer")
+    func singleFlight() async throws {
+        let coordinator = PullCoordinator<String>()
+        let fetches = Fetches()
+        let gate = Gate()
+        let first = ProgressLog()
+        let second = ProgressLog()
+
+        let leader = Task {
+            try await coordinator.pull(
+                key: "sha256:aaa", registry: "registry.local", layers: ["sha256:l1": 100],
+                progress: { await first.append($0) },
+                operation: stubFetcher("leader", fetches: fetches, gate: gate))
+        }
+        try await waitUntil { await coordinator.activity().transfers == 1 }
+
+        let follower = Task {
+            try await coordinator.pull(
+                key: "sha256:aaa", registry: "registry.local", layers: ["sha256:l1": 100],
+                progress: { await second.append($0) },
+                operation: stubFetcher("follower", fetches: fetches, gate: gate))
+        }
+        try await waitUntil { await coordinator.activity().watchers == 2 }
+        await gate.open()
+
+        let (leaderImage, leaderShared) = try await leader.value
+        let (followerImage, followerShared) = try await follower.value
+        #expect(leaderImage == "leader" && !leaderShared)
+        #expect(followerImage == "leader" && followerShared)
+        #expect(await fetches.started == 1)
+        #expect(await coordinator.activity().transfers == 0)
+    }
+
+    @Test("Transfers from one registry are bounded; other registries are not held back")
+    func registrySlots() async throws {
+        let coordinator = PullCoordinator<String>(config: PullConfig(maxConcurrentPullsPerRegistry: 2))
+        let fetches = Fetches()
+        let gate = Gate()
+
+        var pulls: [Task<(image: String, shared: Bool), Error>] = []
+        for index in 0..<5 {
+            pulls.append(Task {
+                try await coordinator.pull(
+                    key: "sha256:busy-\(index)", registry: "busy.local", layers: ["sha256:busy-\(index)": 10],
+                    progress: nil,
+                    operation: stubFetcher("busy-\(index)", fetches: fetches, gate: gate))
+            })
+        }
+        try await waitUntil {
+            let transfers = await coordinator.activity().transfers
+            return await transfers == 5 && fetches.running == 2
+        }
+
+        // A different registry gets its own slots
+        let other = Task {
+            try await coordinator.pull(
+                key: "sha256:other", registry: "other.local", layers: ["sha256:other": 10],
+                progress: nil,
+                operation: stubFetcher("other", fetches: fetches, gate: gate))
+        }
+        try await waitUntil { await fetches.running == 3 }
+        try await Task.sleep(for: .milliseconds(50))
+        #expect(await fetches.running == 3)
+
+        await gate.open()
+        for pull in pulls {
+            _ = try await pull.value
+        }
+        _ = try await other.value
+        #expect(await fetches.started == 6)
+        #expect(await fetches.peak == 3)
+    }
+
+    @Test("A caller joining late is replayed the totals reported so far")
+    func lateJoinerReplay() async throws {
+        let coordinator = PullCoordinator<String>()
+        let fetches = Fetches()
+        let gate = Gate()
+        let first = ProgressLog()
+        let late = ProgressLog()
+
+        let events = [
+            ProgressEvent(event: "add-total-size", value: Int64(1000)),
+            ProgressEvent(event: "add-size", value: Int64(400)),
+        ]
+        let leader = Task {
+            try await coordinator.pull(
+                key: "sha256:bbb", registry: "registry.local", layers: ["sha256:l1": 1000],
+                progress: { await first.append($0) },
+                operation: stubFetcher("image", fetches: fetches, gate: gate, events: events))
+        }
+        try await waitUntil { await first.total("add-size") == 400 }
+
+        let follower = Task {
+            try await coordinator.pull(
+                key: "sha256:bbb", registry: "registry.local", layers: ["sha256:l1": 1000],
+                progress: { await late.append($0) },
+                operation: stubFetcher("unused", fetches: fetches, gate: gate))
+        }
+        try await waitUntil { await late.batches.count == 1 }
+        #expect(await late.total("add-total-size") == 1000)
+        #expect(await late.total("add-size") == 400)
+
+        await gate.open()
+        _ = try await leader.value
+        _ = try await follower.value
+        #expect(await fetches.started == 1)
+        #expect(await first.total("add-size") == 400)
+    }
+
+    @Test("A pull overlapping most of an in-flight pull's layers waits for it first")
+    func overlappingLayers() async throws {
+        let coordinator = PullCoordinator<String>()
+        let fetches = Fetches()
+        let gate = Gate()
+
+        let base = Task {
+            try await coordinator.pull(
+                key: "sha256:base", registry: "registry.local", layers: ["sha256:big": 900, "sha256:a": 100],
+                progress: nil,
+                operation: stubFetcher("base", fetches: fetches, gate: gate))
+        }
+        try await waitUntil { await fetches.running == 1 }
+
+        let derived = Task {
+            try await coordinator.pull(
+                key: "sha256:derived", registry: "registry.local", layers: ["sha256:big": 900, "sha256:b": 100],
+                progress: nil,
+                operation: stubFetcher("derived", fetches: fetches, gate: gate))
+        }
+        try await waitUntil { await coordinator.activity().transfers == 2 }
+        try await Task.sleep(for: .milliseconds(50))
+        #expect(await fetches.started == 1)
+
+        await gate.open()
+        #expect(try await base.value.image == "base")
+        #expect(try await derived.value.image == "derived")
+        #expect(await fetches.peak == 1)
+    }
+}
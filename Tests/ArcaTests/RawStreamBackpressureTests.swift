@@ -0,0 +1,197 @@
+import Testing
+import Foundation
+import Logging
+import NIOCore
+import NIOPosix
+@testable import ArcaDaemon
+@testable import ContainerBridge
+
+/// Raw Stream Backpressure Tests
+/// Verifies that exec/attach streams stop reading stdin while the process is behind and
+/// block container output while the client is behind, resuming once each side drains
+///
+/// These tests bind loopback ports only and do not need a running daemon
+@Suite("Raw Stream Backpressure")
+struct RawStreamBackpressureTests {
+
+    /// @unchecked Sendable: Safe because the count is protected by NSLock
+    private final class Counter: @unchecked Sendable {
+        private let lock = NSLock()
+        private var count = 0
+
+        var value: Int {
+            lock.lock()
+            defer { lock.unlock() }
+            return count
+        }
+
+        func add(_ amount: Int) {
+            lock.lock()
+            count += amount
+            lock.unlock()
+        }
+    }
+
+    /// Counts bytes a client has read
+    private final class CountHandler: ChannelInboundHandler {
+        typealias InboundIn = ByteBuffer
+
+        let received: Counter
+
+        init(received: Counter) {
+            self.received = received
+        }
+
+        func channelRead(context: ChannelHandlerContext, data: NIOAny) {
+            received.add(unwrapInboundIn(data).readableBytes)
+        }
+    }
+
+    /// Poll `condition` until it holds or a few seconds pass
+    private func waitUntil(_ condition: () async throws -> Bool) async throws {
+        for _ in 0..<500 {
+            if try await condition() { return }
+            try await Task.sleep(for: .milliseconds(10))
+        }
+        Issue.record("Condition not reached in time")
+    }
+
+    /// Listen on loopback and connect a client; returns the server side of the connection
+    private func connect(
+        group: EventLoopGroup,
+        server configure: @escaping @Sendable (Channel) -> EventLoopFuture<Void> = { $0.eventLoop.makeSucceededVoidFuture() },
+        clientAutoRead: Bool = true,
+        clientReceived: Counter? = nil
+    ) async throws -> (listener: Channel, server: Channel, client: Channel) {
+        let accepted = group.next().makePromise(of: Channel.self)
+        let listener = try await ServerBootstrap(group: group)
+            .childChannelInitializer { channel in
+                configure(channel).map { accepted.succeed(channel) }
+            }
+            .bind(host: "127.0.0.1", port: 0).get()
+        let port = try #require(listener.localAddress?.port)
+
+        let client = try await ClientBootstrap(group: group)
+            .channelOption(ChannelOptions.autoRead, value: clientAutoRead)
+            .channelInitializer { channel in
+                guard let received = clientReceived else { return channel.eventLoop.makeSucceededVoidFuture() }
+                return channel.pipeline.addHandler(CountHandler(received: received))
+            }
+            .connect(host: "127.0.0.1", port: port).get()
+
+        return (listener, try await accepted.futureResult.get(), client)
+    }
+
+    // MARK: - Stdin
+
+    @Test("ChannelReader asks the producer to pause at the high watermark and resumes it on drain")
+    func readerWatermark() async throws {
+        let reader = ChannelReader()
+        let resumes = Counter()
+        reader.setResumeHandler { resumes.add(1) }
+
+        let chunk = [UInt8](repeating: 0x61, count: 256 * 1024)
+        var accepted = 0
+        while reader.push(chunk) {
+            accepted += 1
+        }
+        #expect(accepted == ChannelReader.highWaterMark / chunk.count - 1)
+
+        // Still paused: input already read off the socket is kept, not dropped
+        #expect(!reader.push(chunk))
+        #expect(resumes.value == 0)
+
+        var iterator = reader.stream().makeAsyncIterator()
+        let drained = await iterator.next()
+        #expect(drained?.count == ChannelReader.highWaterMark + chunk.count)
+        #expect(resumes.value == 1)
+
+        // Below the watermark again; draining without a pause doesn't resume twice
+        #expect(reader.push(chunk))
+        _ = await iterator.next()
+        #expect(resumes.value == 1)
+
+        reader.finish()
+        let end = await iterator.next()
+        #expect(end == nil)
+    }
+
+    @Test("The raw stream handler stops reading the socket while stdin is full")
+    func stdinPausesSocketReads() async throws {
+        let group = MultiThreadedEventLoopGroup(numberOfThreads: 2)
+        defer { try? group.syncShutdownGracefully() }
+
+        let reader = ChannelReader()
+        let logger = Logger(label: "arca.tests.rawstream")
+        let (listener, server, client) = try await connect(group: group, server: { channel in
+            channel.pipeline.addHandler(DockerRawStreamHandler(logger: logger, stdinReader: reader))
+        })
+        defer {
+            client.close(promise: nil)
+            listener.close(promise: nil)
+        }
+
+        // Several times the watermark, so the client's write can't complete while paused
+        let payload = ByteBuffer(repeating: 0x62, count: 4 * ChannelReader.highWaterMark)
+        let written = client.writeAndFlush(payload)
+
+        try await waitUntil { try await !server.getOption(ChannelOptions.autoRead).get() }
+
+        var iterator = reader.stream().makeAsyncIterator()
+        var received = 0
+        while received < payload.readableBytes, let chunk = await iterator.next() {
+            received += chunk.count
+        }
+        try await written.get()
+        #expect(received == payload.readableBytes)
+        try await waitUntil { try await server.getOption(ChannelOptions.autoRead).get() }
+    }
+
+    // MARK: - Output
+
+    @Test("Output writers block above the high watermark and continue once the client reads")
+    func outputBlocksSlowClient() async throws {
+        let group = MultiThreadedEventLoopGroup(numberOfThreads: 2)
+        defer { try? group.syncShutdownGracefully() }
+
+        // The client doesn't read until told to, so the socket buffers fill up
+        let received = Counter()
+        let (listener, server, client) = try await connect(
+            group: group, clientAutoRead: false, clientReceived: received)
+        defer {
+            client.close(promise: nil)
+            listener.close(promise: nil)
+        }
+
+        let output = RawStreamOutput(channel: server)
+        let chunk = Data(repeating: 0x63, count: 256 * 1024)
+        let chunks = 128  // Well past the watermark plus the kernel's socket buffers
+        let sent = Counter()
+        let finished = group.next().makePromise(of: Void.self)
+
+        // Writers block their thread, as the process output pipes do
+        Thread {
+            for _ in 0..<chunks {
+                output.send(chunk, streamType: 1)
+                sent.add(1)
+            }
+            finished.succeed(())
+        }.start()
+
+        // Let the send that crossed the watermark return before sampling
+        try await waitUntil { output.backlog > RawStreamOutput.highWaterMark }
+        try await Task.sleep(for: .milliseconds(100))
+        let stalled = sent.value
+        try await Task.sleep(for: .milliseconds(200))
+        #expect(sent.value == stalled)
+        #expect(stalled < chunks)
+        #expect(output.backlog <= RawStreamOutput.highWaterMark + chunk.count + 8)
+
+        try await client.setOption(ChannelOptions.autoRead, value: true).get()
+        try await finished.futureResult.get()
+        await output.drain()
+        #expect(output.backlog == 0)
+
+        try await waitUntil { received.value == chunks * (chunk.count + 8) }
+    }
+}
@@ -0,0 +1,91 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Recovery Plan Tests
+/// Verifies dependency waves from compose labels, network grouping, cycles and the concurrency limit
+@Suite("Recovery Plan")
+struct RecoveryPlanTests {
+
+    private func member(_ id: String, project: String? = "app", service: String? = nil, dependsOn: String? = nil, networks: [String] = []) -> RecoveryPlan.Member {
+        var labels: [String: String] = [:]
+        labels[RecoveryPlan.projectLabel] = project
+        labels[RecoveryPlan.serviceLabel] = service ?? id
+        labels[RecoveryPlan.dependsOnLabel] = dependsOn
+        return RecoveryPlan.Member(id: id, labels: labels, networkIDs: networks)
+    }
+
+    @Test("depends_on services start in earlier waves")
+    func waves() {
+        let plan = RecoveryPlan([
+            member("web", dependsOn: "api:service_started:false"),
+            member("api", dependsOn: "db:service_healthy:true,cache:service_started:false"),
+            member("db"),
+            member("cache"),
+            member("worker", dependsOn: "db:service_started:false")
+        ])
+
+        #expect(plan.waves.map { Set($0) } == [["db", "cache"], ["api", "worker"], ["web"]])
+        #expect(plan.cyclic.isEmpty)
+    }
+
+    @Test("Dependencies outside the plan or another project are ignored")
+    func externalDependencies() {
+        let plan = RecoveryPlan([
+            member("web", dependsOn: "db:service_started:false"),
+            member("db", project: "other")
+        ])
+
+        #expect(plan.waves.map { Set($0) } == [["web", "db"]])
+    }
+
+    @Test("Scaled services are all waited for")
+    func scaledServices() {
+        let plan = RecoveryPlan([
+            member("web", dependsOn: "api:service_started:false"),
+            member("api-1", service: "api"),
+            member("api-2", service: "api")
+        ])
+
+        #expect(plan.waves.map { Set($0) } == [["api-1", "api-2"], ["web"]])
+    }
+
+    @Test("Cycles go last instead of blocking recovery")
+    func cycles() {
+        let plan = RecoveryPlan([
+            member("a", dependsOn: "b:service_started:false"),
+            member("b", dependsOn: "a:service_started:false"),
+            member("c")
+        ])
+
+        #expect(plan.waves == [["c"], ["a", "b"]])
+        #expect(Set(plan.cyclic) == ["a", "b"])
+    }
+
+    @Test("Containers sharing a network are adjacent within a wave")
+    func networkGrouping() {
+        let plan = RecoveryPlan([
+            member("a", networks: ["net2"]),
+            member("b", networks: ["net1"]),
+            member("c", networks: ["net2"]),
+            member("d", networks: ["net1"])
+        ])
+
+        #expect(plan.waves == [["b", "d", "a", "c"]])
+    }
+
+    @Test("depends_on labels parse service names")
+    func dependsOnParsing() {
+        #expect(RecoveryPlan.services(in: "db:service_started:false, cache:service_healthy:true") == ["db", "cache"])
+        #expect(RecoveryPlan.services(in: "db") == ["db"])
+        #expect(RecoveryPlan.services(in: "").isEmpty)
+    }
+
+    @Test("Concurrency is bounded by cores and memory")
+    func concurrency() {
+        let gib: UInt64 = 1 << 30
+        #expect(RecoveryPlan.defaultConcurrency(cores: 10, memoryBytes: 64 * gib) == 10)
+        #expect(RecoveryPlan.defaultConcurrency(cores: 10, memoryBytes: 8 * gib) == 4)
+        #expect(RecoveryPlan.defaultConcurrency(cores: 4, memoryBytes: 1 * gib) == 1)
+    }
+}
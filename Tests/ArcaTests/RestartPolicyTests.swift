@@ -1,5 +1,6 @@
 import Testing
 import Foundation
+import ArcaTestSupport
 
 /// Restart Policy Tests
 /// Tests Docker restart policies (always, unless-stopped, on-failure, no) by:
@@ -0,0 +1,49 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Ring Buffer Tests
+/// Verifies FIFO order, overwrite-on-full eviction and indexing
+@Suite("Ring Buffer")
+struct RingBufferTests {
+
+    @Test("Appends beyond capacity evict the oldest element")
+    func eviction() {
+        var ring = RingBuffer<Int>(capacity: 3)
+        #expect(ring.isEmpty)
+        #expect(ring.last == nil)
+
+        #expect(ring.append(1) == nil)
+        #expect(ring.append(2) == nil)
+        #expect(ring.append(3) == nil)
+        #expect(ring.isFull)
+        #expect(ring.append(4) == 1)
+        #expect(ring.append(5) == 2)
+
+        #expect(Array(ring) == [3, 4, 5])
+        #expect(ring.first == 3)
+        #expect(ring.last == 5)
+        #expect(ring[1] == 4)
+        #expect(ring.count == 3)
+    }
+
+    @Test("popFirst drains in FIFO order")
+    func drain() {
+        var ring = RingBuffer<String>(capacity: 2)
+        ring.append("a")
+        ring.append("b")
+        ring.append("c")
+
+        #expect(ring.popFirst() == "b")
+        ring.append("d")
+        #expect(Array(ring) == ["c", "d"])
+        #expect(ring.popFirst() == "c")
+        #expect(ring.popFirst() == "d")
+        #expect(ring.popFirst() == nil)
+
+        ring.append("e")
+        ring.removeAll()
+        #expect(ring.isEmpty)
+        #expect(Array(ring).isEmpty)
+    }
+}
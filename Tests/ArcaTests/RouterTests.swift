@@ -0,0 +1,81 @@
+import Testing
+import Foundation
+import Logging
+import NIOHTTP1
+import DockerAPI
+@testable import ArcaDaemon
+
+/// Router Tests
+/// Verifies route trie matching, parameter extraction and API version prefix handling
+@Suite("Router")
+struct RouterTests {
+
+    private func makeRouter() -> Router {
+        let handler: RouteHandler = { _ in .standard(HTTPResponse.error("unused", status: .ok)) }
+        let builder = Router.builder(logger: Logger(label: "arca.tests.router"))
+        for pattern in [
+            "/_ping", "/containers/json", "/containers/create", "/containers/{id}/json",
+            "/containers/{id}/start", "/images/json", "/images/{name:.*}/json", "/version"
+        ] {
+            _ = builder.get(pattern, handler: handler)
+        }
+        _ = builder.delete("/images/{name:.*}", handler: handler)
+        _ = builder.put("/containers/{id}/archive", streamingBody: true, handler: handler)
+        return builder.build()
+    }
+
+    @Test("Literal segments win over parameters")
+    func literalPrecedence() {
+        let router = makeRouter()
+        #expect(router.match(method: .GET, path: "/containers/json")?.route.pattern.pattern == "/containers/json")
+        #expect(router.match(method: .GET, path: "/containers/json")?.parameters.isEmpty == true)
+        #expect(router.match(method: .GET, path: "/images/json")?.route.pattern.pattern == "/images/json")
+        #expect(router.match(method: .GET, path: "/_ping") != nil)
+        #expect(router.match(method: .POST, path: "/_ping") == nil)
+    }
+
+    @Test("Parameters are extracted in the walk")
+    func parameters() {
+        let router = makeRouter()
+        let inspect = router.match(method: .GET, path: "/containers/abc123/json")
+        #expect(inspect?.route.pattern.pattern == "/containers/{id}/json")
+        #expect(inspect?.parameters == ["id": "abc123"])
+
+        #expect(router.match(method: .GET, path: "/containers//json") == nil)
+        #expect(router.match(method: .GET, path: "/containers/abc123") == nil)
+        #expect(router.match(method: .GET, path: "/containers/json/") == nil)
+    }
+
+    @Test("Greedy parameters span slashes")
+    func greedy() {
+        let router = makeRouter()
+        let inspect = router.match(method: .GET, path: "/images/ghcr.io/org/app:1.0/json")
+        #expect(inspect?.route.pattern.pattern == "/images/{name:.*}/json")
+        #expect(inspect?.parameters == ["name": "ghcr.io/org/app:1.0"])
+
+        #expect(router.match(method: .DELETE, path: "/images/org/app:latest")?.parameters == ["name": "org/app:latest"])
+        #expect(router.match(method: .DELETE, path: "/images/") == nil)
+    }
+
+    @Test("API version prefixes are skipped")
+    func versionPrefix() {
+        let router = makeRouter()
+        #expect(router.match(method: .GET, path: "/v1.51/containers/json")?.route.pattern.pattern == "/containers/json")
+        #expect(router.match(method: .GET, path: "/v1.24/containers/c1/json")?.parameters == ["id": "c1"])
+        #expect(router.match(method: .GET, path: "/v1/containers/json") == nil)
+        #expect(router.expectsStreamingBody(method: .PUT, uri: "/v1.51/containers/c1/archive?path=/tmp"))
+        #expect(!router.expectsStreamingBody(method: .GET, uri: "/v1.51/containers/c1/json"))
+
+        #expect(APIVersionNormalizer.normalizePath("/v1.51/version") == "/version")
+        #expect(APIVersionNormalizer.normalizePath("/v1.51") == "/")
+        #expect(APIVersionNormalizer.normalizePath("/v1.51x/version") == "/v1.51x/version")
+        #expect(APIVersionNormalizer.normalizePath("/version") == "/version")
+    }
+
+    @Test("Request paths drop the query string")
+    func requestPath() {
+        #expect(Router.path(of: "/containers/json?all=1") == "/containers/json")
+        #expect(Router.path(of: "/images/a%2Fb/json") == "/images/a/b/json")
+        #expect(Router.path(of: "/_ping") == "/_ping")
+    }
+}
@@ -0,0 +1,91 @@
+import Testing
+import Foundation
+import Logging
+@testable import ContainerBridge
+
+/// State Store Tests
+/// Verifies group-committed writes against a temporary database
+///
+/// These tests do not need a running daemon
+@Suite("State Store")
+struct StateStoreTests {
+
+    private func makeStore() throws -> (StateStore, URL) {
+        let dir = FileManager.default.temporaryDirectory
+            .appendingPathComponent("arca-state-\(UUID().uuidString)")
+        let store = try StateStore(path: dir.appendingPathComponent("state.db").path, logger: Logger(label: "test.statestore"))
+        return (store, dir)
+    }
+
+    private func saveContainer(_ store: StateStore, id: String, name: String, status: String = "created") async throws {
+        try await store.saveContainer(
+            id: id, name: name, image: "alpine", imageID: "sha256:0", createdAt: Date(),
+            status: status, running: false, paused: false, restarting: false, pid: 0, exitCode: 0,
+            startedAt: nil, finishedAt: nil, stoppedByUser: false, entrypoint: nil,
+            configJSON: "{}", hostConfigJSON: "{}"
+        )
+    }
+
+    @Test("Concurrent writes all commit and are visible once awaited")
+    func concurrentWrites() async throws {
+        let (store, dir) = try makeStore()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        try await withThrowingTaskGroup(of: Void.self) { group in
+            for i in 0..<60 {
+                group.addTask {
+                    try await saveContainer(store, id: "c\(i)", name: "svc-\(i)")
+                    try await store.updateContainerStatus(id: "c\(i)", status: "exited", exitCode: i)
+                }
+            }
+            try await group.waitForAll()
+        }
+
+        let containers = try await store.loadAllContainers()
+        #expect(containers.count == 60)
+        #expect(containers.allSatisfy { $0.status == "exited" && $0.exitCode == Int($0.id.dropFirst())! })
+    }
+
+    @Test("A failing write does not roll back the rest of its batch")
+    func failureIsolation() async throws {
+        let (store, dir) = try makeStore()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        try await saveContainer(store, id: "a", name: "web")
+
+        // Issued together so they share a group commit; the name is UNIQUE
+        async let duplicate: Void = saveContainer(store, id: "b", name: "web")
+        async let other: Void = saveContainer(store, id: "c", name: "db")
+        await #expect(throws: (any Error).self) { try await duplicate }
+        try await other
+
+        let ids = Set(try await store.loadAllContainers().map { $0.id })
+        #expect(ids == ["a", "c"])
+    }
+
+    @Test("Startup snapshot includes attachments and upserts keep rows")
+    func snapshot() async throws {
+        let (store, dir) = try makeStore()
+        defer { try? FileManager.default.removeItem(at: dir) }
+
+        try await store.saveNetwork(
+            id: "n1", name: "net", driver: "bridge", scope: "local", createdAt: Date(),
+            subnet: "172.18.0.0/16", gateway: "172.18.0.1", ipRange: nil,
+            optionsJSON: nil, labelsJSON: nil, isDefault: false
+        )
+        try await saveContainer(store, id: "a", name: "web")
+        let ip = try await store.allocateAndReserveIP(
+            containerID: "a", networkID: "n1",
+            rangeStart: 0xAC12_0002, rangeEnd: 0xAC12_00FE, gatewayInt: 0xAC12_0001,
+            macAddress: "02:00:00:00:00:01", aliases: ["web"]
+        )
+        #expect(ip == "172.18.0.2")
+
+        // Updating the container must not cascade-delete its attachment
+        try await saveContainer(store, id: "a", name: "web", status: "running")
+
+        let state = try await store.loadContainerSnapshot()
+        #expect(state.containers.map { $0.status } == ["running"])
+        #expect(state.attachments["a"]?.map { $0.ipAddress } == ["172.18.0.2"])
+    }
+}
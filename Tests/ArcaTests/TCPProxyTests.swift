@@ -0,0 +1,108 @@
+import Testing
+import Foundation
+import Logging
+import NIOCore
+import NIOPosix
+@testable import ContainerBridge
+
+/// TCP Proxy Tests
+/// Forwards loopback connections through TCPProxy to a local echo server
+///
+/// These tests bind loopback ports only and do not need a running daemon
+@Suite("TCP Proxy")
+struct TCPProxyTests {
+
+    /// Echoes every read back to the sender
+    private final class EchoHandler: ChannelInboundHandler {
+        typealias InboundIn = ByteBuffer
+        typealias OutboundOut = ByteBuffer
+
+        func channelRead(context: ChannelHandlerContext, data: NIOAny) {
+            context.write(data, promise: nil)
+        }
+
+        func channelReadComplete(context: ChannelHandlerContext) {
+            context.flush()
+        }
+    }
+
+    /// Collects bytes until `expected` have arrived
+    private final class CollectHandler: ChannelInboundHandler {
+        typealias InboundIn = ByteBuffer
+
+        private let expected: Int
+        private var received = ByteBuffer()
+        private var completed = false
+        let done: EventLoopPromise<ByteBuffer>
+
+        init(expected: Int, eventLoop: EventLoop) {
+            self.expected = expected
+            self.done = eventLoop.makePromise()
+        }
+
+        func channelRead(context: ChannelHandlerContext, data: NIOAny) {
+            var buffer = unwrapInboundIn(data)
+            received.writeBuffer(&buffer)
+            if !completed, received.readableBytes >= expected {
+                completed = true
+                done.succeed(received)
+            }
+        }
+
+        func channelInactive(context: ChannelHandlerContext) {
+            if !completed {
+                completed = true
+                done.fail(ChannelError.eof)
+            }
+        }
+    }
+
+    @Test("Data round-trips through the proxy and is counted")
+    func roundTrip() async throws {
+        let group = MultiThreadedEventLoopGroup(numberOfThreads: 2)
+        defer { try? group.syncShutdownGracefully() }
+
+        let echo = try await ServerBootstrap(group: group)
+            .childChannelInitializer { $0.pipeline.addHandler(EchoHandler()) }
+            .bind(host: "127.0.0.1", port: 0).get()
+        defer { echo.close(promise: nil) }
+        let echoPort = try #require(echo.localAddress?.port)
+
+        // Find a free port for the proxy listener
+        let probe = try await ServerBootstrap(group: group).bind(host: "127.0.0.1", port: 0).get()
+        let proxyPort = try #require(probe.localAddress?.port)
+        try await probe.close()
+
+        let proxy = TCPProxy(
+            listenAddress: "127.0.0.1",
+            listenPort: proxyPort,
+            targetAddress: "127.0.0.1",
+            targetPort: echoPort,
+            group: group,
+            logger: Logger(label: "test.tcpproxy")
+        )
+        try await proxy.start()
+
+        // Larger than the socket buffers so backpressure has to engage
+        let payload = ByteBuffer(repeating: 0x5A, count: 8 * 1024 * 1024)
+        let eventLoop = group.next()
+        let collector = CollectHandler(expected: payload.readableBytes, eventLoop: eventLoop)
+        let client = try await ClientBootstrap(group: eventLoop)
+            .channelInitializer { $0.pipeline.addHandler(collector) }
+            .connect(host: "127.0.0.1", port: proxyPort).get()
+
+        try await client.writeAndFlush(payload).get()
+        let echoed = try await collector.done.futureResult.get()
+        #expect(echoed == payload)
+
+        let snapshot = proxy.counters.snapshot()
+        #expect(snapshot.bytesToContainer == UInt64(payload.readableBytes))
+        #expect(snapshot.bytesFromContainer == UInt64(payload.readableBytes))
+        #expect(snapshot.connectionsTotal == 1)
+        #expect(snapshot.connectionsActive == 1)
+
+        // stop() closes open connections even though the group lives on
+        try await proxy.stop()
+        try await client.closeFuture.get()
+    }
+}
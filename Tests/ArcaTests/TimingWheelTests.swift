@@ -0,0 +1,50 @@
+import Testing
+@testable import ContainerBridge
+
+/// Timing Wheel Tests
+/// Verifies expiry, lazy deadline refresh and removal
+@Suite("Timing Wheel")
+struct TimingWheelTests {
+
+    @Test("Keys expire at their deadline")
+    func expiry() {
+        var wheel = TimingWheel<String>(slotCount: 8)
+        wheel.schedule("a", at: 3)
+        wheel.schedule("b", at: 20)  // More than one revolution away
+
+        #expect(wheel.advance(to: 2).isEmpty)
+        #expect(wheel.advance(to: 3) == ["a"])
+        #expect(wheel.advance(to: 19).isEmpty)
+        #expect(wheel.advance(to: 20) == ["b"])
+        #expect(wheel.count == 0)
+    }
+
+    @Test("Refreshing a deadline postpones expiry")
+    func refresh() {
+        var wheel = TimingWheel<String>(slotCount: 4)
+        wheel.schedule("a", at: 2)
+        #expect(wheel.advance(to: 1).isEmpty)
+        wheel.schedule("a", at: 11)
+
+        #expect(wheel.advance(to: 10).isEmpty)
+        #expect(wheel.deadline(of: "a") == 11)
+        #expect(wheel.advance(to: 11) == ["a"])
+    }
+
+    @Test("Removed keys and large jumps")
+    func removeAndJump() {
+        var wheel = TimingWheel<Int>(slotCount: 4)
+        for key in 0..<100 {
+            wheel.schedule(key, at: UInt64(key % 10) + 1)
+        }
+        wheel.remove(5)
+
+        let expired = wheel.advance(to: 1_000)
+        #expect(Set(expired) == Set((0..<100).filter { $0 != 5 }))
+        #expect(wheel.count == 0)
+
+        // A deadline already in the past expires on the next tick
+        wheel.schedule(7, at: 0)
+        #expect(wheel.advance(to: 1_001) == [7])
+    }
+}
@@ -0,0 +1,50 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// Upperdir Query Tests
+/// Verifies prefix normalisation, subtree and depth filtering, and mapping entries to changes
+@Suite("Upperdir Query")
+struct UpperdirQueryTests {
+
+    @Test("Prefixes are normalised to a leading slash without a trailing one")
+    func normalisation() {
+        #expect(UpperdirQuery().pathPrefix == "/")
+        #expect(UpperdirQuery(pathPrefix: "").pathPrefix == "/")
+        #expect(UpperdirQuery(pathPrefix: "etc/").pathPrefix == "/etc")
+        #expect(UpperdirQuery(pathPrefix: "//var//log/").pathPrefix == "/var/log")
+    }
+
+    @Test("Only the prefix and paths below it match")
+    func subtree() {
+        let query = UpperdirQuery(pathPrefix: "/etc")
+        #expect(query.matches("/etc"))
+        #expect(query.matches("/etc/hosts"))
+        #expect(query.matches("/etc/ssl/certs/ca.pem"))
+        #expect(!query.matches("/etcetera"))
+        #expect(!query.matches("/var/etc/hosts"))
+    }
+
+    @Test("Depth counts levels below the prefix")
+    func depth() {
+        let query = UpperdirQuery(pathPrefix: "/etc", maxDepth: 1)
+        #expect(query.matches("/etc"))
+        #expect(query.matches("/etc/ssl"))
+        #expect(!query.matches("/etc/ssl/certs"))
+
+        let root = UpperdirQuery(maxDepth: 2)
+        #expect(root.matches("/etc/hosts"))
+        #expect(!root.matches("/etc/ssl/certs"))
+    }
+
+    @Test("Whiteouts are deletions, other known types modifications")
+    func changes() {
+        func change(_ type: String) -> FilesystemChange? {
+            FilesystemChange(upperdirEntry: UpperdirEntry(path: "/a", type: type, size: 0, mtime: 0, mode: 0))
+        }
+        #expect(change("whiteout")?.kind == FilesystemChange.ChangeKind.deleted.rawValue)
+        #expect(change("file")?.kind == FilesystemChange.ChangeKind.modified.rawValue)
+        #expect(change("symlink")?.kind == FilesystemChange.ChangeKind.modified.rawValue)
+        #expect(change("socket") == nil)
+    }
+}
@@ -0,0 +1,26 @@
+import Testing
+import Foundation
+@testable import ContainerBridge
+
+/// VM Resources Tests
+/// Verifies CPU settings mapped to vCPUs and cpuset list parsing
+@Suite("VM Resources")
+struct VMResourcesTests {
+
+    @Test("CPU limits map to the smallest vCPU count they allow")
+    func vcpus() {
+        #expect(VMResources.vcpuCount(nanoCpus: 1_500_000_000, cpuQuota: nil, cpuPeriod: nil, cpusetCpus: nil, hostCPUs: 8) == 2)
+        #expect(VMResources.vcpuCount(nanoCpus: nil, cpuQuota: 150_000, cpuPeriod: nil, cpusetCpus: nil, hostCPUs: 8) == 2)
+        #expect(VMResources.vcpuCount(nanoCpus: nil, cpuQuota: 50_000, cpuPeriod: 25_000, cpusetCpus: "0-3,6", hostCPUs: 8) == 2)
+        #expect(VMResources.vcpuCount(nanoCpus: nil, cpuQuota: nil, cpuPeriod: nil, cpusetCpus: "0-15", hostCPUs: 8) == 8)
+        #expect(VMResources.vcpuCount(nanoCpus: nil, cpuQuota: -1, cpuPeriod: nil, cpusetCpus: nil, hostCPUs: 8) == nil)
+    }
+
+    @Test("cpuset lists are counted and malformed ones rejected")
+    func cpusets() {
+        #expect(VMResources.cpusetCount("0-3,6") == 5)
+        #expect(VMResources.cpusetCount("1,1,2") == 2)
+        #expect(VMResources.cpusetCount("3-1") == nil)
+        #expect(VMResources.cpusetCount("a") == nil)
+    }
+}
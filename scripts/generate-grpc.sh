@@ -8,7 +8,10 @@ echo "========================================"
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 PROJECT_ROOT="$(dirname "$SCRIPT_DIR")"
 
-# Proto file locations (all in arca-services now)
+# Proto definitions live in this repo; the Swift client code is generated from them, and
+# they are copied into arca-services (the guest side, in the containerization submodule)
+# before its Go code is generated, so both sides always build from the same definitions
+PROTO_DIR="$PROJECT_ROOT/Sources/ContainerBridge/proto"
 ARCA_SERVICES_DIR="$PROJECT_ROOT/containerization/vminitd/extensions/arca-services"
 
 # Output directories
@@ -42,10 +45,21 @@ if ! command -v protoc-gen-grpc-swift &> /dev/null; then
     exit 1
 fi
 
+# Copy a proto into its arca-services directory (no-op without the submodule)
+sync_guest_proto() {
+    local proto="$1"
+    local go_dir="$2"
+    if [ -d "$ARCA_SERVICES_DIR" ]; then
+        mkdir -p "$go_dir"
+        cp "$proto" "$go_dir/"
+        echo "  ✓ Copied $(basename "$proto") to $go_dir"
+    fi
+}
+
 # ============================================================================
 # WireGuard Service
 # ============================================================================
-WG_PROTO="$ARCA_SERVICES_DIR/proto/wireguard/wireguard.proto"
+WG_PROTO="$PROTO_DIR/wireguard.proto"
 WG_GO_DIR="$ARCA_SERVICES_DIR/proto/wireguard"
 
 echo ""
@@ -62,7 +76,8 @@ fi
 
 echo ""
 echo "→ Generating Go code for WireGuard Service..."
-if [ -f "$WG_PROTO" ] && command -v protoc-gen-go &> /dev/null && command -v protoc-gen-go-grpc &> /dev/null; then
+sync_guest_proto "$WG_PROTO" "$WG_GO_DIR"
+if [ -d "$WG_GO_DIR" ] && command -v protoc-gen-go &> /dev/null && command -v protoc-gen-go-grpc &> /dev/null; then
     protoc "$WG_PROTO" \
         --proto_path="$(dirname "$WG_PROTO")" \
         --go_out="$WG_GO_DIR" \
@@ -77,7 +92,7 @@ fi
 # ============================================================================
 # Filesystem Service
 # ============================================================================
-FS_PROTO="$ARCA_SERVICES_DIR/proto/filesystem/filesystem.proto"
+FS_PROTO="$PROTO_DIR/filesystem.proto"
 FS_GO_DIR="$ARCA_SERVICES_DIR/proto/filesystem"
 
 echo ""
@@ -94,7 +109,8 @@ fi
 
 echo ""
 echo "→ Generating Go code for Filesystem Service..."
-if [ -f "$FS_PROTO" ] && command -v protoc-gen-go &> /dev/null && command -v protoc-gen-go-grpc &> /dev/null; then
+sync_guest_proto "$FS_PROTO" "$FS_GO_DIR"
+if [ -d "$FS_GO_DIR" ] && command -v protoc-gen-go &> /dev/null && command -v protoc-gen-go-grpc &> /dev/null; then
     protoc "$FS_PROTO" \
         --proto_path="$(dirname "$FS_PROTO")" \
         --go_out="$FS_GO_DIR" \
@@ -109,7 +125,7 @@ fi
 # ============================================================================
 # Process Service
 # ============================================================================
-PROC_PROTO="$ARCA_SERVICES_DIR/proto/process/process.proto"
+PROC_PROTO="$PROTO_DIR/process.proto"
 PROC_GO_DIR="$ARCA_SERVICES_DIR/proto/process"
 
 echo ""
@@ -126,7 +142,8 @@ fi
 
 echo ""
 echo "→ Generating Go code for Process Service..."
-if [ -f "$PROC_PROTO" ] && command -v protoc-gen-go &> /dev/null && command -v protoc-gen-go-grpc &> /dev/null; then
+sync_guest_proto "$PROC_PROTO" "$PROC_GO_DIR"
+if [ -d "$PROC_GO_DIR" ] && command -v protoc-gen-go &> /dev/null && command -v protoc-gen-go-grpc &> /dev/null; then
     protoc "$PROC_PROTO" \
         --proto_path="$(dirname "$PROC_PROTO")" \
         --go_out="$PROC_GO_DIR" \